@@ -103,5 +103,6 @@ filter "configurations:Dist"
     optimize "on"
     symbols "off"
     defines {
-        "NDEBUG"
+        "NDEBUG",
+        "IGNITE_DIST"
     }
\ No newline at end of file
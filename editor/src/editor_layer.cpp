@@ -2,9 +2,12 @@
 
 #include "panels/scene_panel.hpp"
 #include "panels/content_browser_panel.hpp"
+#include "panels/profiler_panel.hpp"
+#include "panels/gpu_profiler_panel.hpp"
 
 #include "ignite/core/platform_utils.hpp"
 #include "ignite/core/command.hpp"
+#include "ignite/core/memory.hpp"
 #include "ignite/graphics/renderer_2d.hpp"
 #include "ignite/imgui/gui_function.hpp"
 #include "ignite/graphics/mesh.hpp"
@@ -16,6 +19,7 @@
 #include "ignite/audio/fmod_dsp.hpp"
 
 #include "ignite/scripting/script_engine.hpp"
+#include "ignite/scene/simulation_rollback.hpp"
 
 #include "stb_image_write.h"
 
@@ -49,6 +53,8 @@ namespace ignite
         m_ScenePanel->CreateRenderTarget(m_Device);
 
         m_ContentBrowserPanel = CreateRef<ContentBrowserPanel>("Content Browser");
+        m_ProfilerPanel = CreateRef<ProfilerPanel>("Profiler");
+        m_GPUProfilerPanel = CreateRef<GPUProfilerPanel>("GPU Timings");
 
         const auto &cmdArgs = Application::GetInstance()->GetCreateInfo().cmdLineArgs;
         for (int i = 0; i < cmdArgs.count; ++i)
@@ -79,6 +85,8 @@ namespace ignite
         Layer::OnUpdate(deltaTime);
         
         AssetImporter::SyncMainThread(m_CommandList, m_Device);
+        UpdateSceneLoader();
+        UpdateSceneSaver(deltaTime);
 
         if (!m_ActiveScene)
             return;
@@ -91,7 +99,8 @@ namespace ignite
             case State::SceneSimulate:
             case State::ScenePlay:
             {
-                m_ActiveScene->OnUpdateRuntimeSimulate(deltaTime);
+                if (!m_Data.simulationPaused)
+                    m_ActiveScene->OnUpdateRuntimeSimulate(deltaTime);
                 break;
             }
             case State::SceneEdit:
@@ -242,7 +251,7 @@ namespace ignite
         {
             CameraBuffer cameraBuffer = { m_ScenePanel->GetViewportCamera().GetViewProjectionMatrix(), glm::vec4(m_ScenePanel->GetViewportCamera().position, 1.0f) };
             m_CommandList->writeBuffer(Renderer::GetCameraBufferHandle(), &cameraBuffer, sizeof(cameraBuffer));
-            m_SceneRenderer.Render(m_ActiveScene.get(), m_CommandList, viewportFramebuffer);
+            m_SceneRenderer.Render(m_ActiveScene.get(), &m_ScenePanel->GetViewportCamera(), m_CommandList, viewportFramebuffer);
             break;
         }
         case State::ScenePlay:
@@ -255,7 +264,7 @@ namespace ignite
 
             CameraBuffer cameraBuffer = { camera->GetViewProjectionMatrix(), glm::vec4(camera->position, 1.0f) };
             m_CommandList->writeBuffer(Renderer::GetCameraBufferHandle(), &cameraBuffer, sizeof(cameraBuffer));
-            m_SceneRenderer.Render(m_ActiveScene.get(), m_CommandList, viewportFramebuffer, camera->projectionType == ICamera::Type::Perspective);
+            m_SceneRenderer.Render(m_ActiveScene.get(), camera, m_CommandList, viewportFramebuffer, camera->projectionType == ICamera::Type::Perspective);
             break;
         }
         }
@@ -415,6 +424,16 @@ namespace ignite
                     m_Data.takeScreenshot = true;
                 }
 
+                if (ImGui::MenuItem("Profiler"))
+                {
+                    m_ProfilerPanel->Open();
+                }
+
+                if (ImGui::MenuItem("GPU Timings"))
+                {
+                    m_GPUProfilerPanel->Open();
+                }
+
 
                 ImGui::EndMenu();
             }
@@ -548,6 +567,8 @@ namespace ignite
             // scene dockspace
             m_ScenePanel->OnGuiRender();
             m_ContentBrowserPanel->OnGuiRender();
+            m_ProfilerPanel->OnGuiRender();
+            m_GPUProfilerPanel->OnGuiRender();
 
             ImGui::Begin("Project");
 
@@ -568,6 +589,12 @@ namespace ignite
         }
 
         ImGui::End(); // end dockspace
+
+        if (m_SceneLoader)
+            SceneLoaderUI();
+
+        if (m_SceneSaver)
+            SceneSaverUI();
     }
 
     void EditorLayer::NewScene()
@@ -578,6 +605,7 @@ namespace ignite
         }
 
         m_CurrentSceneFilePath.clear();
+        m_QueuedSave = {};
 
         // create editor scene
         m_EditorScene = CreateRef<Scene>("New Scene");
@@ -599,10 +627,69 @@ namespace ignite
         }
     }
 
-    bool EditorLayer::SaveScene(const std::filesystem::path &filepath) const
+    bool EditorLayer::SaveScene(const std::filesystem::path &filepath)
+    {
+        if (!m_ActiveScene)
+            return false;
+
+        // one save at a time, they write the same temporary file
+        if (m_SceneSaver)
+        {
+            m_QueuedSave = { m_ActiveScene, filepath };
+            return true;
+        }
+
+        // the snapshot is taken now, the file is written by a worker and the editor keeps running
+        m_SceneSaver = CreateScope<SceneSaver>(m_ActiveScene, filepath);
+        m_AutosaveTimer = 0.0f;
+        return true;
+    }
+
+    void EditorLayer::UpdateSceneSaver(f32 deltaTime)
+    {
+        if (m_SceneSaver && m_SceneSaver->Update())
+        {
+            m_SceneSaver.reset();
+
+            // the scene was replaced meanwhile (opened, new, play), saving now would write another scene to its file
+            QueuedSave queued = std::move(m_QueuedSave);
+            m_QueuedSave = {};
+            if (queued.scene && queued.scene == m_ActiveScene)
+                SaveScene(queued.filepath);
+        }
+
+        // autosave writes the edit scene only, never a scene that is playing
+        if (!m_Data.autosave || m_Data.sceneState != State::SceneEdit || !m_EditorScene || m_CurrentSceneFilePath.empty())
+        {
+            m_AutosaveTimer = 0.0f;
+            return;
+        }
+
+        m_AutosaveTimer += deltaTime;
+        if (m_AutosaveTimer < m_Data.autosaveInterval || !m_EditorScene->IsDirty() || m_SceneSaver || m_SceneLoader)
+            return;
+
+        SaveScene(m_CurrentSceneFilePath);
+    }
+
+    void EditorLayer::SceneSaverUI()
     {
-        SceneSerializer serializer(m_ActiveScene);
-        return serializer.Serialize(filepath);
+        const ImGuiViewport *viewport = ImGui::GetMainViewport();
+        const ImVec2 corner = { viewport->WorkPos.x + viewport->WorkSize.x - 10.0f, viewport->WorkPos.y + viewport->WorkSize.y - 10.0f };
+        ImGui::SetNextWindowPos(corner, ImGuiCond_Always, ImVec2(1.0f, 1.0f));
+        ImGui::SetNextWindowViewport(viewport->ID);
+        ImGui::SetNextWindowBgAlpha(0.6f);
+
+        constexpr ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings
+            | ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs;
+
+        // small and out of the way, the editor stays usable while the file is written
+        ImGui::Begin("##scene_saver", nullptr, flags);
+
+        const std::string filename = m_SceneSaver->GetFilepath().filename().generic_string();
+        ImGui::Text("Saving %s (%.1f s)", filename.c_str(), m_SceneSaver->GetElapsed());
+
+        ImGui::End();
     }
 
     void EditorLayer::SaveSceneAs()
@@ -626,26 +713,68 @@ namespace ignite
 
     bool EditorLayer::OpenScene(const std::filesystem::path &filepath)
     {
-        if (m_EditorScene)
-        {
-            m_EditorScene->OnStop();
-        }
+        // parsed on a worker and committed a slice per frame in UpdateSceneLoader,
+        // opening another scene drops the one still loading
+        m_SceneLoader = CreateScope<SceneLoader>(filepath);
+        return true;
+    }
 
-        if (m_Data.sceneState == State::ScenePlay)
-            OnSceneStop();
+    void EditorLayer::UpdateSceneLoader()
+    {
+        if (!m_SceneLoader || !m_SceneLoader->Update())
+            return;
 
-        if (Ref<Scene> openScene = SceneSerializer::Deserialize(filepath))
+        if (Ref<Scene> openScene = m_SceneLoader->GetScene())
         {
-            m_EditorScene = SceneManager::Copy(openScene);
+            if (m_EditorScene)
+            {
+                m_EditorScene->OnStop();
+            }
+
+            if (m_Data.sceneState == State::ScenePlay)
+                OnSceneStop();
+
+            // the loader's scene is not shared with anything, no copy needed
+            m_QueuedSave = {};
+            m_EditorScene = openScene;
             m_EditorScene->SetDirtyFlag(false);
 
             m_ActiveScene = m_EditorScene;
             m_ScenePanel->SetActiveScene(m_ActiveScene.get(), true);
 
-            m_CurrentSceneFilePath = filepath;
+            m_CurrentSceneFilePath = m_SceneLoader->GetFilepath();
         }
 
-        return true;
+        m_SceneLoader.reset();
+    }
+
+    void EditorLayer::SceneLoaderUI()
+    {
+        const ImGuiViewport *viewport = ImGui::GetMainViewport();
+        ImGui::SetNextWindowPos(viewport->GetCenter(), ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+        ImGui::SetNextWindowViewport(viewport->ID);
+
+        constexpr ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize
+            | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_NoMove;
+
+        ImGui::Begin("##scene_loader", nullptr, flags);
+
+        const std::string filename = m_SceneLoader->GetFilepath().filename().generic_string();
+        ImGui::Text("Opening %s", filename.c_str());
+
+        const u32 entityCount = m_SceneLoader->GetEntityCount();
+        char overlay[64];
+        if (entityCount > 0)
+            snprintf(overlay, sizeof(overlay), "%u / %u entities", m_SceneLoader->GetCommittedCount(), entityCount);
+        else
+            snprintf(overlay, sizeof(overlay), "Parsing...");
+
+        ImGui::ProgressBar(m_SceneLoader->GetProgress(), ImVec2(320.0f, 0.0f), overlay);
+
+        if (ImGui::Button("Cancel"))
+            m_SceneLoader->Cancel();
+
+        ImGui::End();
     }
 
     void EditorLayer::SaveProject()
@@ -733,10 +862,12 @@ namespace ignite
             OnSceneStop();
 
         m_Data.sceneState = State::ScenePlay;
+        m_QueuedSave = {};
 
         // copy initial components to new scene
         m_ActiveScene = SceneManager::Copy(m_EditorScene);
         m_ActiveScene->OnStart();
+        StartRollback();
 
         m_ScenePanel->SetActiveScene(m_ActiveScene.get());
     }
@@ -757,14 +888,23 @@ namespace ignite
             OnSceneStop();
 
         m_Data.sceneState = State::SceneSimulate;
+        m_QueuedSave = {};
 
         // copy initial components to new scene
         m_ActiveScene = SceneManager::Copy(m_EditorScene);
         m_ActiveScene->OnStart();
+        StartRollback();
 
         m_ScenePanel->SetActiveScene(m_ActiveScene.get());
     }
 
+    void EditorLayer::StartRollback()
+    {
+        m_Data.simulationPaused = false;
+        if (m_Data.recordRollback)
+            m_ActiveScene->rollback = CreateScope<SimulationRollback>(m_ActiveScene.get());
+    }
+
     void EditorLayer::SettingsUI()
     {
         ImGui::Begin("Settings", &m_Data.settingsWindow);
@@ -800,6 +940,25 @@ namespace ignite
             ImGui::TreePop();
         }
 
+        if (ImGui::TreeNodeEx("Scene"))
+        {
+            ImGui::Checkbox("Autosave", &m_Data.autosave);
+            ImGui::DragFloat("Autosave Interval", &m_Data.autosaveInterval, 1.0f, 10.0f, 3600.0f, "%.0f s");
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNodeEx("Simulation"))
+        {
+            SimulationRollbackUI();
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNodeEx("Memory"))
+        {
+            MemoryStatsUI();
+            ImGui::TreePop();
+        }
+
         if (m_ActiveScene)
         {
             // Environment
@@ -847,7 +1006,7 @@ namespace ignite
         
         if (m_Data.assetRegistryWindow)
         {
-            AssetRegistry assetRegistry = m_ActiveProject->GetAssetManager().GetAssetAssetRegistry();
+            const AssetRegistry &assetRegistry = m_ActiveProject->GetAssetManager().GetAssetAssetRegistry();
 
             struct AssetPairCompare {
                 bool operator()(const std::pair<AssetHandle, AssetMetaData>& lhs, const std::pair<AssetHandle, AssetMetaData>& rhs) const
@@ -989,4 +1148,78 @@ namespace ignite
             ImGui::End();
         }
     }
+
+    void EditorLayer::SimulationRollbackUI()
+    {
+        ImGui::Checkbox("Record Rollback", &m_Data.recordRollback);
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("Applies from the next play or simulate");
+
+        SimulationRollback *rollback = m_Data.sceneState != State::SceneEdit ? m_ActiveScene->rollback.get() : nullptr;
+        if (!rollback)
+            return;
+
+        ImGui::Checkbox("Paused", &m_Data.simulationPaused);
+
+        // scrubbing pauses, the ticks after the one shown are kept until the scene steps again
+        u64 tick = rollback->GetCurrentTick();
+        u64 oldest = rollback->GetOldestTick();
+        u64 newest = rollback->GetNewestTick();
+        if (ImGui::SliderScalar("Tick", ImGuiDataType_U64, &tick, &oldest, &newest))
+        {
+            m_Data.simulationPaused = true;
+            rollback->Rewind(tick);
+        }
+
+        ImGui::BeginDisabled(rollback->GetCurrentTick() >= newest);
+        if (ImGui::Button("Step"))
+            rollback->Resimulate(rollback->GetCurrentTick() + 1);
+
+        ImGui::SameLine();
+        if (ImGui::Button("Resimulate"))
+            rollback->Resimulate(newest);
+        ImGui::EndDisabled();
+
+        ImGui::Text("Capture %.3f ms, %.1f MB for %u ticks", rollback->GetCaptureMillis(),
+            static_cast<f32>(rollback->GetMemoryUsage()) / (1024.0f * 1024.0f), rollback->GetCapacity());
+    }
+
+    void EditorLayer::MemoryStatsUI()
+    {
+        constexpr f32 toMB = 1.0f / (1024.0f * 1024.0f);
+
+        ImGui::Text("Frame arena %.2f / %.2f MB", static_cast<f32>(FrameAllocator::GetUsed()) * toMB,
+            static_cast<f32>(FrameAllocator::GetCapacity()) * toMB);
+
+        ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders;
+        if (ImGui::BeginTable("memory_stats_table", 5, tableFlags))
+        {
+            ImGui::TableSetupColumn("Tag");
+            ImGui::TableSetupColumn("Live MB");
+            ImGui::TableSetupColumn("Peak MB");
+            ImGui::TableSetupColumn("Live");
+            ImGui::TableSetupColumn("Total");
+            ImGui::TableHeadersRow();
+
+            for (u8 i = 0; i < static_cast<u8>(MemoryTag::Count); ++i)
+            {
+                const MemoryTag tag = static_cast<MemoryTag>(i);
+                const MemoryStats stats = MemoryTracker::GetStats(tag);
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(MemoryTracker::GetTagName(tag));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", static_cast<f32>(stats.liveBytes) * toMB);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", static_cast<f32>(stats.peakBytes) * toMB);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", stats.liveAllocations);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", stats.totalAllocations);
+            }
+
+            ImGui::EndTable();
+        }
+    }
 }
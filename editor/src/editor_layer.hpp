@@ -5,6 +5,8 @@
 #include "ignite/ignite.hpp"
 #include "ignite/graphics/scene_renderer.hpp"
 #include "ignite/serializer/serializer.hpp"
+#include "ignite/serializer/scene_loader.hpp"
+#include "ignite/serializer/scene_saver.hpp"
 #include "ignite/project/project.hpp"
 #include "states.hpp"
 #include <future>
@@ -14,6 +16,8 @@ namespace ignite
     class ShaderFactory;
     class ScenePanel;
     class ContentBrowserPanel;
+    class ProfilerPanel;
+    class GPUProfilerPanel;
 
     class EditorLayer final : public Layer
     {
@@ -28,6 +32,10 @@ namespace ignite
             bool assetRegistryWindow = false;
             bool isPickingEntity = false;
             bool takeScreenshot = false;
+            bool autosave = true;
+            f32 autosaveInterval = SCENE_AUTOSAVE_INTERVAL; // seconds
+            bool recordRollback = true; // every step of play and simulate, see SimulationRollback
+            bool simulationPaused = false;
 
             uint32_t hoveredEntity = uint32_t(-1);
 
@@ -61,9 +69,13 @@ namespace ignite
         void NewScene();
         void SaveScene();
         void SaveSceneAs();
-        bool SaveScene(const std::filesystem::path &filepath) const;
+        bool SaveScene(const std::filesystem::path &filepath);
+        void UpdateSceneSaver(f32 deltaTime);
+        void SceneSaverUI();
         void OpenScene();
         bool OpenScene(const std::filesystem::path &filepath);
+        void UpdateSceneLoader();
+        void SceneLoaderUI();
         
         void SaveProject();
         void SaveProjectAs();
@@ -73,11 +85,16 @@ namespace ignite
         void OnScenePlay();
         void OnSceneStop();
         void OnSceneSimulate();
+        void StartRollback();
 
         void SettingsUI();
+        void SimulationRollbackUI();
+        void MemoryStatsUI();
 
         Ref<ScenePanel> m_ScenePanel;
         Ref<ContentBrowserPanel> m_ContentBrowserPanel;
+        Ref<ProfilerPanel> m_ProfilerPanel;
+        Ref<GPUProfilerPanel> m_GPUProfilerPanel;
         SceneRenderer m_SceneRenderer;
 
         Ref<Scene> m_ActiveScene;
@@ -86,6 +103,15 @@ namespace ignite
         EditorData m_Data;
 
         std::filesystem::path m_CurrentSceneFilePath;
+        Scope<SceneLoader> m_SceneLoader; // scene being opened, the current one stays usable until it is ready
+        Scope<SceneSaver> m_SceneSaver; // save being written on a worker
+        struct QueuedSave
+        {
+            Ref<Scene> scene;
+            std::filesystem::path filepath;
+        };
+        QueuedSave m_QueuedSave; // saved once the running save is done, dropped if its scene is no longer the active one
+        f32 m_AutosaveTimer = 0.0f;
 
         nvrhi::BufferHandle m_DebugRenderBuffer;
         
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "ignite/scene/component_reflection.hpp"
+
+#include <imgui.h>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstring>
+#include <string>
+
+namespace ignite
+{
+    // draws one ComponentInfo field, true when the value was edited
+    template<typename T, typename Field>
+    bool DrawComponentField(T &comp, const Field &field)
+    {
+        using Value = typename Field::ValueType;
+
+        if (field.flags & FieldFlags_HideInInspector)
+            return false;
+
+        Value &value = field.Get(comp);
+        bool changed = false;
+
+        const bool readOnly = field.flags & FieldFlags_ReadOnly;
+        if (readOnly)
+            ImGui::BeginDisabled();
+
+        if constexpr (std::is_enum_v<Value>)
+        {
+            i32 index = static_cast<i32>(value);
+            if (!field.enumNames.empty())
+            {
+                const std::string preview = index >= 0 && static_cast<size_t>(index) < field.enumNames.size()
+                    ? std::string(field.enumNames[index]) : std::to_string(index);
+
+                if (ImGui::BeginCombo(field.label, preview.c_str()))
+                {
+                    for (size_t i = 0; i < field.enumNames.size(); ++i)
+                    {
+                        const std::string name(field.enumNames[i]);
+                        const bool selected = static_cast<size_t>(index) == i;
+                        if (ImGui::Selectable(name.c_str(), selected))
+                        {
+                            index = static_cast<i32>(i);
+                            changed = true;
+                        }
+                        if (selected)
+                            ImGui::SetItemDefaultFocus();
+                    }
+                    ImGui::EndCombo();
+                }
+            }
+            else
+            {
+                changed = ImGui::DragInt(field.label, &index);
+            }
+
+            if (changed)
+                value = static_cast<Value>(index);
+        }
+        else if constexpr (Field::type == ComponentFieldType::Bool)
+        {
+            changed = ImGui::Checkbox(field.label, &value);
+        }
+        else if constexpr (Field::type == ComponentFieldType::Int)
+        {
+            changed = ImGui::DragInt(field.label, &value, field.speed, static_cast<i32>(field.min), static_cast<i32>(field.max));
+        }
+        else if constexpr (Field::type == ComponentFieldType::Float)
+        {
+            changed = ImGui::DragFloat(field.label, &value, field.speed, field.min, field.max);
+        }
+        else if constexpr (Field::type == ComponentFieldType::Vec2)
+        {
+            changed = ImGui::DragFloat2(field.label, &value.x, field.speed, field.min, field.max);
+        }
+        else if constexpr (Field::type == ComponentFieldType::Vec3)
+        {
+            changed = ImGui::DragFloat3(field.label, &value.x, field.speed, field.min, field.max);
+        }
+        else if constexpr (Field::type == ComponentFieldType::Vec4)
+        {
+            if (field.flags & FieldFlags_Color)
+                changed = ImGui::ColorEdit4(field.label, &value.x);
+            else
+                changed = ImGui::DragFloat4(field.label, &value.x, field.speed, field.min, field.max);
+        }
+        else if constexpr (Field::type == ComponentFieldType::Quat)
+        {
+            // edited as euler angles, the same as the transform
+            glm::vec3 euler = glm::eulerAngles(value);
+            if (ImGui::DragFloat3(field.label, &euler.x, field.speed))
+            {
+                value = glm::quat(euler);
+                changed = true;
+            }
+        }
+        else if constexpr (Field::type == ComponentFieldType::String)
+        {
+            const std::string text = ToFieldStorage(value);
+            char buffer[256] = {};
+            strncpy(buffer, text.c_str(), sizeof(buffer) - 1);
+            if (ImGui::InputText(field.label, buffer, sizeof(buffer), ImGuiInputTextFlags_EnterReturnsTrue))
+            {
+                value = FromFieldStorage<Value>(std::string(buffer));
+                changed = true;
+            }
+        }
+        else if constexpr (Field::type == ComponentFieldType::UInt64)
+        {
+            ImGui::LabelText(field.label, "%llu", static_cast<unsigned long long>(ToFieldStorage(value)));
+        }
+
+        if (readOnly)
+            ImGui::EndDisabled();
+
+        return changed;
+    }
+
+    // the inspector body of components without a hand written one
+    template<typename T>
+    bool DrawComponentFields(T &comp)
+    {
+        bool changed = false;
+        ForEachField<T>([&](const auto &field)
+        {
+            changed |= DrawComponentField(comp, field);
+        });
+
+        if (changed)
+            comp.dirty = true;
+
+        return changed;
+    }
+}
@@ -1,5 +1,6 @@
 #include "content_browser_panel.hpp"
 #include "ignite/project/project.hpp"
+#include "ignite/graphics/texture_cache.hpp"
 #include "editor_layer.hpp"
 
 #include <format>
@@ -13,8 +14,8 @@ namespace ignite {
 
         TextureCreateInfo createInfo;
         createInfo.format = nvrhi::Format::RGBA8_UNORM;
-        m_Icons["folder"] = Texture::Create("resources/ui/ic_folder.png", createInfo);
-        m_Icons["unknown"] = Texture::Create("resources/ui/ic_file.png", createInfo);
+        m_Icons["folder"] = TextureCache::Load("resources/ui/ic_folder.png", createInfo);
+        m_Icons["unknown"] = TextureCache::Load("resources/ui/ic_file.png", createInfo);
     }
 
     void ContentBrowserPanel::SetActiveProject(const Ref<Project> &project)
@@ -44,7 +45,7 @@ namespace ignite {
 
         const std::filesystem::path &filepath = m_ActiveProject->GetAssetFilepath(node->path);
         const std::string filename = filepath.filename().string();
-        const bool isDirectory = std::filesystem::is_directory(filepath);
+        const bool isDirectory = IsDirectory(filepath);
 
         ImGuiTreeNodeFlags flags = (m_SelectedFileTree == filepath ? ImGuiTreeNodeFlags_Selected : 0)
             | ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_SpanFullWidth;
@@ -123,6 +124,14 @@ namespace ignite {
 
         if (m_ActiveProject)
         {
+            // files added outside the editor show up without pressing refresh
+            const u64 indexVersion = m_ActiveProject->GetAssetFileSystem()->GetIndex().GetVersion();
+            if (indexVersion != m_AssetIndexVersion)
+            {
+                m_AssetIndexVersion = indexVersion;
+                RefreshAssetTree();
+            }
+
             // Left side directory tree
             ImGui::BeginChild("left_item_browser", { 300.0f, 0.0f }, ImGuiChildFlags_ResizeX);
             for (auto it = m_TreeNodes.begin() + 1; it != m_TreeNodes.end(); ++it)
@@ -174,7 +183,7 @@ namespace ignite {
                 ImGui::PushID(filenameStr.c_str());
 
                 std::filesystem::path path = m_CurrentDirectory / item;
-                bool isDirectory = std::filesystem::is_directory(path);
+                bool isDirectory = IsDirectory(path);
 
                 // float thumbnailHeight = m_ThumbnailSize * (thumbnail->GetHeight() / thumbnail->GetWidth());
                 const float thumbnailHeight = static_cast<float>(m_ThumbnailSize) * (320.0f / 540.0f);
@@ -224,7 +233,7 @@ namespace ignite {
 
                 if (ImGui::BeginDragDropSource())
                 {
-                    if (!std::filesystem::is_directory(item))
+                    if (!isDirectory)
                     {
                         const std::filesystem::path filepath = m_ActiveProject->GetAssetRelativeFilepath(m_BaseDirectory / node->path / item);
                         AssetHandle handle = m_ActiveProject->GetAssetManager().GetAssetHandle(filepath);
@@ -306,52 +315,70 @@ namespace ignite {
 
     void ContentBrowserPanel::LoadAssetTree(const std::filesystem::path &directory)
     {
-        const std::filesystem::path assetPath = Project::GetActiveAssetDirectory();
+        // listings come from the project's directory index, only unseen directories touch the disk
+        const Ref<vfs::IndexedFileSystem> &assetFS = m_ActiveProject->GetAssetFileSystem();
 
-        for (const auto &entry : std::filesystem::directory_iterator(directory))
+        std::filesystem::path relativeDirectory = directory.lexically_relative(Project::GetActiveAssetDirectory());
+        if (relativeDirectory == ".")
+            relativeDirectory.clear();
+
+        assetFS->EnumerateFiles(relativeDirectory, {}, [&](std::string_view filename)
         {
-            const std::filesystem::path &relativePath = std::filesystem::relative(entry.path(), assetPath);
-            uint32_t currentNodeIndex = 0;
-            
-            for (const std::filesystem::path &path : relativePath)
+            InsertTreeEntry(relativeDirectory / filename, false);
+        });
+
+        std::vector<std::string> subdirectories;
+        assetFS->EnumerateDirectories(relativeDirectory, [&](std::string_view name)
+        {
+            subdirectories.emplace_back(name);
+        }, false);
+
+        for (const std::string &name : subdirectories)
+        {
+            InsertTreeEntry(relativeDirectory / name, true);
+            LoadAssetTree(directory / name);
+        }
+    }
+
+    void ContentBrowserPanel::InsertTreeEntry(const std::filesystem::path &relativePath, bool isDirectory)
+    {
+        uint32_t currentNodeIndex = 0;
+        const std::filesystem::path filename = relativePath.filename();
+
+        for (const std::filesystem::path &path : relativePath)
+        {
+            const auto it = m_TreeNodes[currentNodeIndex].children.find(path.generic_string());
+            if (it != m_TreeNodes[currentNodeIndex].children.end())
             {
-                const auto it = m_TreeNodes[currentNodeIndex].children.find(path.generic_string());
-                if (it != m_TreeNodes[currentNodeIndex].children.end())
-                {
-                    currentNodeIndex = it->second;
-                }
-                else
+                currentNodeIndex = it->second;
+            }
+            else
+            {
+                AssetHandle assetHandle = AssetHandle(0);
+                const bool isFile = !isDirectory && path == filename;
+                if (isFile && path.has_extension())
                 {
-                    AssetHandle assetHandle = AssetHandle(0);
-                    if (!std::filesystem::is_directory(path) && path.has_extension())
+                    std::string relPath = relativePath.generic_string();
+                    assetHandle = m_ActiveProject->GetAssetManager().GetAssetHandle(relPath);
+
+                    // not registered yet
+                    // (insert the metadata and generate the asset handle)
+                    if (assetHandle == AssetHandle(0))
                     {
-                        std::string relPath = relativePath.generic_string();
-                        assetHandle = m_ActiveProject->GetAssetManager().GetAssetHandle(relPath);
-                        
-                        // not registered yet
-                        // (insert the metadata and generate the asset handle)
-                        if (assetHandle == AssetHandle(0))
-                        {
-                            assetHandle = AssetHandle();
-                            AssetMetaData metadata;
-                            metadata.type = GetAssetTypeFromExtension(relativePath.extension().generic_string());
-                            metadata.filepath = relPath;
-                            m_ActiveProject->GetAssetManager().InsertMetaData(assetHandle, metadata);
-                        }
+                        assetHandle = AssetHandle();
+                        AssetMetaData metadata;
+                        metadata.type = GetAssetTypeFromExtension(relativePath.extension().generic_string());
+                        metadata.filepath = relPath;
+                        m_ActiveProject->GetAssetManager().InsertMetaData(assetHandle, metadata);
                     }
+                }
 
-                    FileTreeNode newNode(path, assetHandle);
-                    newNode.parent = currentNodeIndex;
+                FileTreeNode newNode(path, assetHandle);
+                newNode.parent = currentNodeIndex;
 
-                    m_TreeNodes.push_back(newNode);
-                    m_TreeNodes[currentNodeIndex].children[path] = static_cast<int>(m_TreeNodes.size()) - 1;
-                    currentNodeIndex = static_cast<int>(m_TreeNodes.size()) - 1;
-                }
-            }
-            
-            if (entry.is_directory())
-            {
-                LoadAssetTree(entry.path());
+                m_TreeNodes.push_back(newNode);
+                m_TreeNodes[currentNodeIndex].children[path] = static_cast<int>(m_TreeNodes.size()) - 1;
+                currentNodeIndex = static_cast<int>(m_TreeNodes.size()) - 1;
             }
         }
     }
@@ -376,11 +403,11 @@ namespace ignite {
 
             std::filesystem::path fullPath = basePath / GetFullPath(childIndex);
 
-            if (!std::filesystem::exists(fullPath))
+            if (!Exists(fullPath))
             {
                 toRemove.push_back((childName.string()));
             }
-            else if (std::filesystem::is_directory(fullPath))
+            else if (IsDirectory(fullPath))
             {
                 PruneMissingNodes(childIndex, fullPath);
             }
@@ -418,11 +445,11 @@ namespace ignite {
         for (auto& childIndex : node.children | std::views::values)
         {
             std::filesystem::path fullPath = basePath / GetFullPath(childIndex);
-            if (!std::filesystem::exists(fullPath))
+            if (!Exists(fullPath))
             {
                 CollectNodeAndDescendants(childIndex, nodesToDelete);
             }
-            else if (std::filesystem::is_directory(fullPath))
+            else if (IsDirectory(fullPath))
             {
                 CollectNodesToDelete(childIndex, fullPath, nodesToDelete);
             }
@@ -559,6 +586,18 @@ namespace ignite {
         m_TreeNodes = std::move(newNodes);
     }
 
+    bool ContentBrowserPanel::IsDirectory(const std::filesystem::path &filepath) const
+    {
+        return m_ActiveProject->GetAssetFileSystem()->DirectoryExists(filepath.lexically_relative(m_BaseDirectory));
+    }
+
+    bool ContentBrowserPanel::Exists(const std::filesystem::path &filepath) const
+    {
+        const std::filesystem::path relativePath = filepath.lexically_relative(m_BaseDirectory);
+        const Ref<vfs::IndexedFileSystem> &assetFS = m_ActiveProject->GetAssetFileSystem();
+        return assetFS->FileExists(relativePath) || assetFS->DirectoryExists(relativePath);
+    }
+
     std::filesystem::path ContentBrowserPanel::GetFullPath(uint32_t nodeIndex) const
     {
         std::filesystem::path result;
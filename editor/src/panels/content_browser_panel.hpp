@@ -48,6 +48,7 @@ namespace ignite {
         void RefreshEntryPathList();
         void RefreshAssetTree();
         void LoadAssetTree(const std::filesystem::path &directory);
+        void InsertTreeEntry(const std::filesystem::path &relativePath, bool isDirectory);
 
         void PruneMissingNodes(uint32_t nodeIndex, const std::filesystem::path &basePath);
         void PruneMissingNodesAlt(uint32_t nodeIndex, const std::filesystem::path &basePath);
@@ -59,6 +60,10 @@ namespace ignite {
         void CompactTree();
         std::filesystem::path GetFullPath(uint32_t nodeIndex) const;
 
+        // answered by the project's directory index, no disk access per frame
+        bool IsDirectory(const std::filesystem::path &filepath) const;
+        bool Exists(const std::filesystem::path &filepath) const;
+
         Ref<Project> m_ActiveProject;
 
         std::vector<FileTreeNode> m_TreeNodes;
@@ -73,5 +78,6 @@ namespace ignite {
         std::vector<std::filesystem::path> m_PathEntryList;
 
         std::unordered_map<std::string, Ref<Texture>> m_Icons;
+        u64 m_AssetIndexVersion = 0;
     };
 }
@@ -0,0 +1,89 @@
+#include "gpu_profiler_panel.hpp"
+
+#include "ignite/graphics/gpu_profiler.hpp"
+
+#include <algorithm>
+
+namespace ignite
+{
+    GPUProfilerPanel::GPUProfilerPanel(const char *windowTitle)
+        : IPanel(windowTitle)
+    {
+    }
+
+    void GPUProfilerPanel::OnGuiRender()
+    {
+        if (!m_IsOpen)
+            return;
+
+        if (!ImGui::Begin(m_WindowTitle.c_str(), &m_IsOpen))
+        {
+            ImGui::End();
+            return;
+        }
+
+        if (!GPUProfiler::IsSupported())
+        {
+            ImGui::TextUnformatted("Timestamp queries are not supported by this device");
+            ImGui::End();
+            return;
+        }
+
+        bool enabled = GPUProfiler::IsEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled))
+            GPUProfiler::SetEnabled(enabled);
+
+        const std::vector<GPUPassStats> stats = GPUProfiler::GetStats();
+
+        f32 totalMs = 0.0f;
+        f32 slowestMs = 0.0f;
+        for (const GPUPassStats &pass : stats)
+        {
+            totalMs += pass.avgMs;
+            slowestMs = std::max(slowestMs, pass.avgMs);
+        }
+
+        ImGui::SameLine();
+        ImGui::Text("Total: %.3f ms (avg over %d frames)", totalMs, GPU_PROFILER_HISTORY);
+
+        ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Borders;
+        if (ImGui::BeginTable("gpu_profiler_table", 6, tableFlags))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Pass", ImGuiTableColumnFlags_WidthStretch, 1.5f);
+            ImGui::TableSetupColumn("Last", ImGuiTableColumnFlags_WidthStretch, 0.5f);
+            ImGui::TableSetupColumn("Min", ImGuiTableColumnFlags_WidthStretch, 0.5f);
+            ImGui::TableSetupColumn("Avg", ImGuiTableColumnFlags_WidthStretch, 0.5f);
+            ImGui::TableSetupColumn("Max", ImGuiTableColumnFlags_WidthStretch, 0.5f);
+            ImGui::TableSetupColumn("Share", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+            ImGui::TableHeadersRow();
+
+            for (const GPUPassStats &pass : stats)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(pass.name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", pass.lastMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", pass.minMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", pass.avgMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", pass.maxMs);
+                ImGui::TableNextColumn();
+
+                // bar relative to the slowest pass, labelled with the share of the total
+                const f32 share = totalMs > 0.0f ? pass.avgMs / totalMs : 0.0f;
+                const f32 fraction = slowestMs > 0.0f ? pass.avgMs / slowestMs : 0.0f;
+                char label[16];
+                snprintf(label, sizeof(label), "%.1f%%", share * 100.0f);
+                ImGui::ProgressBar(fraction, ImVec2(-FLT_MIN, 0.0f), label);
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "ipanel.hpp"
+
+namespace ignite
+{
+    // Rolling GPU time of each render pass measured by GPUProfiler
+    class GPUProfilerPanel : public IPanel
+    {
+    public:
+        explicit GPUProfilerPanel(const char *windowTitle);
+
+        virtual void OnGuiRender() override;
+
+        void Open() { m_IsOpen = true; }
+    };
+}
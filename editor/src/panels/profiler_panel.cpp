@@ -0,0 +1,239 @@
+#include "profiler_panel.hpp"
+
+#include "ignite/core/platform_utils.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+namespace ignite
+{
+    namespace
+    {
+        constexpr f32 kLaneRowHeight = 18.0f;
+        constexpr f32 kFrameBarWidth = 3.0f;
+        constexpr f32 kFrameHistoryHeight = 50.0f;
+
+        f32 ToMillis(u64 nanoseconds)
+        {
+            return static_cast<f32>(static_cast<f64>(nanoseconds) / 1'000'000.0);
+        }
+
+        // the same scope keeps its color between frames
+        ImU32 ScopeColor(const char *name)
+        {
+            const size_t hash = std::hash<std::string_view>{}(name);
+            const f32 hue = static_cast<f32>(hash % 360) / 360.0f;
+            return ImColor::HSV(hue, 0.5f, 0.75f);
+        }
+    }
+
+    ProfilerPanel::ProfilerPanel(const char *windowTitle)
+        : IPanel(windowTitle)
+    {
+    }
+
+    void ProfilerPanel::OnGuiRender()
+    {
+        if (!m_IsOpen)
+            return;
+
+        if (!ImGui::Begin(m_WindowTitle.c_str(), &m_IsOpen))
+        {
+            ImGui::End();
+            return;
+        }
+
+#if IGNITE_PROFILE
+        bool recording = Profiler::IsEnabled();
+        if (ImGui::Checkbox("Record", &recording))
+            Profiler::SetEnabled(recording);
+
+        ImGui::SameLine();
+        ImGui::Checkbox("Pause", &m_Paused);
+
+        ImGui::SameLine();
+        if (ImGui::Button("Export Trace"))
+        {
+            std::string filepath = FileDialogs::SaveFile("Chrome Trace (*.json)\0*.json\0");
+            if (!filepath.empty())
+                Profiler::ExportChromeTrace(filepath);
+        }
+
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(120.0f);
+        ImGui::SliderFloat("Zoom", &m_Zoom, 1.0f, 50.0f, "%.1fx", ImGuiSliderFlags_Logarithmic);
+
+        const std::vector<ProfileFrame> frames = Profiler::GetFrames();
+
+        // the last frame is still running
+        if (!m_Paused && frames.size() >= 2)
+        {
+            m_Frame = frames[frames.size() - 2];
+            Profiler::Collect(m_Frame.start, m_Frame.end, m_Threads);
+        }
+
+        FrameHistoryUI(frames);
+
+        ImGui::Text("Frame %llu: %.3f ms", m_Frame.index, ToMillis(m_Frame.end - m_Frame.start));
+
+        TimelineUI();
+        ScopeTotalsUI();
+#else
+        ImGui::TextUnformatted("Profiling is compiled out of Dist builds");
+#endif
+
+        ImGui::End();
+    }
+
+    void ProfilerPanel::FrameHistoryUI(const std::vector<ProfileFrame> &frames)
+    {
+        if (frames.size() < 2)
+            return;
+
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        const f32 width = ImGui::GetContentRegionAvail().x;
+        ImGui::InvisibleButton("##frame_history", ImVec2(width, kFrameHistoryHeight));
+
+        const bool hovered = ImGui::IsItemHovered();
+        const bool clicked = ImGui::IsItemClicked();
+        const f32 mouseX = ImGui::GetIO().MousePos.x;
+
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + kFrameHistoryHeight), IM_COL32(30, 30, 30, 255));
+
+        // newest on the right, a bar of full height is 33 ms
+        const size_t completed = frames.size() - 1;
+        const size_t visible = std::min(completed, static_cast<size_t>(width / kFrameBarWidth));
+        for (size_t i = 0; i < visible; ++i)
+        {
+            const ProfileFrame &frame = frames[completed - visible + i];
+            const f32 ms = ToMillis(frame.end - frame.start);
+            const f32 height = std::min(ms / 33.3f, 1.0f) * kFrameHistoryHeight;
+
+            const f32 x = origin.x + width - static_cast<f32>(visible - i) * kFrameBarWidth;
+            const ImVec2 min(x, origin.y + kFrameHistoryHeight - height);
+            const ImVec2 max(x + kFrameBarWidth - 1.0f, origin.y + kFrameHistoryHeight);
+
+            ImU32 color = ms > 16.7f ? IM_COL32(220, 80, 60, 255) : IM_COL32(90, 180, 90, 255);
+            if (frame.index == m_Frame.index)
+                color = IM_COL32(240, 220, 80, 255);
+            drawList->AddRectFilled(min, max, color);
+
+            if (hovered && mouseX >= x && mouseX < x + kFrameBarWidth)
+            {
+                ImGui::SetTooltip("Frame %llu: %.3f ms", frame.index, ms);
+                if (clicked)
+                {
+                    m_Paused = true;
+                    m_Frame = frame;
+                    Profiler::Collect(m_Frame.start, m_Frame.end, m_Threads);
+                }
+            }
+        }
+    }
+
+    void ProfilerPanel::TimelineUI()
+    {
+        const u64 frameDuration = m_Frame.end > m_Frame.start ? m_Frame.end - m_Frame.start : 1;
+
+        ImGui::BeginChild("##timeline", ImVec2(0.0f, ImGui::GetContentRegionAvail().y * 0.6f), ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar);
+
+        const f32 labelWidth = 110.0f;
+        const f32 width = (ImGui::GetContentRegionAvail().x - labelWidth) * m_Zoom;
+        const f32 scale = width / static_cast<f32>(frameDuration);
+
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        const ImVec2 mouse = ImGui::GetIO().MousePos;
+
+        for (const ProfileThreadEvents &thread : m_Threads)
+        {
+            u32 maxDepth = 0;
+            for (const ProfileEvent &event : thread.events)
+                maxDepth = std::max(maxDepth, event.depth);
+
+            const ImVec2 origin = ImGui::GetCursorScreenPos();
+            const f32 laneHeight = static_cast<f32>(maxDepth + 1) * kLaneRowHeight;
+            ImGui::Dummy(ImVec2(labelWidth + width, laneHeight + 4.0f));
+
+            drawList->AddText(origin, IM_COL32(200, 200, 200, 255), thread.threadName.c_str());
+
+            for (const ProfileEvent &event : thread.events)
+            {
+                // scopes that started in the frame before are cut at its start
+                const u64 start = std::max(event.start, m_Frame.start) - m_Frame.start;
+                const u64 end = event.end - m_Frame.start;
+
+                const ImVec2 min(origin.x + labelWidth + static_cast<f32>(start) * scale, origin.y + static_cast<f32>(event.depth) * kLaneRowHeight);
+                const ImVec2 max(std::max(min.x + 1.0f, origin.x + labelWidth + static_cast<f32>(end) * scale), min.y + kLaneRowHeight - 1.0f);
+
+                drawList->AddRectFilled(min, max, ScopeColor(event.name));
+
+                if (max.x - min.x > 30.0f)
+                {
+                    drawList->PushClipRect(min, max, true);
+                    drawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32(15, 15, 15, 255), event.name);
+                    drawList->PopClipRect();
+                }
+
+                if (ImGui::IsWindowHovered() && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+                    ImGui::SetTooltip("%s\n%.3f ms", event.name, ToMillis(event.end - event.start));
+            }
+        }
+
+        ImGui::EndChild();
+    }
+
+    void ProfilerPanel::ScopeTotalsUI()
+    {
+        struct ScopeTotal
+        {
+            const char *name = nullptr;
+            u64 duration = 0;
+            u32 count = 0;
+        };
+
+        // per scope name over every thread, nested scopes also count in their parents
+        std::unordered_map<std::string_view, ScopeTotal> totals;
+        for (const ProfileThreadEvents &thread : m_Threads)
+        {
+            for (const ProfileEvent &event : thread.events)
+            {
+                ScopeTotal &total = totals[event.name];
+                total.name = event.name;
+                total.duration += event.end - event.start;
+                total.count++;
+            }
+        }
+
+        std::vector<ScopeTotal> sorted;
+        sorted.reserve(totals.size());
+        for (const auto &[name, total] : totals)
+            sorted.push_back(total);
+
+        std::ranges::sort(sorted, [](const ScopeTotal &a, const ScopeTotal &b) { return a.duration > b.duration; });
+
+        ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Borders;
+        if (ImGui::BeginTable("profiler_totals_table", 3, tableFlags))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch, 2.0f);
+            ImGui::TableSetupColumn("Total ms", ImGuiTableColumnFlags_WidthStretch, 0.5f);
+            ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthStretch, 0.5f);
+            ImGui::TableHeadersRow();
+
+            for (const ScopeTotal &total : sorted)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(total.name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", ToMillis(total.duration));
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", total.count);
+            }
+
+            ImGui::EndTable();
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "ipanel.hpp"
+
+#include "ignite/core/profiler.hpp"
+
+#include <vector>
+
+namespace ignite
+{
+    // Frame times of the recent frames and a timeline of the selected one, one lane per thread.
+    // Follows the last completed frame until a frame is clicked or the view is paused.
+    class ProfilerPanel : public IPanel
+    {
+    public:
+        explicit ProfilerPanel(const char *windowTitle);
+
+        virtual void OnGuiRender() override;
+
+        void Open() { m_IsOpen = true; }
+
+    private:
+        void FrameHistoryUI(const std::vector<ProfileFrame> &frames);
+        void TimelineUI();
+        void ScopeTotalsUI();
+
+        std::vector<ProfileThreadEvents> m_Threads;
+        ProfileFrame m_Frame;
+        bool m_Paused = false;
+        f32 m_Zoom = 1.0f;
+    };
+}
@@ -8,9 +8,11 @@
 #include "ignite/core/input/mouse_event.hpp"
 #include "ignite/core/input/joystick_event.hpp"
 #include "ignite/graphics/texture.hpp"
+#include "ignite/graphics/texture_cache.hpp"
 #include "ignite/scene/icomponent.hpp"
 #include "ignite/core/platform_utils.hpp"
 #include "editor_layer.hpp"
+#include "component_inspector.hpp"
 #include "ignite/graphics/mesh.hpp"
 #include "ignite/animation/animation_system.hpp"
 
@@ -61,10 +63,10 @@ namespace ignite
         // Load icons
         TextureCreateInfo createInfo;
         createInfo.format = nvrhi::Format::RGBA8_UNORM;
-        m_Icons["simulate"] = Texture::Create("resources/ui/ic_simulate.png", createInfo);
-        m_Icons["play"] = Texture::Create("resources/ui/ic_play.png", createInfo);
-        m_Icons["stop"] = Texture::Create("resources/ui/ic_stop.png", createInfo);
-        m_Icons["checker128"] = Texture::Create("resources/ui/checker-128px.jpg", createInfo);
+        m_Icons["simulate"] = TextureCache::Load("resources/ui/ic_simulate.png", createInfo);
+        m_Icons["play"] = TextureCache::Load("resources/ui/ic_play.png", createInfo);
+        m_Icons["stop"] = TextureCache::Load("resources/ui/ic_stop.png", createInfo);
+        m_Icons["checker128"] = TextureCache::Load("resources/ui/checker-128px.jpg", createInfo);
     }
 
     void ScenePanel::SetActiveScene(Scene *scene, bool reset)
@@ -403,8 +405,10 @@ namespace ignite
                                 texCI.format = nvrhi::Format::RGBA8_UNORM;
                                 texCI.dimension = nvrhi::TextureDimension::Texture2D;
                                 texCI.samplerMode = nvrhi::SamplerAddressMode::ClampToEdge;
+                                texCI.mipLevels = 0;
+                                texCI.usage = TextureUsage::Sprite;
 
-                                c->texture = Texture::Create(filepath.generic_string(), texCI);
+                                c->texture = TextureCache::Load(filepath, texCI);
                             }
                         }
 
@@ -569,57 +573,6 @@ namespace ignite
 
                         break;
                     }
-                case CompType_BoxCollider2D:
-                {
-                    RenderComponent<BoxCollider2D>("Box Collider 2D", selectedEntity, [&]()
-                    {
-                        BoxCollider2D *c = comp->As<BoxCollider2D>();
-                        ImGui::DragFloat2("Size", &c->size.x, 0.025f, 0.0f, FLT_MAX);
-                        ImGui::DragFloat2("Offset", &c->offset.x, 0.025f, 0.0f, FLT_MAX);
-                        ImGui::DragFloat("Restitution", &c->restitution, 0.025f, 0.0f, FLT_MAX);
-                        ImGui::DragFloat("Friction", &c->friction, 0.025f, 0.0f, FLT_MAX);
-                        ImGui::DragFloat("Density", &c->density, 0.025f);
-                        ImGui::Checkbox("Is Sensor", &c->isSensor);
-                    });
-
-                    break;
-                }
-                case CompType_Rigidbody:
-                {
-                    RenderComponent<Rigibody>("Rigid Body", selectedEntity, [&]()
-                    {
-                        Rigibody *c = comp->As<Rigibody>();
-                        ImGui::Checkbox("Static", &c->isStatic);
-
-                    });
-                    break;
-                }
-                case CompType_BoxCollider:
-                {
-                    RenderComponent<BoxCollider>("Box Collider", selectedEntity, [&]()
-                    {
-                        BoxCollider *c = comp->As<BoxCollider>();
-                        ImGui::DragFloat3("Scale", &c->scale.x, 0.025f, 0.0f, 10000.0f);
-                        ImGui::DragFloat("Friction", &c->friction, 0.025f);
-                        ImGui::DragFloat("Static Friction", &c->staticFriction, 0.025f);
-                        ImGui::DragFloat("Restitution", &c->restitution, 0.025f);
-                        ImGui::DragFloat("Density", &c->density, 0.025f);
-                    });
-                    break;
-                }
-                case CompType_SphereCollider:
-                {
-                    RenderComponent<SphereCollider>("Sphere Collider", selectedEntity, [&]()
-                        {
-                            SphereCollider *c = comp->As<SphereCollider>();
-                            ImGui::DragFloat("Radius", &c->radius, 0.025f, 0.01f, 10000.0f);
-                            ImGui::DragFloat("Friction", &c->friction, 0.025f);
-                            ImGui::DragFloat("Static Friction", &c->staticFriction, 0.025f);
-                            ImGui::DragFloat("Restitution", &c->restitution, 0.025f);
-                            ImGui::DragFloat("Density", &c->density, 0.025f);
-                        });
-                    break;
-                }
                 case CompType_AudioSource:
                 {
                     RenderComponent<AudioSource>("Audio Source", selectedEntity, [&]()
@@ -1058,7 +1011,9 @@ namespace ignite
                                 {
                                     TextureCreateInfo createInfo;
                                     createInfo.format = nvrhi::Format::RGBA8_UNORM;
-                                    Ref<Texture> texture = Texture::Create(filepath, createInfo);
+                                    createInfo.mipLevels = 0;
+                                    createInfo.usage = TextureUsage::BaseColor;
+                                    Ref<Texture> texture = TextureCache::Load(filepath, createInfo);
                                     c->mesh->UpdateTexture(texture, aiTextureType_BASE_COLOR);
                                 }
                             }
@@ -1095,7 +1050,9 @@ namespace ignite
                                 {
                                     TextureCreateInfo createInfo;
                                     createInfo.format = nvrhi::Format::RGBA8_UNORM;
-                                    Ref<Texture> texture = Texture::Create(filepath, createInfo);
+                                    createInfo.mipLevels = 0;
+                                    createInfo.usage = TextureUsage::Specular;
+                                    Ref<Texture> texture = TextureCache::Load(filepath, createInfo);
                                     c->mesh->UpdateTexture(texture, aiTextureType_SPECULAR);
                                 }
                             }
@@ -1110,7 +1067,9 @@ namespace ignite
                                 {
                                     TextureCreateInfo createInfo;
                                     createInfo.format = nvrhi::Format::RGBA8_UNORM;
-                                    Ref<Texture> texture = Texture::Create(filepath, createInfo);
+                                    createInfo.mipLevels = 0;
+                                    createInfo.usage = TextureUsage::Mask;
+                                    Ref<Texture> texture = TextureCache::Load(filepath, createInfo);
                                     c->mesh->UpdateTexture(texture, aiTextureType_DIFFUSE_ROUGHNESS);
                                 }
                             }
@@ -1125,7 +1084,9 @@ namespace ignite
                                 {
                                     TextureCreateInfo createInfo;
                                     createInfo.format = nvrhi::Format::RGBA8_UNORM;
-                                    Ref<Texture> texture = Texture::Create(filepath, createInfo);
+                                    createInfo.mipLevels = 0;
+                                    createInfo.usage = TextureUsage::Emissive;
+                                    Ref<Texture> texture = TextureCache::Load(filepath, createInfo);
                                     c->mesh->UpdateTexture(texture, aiTextureType_EMISSIVE);
                                 }
                             }
@@ -1213,6 +1174,21 @@ namespace ignite
                     });
                     break;
                 }
+                default:
+                {
+                    // the rest is drawn from their ComponentInfo fields
+                    VisitComponentType(compType, [&]<typename T>()
+                    {
+                        if constexpr ((ComponentInfo<T>::flags & ComponentFlags_Builtin) == 0)
+                        {
+                            RenderComponent<T>(ComponentInfo<T>::displayName, selectedEntity, [&]()
+                            {
+                                DrawComponentFields(*comp->As<T>());
+                            });
+                        }
+                    });
+                    break;
+                }
                 }
 
                 ImGui::PopID();
@@ -1230,93 +1206,54 @@ namespace ignite
 
                 filteredCompName.clear();
 
+                // builtin components are never added by hand, the rest once per entity
+                static auto canAddComponent = [](const ComponentTypeInfo &info, const std::vector<IComponent *> &entityComps)
+                {
+                    if (info.flags & ComponentFlags_Builtin)
+                        return false;
+
+                    for (IComponent *comp : entityComps)
+                    {
+                        if (comp->GetType() == info.type)
+                            return false;
+                    }
+                    return true;
+                };
+
                 if (!compNameFilterResultStr.empty())
                 {
                     std::string search = stringutils::ToLower(compNameFilterResultStr);
-                    for (const auto &[strName, type] : s_ComponentsName)
+                    for (const ComponentTypeInfo &info : s_ComponentTypes)
                     {
-                        bool found = false;
-                        for (IComponent *comp : comps)
-                        {
-                            if (comp->GetType() == type)
-                            {
-                                found = true;
-                                break;
-                            }
-                        }
-                        if (found)
+                        if (!canAddComponent(info, comps))
                             continue;
 
-                        std::string nameLower = stringutils::ToLower(strName);
+                        std::string nameLower = stringutils::ToLower(info.displayName);
                         if (nameLower.find(search) != std::string::npos)
                         {
-                            filteredCompName.insert({ strName, type });
+                            filteredCompName.insert({ info.displayName, info.type });
                         }
                     }
                 }
 
                 static std::function addCompFunc = [=](Entity entity, CompType type)
                 {
-                    switch (type)
+                    VisitComponentType(type, [&]<typename T>()
                     {
-                    case CompType_Camera:
-                        entity.AddComponent<Camera>();
-                        break;
-                    case CompType_Sprite2D:
-                        entity.AddComponent<Sprite2D>();
-                        break;
-                    case CompType_Rigidbody2D:
-                        entity.AddComponent<Rigidbody2D>();
-                        break;
-                    case CompType_BoxCollider2D:
-                        entity.AddComponent<BoxCollider2D>();
-                        break;
-                    case CompType_MeshRenderer:
-                        entity.AddComponent<MeshRenderer>();
-                        break;
-                    case CompType_SkinnedMesh:
-                        entity.AddComponent<SkinnedMesh>();
-                        break;
-                    case CompType_Rigidbody:
-                        entity.AddComponent<Rigibody>();
-                        break;
-                    case CompType_BoxCollider:
-                        entity.AddComponent<BoxCollider>();
-                        break;
-                    case CompType_SphereCollider:
-                        entity.AddComponent<SphereCollider>();
-                        break;
-                    case CompType_AudioSource:
-                        entity.AddComponent<AudioSource>();
-                        break;
-                    case CompType_Script:
-                        entity.AddComponent<Script>();
-                        break;
-                    default: break;
-                    }
+                        entity.AddComponent<T>();
+                    });
                 };
 
                 if (compNameFilterResultStr.empty())
                 {
-                    for (const auto &[strName, type] : s_ComponentsName)
+                    for (const ComponentTypeInfo &info : s_ComponentTypes)
                     {
-                        bool found = false;
-                        for (IComponent *comp : comps)
-                        {
-                            if (comp->GetType() == type)
-                            {
-                                found = true;
-                                break;
-                            }
-                        }
-                        if (found)
-                        {
+                        if (!canAddComponent(info, comps))
                             continue;
-                        }
 
-                        if (ImGui::Selectable(strName.c_str()))
+                        if (ImGui::Selectable(info.displayName))
                         {
-                            addCompFunc(Entity{ selectedEntity, m_Scene }, type);
+                            addCompFunc(Entity{ selectedEntity, m_Scene }, info.type);
                             ImGui::CloseCurrentPopup();
                         }
                     }
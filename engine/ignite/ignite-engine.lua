@@ -168,7 +168,8 @@ filter "system:windows"
         optimize "on"
         symbols "off" -- without debug info
         defines {
-            "NDEBUG"
+            "NDEBUG",
+            "IGNITE_DIST"
         }
         links {
             "%{Library.ShaderC}",
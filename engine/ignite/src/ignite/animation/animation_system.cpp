@@ -81,18 +81,16 @@ namespace ignite {
         }
     }
 
-    std::vector<glm::mat4> AnimationSystem::GetFinalJointTransforms(const Ref<Skeleton> &skeleton)
+    void AnimationSystem::GetFinalJointTransforms(const Ref<Skeleton> &skeleton, std::vector<glm::mat4> &outTransforms)
     {
-        std::vector<glm::mat4> finalTransforms;
-        finalTransforms.reserve(skeleton->joints.size());
+        outTransforms.resize(skeleton->joints.size());
 
-        for (const Joint &joint : skeleton->joints)
+        for (size_t i = 0; i < skeleton->joints.size(); ++i)
         {
             // Final transform = globalTransform * inverseBindPose
-            finalTransforms.push_back(joint.globalTransform * joint.inverseBindPose);
+            const Joint &joint = skeleton->joints[i];
+            outTransforms[i] = joint.globalTransform * joint.inverseBindPose;
         }
-
-        return finalTransforms;
     }
 
 }
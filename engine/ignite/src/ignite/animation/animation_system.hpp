@@ -14,6 +14,7 @@ namespace ignite {
         static void ApplySkeletonToEntities(Scene *scene, const Ref<Skeleton> &skeleton); 
         static bool UpdateSkeleton(Ref<Skeleton> &skeleton, SkeletalAnimation &animation, float timeInSeconds);
         static void UpdateGlobalTransforms(Ref<Skeleton> &skeleton);
-        static std::vector<glm::mat4> GetFinalJointTransforms(const Ref<Skeleton> &skeleton);
+        // reuses the storage of outTransforms, nothing is allocated once it has the joint count
+        static void GetFinalJointTransforms(const Ref<Skeleton> &skeleton, std::vector<glm::mat4> &outTransforms);
     };
 }
\ No newline at end of file
@@ -51,9 +51,12 @@ namespace ignite {
     {
         { ".ixproj", AssetType::Project },
         { ".ixscene", AssetType::Scene },
+        { ".ixbscene", AssetType::Scene },
         { ".jpg", AssetType::Texture },
         { ".png", AssetType::Texture },
         { ".jpeg", AssetType::Texture },
+        { ".dds", AssetType::Texture },
+        { ".ktx2", AssetType::Texture },
         { ".hdr", AssetType::TextureCube },
         { ".mp3", AssetType::Audio },
         { ".flac", AssetType::Audio },
@@ -0,0 +1,319 @@
+#include "asset_dependency_graph.hpp"
+#include "asset_importer.hpp"
+#include "asset_registry.hpp"
+
+#include "ignite/core/hash.hpp"
+#include "ignite/core/logger.hpp"
+#include "ignite/serializer/serializer.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <ranges>
+#include <unordered_set>
+
+namespace ignite {
+
+    namespace
+    {
+        constexpr size_t HASH_CHUNK_SIZE = 1024 * 1024;
+
+        // chunked so large models are not read into memory at once
+        bool HashFile(const std::filesystem::path &filepath, u64 &outHash)
+        {
+            std::ifstream file(filepath, std::ios::binary);
+            if (!file)
+                return false;
+
+            std::vector<u8> chunk(HASH_CHUNK_SIZE);
+            u64 hash = 0xcbf29ce484222325ull;
+
+            while (file)
+            {
+                file.read(reinterpret_cast<char *>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+                const std::streamsize count = file.gcount();
+                if (count <= 0)
+                    break;
+
+                hash = HashBytes(chunk.data(), static_cast<size_t>(count), hash);
+            }
+
+            outHash = hash;
+            return true;
+        }
+
+        u32 GetImporterVersion(const std::string &key)
+        {
+            return AssetImporter::GetImporterVersion(GetAssetTypeFromExtension(std::filesystem::path(key).extension().generic_string()));
+        }
+    }
+
+    void AssetDependencyGraph::Record(const std::filesystem::path &asset, const std::vector<std::filesystem::path> &dependencies)
+    {
+        const std::string key = AssetRegistry::NormalizePath(asset);
+
+        AssetDependencyNode &node = m_Nodes[key];
+        RemoveEdges(key, node);
+
+        node.dependencies.clear();
+        for (const std::filesystem::path &dependency : dependencies)
+        {
+            std::string dependencyKey = AssetRegistry::NormalizePath(dependency);
+            if (dependencyKey.empty() || dependencyKey == key)
+                continue;
+
+            if (std::find(node.dependencies.begin(), node.dependencies.end(), dependencyKey) != node.dependencies.end())
+                continue;
+
+            if (!m_Nodes.contains(dependencyKey))
+                Stamp(dependencyKey);
+
+            m_Dependents[dependencyKey].push_back(key);
+            node.dependencies.push_back(std::move(dependencyKey));
+        }
+
+        Stamp(key);
+    }
+
+    void AssetDependencyGraph::Stamp(const std::filesystem::path &asset)
+    {
+        const std::string key = AssetRegistry::NormalizePath(asset);
+
+        AssetDependencyNode &node = m_Nodes[key];
+        ReadFileState(key, node, true);
+        node.importerVersion = GetImporterVersion(key);
+
+        m_Dirty = true;
+    }
+
+    void AssetDependencyGraph::Remove(const std::filesystem::path &asset)
+    {
+        const std::string key = AssetRegistry::NormalizePath(asset);
+
+        auto it = m_Nodes.find(key);
+        if (it == m_Nodes.end())
+            return;
+
+        RemoveEdges(key, it->second);
+        m_Nodes.erase(it);
+
+        // dependents keep their edge, the file may come back
+        m_Dirty = true;
+    }
+
+    void AssetDependencyGraph::Clear()
+    {
+        m_Nodes.clear();
+        m_Dependents.clear();
+        m_Dirty = true;
+    }
+
+    bool AssetDependencyGraph::Contains(const std::filesystem::path &asset) const
+    {
+        return m_Nodes.contains(AssetRegistry::NormalizePath(asset));
+    }
+
+    const AssetDependencyNode *AssetDependencyGraph::GetNode(const std::filesystem::path &asset) const
+    {
+        auto it = m_Nodes.find(AssetRegistry::NormalizePath(asset));
+        return it != m_Nodes.end() ? &it->second : nullptr;
+    }
+
+    std::vector<std::string> AssetDependencyGraph::GetDependents(const std::filesystem::path &asset, bool transitive) const
+    {
+        std::vector<std::string> result;
+        std::unordered_set<std::string> visited;
+
+        std::vector<std::string> stack = { AssetRegistry::NormalizePath(asset) };
+        visited.insert(stack.back());
+
+        while (!stack.empty())
+        {
+            const std::string key = std::move(stack.back());
+            stack.pop_back();
+
+            auto it = m_Dependents.find(key);
+            if (it == m_Dependents.end())
+                continue;
+
+            for (const std::string &dependent : it->second)
+            {
+                if (!visited.insert(dependent).second)
+                    continue;
+
+                result.push_back(dependent);
+                if (transitive)
+                    stack.push_back(dependent);
+            }
+        }
+
+        return result;
+    }
+
+    bool AssetDependencyGraph::IsStale(const std::filesystem::path &asset)
+    {
+        const std::string key = AssetRegistry::NormalizePath(asset);
+
+        auto it = m_Nodes.find(key);
+        if (it == m_Nodes.end())
+            return true;
+
+        AssetDependencyNode &node = it->second;
+        if (node.importerVersion != GetImporterVersion(key))
+            return true;
+
+        // size and write time first, the hash only when they differ
+        AssetDependencyNode current;
+        if (!ReadFileState(key, current, false))
+            return true;
+
+        if (current.fileSize == node.fileSize && current.writeTime == node.writeTime)
+            return false;
+
+        if (!ReadFileState(key, current, true))
+            return true;
+
+        if (current.contentHash != node.contentHash)
+            return true;
+
+        node.fileSize = current.fileSize;
+        node.writeTime = current.writeTime;
+        m_Dirty = true;
+        return false;
+    }
+
+    std::vector<std::string> AssetDependencyGraph::GetStaleAssets()
+    {
+        std::vector<std::string> stale;
+        for (const auto &key : m_Nodes | std::views::keys)
+        {
+            if (IsStale(key))
+                stale.push_back(key);
+        }
+        return stale;
+    }
+
+    bool AssetDependencyGraph::Save(const std::filesystem::path &filepath) const
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(filepath.parent_path(), ec);
+
+        // sorted, the file stays diffable
+        std::vector<const std::string *> keys;
+        keys.reserve(m_Nodes.size());
+        for (const auto &key : m_Nodes | std::views::keys)
+            keys.push_back(&key);
+        std::sort(keys.begin(), keys.end(), [](const std::string *a, const std::string *b) { return *a < *b; });
+
+        Serializer sr(filepath);
+        sr.BeginMap();
+        sr.BeginMap("AssetDependencies");
+        sr.BeginSequence("Assets");
+
+        for (const std::string *key : keys)
+        {
+            const AssetDependencyNode &node = m_Nodes.at(*key);
+
+            sr.BeginMap();
+            sr.AddKeyValue("Filepath", *key);
+            sr.AddKeyValue("ContentHash", node.contentHash);
+            sr.AddKeyValue("FileSize", node.fileSize);
+            sr.AddKeyValue("WriteTime", node.writeTime);
+            sr.AddKeyValue("ImporterVersion", node.importerVersion);
+
+            if (!node.dependencies.empty())
+            {
+                sr.BeginSequence("Dependencies");
+                for (const std::string &dependency : node.dependencies)
+                    sr.AddValue(dependency);
+                sr.EndSequence();
+            }
+
+            sr.EndMap();
+        }
+
+        sr.EndSequence();
+        sr.EndMap();
+        sr.EndMap();
+        sr.Serialize();
+
+        m_Dirty = false;
+        return true;
+    }
+
+    bool AssetDependencyGraph::Load(const std::filesystem::path &filepath)
+    {
+        Clear();
+        m_Dirty = false;
+
+        if (!std::filesystem::exists(filepath))
+            return false;
+
+        try
+        {
+            YAML::Node fileNode = Serializer::Deserialize(filepath);
+            YAML::Node graphNode = fileNode["AssetDependencies"];
+            if (!graphNode)
+                return false;
+
+            for (YAML::Node assetNode : graphNode["Assets"])
+            {
+                const std::string key = assetNode["Filepath"].as<std::string>();
+
+                AssetDependencyNode &node = m_Nodes[key];
+                node.contentHash = assetNode["ContentHash"].as<u64>();
+                node.fileSize = assetNode["FileSize"].as<u64>();
+                node.writeTime = assetNode["WriteTime"].as<i64>();
+                node.importerVersion = assetNode["ImporterVersion"].as<u32>();
+
+                for (YAML::Node dependencyNode : assetNode["Dependencies"])
+                {
+                    node.dependencies.push_back(dependencyNode.as<std::string>());
+                    m_Dependents[node.dependencies.back()].push_back(key);
+                }
+            }
+        }
+        catch (const YAML::Exception &e)
+        {
+            LOG_WARN("[Asset Dependency Graph] Discarding {}: {}", filepath.generic_string(), e.what());
+            Clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool AssetDependencyGraph::ReadFileState(const std::string &key, AssetDependencyNode &outNode, bool hashContent) const
+    {
+        const std::filesystem::path filepath = m_RootDirectory / key;
+
+        std::error_code ec;
+        const u64 fileSize = std::filesystem::file_size(filepath, ec);
+        if (ec)
+            return false;
+
+        const auto writeTime = std::filesystem::last_write_time(filepath, ec);
+        if (ec)
+            return false;
+
+        outNode.fileSize = fileSize;
+        outNode.writeTime = static_cast<i64>(writeTime.time_since_epoch().count());
+
+        if (hashContent)
+            return HashFile(filepath, outNode.contentHash);
+        return true;
+    }
+
+    void AssetDependencyGraph::RemoveEdges(const std::string &key, const AssetDependencyNode &node)
+    {
+        for (const std::string &dependency : node.dependencies)
+        {
+            auto it = m_Dependents.find(dependency);
+            if (it == m_Dependents.end())
+                continue;
+
+            std::erase(it->second, key);
+            if (it->second.empty())
+                m_Dependents.erase(it);
+        }
+    }
+}
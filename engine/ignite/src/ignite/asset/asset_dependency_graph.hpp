@@ -0,0 +1,71 @@
+#pragma once
+
+#include "asset.hpp"
+
+#include "ignite/core/types.hpp"
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ignite {
+
+// stored in the project cache directory
+#define ASSET_DEPENDENCY_GRAPH_FILENAME "AssetDependencies.ixdeps"
+
+    struct AssetDependencyNode
+    {
+        // file state when the asset was last imported
+        u64 contentHash = 0;
+        u64 fileSize = 0;
+        i64 writeTime = 0;
+        u32 importerVersion = 0;
+
+        std::vector<std::string> dependencies; // normalized asset relative paths
+    };
+
+    // Records which assets reference which files (scene -> model -> texture, scene -> audio),
+    // together with the content hash and importer version each one was imported with.
+    // Keys are asset relative paths, files are resolved against the root directory.
+    class AssetDependencyGraph
+    {
+    public:
+        void SetRootDirectory(const std::filesystem::path &directory) { m_RootDirectory = directory; }
+        const std::filesystem::path &GetRootDirectory() const { return m_RootDirectory; }
+
+        // replaces the outgoing edges and stamps the asset, dependencies seen for the first time are stamped too
+        void Record(const std::filesystem::path &asset, const std::vector<std::filesystem::path> &dependencies);
+
+        // store the current file state, call after the asset was (re)imported
+        void Stamp(const std::filesystem::path &asset);
+
+        void Remove(const std::filesystem::path &asset);
+        void Clear();
+
+        bool Contains(const std::filesystem::path &asset) const;
+        const AssetDependencyNode *GetNode(const std::filesystem::path &asset) const;
+
+        // direct dependents only, or everything that reaches the asset
+        std::vector<std::string> GetDependents(const std::filesystem::path &asset, bool transitive = true) const;
+
+        // content changed since the last stamp or the importer got a newer version.
+        // a file touched without changes is restamped, later checks skip the hash again
+        bool IsStale(const std::filesystem::path &asset);
+        std::vector<std::string> GetStaleAssets();
+
+        bool Save(const std::filesystem::path &filepath) const;
+        bool Load(const std::filesystem::path &filepath);
+
+        bool IsDirty() const { return m_Dirty; }
+
+    private:
+        bool ReadFileState(const std::string &key, AssetDependencyNode &outNode, bool hashContent) const;
+        void RemoveEdges(const std::string &key, const AssetDependencyNode &node);
+
+        std::unordered_map<std::string, AssetDependencyNode> m_Nodes;
+        std::unordered_map<std::string, std::vector<std::string>> m_Dependents; // reverse edges
+        std::filesystem::path m_RootDirectory;
+        mutable bool m_Dirty = false;
+    };
+}
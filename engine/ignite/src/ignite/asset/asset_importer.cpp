@@ -1,4 +1,5 @@
 #include "asset_importer.hpp"
+#include "asset_watcher.hpp"
 
 #include "ignite/audio/fmod_audio.hpp"
 #include "ignite/audio/fmod_sound.hpp"
@@ -6,15 +7,22 @@
 #include "ignite/core/application.hpp"
 #include "ignite/project/project.hpp"
 #include "ignite/serializer/serializer.hpp"
+#include "ignite/serializer/scene_document.hpp"
 #include "ignite/graphics/scene_renderer.hpp"
 #include "ignite/graphics/graphics_pipeline.hpp"
 #include "ignite/graphics/environment.hpp"
 #include "ignite/graphics/mesh_loader.hpp"
+#include "ignite/graphics/mapped_io_system.hpp"
 #include "ignite/graphics/mesh.hpp"
+#include "ignite/graphics/texture_cache.hpp"
+#include "ignite/graphics/texture_streamer.hpp"
+#include "ignite/graphics/texture_compressor.hpp"
+#include "ignite/graphics/environment_baker.hpp"
 
 #include "ignite/scene/scene.hpp"
 #include "ignite/scene/component.hpp"
 #include "ignite/scene/scene_manager.hpp"
+#include "ignite/core/profiler.hpp"
 
 namespace ignite {
 
@@ -25,14 +33,206 @@ namespace ignite {
         { AssetType::Audio, AssetImporter::ImportAudio },
     };
 
+    namespace
+    {
+        TextureCreateInfo GetTextureImportInfo()
+        {
+            TextureCreateInfo createInfo;
+            createInfo.format = nvrhi::Format::RGBA8_UNORM;
+            createInfo.mipLevels = 0; // full chain
+            createInfo.usage = TextureUsage::Sprite;
+            return createInfo;
+        }
+
+        // from the bytes AssetManager::Prefetch already read when there are any, the file otherwise
+        FMOD::Sound *CreateSound(const std::filesystem::path &filepath, const vfs::ReadFuture &prefetched)
+        {
+            FMOD::Sound *sound = nullptr;
+
+            const Ref<vfs::IBlob> blob = prefetched.valid() ? prefetched.get() : nullptr;
+            if (!vfs::IBlob::IsEmpty(blob.get()))
+            {
+                // FMOD_DEFAULT decodes into a sample, the blob is not needed after this
+                FMOD_CREATESOUNDEXINFO info = {};
+                info.cbsize = sizeof(info);
+                info.length = static_cast<unsigned int>(blob->Size());
+
+                if (FmodAudio::GetFmodSystem()->createSound(static_cast<const char *>(blob->Data()), FMOD_DEFAULT | FMOD_OPENMEMORY, &info, &sound) == FMOD_OK)
+                    return sound;
+            }
+
+            FmodAudio::GetFmodSystem()->createSound(filepath.generic_string().c_str(), FMOD_DEFAULT, nullptr, &sound);
+            return sound;
+        }
+
+        class TextureImportJob : public AssetImportJob
+        {
+        public:
+            TextureImportJob(AssetHandle handle, const std::filesystem::path &filepath)
+                : m_Handle(handle), m_Filepath(filepath)
+            {
+            }
+
+            bool Load() override
+            {
+                return TextureCache::Prepare(m_Filepath, GetTextureImportInfo(), m_Prepared);
+            }
+
+            Ref<Asset> Finish(nvrhi::ICommandList *commandList) override
+            {
+                Ref<Texture> texture = TextureCache::Finish(m_Prepared, commandList);
+                if (texture)
+                    texture->handle = m_Handle;
+                return texture;
+            }
+
+        private:
+            AssetHandle m_Handle;
+            std::filesystem::path m_Filepath;
+            PreparedTexture m_Prepared;
+        };
+
+        // FMOD decodes the sample in createSound, the channel setup stays on the main thread
+        class AudioImportJob : public AssetImportJob
+        {
+        public:
+            AudioImportJob(AssetHandle handle, const std::filesystem::path &filepath, vfs::ReadFuture prefetched)
+                : m_Handle(handle), m_Filepath(filepath), m_Prefetched(std::move(prefetched))
+            {
+            }
+
+            ~AudioImportJob() override
+            {
+                if (m_Sound)
+                    m_Sound->release();
+            }
+
+            bool Load() override
+            {
+                m_Sound = CreateSound(m_Filepath, m_Prefetched);
+                m_Prefetched = {};
+                return m_Sound != nullptr;
+            }
+
+            Ref<Asset> Finish(nvrhi::ICommandList *commandList) override
+            {
+                LOG_WARN("[FMOD Sound] Load sound '{}'", m_Filepath.generic_string());
+
+                Ref<FmodSound> sound = FmodSound::Create(m_Filepath.filename().string(), m_Sound);
+                m_Sound = nullptr;
+
+                if (sound)
+                    sound->handle = m_Handle;
+                return sound;
+            }
+
+        private:
+            AssetHandle m_Handle;
+            std::filesystem::path m_Filepath;
+            vfs::ReadFuture m_Prefetched;
+            FMOD::Sound *m_Sound = nullptr;
+        };
+
+        // parsing is the expensive part, entities and scripts are created on the main thread
+        class SceneImportJob : public AssetImportJob
+        {
+        public:
+            SceneImportJob(AssetHandle handle, const std::filesystem::path &filepath)
+                : m_Handle(handle), m_Filepath(filepath)
+            {
+            }
+
+            bool Load() override
+            {
+                if (!std::filesystem::exists(m_Filepath))
+                {
+                    LOG_ERROR("[Asset Importer] Scene does not exists {}", m_Filepath.generic_string());
+                    return false;
+                }
+
+                // binary scenes are read into plain arrays here, no parsing left for the main thread
+                if (m_Filepath.extension() == IXSCENE_BINARY_EXTENSION)
+                {
+                    m_Binary = true;
+                    return SceneDocument::ReadBinary(m_Filepath, m_Document);
+                }
+
+                m_SceneFileNode = Serializer::Deserialize(m_Filepath);
+                return static_cast<bool>(m_SceneFileNode);
+            }
+
+            Ref<Asset> Finish(nvrhi::ICommandList *commandList) override
+            {
+                // the referenced files are read in one batch while the entities are created
+                std::vector<AssetHandle> dependencies;
+                if (m_Binary)
+                {
+                    for (u64 handle : m_Document.GetAudioHandles())
+                        dependencies.push_back(AssetHandle(handle));
+                }
+                else if (YAML::Node sceneNode = m_SceneFileNode["Scene"])
+                {
+                    for (YAML::Node entityNode : sceneNode["Entities"])
+                    {
+                        if (YAML::Node node = entityNode["AudioSource"])
+                            dependencies.push_back(AssetHandle(node["Handle"].as<uint64_t>()));
+                    }
+                }
+                Project::GetActive()->GetAssetManager().Prefetch(dependencies);
+
+                Ref<Scene> scene = m_Binary ? m_Document.CreateScene() : SceneSerializer::Deserialize(m_SceneFileNode);
+                if (scene)
+                    scene->handle = m_Handle;
+                return scene;
+            }
+
+        private:
+            AssetHandle m_Handle;
+            std::filesystem::path m_Filepath;
+            YAML::Node m_SceneFileNode;
+            SceneDocument m_Document;
+            bool m_Binary = false;
+        };
+
+        // types without a split import run entirely on the main thread
+        class MainThreadImportJob : public AssetImportJob
+        {
+        public:
+            MainThreadImportJob(AssetHandle handle, const AssetMetaData &metadata)
+                : m_Handle(handle), m_MetaData(metadata)
+            {
+            }
+
+            bool Load() override
+            {
+                return true;
+            }
+
+            Ref<Asset> Finish(nvrhi::ICommandList *commandList) override
+            {
+                if (s_ImportFunctions.contains(m_MetaData.type))
+                    return s_ImportFunctions.at(m_MetaData.type)(m_Handle, m_MetaData);
+                return nullptr;
+            }
+
+        private:
+            AssetHandle m_Handle;
+            AssetMetaData m_MetaData;
+        };
+    }
+
     void AssetImporter::SyncMainThread(nvrhi::ICommandList *commandList, nvrhi::IDevice *device)
     {
-        // ModelImporter::SyncMainThread(commandList, device);
         EnvironmentImporter::SyncMainThread(commandList, device);
+        AssetLoader::SyncMainThread(commandList, device);
+        TextureStreamer::SyncMainThread(commandList, device);
+        AssetWatcher::SyncMainThread();
     }
 
     Ref<Asset> AssetImporter::Import(AssetHandle handle, const AssetMetaData &metadata)
     {
+        IGN_PROFILE_FUNCTION();
+
         Project *activeProject = Project::GetActive();
 
         // should be always importing with full filepath
@@ -45,6 +245,31 @@ namespace ignite {
         return nullptr;
     }
 
+    u32 AssetImporter::GetImporterVersion(AssetType type)
+    {
+        switch (type)
+        {
+        case AssetType::Texture: return TEXTURE_COMPRESSOR_VERSION;
+        case AssetType::TextureCube: return ENVIRONMENT_BAKER_VERSION;
+        case AssetType::MeshSource: return MESH_LOADER_VERSION;
+        default: return ASSET_IMPORTER_VERSION;
+        }
+    }
+
+    Scope<AssetImportJob> AssetImporter::CreateImportJob(AssetHandle handle, const AssetMetaData &metadata)
+    {
+        AssetMetaData metadataCopy = metadata;
+        metadataCopy.filepath = Project::GetActive()->GetAssetFilepath(metadata.filepath);
+
+        switch (metadataCopy.type)
+        {
+        case AssetType::Texture: return CreateScope<TextureImportJob>(handle, metadataCopy.filepath);
+        case AssetType::Audio: return CreateScope<AudioImportJob>(handle, metadataCopy.filepath, Project::GetActive()->GetAssetManager().TakePrefetched(handle));
+        case AssetType::Scene: return CreateScope<SceneImportJob>(handle, metadataCopy.filepath);
+        default: return CreateScope<MainThreadImportJob>(handle, metadataCopy);
+        }
+    }
+
     Ref<Scene> AssetImporter::ImportScene(AssetHandle handle, const AssetMetaData& metadata)
     {
         Ref<Scene> scene = SceneSerializer::Deserialize(metadata.filepath);
@@ -57,10 +282,7 @@ namespace ignite {
 
     Ref<Texture> AssetImporter::ImportTexture(AssetHandle handle, const AssetMetaData &metadata)
     {
-        TextureCreateInfo createInfo;
-        createInfo.format = nvrhi::Format::RGBA8_UNORM;
-
-        Ref<Texture> texture = Texture::Create(metadata.filepath, createInfo);
+        Ref<Texture> texture = TextureCache::Load(metadata.filepath, GetTextureImportInfo());
         if (texture)
         {
             texture->handle = handle;
@@ -71,7 +293,10 @@ namespace ignite {
 
     Ref<FmodSound> AssetImporter::ImportAudio(AssetHandle handle, const AssetMetaData &metadata)
     {
-        Ref<FmodSound> sound = FmodSound::Create(metadata.filepath.filename().string(), metadata.filepath.generic_string(), FMOD_DEFAULT);
+        FMOD::Sound *fmodSound = CreateSound(metadata.filepath, Project::GetActive()->GetAssetManager().TakePrefetched(handle));
+        LOG_WARN("[FMOD Sound] Load sound '{}'", metadata.filepath.generic_string());
+
+        Ref<FmodSound> sound = FmodSound::Create(metadata.filepath.filename().string(), fmodSound);
         if (sound)
         {
             sound->handle = handle;
@@ -86,7 +311,9 @@ namespace ignite {
         SkinnedMesh &skinnedMesh = outEntity.GetComponent<SkinnedMesh>();
         skinnedMesh.filepath = Project::GetActive()->GetAssetRelativeFilepath(filepath);
 
+        // the importer owns the io system, model and referenced files are read from mapped views
         Assimp::Importer importer;
+        importer.SetIOHandler(new MappedIOSystem());
         const aiScene *assimpScene = importer.ReadFile(filepath.generic_string(), ASSIMP_IMPORTER_FLAGS);
 
         LOG_ASSERT(assimpScene == nullptr || assimpScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || assimpScene->mRootNode,
@@ -122,6 +349,19 @@ namespace ignite {
         MeshLoader::ProcessNode(assimpScene, assimpScene->mRootNode, filepath, meshes, nodes, skinnedMesh.skeleton, -1);
         MeshLoader::CalculateWorldTransforms(nodes);
 
+        // external texture files, embedded ones change with the model itself
+        std::vector<std::filesystem::path> dependencies;
+        for (const Ref<Mesh> &mesh : meshes)
+        {
+            for (const Material::TextureData &textureData : mesh->material.textures | std::views::values)
+            {
+                std::error_code ec;
+                if (textureData.texture && std::filesystem::is_regular_file(textureData.texture->GetFilepath(), ec))
+                    dependencies.push_back(Project::GetActive()->GetAssetRelativeFilepath(textureData.texture->GetFilepath()));
+            }
+        }
+        Project::GetActive()->GetAssetManager().GetDependencyGraph().Record(skinnedMesh.filepath, dependencies);
+
         // First pass: create all node entities
         for (auto &node : nodes)
         {
@@ -173,7 +413,7 @@ namespace ignite {
                 meshRenderer.mesh->environment = scene->sceneRenderer->GetEnvironment();
                 meshRenderer.mesh->CreateBuffers();
                 meshRenderer.mesh->CreateBindingSet();
-                meshRenderer.mesh->WriteBuffers(nodeEntity);
+                meshRenderer.mesh->WriteBuffers();
             }
 
             // Extract skeleton joints into entity
@@ -192,109 +432,86 @@ namespace ignite {
                 }
             }
         }
-
-        MeshLoader::ClearTextureCache();
     }
 
-#if 0
-    std::vector<std::future<Ref<Model>>> ModelImporter::m_ModelFutures;
-    void ModelImporter::LoadAsync(std::vector<Ref<Model>> *outModels, const std::vector<std::string> &filepaths, const ModelCreateInfo &createInfo, const Ref<Environment> &env, const Ref<GraphicsPipeline> &pipeline)
+    void EnvironmentImporter::Import(Ref<Environment> *outEnvironment, const std::string &filepath)
     {
-        for (const std::string &filepath : filepaths)
-        {
-            m_ModelFutures.push_back(std::async(std::launch::async, LoadModels, outModels, filepath, createInfo, env, pipeline));
-        }
+        BakeAsync(outEnvironment, filepath, true);
     }
 
-    void ModelImporter::LoadAsync(Ref<Model> *model, const std::string &filepath, const ModelCreateInfo &createInfo, const Ref<Environment> &env, const Ref<GraphicsPipeline> &pipeline)
+    void EnvironmentImporter::UpdateTexture(Ref<Environment> *outEnvironment, const std::string &filepath)
     {
-        m_ModelFutures.push_back(std::async(std::launch::async, LoadModel, model, filepath, createInfo, env, pipeline));
+        BakeAsync(outEnvironment, filepath, false);
     }
 
-    void ModelImporter::SyncMainThread(nvrhi::ICommandList *commandList, nvrhi::IDevice *device)
+    void EnvironmentImporter::SyncMainThread(nvrhi::ICommandList *commandList, nvrhi::IDevice *device)
     {
-        for (auto it = m_ModelFutures.begin(); it != m_ModelFutures.end(); )
+        if (m_Baking && m_BakeCounter.IsDone())
         {
-            if ((*it).wait_for(std::chrono::milliseconds(0)) == std::future_status::ready)
-            {
-                Ref<Model> returnedModel = (*it).get();
-                commandList->open();
-                returnedModel->WriteBuffer(commandList);
-                commandList->close();
-
-                device->executeCommandList(commandList);
+            JobSystem::Wait(m_BakeCounter);
+            m_Baking = false;
 
-                it = m_ModelFutures.erase(it);
-            }
-            else
+            Ref<BakedEnvironment> baked = std::move(m_Baked);
+            if (!baked)
             {
-                ++it;
+                LOG_ERROR("[Environment Importer] Failed to load {}", m_Pending.filepath);
+                return;
             }
-        }
-    }
 
-    Ref<Model> ModelImporter::LoadModels(std::vector<Ref<Model>> *outModels, const std::string &filepath, const ModelCreateInfo &createInfo, const Ref<Environment> &env, const Ref<GraphicsPipeline> &pipeline)
-    {
-        Ref<Model> model = Model::Create(filepath, createInfo);
+            Ref<Environment> &env = *m_Pending.outEnvironment;
 
-        model->SetEnvironment(env);
-        model->CreateBindingSet();
+            commandList->open();
+            if (m_Pending.create || !env)
+                env = Environment::Create();
 
-        outModels->push_back(model);
+            env->WriteBuffer(commandList);
+            env->LoadTexture(*baked, m_Pending.filepath, commandList);
+            commandList->close();
+            device->executeCommandList(commandList);
 
-        return model;
+            env->isUpdatingTexture = true;
+            m_Loaded = m_Pending;
+        }
     }
 
-
-    Ref<Model> ModelImporter::LoadModel(Ref<Model> *outModels, const std::string &filepath, const ModelCreateInfo &createInfo, const Ref<Environment> &env, const Ref<GraphicsPipeline> &pipeline)
+    bool EnvironmentImporter::Reload(const std::filesystem::path &filepath)
     {
-        *outModels = Model::Create(filepath, createInfo);
+        if (!m_Loaded.outEnvironment || m_Loaded.filepath.empty())
+            return false;
 
-        (*outModels)->SetEnvironment(env);
-        (*outModels)->CreateBindingSet();
+        std::error_code ec;
+        if (!std::filesystem::equivalent(filepath, m_Loaded.filepath, ec))
+            return false;
 
-        return *outModels;
+        BakeAsync(m_Loaded.outEnvironment, m_Loaded.filepath, false);
+        return true;
     }
-#endif
 
-    void EnvironmentImporter::Import(Ref<Environment> *outEnvironment, const std::string &filepath)
+    void EnvironmentImporter::BakeAsync(Ref<Environment> *outEnvironment, const std::string &filepath, bool create)
     {
-        m_Future = std::async(std::launch::async, ImportAsync, outEnvironment, filepath);
-    }
+        // finish the previous bake before the pending target is replaced
+        JobSystem::Wait(m_BakeCounter);
 
-    void EnvironmentImporter::UpdateTexture(Ref<Environment> *outEnvironment, const std::string &filepath)
-    {
-        m_Future = std::async(std::launch::async, LoadTextureAsync, outEnvironment, filepath);
-    }
-
-    void EnvironmentImporter::SyncMainThread(nvrhi::ICommandList *commandList, nvrhi::IDevice *device)
-    {
-        if (m_Future.valid() && m_Future.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready)
+        m_Pending = { outEnvironment, filepath, create };
+        m_Baking = true;
+        JobSystem::Run([filepath]()
         {
-            Ref<Environment> env = m_Future.get();
-
-            commandList->open();
-            env->WriteBuffer(commandList);
-            commandList->close();
-            device->executeCommandList(commandList);
-
-            env->isUpdatingTexture = true;
-        }
-    }
-
-    Ref<Environment> EnvironmentImporter::ImportAsync(Ref<Environment> *outEnvironment, const std::string &filepath)
-    {
-        (*outEnvironment) = Environment::Create();
-        (*outEnvironment)->LoadTexture(filepath);
-        return *outEnvironment;
+            m_Baked = Bake(filepath);
+        }, &m_BakeCounter);
     }
 
-    Ref<Environment> EnvironmentImporter::LoadTextureAsync(Ref<Environment> *outEnvironment, const std::string &filepath)
+    Ref<BakedEnvironment> EnvironmentImporter::Bake(const std::string &filepath)
     {
-        (*outEnvironment)->LoadTexture(filepath);
-        return *outEnvironment;
+        Ref<BakedEnvironment> baked = CreateRef<BakedEnvironment>();
+        if (!EnvironmentBaker::Load(filepath, *baked))
+            return nullptr;
+        return baked;
     }
 
-    std::future<Ref<Environment>> EnvironmentImporter::m_Future;
+    EnvironmentImporter::PendingBake EnvironmentImporter::m_Pending;
+    EnvironmentImporter::PendingBake EnvironmentImporter::m_Loaded;
+    JobCounter EnvironmentImporter::m_BakeCounter;
+    Ref<BakedEnvironment> EnvironmentImporter::m_Baked;
+    bool EnvironmentImporter::m_Baking = false;
 
 }
@@ -1,15 +1,21 @@
 #pragma once
 
 #include "asset.hpp"
-#include <future>
+#include "asset_loader.hpp"
 #include <nvrhi/nvrhi.h>
 
+#include "ignite/core/job_system.hpp"
+
 #include "ignite/scene/entity.hpp"
 
 namespace ignite {
 
+// importer version stamped on assets without a dedicated cooker
+#define ASSET_IMPORTER_VERSION 1
+
     class Environment;
     class GraphicsPipeline;
+    struct BakedEnvironment;
     class Scene;
     struct FmodSound;
 
@@ -18,10 +24,17 @@ namespace ignite {
     public:
         static void SyncMainThread(nvrhi::ICommandList *commandList, nvrhi::IDevice *device);
         static Ref<Asset> Import(AssetHandle handle, const AssetMetaData &metadata);
+
+        // version of the importer or cooker producing assets of this type, stamped into the dependency graph
+        static u32 GetImporterVersion(AssetType type);
+
         static Ref<Scene> ImportScene(AssetHandle handle, const AssetMetaData &metadata);
         static Ref<Texture> ImportTexture(AssetHandle handle, const AssetMetaData &metadata);
         static Ref<FmodSound> ImportAudio(AssetHandle handle, const AssetMetaData &metadata);
 
+        // split import used by AssetManager::LoadAsync, metadata holds the asset relative path
+        static Scope<AssetImportJob> CreateImportJob(AssetHandle handle, const AssetMetaData &metadata);
+
         static void LoadSkinnedMesh(Scene *scene, Entity outEntity, const std::filesystem::path& filepath);
     };
 
@@ -32,9 +45,25 @@ namespace ignite {
         static void UpdateTexture(Ref<Environment> *outEnvironment, const std::string &filepath);
         static void SyncMainThread(nvrhi::ICommandList *commandList, nvrhi::IDevice *device);
 
+        // re-bakes the environment loaded from filepath, false when it is not the current one
+        static bool Reload(const std::filesystem::path &filepath);
+
     private:
-        static Ref<Environment> ImportAsync(Ref<Environment> *outEnvironment, const std::string &filepath);
-        static Ref<Environment> LoadTextureAsync(Ref<Environment> *outEnvironment, const std::string &filepath);
-        static std::future<Ref<Environment>> m_Future;
+        // the bake runs as a job, the environment is created and uploaded in SyncMainThread
+        static void BakeAsync(Ref<Environment> *outEnvironment, const std::string &filepath, bool create);
+        static Ref<BakedEnvironment> Bake(const std::string &filepath);
+
+        struct PendingBake
+        {
+            Ref<Environment> *outEnvironment = nullptr;
+            std::string filepath;
+            bool create = false;
+        };
+
+        static PendingBake m_Pending;
+        static PendingBake m_Loaded;
+        static JobCounter m_BakeCounter;
+        static Ref<BakedEnvironment> m_Baked; // written by the bake job
+        static bool m_Baking;
     };
 }
@@ -0,0 +1,470 @@
+#include "asset_loader.hpp"
+
+#include "ignite/core/application.hpp"
+#include "ignite/core/logger.hpp"
+#include "ignite/core/profiler.hpp"
+#include "ignite/core/job_system.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ignite {
+
+    struct AssetLoadRequest
+    {
+        AssetHandle handle = AssetHandle(0);
+        Scope<AssetImportJob> job;
+        AssetLoader::CompletionFunc onComplete;
+        u64 sequence = 0;
+
+        std::atomic<AssetLoadStatus> status = AssetLoadStatus::Queued;
+        std::atomic<AssetLoadPriority> priority = AssetLoadPriority::Normal;
+        std::atomic<bool> canceled = false;
+
+        // guards asset and status changes that waiters sleep on
+        std::mutex mutex;
+        std::condition_variable condition;
+        Ref<Asset> asset;
+    };
+
+    namespace
+    {
+        // A request is owned by exactly one place at a time: the queued list,
+        // a worker, the loaded list or the main thread. Only the owner completes it.
+        struct AssetLoaderData
+        {
+            std::mutex queueMutex;
+
+            std::vector<Ref<AssetLoadRequest>> queued;
+            std::vector<Ref<AssetLoadRequest>> loaded; // CPU stage done, waiting for the main thread
+
+            // load jobs on the job system, each takes the best queued request when it starts
+            JobCounter jobs;
+            u32 activeJobs = 0;
+            u32 idleJobs = 0; // started but no request taken yet
+            bool running = false;
+            u64 nextSequence = 0;
+            std::thread::id mainThreadId;
+
+            std::atomic<u32> pendingCount = 0;
+            f64 frameBudget = ASSET_LOADER_FRAME_BUDGET_MS;
+        };
+
+        AssetLoaderData &GetData()
+        {
+            static AssetLoaderData data;
+            return data;
+        }
+
+        // higher priority first, then submission order
+        bool ComesBefore(const Ref<AssetLoadRequest> &a, const Ref<AssetLoadRequest> &b)
+        {
+            const AssetLoadPriority priorityA = a->priority;
+            const AssetLoadPriority priorityB = b->priority;
+            if (priorityA != priorityB)
+                return priorityA > priorityB;
+            return a->sequence < b->sequence;
+        }
+
+        // caller must hold the queue lock
+        bool RemoveRequest(std::vector<Ref<AssetLoadRequest>> &requests, const Ref<AssetLoadRequest> &request)
+        {
+            auto it = std::find(requests.begin(), requests.end(), request);
+            if (it == requests.end())
+                return false;
+
+            *it = std::move(requests.back());
+            requests.pop_back();
+            return true;
+        }
+
+        void SetStatus(AssetLoadRequest &request, AssetLoadStatus status, const Ref<Asset> &asset = nullptr)
+        {
+            {
+                std::lock_guard lock(request.mutex);
+                request.asset = asset;
+                request.status = status;
+            }
+            request.condition.notify_all();
+        }
+
+        void Complete(AssetLoadRequest &request, AssetLoadStatus status, const Ref<Asset> &asset = nullptr)
+        {
+            request.job.reset();
+            request.onComplete = nullptr;
+            SetStatus(request, status, asset);
+
+            GetData().pendingCount--;
+        }
+
+        // main thread only
+        void FinishRequest(const Ref<AssetLoadRequest> &request, nvrhi::ICommandList *commandList)
+        {
+            if (request->canceled)
+            {
+                Complete(*request, AssetLoadStatus::Canceled);
+                return;
+            }
+
+            IGN_PROFILE_SCOPE("Asset Finish");
+
+            Ref<Asset> asset = request->job->Finish(commandList);
+            if (asset && request->onComplete)
+                asset = request->onComplete(asset);
+
+            Complete(*request, asset ? AssetLoadStatus::Ready : AssetLoadStatus::Failed, asset);
+        }
+
+        void FinishImmediately(const Ref<AssetLoadRequest> &request)
+        {
+            nvrhi::IDevice *device = Application::GetRenderDevice();
+
+            nvrhi::CommandListHandle commandList = device->createCommandList();
+            commandList->open();
+            FinishRequest(request, commandList);
+            commandList->close();
+            device->executeCommandList(commandList);
+        }
+
+        void LoadNext();
+
+        // caller must hold the queue lock, the jobs are started with StartLoads once it is released
+        u32 ReserveLoads(AssetLoaderData &data)
+        {
+            u32 count = 0;
+            while (data.running && data.activeJobs < ASSET_LOADER_MAX_JOBS && data.idleJobs < data.queued.size())
+            {
+                data.activeJobs++;
+                data.idleJobs++;
+                count++;
+            }
+            return count;
+        }
+
+        // before JobSystem::Init the job runs inline and takes the queue lock itself
+        void StartLoads(u32 count)
+        {
+            for (u32 i = 0; i < count; ++i)
+                JobSystem::Run(LoadNext, &GetData().jobs);
+        }
+
+        void LoadNext()
+        {
+            AssetLoaderData &data = GetData();
+
+            Ref<AssetLoadRequest> request;
+            {
+                std::lock_guard lock(data.queueMutex);
+                data.idleJobs--;
+
+                // canceled meanwhile or shutting down
+                if (!data.running || data.queued.empty())
+                {
+                    data.activeJobs--;
+                    return;
+                }
+
+                // picked now, a request submitted or raised after this job was queued still goes first
+                auto it = std::min_element(data.queued.begin(), data.queued.end(), ComesBefore);
+                request = *it;
+                *it = std::move(data.queued.back());
+                data.queued.pop_back();
+            }
+
+            if (request->canceled)
+            {
+                Complete(*request, AssetLoadStatus::Canceled);
+            }
+            else
+            {
+                request->status = AssetLoadStatus::Loading;
+
+                bool loaded = false;
+                try
+                {
+                    IGN_PROFILE_SCOPE("Asset Load");
+                    loaded = request->job->Load();
+                }
+                catch (const std::exception &e)
+                {
+                    // yaml-cpp reports malformed files with exceptions
+                    LOG_ERROR("[Asset Loader] Failed to load {}: {}", static_cast<u64>(request->handle), e.what());
+                }
+
+                if (request->canceled)
+                {
+                    Complete(*request, AssetLoadStatus::Canceled);
+                }
+                else if (!loaded)
+                {
+                    Complete(*request, AssetLoadStatus::Failed);
+                }
+                else
+                {
+                    // the status goes first, the main thread may finish the request as soon as it is listed
+                    SetStatus(*request, AssetLoadStatus::Uploading);
+
+                    std::lock_guard lock(data.queueMutex);
+                    data.loaded.push_back(request);
+                }
+            }
+
+            u32 startCount = 0;
+            {
+                std::lock_guard lock(data.queueMutex);
+                data.activeJobs--;
+                startCount = ReserveLoads(data);
+            }
+
+            StartLoads(startCount);
+        }
+    }
+
+    AssetHandle AssetLoadHandle::GetAssetHandle() const
+    {
+        return m_Request ? m_Request->handle : AssetHandle(0);
+    }
+
+    AssetLoadStatus AssetLoadHandle::GetStatus() const
+    {
+        return m_Request ? m_Request->status.load() : AssetLoadStatus::Failed;
+    }
+
+    AssetLoadPriority AssetLoadHandle::GetPriority() const
+    {
+        return m_Request ? m_Request->priority.load() : AssetLoadPriority::Normal;
+    }
+
+    bool AssetLoadHandle::IsDone() const
+    {
+        const AssetLoadStatus status = GetStatus();
+        return status == AssetLoadStatus::Ready || status == AssetLoadStatus::Failed || status == AssetLoadStatus::Canceled;
+    }
+
+    bool AssetLoadHandle::IsReady() const
+    {
+        return GetStatus() == AssetLoadStatus::Ready;
+    }
+
+    Ref<Asset> AssetLoadHandle::Get() const
+    {
+        if (!m_Request)
+            return nullptr;
+
+        std::lock_guard lock(m_Request->mutex);
+        return m_Request->asset;
+    }
+
+    Ref<Asset> AssetLoadHandle::Wait() const
+    {
+        if (!m_Request)
+            return nullptr;
+
+        AssetLoaderData &data = GetData();
+        const bool mainThread = std::this_thread::get_id() == data.mainThreadId;
+
+        SetPriority(AssetLoadPriority::High);
+
+        std::unique_lock lock(m_Request->mutex);
+        while (!IsDone())
+        {
+            // nobody else finishes requests on the main thread, do it here
+            if (mainThread && m_Request->status == AssetLoadStatus::Uploading)
+            {
+                lock.unlock();
+
+                bool owned = false;
+                {
+                    std::lock_guard queueLock(data.queueMutex);
+                    owned = RemoveRequest(data.loaded, m_Request);
+                }
+
+                if (owned)
+                    FinishImmediately(m_Request);
+
+                lock.lock();
+
+                // the worker has set the status but not listed the request yet
+                if (!owned)
+                    m_Request->condition.wait_for(lock, std::chrono::milliseconds(1));
+
+                continue;
+            }
+
+            m_Request->condition.wait(lock);
+        }
+
+        return m_Request->asset;
+    }
+
+    void AssetLoadHandle::Cancel() const
+    {
+        if (!m_Request || IsDone())
+            return;
+
+        m_Request->canceled = true;
+
+        // still listed, complete it now, otherwise the current owner sees the flag
+        AssetLoaderData &data = GetData();
+        bool owned = false;
+        {
+            std::lock_guard lock(data.queueMutex);
+            owned = RemoveRequest(data.queued, m_Request) || RemoveRequest(data.loaded, m_Request);
+        }
+
+        if (owned)
+            Complete(*m_Request, AssetLoadStatus::Canceled);
+    }
+
+    void AssetLoadHandle::SetPriority(AssetLoadPriority priority) const
+    {
+        if (m_Request)
+            m_Request->priority = priority;
+    }
+
+    AssetLoadHandle AssetLoader::Submit(AssetHandle handle, Scope<AssetImportJob> job, AssetLoadPriority priority, const CompletionFunc &onComplete)
+    {
+        LOG_ASSERT(job, "[Asset Loader] Import job is null");
+
+        Ref<AssetLoadRequest> request = CreateRef<AssetLoadRequest>();
+        request->handle = handle;
+        request->job = std::move(job);
+        request->onComplete = onComplete;
+        request->priority = priority;
+
+        AssetLoaderData &data = GetData();
+        data.pendingCount++;
+
+        u32 startCount = 0;
+        {
+            std::lock_guard lock(data.queueMutex);
+
+            if (!data.running)
+            {
+                data.running = true;
+                data.mainThreadId = std::this_thread::get_id();
+            }
+
+            request->sequence = data.nextSequence++;
+            data.queued.push_back(request);
+            startCount = ReserveLoads(data);
+        }
+
+        StartLoads(startCount);
+        return AssetLoadHandle(request);
+    }
+
+    AssetLoadHandle AssetLoader::MakeReady(AssetHandle handle, const Ref<Asset> &asset)
+    {
+        Ref<AssetLoadRequest> request = CreateRef<AssetLoadRequest>();
+        request->handle = handle;
+        request->asset = asset;
+        request->status = AssetLoadStatus::Ready;
+        return AssetLoadHandle(request);
+    }
+
+    void AssetLoader::SyncMainThread(nvrhi::ICommandList *commandList, nvrhi::IDevice *device)
+    {
+        IGN_PROFILE_FUNCTION();
+
+        AssetLoaderData &data = GetData();
+
+        std::vector<Ref<AssetLoadRequest>> loaded;
+        {
+            std::lock_guard lock(data.queueMutex);
+            if (data.loaded.empty())
+                return;
+
+            loaded.swap(data.loaded);
+        }
+
+        // priorities can change while sorting, order by a snapshot
+        struct SortKey
+        {
+            AssetLoadPriority priority;
+            u64 sequence;
+            Ref<AssetLoadRequest> request;
+        };
+
+        std::vector<SortKey> sorted;
+        sorted.reserve(loaded.size());
+        for (Ref<AssetLoadRequest> &request : loaded)
+            sorted.push_back({ request->priority.load(), request->sequence, std::move(request) });
+
+        std::sort(sorted.begin(), sorted.end(), [](const SortKey &a, const SortKey &b)
+        {
+            if (a.priority != b.priority)
+                return a.priority > b.priority;
+            return a.sequence < b.sequence;
+        });
+
+        const auto start = std::chrono::steady_clock::now();
+
+        commandList->open();
+
+        size_t index = 0;
+        for (; index < sorted.size(); ++index)
+        {
+            // at least one per frame, a large asset must not stall the queue
+            const f64 elapsedMs = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (index > 0 && elapsedMs >= data.frameBudget)
+                break;
+
+            FinishRequest(sorted[index].request, commandList);
+        }
+
+        commandList->close();
+        device->executeCommandList(commandList);
+
+        if (index < sorted.size())
+        {
+            std::lock_guard lock(data.queueMutex);
+            for (; index < sorted.size(); ++index)
+                data.loaded.push_back(std::move(sorted[index].request));
+        }
+    }
+
+    void AssetLoader::Shutdown()
+    {
+        AssetLoaderData &data = GetData();
+        {
+            std::lock_guard lock(data.queueMutex);
+            data.running = false;
+        }
+
+        // loads in progress finish, the ones not started yet return right away
+        JobSystem::Wait(data.jobs);
+
+        std::vector<Ref<AssetLoadRequest>> remaining;
+        {
+            std::lock_guard lock(data.queueMutex);
+            remaining.insert(remaining.end(), data.queued.begin(), data.queued.end());
+            remaining.insert(remaining.end(), data.loaded.begin(), data.loaded.end());
+            data.queued.clear();
+            data.loaded.clear();
+        }
+
+        for (const Ref<AssetLoadRequest> &request : remaining)
+            Complete(*request, AssetLoadStatus::Canceled);
+    }
+
+    void AssetLoader::SetFrameBudget(f64 milliseconds)
+    {
+        GetData().frameBudget = milliseconds;
+    }
+
+    f64 AssetLoader::GetFrameBudget()
+    {
+        return GetData().frameBudget;
+    }
+
+    u32 AssetLoader::GetPendingCount()
+    {
+        return GetData().pendingCount;
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "asset.hpp"
+
+#include "ignite/core/types.hpp"
+
+#include <nvrhi/nvrhi.h>
+
+#include <functional>
+
+namespace ignite {
+
+#define ASSET_LOADER_FRAME_BUDGET_MS 4.0
+#define ASSET_LOADER_MAX_JOBS 4 // imports running at once on the job system, the rest of the pool stays free
+
+    enum class AssetLoadPriority : u8
+    {
+        Low = 0,
+        Normal,
+        High
+    };
+
+    enum class AssetLoadStatus : u8
+    {
+        Queued, // waiting for a worker
+        Loading, // CPU work on a worker
+        Uploading, // waiting for the main thread
+        Ready,
+        Failed,
+        Canceled
+    };
+
+    // One asset import split in two stages, Load runs on a worker
+    // and Finish creates the GPU objects on the main thread.
+    class AssetImportJob
+    {
+    public:
+        virtual ~AssetImportJob() = default;
+
+        virtual bool Load() = 0;
+        virtual Ref<Asset> Finish(nvrhi::ICommandList *commandList) = 0;
+    };
+
+    struct AssetLoadRequest;
+
+    // Pollable result of AssetManager::LoadAsync, copies refer to the same request.
+    class AssetLoadHandle
+    {
+    public:
+        AssetLoadHandle() = default;
+
+        bool IsValid() const { return m_Request != nullptr; }
+        AssetHandle GetAssetHandle() const;
+        AssetLoadStatus GetStatus() const;
+        AssetLoadPriority GetPriority() const;
+
+        // ready, failed or canceled
+        bool IsDone() const;
+        bool IsReady() const;
+
+        // null until ready
+        Ref<Asset> Get() const;
+
+        template<typename T>
+        Ref<T> Get() const { return std::static_pointer_cast<T>(Get()); }
+
+        // blocks until done, on the main thread the upload is finished in place
+        Ref<Asset> Wait() const;
+
+        void Cancel() const;
+        void SetPriority(AssetLoadPriority priority) const;
+
+    private:
+        AssetLoadHandle(const Ref<AssetLoadRequest> &request) : m_Request(request) {}
+
+        Ref<AssetLoadRequest> m_Request;
+
+        friend class AssetLoader;
+    };
+
+    // Runs AssetManager::LoadAsync imports as JobSystem jobs.
+    // Requests are picked by priority, finished ones are committed in SyncMainThread
+    // with one command list, highest priority first, within a per-frame time budget.
+    class AssetLoader
+    {
+    public:
+        // runs on the main thread once the asset is ready, the returned asset is handed to the caller
+        using CompletionFunc = std::function<Ref<Asset>(const Ref<Asset> &asset)>;
+
+        // submit from the main thread, it is the thread allowed to finish requests
+        static AssetLoadHandle Submit(AssetHandle handle, Scope<AssetImportJob> job, AssetLoadPriority priority, const CompletionFunc &onComplete = nullptr);
+
+        // handle for an asset that is already loaded
+        static AssetLoadHandle MakeReady(AssetHandle handle, const Ref<Asset> &asset);
+
+        static void SyncMainThread(nvrhi::ICommandList *commandList, nvrhi::IDevice *device);
+        static void Shutdown();
+
+        static void SetFrameBudget(f64 milliseconds);
+        static f64 GetFrameBudget();
+
+        // requests that are not done yet
+        static u32 GetPendingCount();
+    };
+}
@@ -2,12 +2,22 @@
 #include "asset_importer.hpp"
 
 #include "ignite/core/logger.hpp"
+#include "ignite/core/vfs/async_reader.hpp"
+#include "ignite/project/project.hpp"
+
 #include <cstdint>
 
 namespace ignite {
 
     static AssetMetaData s_NullMetaData;
 
+    AssetManager::~AssetManager()
+    {
+        // completion callbacks point at this manager
+        for (auto &[handle, loadHandle] : m_PendingLoads)
+            loadHandle.Cancel();
+    }
+
     AssetHandle AssetManager::ImportAsset(const std::filesystem::path &filepath)
     {
         bool foundInAssetRegistry = false;
@@ -43,17 +53,14 @@ namespace ignite {
         // Find in registered asset first
         if (!foundInAssetRegistry)
         {
-            for (const auto &[assetHandle, assetMetaData] : m_AssetRegistry)
+            AssetHandle assetHandle = m_AssetRegistry.Find(metadata.filepath);
+            if (assetHandle != AssetHandle(0))
             {
-                if (metadata.filepath == assetMetaData.filepath)
-                {
-                    // found it
-                    handle = assetHandle;
-                    metadata = assetMetaData;
-
-                    foundInAssetRegistry = true;
-                    break;
-                }
+                // found it
+                handle = assetHandle;
+                metadata = *m_AssetRegistry.Find(assetHandle);
+
+                foundInAssetRegistry = true;
             }
         }
 
@@ -62,7 +69,7 @@ namespace ignite {
         {
             handle = AssetHandle();
             Import(handle, metadata);
-            m_AssetRegistry[handle] = metadata;
+            m_AssetRegistry.Insert(handle, metadata);
         }
         else
         {
@@ -70,7 +77,7 @@ namespace ignite {
             Ref<Asset> asset = GetAsset(handle);
             if (!asset)
             {
-                m_AssetRegistry[handle] = metadata;
+                m_AssetRegistry.Insert(handle, metadata);
                 m_LoadedAssets[handle] = asset;
             }
         }
@@ -81,14 +88,13 @@ namespace ignite {
 
     void AssetManager::InsertMetaData(AssetHandle handle, const AssetMetaData &metadata)
     {
-        m_AssetRegistry[handle] = metadata;
+        m_AssetRegistry.Insert(handle, metadata);
     }
 
     void AssetManager::RemoveAsset(AssetHandle handle)
     {
-        auto it = m_AssetRegistry.find(handle);
-        if (it != m_AssetRegistry.end())
-            m_AssetRegistry.erase(it);
+        m_AssetRegistry.Remove(handle);
+        m_Prefetched.erase(handle);
     }
 
     Ref<Asset> AssetManager::GetAsset(AssetHandle handle)
@@ -102,6 +108,116 @@ namespace ignite {
         return Import(handle, metadata);
     }
 
+    Ref<Asset> AssetManager::ReloadAsset(AssetHandle handle)
+    {
+        if (!IsAssetHandleValid(handle))
+            return nullptr;
+
+        if (auto it = m_PendingLoads.find(handle); it != m_PendingLoads.end())
+        {
+            it->second.Cancel();
+            m_PendingLoads.erase(it);
+        }
+
+        // read before the file changed
+        m_Prefetched.erase(handle);
+
+        m_LoadedAssets.erase(handle);
+        return GetAsset(handle);
+    }
+
+    AssetLoadHandle AssetManager::LoadAsync(AssetHandle handle, AssetLoadPriority priority)
+    {
+        if (!IsAssetHandleValid(handle))
+        {
+            LOG_ERROR("[Asset Manager] Invalid asset handle {}", static_cast<u64>(handle));
+            return AssetLoadHandle();
+        }
+
+        if (auto it = m_LoadedAssets.find(handle); it != m_LoadedAssets.end() && it->second)
+            return AssetLoader::MakeReady(handle, it->second);
+
+        if (auto it = m_PendingLoads.find(handle); it != m_PendingLoads.end())
+        {
+            AssetLoadHandle &pending = it->second;
+            if (!pending.IsDone())
+            {
+                if (pending.GetPriority() < priority)
+                    pending.SetPriority(priority);
+                return pending;
+            }
+
+            // failed or canceled, try again
+            m_PendingLoads.erase(it);
+        }
+
+        AssetLoadHandle loadHandle = AssetLoader::Submit(handle, AssetImporter::CreateImportJob(handle, GetMetaData(handle)), priority,
+            [this, handle](const Ref<Asset> &asset) -> Ref<Asset>
+            {
+                m_PendingLoads.erase(handle);
+
+                // a synchronous GetAsset may have finished first, keep that one
+                Ref<Asset> &loaded = m_LoadedAssets[handle];
+                if (!loaded)
+                    loaded = asset;
+                return loaded;
+            });
+
+        m_PendingLoads[handle] = loadHandle;
+        return loadHandle;
+    }
+
+    void AssetManager::Prefetch(const std::vector<AssetHandle> &handles)
+    {
+        Project *project = Project::GetActive();
+        if (!project)
+            return;
+
+        std::vector<AssetHandle> readHandles;
+        std::vector<vfs::AsyncRead> reads;
+        std::vector<std::filesystem::path> hints;
+
+        for (AssetHandle handle : handles)
+        {
+            // loaded assets do not touch their file again
+            if (!IsAssetHandleValid(handle) || m_LoadedAssets.contains(handle) || m_Prefetched.contains(handle))
+                continue;
+
+            std::filesystem::path filepath = project->GetAssetFilepath(GetFilepath(handle));
+
+            // FMOD decodes audio from memory, textures and scenes are mapped or read by their importers
+            if (GetAssetType(handle) == AssetType::Audio)
+            {
+                readHandles.push_back(handle);
+                reads.push_back({ std::move(filepath), nullptr });
+            }
+            else
+            {
+                hints.push_back(std::move(filepath));
+            }
+        }
+
+        vfs::AsyncReader::Prefetch(hints);
+
+        if (reads.empty())
+            return;
+
+        std::vector<vfs::ReadFuture> futures = vfs::AsyncReader::Submit(nullptr, std::move(reads));
+        for (size_t i = 0; i < readHandles.size(); ++i)
+            m_Prefetched.emplace(readHandles[i], std::move(futures[i]));
+    }
+
+    vfs::ReadFuture AssetManager::TakePrefetched(AssetHandle handle)
+    {
+        auto it = m_Prefetched.find(handle);
+        if (it == m_Prefetched.end())
+            return {};
+
+        vfs::ReadFuture future = std::move(it->second);
+        m_Prefetched.erase(it);
+        return future;
+    }
+
     AssetType AssetManager::GetAssetType(AssetHandle handle)
     {
         return GetMetaData(handle).type;
@@ -109,23 +225,21 @@ namespace ignite {
 
     const AssetMetaData &AssetManager::GetMetaData(const std::filesystem::path &filepath, AssetHandle &outHandle)
     {
-        for (const auto &[handle, metadata] : m_AssetRegistry)
+        AssetHandle handle = m_AssetRegistry.Find(filepath);
+        if (handle != AssetHandle(0))
         {
-            if (metadata.filepath == filepath)
-            {
-                // found it
-                outHandle = handle;
-                return metadata;
-            }
+            // found it
+            outHandle = handle;
+            return *m_AssetRegistry.Find(handle);
         }
         return s_NullMetaData;
     }
 
     const AssetMetaData &AssetManager::GetMetaData(AssetHandle handle) const
     {
-        if (m_AssetRegistry.contains(handle))
+        if (const AssetMetaData *metadata = m_AssetRegistry.Find(handle))
         {
-            return m_AssetRegistry.at(handle);
+            return *metadata;
         }
 
         return s_NullMetaData;
@@ -133,12 +247,7 @@ namespace ignite {
 
     AssetHandle AssetManager::GetAssetHandle(const std::filesystem::path& filepath)
     {
-        for (const auto &[handle, metadata] : m_AssetRegistry)
-        {
-            if (metadata.filepath == filepath)
-                return handle;
-        }
-        return AssetHandle(0);
+        return m_AssetRegistry.Find(filepath);
     }
 
     const std::filesystem::path &AssetManager::GetFilepath(AssetHandle handle)
@@ -148,7 +257,7 @@ namespace ignite {
 
     bool AssetManager::IsAssetHandleValid(AssetHandle handle)
     {
-        return (uint64_t)handle != 0 && m_AssetRegistry.contains(handle);
+        return (uint64_t)handle != 0 && m_AssetRegistry.Contains(handle);
     }
 
     Ref<Asset> AssetManager::Import(AssetHandle handle, const AssetMetaData &metadata)
@@ -1,22 +1,39 @@
 #pragma once
 
 #include "asset.hpp"
+#include "asset_loader.hpp"
+#include "asset_registry.hpp"
+#include "asset_dependency_graph.hpp"
 
-#include <map>
+#include "ignite/core/vfs/vfs.hpp"
 
 namespace ignite {
 
-    using AssetRegistry = std::map<AssetHandle, AssetMetaData>;
-
     class AssetManager
     {
     public:
         AssetManager() = default;
+        ~AssetManager();
 
         AssetHandle ImportAsset(const std::filesystem::path &filepath);
         void InsertMetaData(AssetHandle handle, const AssetMetaData &metadata);
         void RemoveAsset(AssetHandle handle);
         Ref<Asset> GetAsset(AssetHandle handle);
+
+        // drop the loaded instance and import again, holders of the old asset keep it alive
+        Ref<Asset> ReloadAsset(AssetHandle handle);
+
+        // decode and parse on the loader workers, GPU objects are created in AssetImporter::SyncMainThread.
+        // loading the same handle again returns the pending request, call from the main thread
+        AssetLoadHandle LoadAsync(AssetHandle handle, AssetLoadPriority priority = AssetLoadPriority::Normal);
+
+        // starts reading the files of not yet loaded assets in one batch. audio is read into memory and
+        // handed to its importer through TakePrefetched, files the importers map themselves only get the page cache warmed
+        void Prefetch(const std::vector<AssetHandle> &handles);
+
+        // the read Prefetch started for handle, an empty future when there is none. main thread
+        vfs::ReadFuture TakePrefetched(AssetHandle handle);
+
         AssetType GetAssetType(AssetHandle handle);
         const AssetMetaData &GetMetaData(const std::filesystem::path &filepath, AssetHandle &outHandle);
         const AssetMetaData &GetMetaData(AssetHandle handle) const;
@@ -25,13 +42,19 @@ namespace ignite {
         const std::filesystem::path &GetFilepath(AssetHandle handle);
         bool IsAssetHandleValid(AssetHandle handle);
     
-        AssetRegistry &GetAssetAssetRegistry() { return m_AssetRegistry; }
+        // read only, mutate through InsertMetaData and RemoveAsset to keep the path index valid
+        const AssetRegistry &GetAssetAssetRegistry() const { return m_AssetRegistry; }
+
+        AssetDependencyGraph &GetDependencyGraph() { return m_DependencyGraph; }
 
     private:
         Ref<Asset> Import(AssetHandle handle, const AssetMetaData &metadata);
 
         AssetRegistry m_AssetRegistry;
+        AssetDependencyGraph m_DependencyGraph;
         std::unordered_map<AssetHandle, Ref<Asset>> m_LoadedAssets;
+        std::unordered_map<AssetHandle, AssetLoadHandle> m_PendingLoads;
+        std::unordered_map<AssetHandle, vfs::ReadFuture> m_Prefetched;
     };
 
 }
\ No newline at end of file
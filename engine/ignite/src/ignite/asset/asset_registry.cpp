@@ -0,0 +1,110 @@
+#include "asset_registry.hpp"
+
+#include <algorithm>
+
+namespace ignite {
+
+    void AssetRegistry::Insert(AssetHandle handle, const AssetMetaData &metadata)
+    {
+        std::string pathKey = NormalizePath(metadata.filepath);
+
+        auto it = m_HandleIndex.find(handle);
+        if (it != m_HandleIndex.end())
+        {
+            Entry &entry = m_Entries[it->second];
+
+            // moved or renamed, drop the stale path key
+            std::string oldKey = NormalizePath(entry.second.filepath);
+            if (oldKey != pathKey)
+            {
+                auto pathIt = m_PathIndex.find(oldKey);
+                if (pathIt != m_PathIndex.end() && pathIt->second == handle)
+                    m_PathIndex.erase(pathIt);
+            }
+
+            entry.second = metadata;
+        }
+        else
+        {
+            m_HandleIndex[handle] = m_Entries.size();
+            m_Entries.emplace_back(handle, metadata);
+        }
+
+        if (!pathKey.empty())
+            m_PathIndex[pathKey] = handle;
+    }
+
+    bool AssetRegistry::Remove(AssetHandle handle)
+    {
+        auto it = m_HandleIndex.find(handle);
+        if (it == m_HandleIndex.end())
+            return false;
+
+        const size_t index = it->second;
+        m_HandleIndex.erase(it);
+
+        auto pathIt = m_PathIndex.find(NormalizePath(m_Entries[index].second.filepath));
+        if (pathIt != m_PathIndex.end() && pathIt->second == handle)
+            m_PathIndex.erase(pathIt);
+
+        // swap with the last entry to keep the table dense
+        if (index != m_Entries.size() - 1)
+        {
+            m_Entries[index] = std::move(m_Entries.back());
+            m_HandleIndex[m_Entries[index].first] = index;
+        }
+        m_Entries.pop_back();
+
+        return true;
+    }
+
+    void AssetRegistry::Clear()
+    {
+        m_Entries.clear();
+        m_HandleIndex.clear();
+        m_PathIndex.clear();
+    }
+
+    const AssetMetaData *AssetRegistry::Find(AssetHandle handle) const
+    {
+        auto it = m_HandleIndex.find(handle);
+        if (it == m_HandleIndex.end())
+            return nullptr;
+
+        return &m_Entries[it->second].second;
+    }
+
+    AssetHandle AssetRegistry::Find(const std::filesystem::path &filepath) const
+    {
+        auto it = m_PathIndex.find(NormalizePath(filepath));
+        if (it == m_PathIndex.end())
+            return AssetHandle(0);
+
+        return it->second;
+    }
+
+    std::vector<const AssetRegistry::Entry *> AssetRegistry::GetSortedEntries() const
+    {
+        std::vector<const Entry *> entries;
+        entries.reserve(m_Entries.size());
+
+        for (const Entry &entry : m_Entries)
+            entries.push_back(&entry);
+
+        std::sort(entries.begin(), entries.end(), [](const Entry *a, const Entry *b)
+        {
+            return static_cast<u64>(a->first) < static_cast<u64>(b->first);
+        });
+
+        return entries;
+    }
+
+    std::string AssetRegistry::NormalizePath(const std::filesystem::path &filepath)
+    {
+        std::string pathStr = filepath.generic_string();
+        std::replace(pathStr.begin(), pathStr.end(), '\\', '/');
+
+        return std::filesystem::path(pathStr).lexically_normal().generic_string();
+    }
+
+}
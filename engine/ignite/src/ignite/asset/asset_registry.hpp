@@ -0,0 +1,47 @@
+#pragma once
+
+#include "asset.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ignite {
+
+    // Flat handle -> metadata table with a normalized path -> handle index.
+    // Entries are stored contiguously, removal swaps the last entry into the hole,
+    // so iteration order is not stable across removals.
+    class AssetRegistry
+    {
+    public:
+        using Entry = std::pair<AssetHandle, AssetMetaData>;
+
+        // inserts or replaces, keeps the path index in sync
+        void Insert(AssetHandle handle, const AssetMetaData &metadata);
+        bool Remove(AssetHandle handle);
+        void Clear();
+
+        const AssetMetaData *Find(AssetHandle handle) const;
+        AssetHandle Find(const std::filesystem::path &filepath) const;
+        bool Contains(AssetHandle handle) const { return m_HandleIndex.contains(handle); }
+
+        size_t Size() const { return m_Entries.size(); }
+        bool Empty() const { return m_Entries.empty(); }
+
+        // entries sorted by handle, for deterministic serialization
+        std::vector<const Entry *> GetSortedEntries() const;
+
+        std::vector<Entry>::const_iterator begin() const { return m_Entries.begin(); }
+        std::vector<Entry>::const_iterator end() const { return m_Entries.end(); }
+
+        // "./Textures\\a.png" and "Textures/a.png" map to the same key
+        static std::string NormalizePath(const std::filesystem::path &filepath);
+
+    private:
+        std::vector<Entry> m_Entries;
+        std::unordered_map<AssetHandle, size_t> m_HandleIndex;
+        std::unordered_map<std::string, AssetHandle> m_PathIndex;
+    };
+
+}
@@ -0,0 +1,189 @@
+#include "asset_watcher.hpp"
+#include "asset_importer.hpp"
+#include "asset_manager.hpp"
+
+#include "ignite/core/logger.hpp"
+#include "ignite/graphics/texture_cache.hpp"
+#include "ignite/project/project.hpp"
+
+#include "FileWatch.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ignite {
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+        using Watcher = filewatch::FileWatch<std::string>;
+
+        struct AssetWatcherData
+        {
+            std::vector<Scope<Watcher>> watchers;
+            std::filesystem::path assetDirectory;
+
+            // full path -> last event, written by the watcher threads
+            std::mutex mutex;
+            std::unordered_map<std::string, Clock::time_point> changed;
+        };
+
+        AssetWatcherData &GetData()
+        {
+            static AssetWatcherData data;
+            return data;
+        }
+
+        void Watch(const std::filesystem::path &directory)
+        {
+            AssetWatcherData &data = GetData();
+
+            try
+            {
+                data.watchers.push_back(CreateScope<Watcher>(directory.string(), [directory](const std::string &path, const filewatch::Event event)
+                {
+                    if (event == filewatch::Event::removed || event == filewatch::Event::renamed_old)
+                        return;
+
+                    AssetWatcherData &data = GetData();
+                    std::lock_guard lock(data.mutex);
+                    data.changed[(directory / path).generic_string()] = Clock::now();
+                }));
+            }
+            catch (const std::exception &e)
+            {
+                LOG_WARN("[Asset Watcher] Can not watch {}: {}", directory.generic_string(), e.what());
+            }
+        }
+
+        void Reimport(const std::filesystem::path &filepath)
+        {
+            Project *project = Project::GetActive();
+            AssetManager &assetManager = project->GetAssetManager();
+            AssetDependencyGraph &graph = assetManager.GetDependencyGraph();
+
+            const std::filesystem::path relativePath = project->GetAssetRelativeFilepath(filepath);
+
+            // touched but identical, e.g. saved without changes
+            if (graph.Contains(relativePath) && !graph.IsStale(relativePath))
+                return;
+
+            switch (GetAssetTypeFromExtension(filepath.extension().generic_string()))
+            {
+            case AssetType::Texture:
+            {
+                TextureCache::Reload(filepath);
+                break;
+            }
+            case AssetType::TextureCube:
+            {
+                EnvironmentImporter::Reload(filepath);
+                break;
+            }
+            case AssetType::Audio:
+            {
+                const AssetHandle handle = assetManager.GetAssetHandle(relativePath);
+                if (handle != AssetHandle(0) && assetManager.ReloadAsset(handle))
+                    LOG_INFO("[Asset Watcher] Reloaded {}", relativePath.generic_string());
+                break;
+            }
+            case AssetType::MeshSource:
+            {
+                // mesh data is not part of the scene file, the scene has to be reopened
+                for (const std::string &dependent : graph.GetDependents(relativePath))
+                    LOG_WARN("[Asset Watcher] {} changed, reopen {} to re-import it", relativePath.generic_string(), dependent);
+                break;
+            }
+            default:
+                return;
+            }
+
+            graph.Stamp(relativePath);
+        }
+    }
+
+    void AssetWatcher::Start(const std::filesystem::path &assetDirectory)
+    {
+        Stop();
+
+        std::error_code ec;
+        if (!std::filesystem::is_directory(assetDirectory, ec))
+            return;
+
+        AssetWatcherData &data = GetData();
+        data.assetDirectory = assetDirectory;
+
+#ifdef PLATFORM_WINDOWS
+        // ReadDirectoryChangesW reports the whole tree
+        Watch(assetDirectory);
+#else
+        // inotify watches a single directory, directories created later are not watched
+        Watch(assetDirectory);
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(assetDirectory, std::filesystem::directory_options::skip_permission_denied, ec))
+        {
+            if (entry.is_directory(ec))
+                Watch(entry.path());
+        }
+#endif
+
+        LOG_INFO("[Asset Watcher] Watching {} ({} watchers)", assetDirectory.generic_string(), data.watchers.size());
+    }
+
+    void AssetWatcher::Stop()
+    {
+        AssetWatcherData &data = GetData();
+
+        // joins the watcher threads, no callback runs after this
+        data.watchers.clear();
+
+        std::lock_guard lock(data.mutex);
+        data.changed.clear();
+    }
+
+    void AssetWatcher::SyncMainThread()
+    {
+        AssetWatcherData &data = GetData();
+        if (data.watchers.empty() || !Project::GetActive())
+            return;
+
+        std::vector<std::filesystem::path> settled;
+        {
+            std::lock_guard lock(data.mutex);
+
+            const Clock::time_point now = Clock::now();
+            for (auto it = data.changed.begin(); it != data.changed.end(); )
+            {
+                if (now - it->second < std::chrono::milliseconds(ASSET_WATCHER_SETTLE_MS))
+                {
+                    ++it;
+                    continue;
+                }
+
+                settled.emplace_back(it->first);
+                it = data.changed.erase(it);
+            }
+        }
+
+        if (settled.empty())
+            return;
+
+        for (const std::filesystem::path &filepath : settled)
+        {
+            std::error_code ec;
+            if (std::filesystem::is_regular_file(filepath, ec))
+                Reimport(filepath);
+        }
+
+        Project *project = Project::GetActive();
+        AssetDependencyGraph &graph = project->GetAssetManager().GetDependencyGraph();
+        if (graph.IsDirty())
+            graph.Save(project->GetCacheDirectory() / ASSET_DEPENDENCY_GRAPH_FILENAME);
+    }
+
+    bool AssetWatcher::IsRunning()
+    {
+        return !GetData().watchers.empty();
+    }
+}
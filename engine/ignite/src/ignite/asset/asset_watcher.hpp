@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+
+#include <filesystem>
+
+namespace ignite {
+
+// changes are collected until the file was quiet this long, editors write in several steps
+#define ASSET_WATCHER_SETTLE_MS 250
+
+    // Watches the project asset directory and re-imports files whose content changed.
+    // Textures and environment maps are swapped in place, audio is imported again,
+    // for models the scenes that depend on them are reported.
+    class AssetWatcher
+    {
+    public:
+        static void Start(const std::filesystem::path &assetDirectory);
+        static void Stop();
+
+        // re-import files that settled, main thread only
+        static void SyncMainThread();
+
+        static bool IsRunning();
+    };
+}
@@ -183,9 +183,19 @@ FMOD::ChannelGroup* FmodSound::GetChannelGroup() const
 }
 
 Ref<FmodSound> FmodSound::Create(const std::string &name, const std::string &filepath, const FMOD_MODE mode)
+{
+    FMOD::Sound *sound = nullptr;
+    FmodAudio::GetFmodSystem()->createSound(filepath.c_str(), mode, nullptr, &sound);
+
+    LOG_WARN("[FMOD Sound] Load sound '{}'", filepath);
+
+    return Create(name, sound);
+}
+
+Ref<FmodSound> FmodSound::Create(const std::string &name, FMOD::Sound *sound)
 {
     Ref<FmodSound> fmod_sound = CreateRef<FmodSound>(name);
-    FmodAudio::GetFmodSystem()->createSound(filepath.c_str(), mode, nullptr, &fmod_sound->m_Sound);
+    fmod_sound->m_Sound = sound;
     
     const FMOD_RESULT result = FmodAudio::GetFmodSystem()->playSound(
             fmod_sound->m_Sound,
@@ -195,8 +205,6 @@ Ref<FmodSound> FmodSound::Create(const std::string &name, const std::string &fil
         );
     
     FMOD_CHECK(result);
-
-    LOG_WARN("[FMOD Sound] Load sound '{}'", filepath);
     
     FmodAudio::InsertFmodSound(name, fmod_sound);
     return fmod_sound;
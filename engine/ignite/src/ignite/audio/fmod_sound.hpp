@@ -47,6 +47,9 @@ namespace ignite {
 
         static Ref<FmodSound> Create(const std::string &name, const std::string &filepath, FMOD_MODE mode = FMOD_DEFAULT | FMOD_LOOP_OFF);
         static Ref<FmodSound> CreateStream(const std::string &name, const std::string &filepath, FMOD_MODE mode = FMOD_DEFAULT | FMOD_LOOP_OFF);
+
+        // takes ownership of a sound created elsewhere, createSound is thread safe so loaders decode off the main thread
+        static Ref<FmodSound> Create(const std::string &name, FMOD::Sound *sound);
     
         static AssetType GetStaticType() { return AssetType::Audio; }
         AssetType GetType() override { return GetStaticType(); }
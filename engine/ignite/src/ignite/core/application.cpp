@@ -4,8 +4,15 @@
 #include "input/app_event.hpp"
 #include "ignite/imgui/imgui_layer.hpp"
 #include "ignite/graphics/renderer.hpp"
+#include "ignite/graphics/gpu_profiler.hpp"
 #include "ignite/audio/fmod_audio.hpp"
 #include "ignite/physics/jolt/jolt_physics.hpp"
+#include "ignite/asset/asset_loader.hpp"
+#include "ignite/asset/asset_watcher.hpp"
+#include "ignite/core/vfs/async_reader.hpp"
+#include "ignite/core/job_system.hpp"
+#include "ignite/core/memory.hpp"
+#include "ignite/core/profiler.hpp"
 
 #include <nvrhi/utils.h>
 
@@ -18,6 +25,12 @@ namespace ignite
     {
         s_JoltInstance = this;
 
+        IGN_PROFILE_THREAD("Main");
+
+        // before anything that may queue jobs, the constructing thread becomes the main thread
+        JobSystem::Init();
+        FrameAllocator::Init();
+
         if (m_CreateInfo.cmdLineArgs.count > 1)
         {
             for (i32 i = 0; i < m_CreateInfo.cmdLineArgs.count; ++i)
@@ -46,6 +59,7 @@ namespace ignite
         m_Input = Input(m_Window->GetWindowHandle());
 
         m_Renderer = CreateRef<Renderer>(m_Window->GetDeviceManager(), m_CreateInfo.graphicsApi);
+        GPUProfiler::Init(m_Window->GetDeviceManager());
 
         if (createInfo.useGui)
         {
@@ -88,18 +102,10 @@ namespace ignite
 
     void Application::ProcessMainThreadSubmissons()
     {
-        while (!m_ThreadFuncs.empty())
-        {
-            auto func = m_ThreadFuncs.front();
-            if (func())
-            {
-                m_ThreadFuncs.pop();
-            }
-            else
-            {
-                break;
-            }
-        }
+        IGN_PROFILE_FUNCTION();
+
+        JobSystem::ProcessMainThreadJobs();
+        m_MainThreadQueue.Process(m_MainThreadBudget);
     }
 
     void Application::PushLayer(Layer *layer)
@@ -120,6 +126,10 @@ namespace ignite
 
         while (m_Window->IsLooping())
         {
+            IGN_PROFILE_FRAME();
+            FrameAllocator::BeginFrame();
+            GPUProfiler::BeginFrame();
+
             m_Window->PollEvents();
 
             const f64 currTime = glfwGetTime();
@@ -156,8 +166,11 @@ namespace ignite
             if (m_Window->IsVisible() && m_Window->IsInFocus())
             {
                 // update system (physics etc..)
-                for (auto layer = m_LayerStack.rbegin(); layer != m_LayerStack.rend(); ++layer)
-                    (*layer)->OnUpdate(static_cast<f32>(m_DeltaTime));
+                {
+                    IGN_PROFILE_SCOPE("Layers Update");
+                    for (auto layer = m_LayerStack.rbegin(); layer != m_LayerStack.rend(); ++layer)
+                        (*layer)->OnUpdate(static_cast<f32>(m_DeltaTime));
+                }
 
                 // render to main framebuffer
                 // begin render frame
@@ -170,17 +183,22 @@ namespace ignite
                         for (auto it = m_LayerStack.rbegin(); it != m_LayerStack.rend(); ++it)
                         {
                             Layer *layer = *it;
-                            layer->OnRender(framebuffer);
+                            {
+                                IGN_PROFILE_SCOPE("Layer Render");
+                                layer->OnRender(framebuffer);
+                            }
 
                             // ImGui rendering
                             if (m_CreateInfo.useGui)
                             {
+                                IGN_PROFILE_SCOPE("ImGui");
                                 m_ImGuiLayer->BeginFrame();
                                 layer->OnGuiRender();
                                 m_ImGuiLayer->EndFrame(framebuffer);
                             }
                         }
 
+                        IGN_PROFILE_SCOPE("Present");
                         if (!deviceManager->Present())
                             continue;
                     }
@@ -210,7 +228,17 @@ namespace ignite
             delete *it;
         }
 
+        // loader workers may still hold decoded data and GPU handles
+        AssetLoader::Shutdown();
+        AssetWatcher::Stop();
+        vfs::AsyncReader::Shutdown();
+
+        // queued jobs finish while the device still exists
+        JobSystem::Shutdown();
+        FrameAllocator::Shutdown();
+
         // destroy renderer first
+        GPUProfiler::Shutdown();
         m_Renderer.reset();
 
         // destroy device
@@ -247,9 +275,19 @@ namespace ignite
         GetInstance()->m_Window->Restore();
     }
 
-    void Application::SubmitToMainThread(const std::function<bool()> func)
+    void Application::SubmitToMainThread(MainThreadFunc func, MainThreadPriority priority)
+    {
+        GetInstance()->m_MainThreadQueue.Push(std::move(func), priority);
+    }
+
+    void Application::SetMainThreadBudget(f64 milliseconds)
+    {
+        GetInstance()->m_MainThreadBudget = milliseconds;
+    }
+
+    f64 Application::GetMainThreadBudget()
     {
-        GetInstance()->m_ThreadFuncs.push(func);
+        return GetInstance()->m_MainThreadBudget;
     }
 
     CommandManager *Application::GetCommandManager()
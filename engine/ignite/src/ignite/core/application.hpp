@@ -11,8 +11,8 @@
 #include "input/app_event.hpp"
 #include "input/input.hpp"
 #include "command.hpp"
+#include "main_thread_queue.hpp"
 
-#include <queue>
 #include <filesystem>
 
 namespace ignite
@@ -75,7 +75,14 @@ namespace ignite
         static void WindowIconify();
         static void WindowMaximize();
         static void WindowRestore();
-        static void SubmitToMainThread(const std::function<bool()> func);
+
+        // any thread, func runs on the main thread before the layers update and is
+        // called again next frame while it returns false
+        static void SubmitToMainThread(MainThreadFunc func, MainThreadPriority priority = MainThreadPriority::Normal);
+
+        // time the submitted functions may take per frame
+        static void SetMainThreadBudget(f64 milliseconds);
+        static f64 GetMainThreadBudget();
 
     private:
         void UpdateAverageTimeTime(f64 elapsedTime);
@@ -99,7 +106,8 @@ namespace ignite
         i32 m_NumberOfAccumulatedFrames = 0;
         i32 m_FrameIndex = 0;
 
-        std::queue<std::function<bool()>> m_ThreadFuncs;
+        MainThreadQueue m_MainThreadQueue;
+        f64 m_MainThreadBudget = MAIN_THREAD_QUEUE_FRAME_BUDGET_MS;
     };
 
     Application *CreateApplication(ApplicationCommandLineArgs args);
@@ -0,0 +1,550 @@
+#include "compression.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace ignite
+{
+    namespace
+    {
+        constexpr u32 kMaxBits = 15;
+        constexpr u32 kMaxLengthCodes = 286;
+        constexpr u32 kMaxDistanceCodes = 30;
+        constexpr u32 kFixedLengthCodes = 288;
+
+        constexpr u16 kLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        constexpr u16 kLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        constexpr u16 kDistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        constexpr u16 kDistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+        constexpr u32 kLZ4MinMatch = 4;
+        constexpr u64 kLZ4LastLiterals = 5; // the block ends with at least this many literals
+        constexpr u64 kLZ4MatchFindLimit = 12; // no match may start closer to the end
+        constexpr u64 kLZ4MaxOffset = 65535;
+        constexpr u64 kLZ4MaxInputSize = 0x7E000000;
+        constexpr u32 kLZ4HashLog = 16;
+
+        // canonical huffman table, symbols ordered by code length
+        struct Huffman
+        {
+            u16 count[kMaxBits + 1];
+            u16 symbol[kFixedLengthCodes];
+        };
+
+        struct InflateState
+        {
+            const u8 *src;
+            u64 srcSize;
+            u64 srcPos = 0;
+
+            u8 *dst;
+            u64 dstSize;
+            u64 dstPos = 0;
+
+            u32 bitBuffer = 0;
+            u32 bitCount = 0;
+            bool error = false;
+
+            u32 Bits(u32 need)
+            {
+                u32 value = bitBuffer;
+                while (bitCount < need)
+                {
+                    if (srcPos >= srcSize)
+                    {
+                        error = true;
+                        return 0;
+                    }
+                    value |= static_cast<u32>(src[srcPos++]) << bitCount;
+                    bitCount += 8;
+                }
+
+                bitBuffer = need < 32 ? value >> need : 0;
+                bitCount -= need;
+                return need < 32 ? value & ((1u << need) - 1) : value;
+            }
+
+            i32 Decode(const Huffman &huffman)
+            {
+                i32 code = 0, first = 0, index = 0;
+                for (u32 length = 1; length <= kMaxBits; ++length)
+                {
+                    code |= static_cast<i32>(Bits(1));
+                    if (error)
+                        return -1;
+
+                    const i32 count = huffman.count[length];
+                    if (code - count < first)
+                        return huffman.symbol[index + (code - first)];
+
+                    index += count;
+                    first += count;
+                    first <<= 1;
+                    code <<= 1;
+                }
+                return -1;
+            }
+        };
+
+        // returns false for over-subscribed code lengths, incomplete codes are allowed
+        bool Construct(Huffman &huffman, const u16 *lengths, u32 count)
+        {
+            std::memset(huffman.count, 0, sizeof(huffman.count));
+            for (u32 symbol = 0; symbol < count; ++symbol)
+                huffman.count[lengths[symbol]]++;
+
+            if (huffman.count[0] == count)
+                return true;
+
+            i32 left = 1;
+            for (u32 length = 1; length <= kMaxBits; ++length)
+            {
+                left <<= 1;
+                left -= huffman.count[length];
+                if (left < 0)
+                    return false;
+            }
+
+            u16 offsets[kMaxBits + 1];
+            offsets[1] = 0;
+            for (u32 length = 1; length < kMaxBits; ++length)
+                offsets[length + 1] = offsets[length] + huffman.count[length];
+
+            for (u32 symbol = 0; symbol < count; ++symbol)
+            {
+                if (lengths[symbol] != 0)
+                    huffman.symbol[offsets[lengths[symbol]]++] = static_cast<u16>(symbol);
+            }
+
+            return true;
+        }
+
+        bool Stored(InflateState &state)
+        {
+            // stored blocks start on a byte boundary
+            state.bitBuffer = 0;
+            state.bitCount = 0;
+
+            if (state.srcPos + 4 > state.srcSize)
+                return false;
+
+            const u32 length = state.src[state.srcPos] | (state.src[state.srcPos + 1] << 8);
+            const u32 inverse = state.src[state.srcPos + 2] | (state.src[state.srcPos + 3] << 8);
+            state.srcPos += 4;
+
+            if (length != (~inverse & 0xffff))
+                return false;
+
+            if (state.srcPos + length > state.srcSize || state.dstPos + length > state.dstSize)
+                return false;
+
+            // empty stored blocks are valid, dst may still be null
+            if (length)
+                std::memcpy(state.dst + state.dstPos, state.src + state.srcPos, length);
+            state.srcPos += length;
+            state.dstPos += length;
+            return true;
+        }
+
+        bool Codes(InflateState &state, const Huffman &lengthCode, const Huffman &distanceCode)
+        {
+            for (;;)
+            {
+                i32 symbol = state.Decode(lengthCode);
+                if (symbol < 0)
+                    return false;
+
+                if (symbol < 256)
+                {
+                    if (state.dstPos >= state.dstSize)
+                        return false;
+                    state.dst[state.dstPos++] = static_cast<u8>(symbol);
+                    continue;
+                }
+
+                if (symbol == 256)
+                    return true;
+
+                symbol -= 257;
+                if (symbol >= 29)
+                    return false;
+
+                const u32 length = kLengthBase[symbol] + state.Bits(kLengthExtra[symbol]);
+
+                symbol = state.Decode(distanceCode);
+                if (symbol < 0 || symbol >= 30)
+                    return false;
+
+                const u32 distance = kDistanceBase[symbol] + state.Bits(kDistanceExtra[symbol]);
+                if (state.error || distance > state.dstPos || state.dstPos + length > state.dstSize)
+                    return false;
+
+                // overlapping copies repeat the pattern, copy byte by byte
+                u8 *out = state.dst + state.dstPos;
+                const u8 *from = out - distance;
+                for (u32 i = 0; i < length; ++i)
+                    out[i] = from[i];
+
+                state.dstPos += length;
+            }
+        }
+
+        bool Fixed(InflateState &state)
+        {
+            static Huffman lengthCode, distanceCode;
+            static const bool built = []()
+            {
+                u16 lengths[kFixedLengthCodes];
+                u32 symbol = 0;
+                for (; symbol < 144; ++symbol) lengths[symbol] = 8;
+                for (; symbol < 256; ++symbol) lengths[symbol] = 9;
+                for (; symbol < 280; ++symbol) lengths[symbol] = 7;
+                for (; symbol < kFixedLengthCodes; ++symbol) lengths[symbol] = 8;
+                Construct(lengthCode, lengths, kFixedLengthCodes);
+
+                for (symbol = 0; symbol < kMaxDistanceCodes; ++symbol)
+                    lengths[symbol] = 5;
+                Construct(distanceCode, lengths, kMaxDistanceCodes);
+                return true;
+            }();
+            (void)built;
+
+            return Codes(state, lengthCode, distanceCode);
+        }
+
+        bool Dynamic(InflateState &state)
+        {
+            constexpr u8 kOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+            const u32 lengthCount = state.Bits(5) + 257;
+            const u32 distanceCount = state.Bits(5) + 1;
+            const u32 codeCount = state.Bits(4) + 4;
+            if (state.error || lengthCount > kMaxLengthCodes || distanceCount > kMaxDistanceCodes)
+                return false;
+
+            u16 lengths[kMaxLengthCodes + kMaxDistanceCodes] = {};
+            for (u32 i = 0; i < codeCount; ++i)
+                lengths[kOrder[i]] = static_cast<u16>(state.Bits(3));
+
+            Huffman lengthCode, distanceCode;
+            if (state.error || !Construct(lengthCode, lengths, 19))
+                return false;
+
+            u32 index = 0;
+            while (index < lengthCount + distanceCount)
+            {
+                const i32 symbol = state.Decode(lengthCode);
+                if (symbol < 0)
+                    return false;
+
+                if (symbol < 16)
+                {
+                    lengths[index++] = static_cast<u16>(symbol);
+                    continue;
+                }
+
+                u16 value = 0;
+                u32 repeat = 0;
+                if (symbol == 16)
+                {
+                    if (index == 0)
+                        return false;
+                    value = lengths[index - 1];
+                    repeat = 3 + state.Bits(2);
+                }
+                else if (symbol == 17)
+                {
+                    repeat = 3 + state.Bits(3);
+                }
+                else
+                {
+                    repeat = 11 + state.Bits(7);
+                }
+
+                if (state.error || index + repeat > lengthCount + distanceCount)
+                    return false;
+
+                while (repeat--)
+                    lengths[index++] = value;
+            }
+
+            // the end of block code must be present
+            if (lengths[256] == 0)
+                return false;
+
+            if (!Construct(lengthCode, lengths, lengthCount) || !Construct(distanceCode, lengths + lengthCount, distanceCount))
+                return false;
+
+            return Codes(state, lengthCode, distanceCode);
+        }
+
+        u32 Read32(const u8 *ptr)
+        {
+            u32 value;
+            std::memcpy(&value, ptr, sizeof(u32));
+            return value;
+        }
+
+        u32 HashLZ4(u32 sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - kLZ4HashLog);
+        }
+
+        // 15 in the token nibble, the rest as a run of 255 terminated by a smaller byte
+        u8 *WriteLZ4Length(u8 *op, u64 length)
+        {
+            for (length -= 15; length >= 255; length -= 255)
+                *op++ = 255;
+            *op++ = static_cast<u8>(length);
+            return op;
+        }
+
+        // false when dst can not hold the sequence
+        bool WriteLZ4Sequence(u8 *&op, const u8 *oend, const u8 *literals, u64 literalLength, u64 offset, u64 matchLength)
+        {
+            const u64 worstCase = 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1;
+            if (static_cast<u64>(oend - op) < worstCase)
+                return false;
+
+            u8 *token = op++;
+            *token = static_cast<u8>((literalLength >= 15 ? 15 : literalLength) << 4);
+            if (literalLength >= 15)
+                op = WriteLZ4Length(op, literalLength);
+
+            // a sequence may start right at a match, literals is null for an empty input
+            if (literalLength)
+                std::memcpy(op, literals, literalLength);
+            op += literalLength;
+
+            // the last sequence carries literals only
+            if (matchLength == 0)
+                return true;
+
+            *op++ = static_cast<u8>(offset & 0xff);
+            *op++ = static_cast<u8>(offset >> 8);
+
+            const u64 length = matchLength - kLZ4MinMatch;
+            *token |= static_cast<u8>(length >= 15 ? 15 : length);
+            if (length >= 15)
+                op = WriteLZ4Length(op, length);
+
+            return true;
+        }
+
+        bool ReadLZ4Length(const u8 *src, u64 srcSize, u64 &ip, u64 &length)
+        {
+            u8 byte;
+            do
+            {
+                if (ip >= srcSize)
+                    return false;
+                byte = src[ip++];
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+    }
+
+    bool Compression::Inflate(const u8 *src, u64 srcSize, u8 *dst, u64 dstSize, u64 *written)
+    {
+        InflateState state{ src, srcSize, 0, dst, dstSize };
+
+        bool last = false;
+        while (!last)
+        {
+            last = state.Bits(1) != 0;
+            const u32 type = state.Bits(2);
+            if (state.error)
+                return false;
+
+            bool ok = false;
+            switch (type)
+            {
+            case 0: ok = Stored(state); break;
+            case 1: ok = Fixed(state); break;
+            case 2: ok = Dynamic(state); break;
+            default: break;
+            }
+
+            if (!ok || state.error)
+                return false;
+        }
+
+        if (written)
+            *written = state.dstPos;
+
+        return true;
+    }
+
+    bool Compression::InflateZlib(const u8 *src, u64 srcSize, u8 *dst, u64 dstSize)
+    {
+        if (srcSize < 6)
+            return false;
+
+        const u32 cmf = src[0];
+        const u32 flags = src[1];
+
+        // deflate only, preset dictionaries are not supported
+        if ((cmf & 0x0f) != 8 || ((cmf << 8) | flags) % 31 != 0 || (flags & 0x20))
+            return false;
+
+        u64 written = 0;
+        if (!Inflate(src + 2, srcSize - 6, dst, dstSize, &written) || written != dstSize)
+            return false;
+
+        const u8 *trailer = src + srcSize - 4;
+        const u32 expected = (static_cast<u32>(trailer[0]) << 24) | (static_cast<u32>(trailer[1]) << 16) | (static_cast<u32>(trailer[2]) << 8) | trailer[3];
+        return Adler32(dst, dstSize) == expected;
+    }
+
+    u32 Compression::Adler32(const u8 *data, u64 size, u32 adler)
+    {
+        constexpr u32 kModulo = 65521;
+        constexpr u64 kBlock = 5552; // largest block that can not overflow 32 bits
+
+        u32 a = adler & 0xffff;
+        u32 b = adler >> 16;
+
+        while (size > 0)
+        {
+            const u64 block = size < kBlock ? size : kBlock;
+            for (u64 i = 0; i < block; ++i)
+            {
+                a += data[i];
+                b += a;
+            }
+
+            a %= kModulo;
+            b %= kModulo;
+            data += block;
+            size -= block;
+        }
+
+        return (b << 16) | a;
+    }
+
+    u64 Compression::LZ4CompressBound(u64 srcSize)
+    {
+        return srcSize + srcSize / 255 + 16;
+    }
+
+    u64 Compression::CompressLZ4(const u8 *src, u64 srcSize, u8 *dst, u64 dstCapacity)
+    {
+        if (srcSize > kLZ4MaxInputSize)
+            return 0;
+
+        u8 *op = dst;
+        const u8 *oend = dst + dstCapacity;
+
+        u64 anchor = 0;
+        u64 ip = 0;
+
+        if (srcSize > kLZ4MatchFindLimit)
+        {
+            // position + 1 of the last occurrence of each hashed 4 byte sequence, 0 is empty
+            std::vector<u32> table(1u << kLZ4HashLog, 0);
+            const u64 matchLimit = srcSize - kLZ4LastLiterals;
+
+            while (ip + kLZ4MatchFindLimit < srcSize)
+            {
+                const u32 sequence = Read32(src + ip);
+                u32 &slot = table[HashLZ4(sequence)];
+                const u64 candidate = slot;
+                slot = static_cast<u32>(ip + 1);
+
+                if (candidate == 0 || ip - (candidate - 1) > kLZ4MaxOffset || Read32(src + candidate - 1) != sequence)
+                {
+                    ++ip;
+                    continue;
+                }
+
+                u64 match = candidate - 1;
+
+                // grow backwards into pending literals
+                while (ip > anchor && match > 0 && src[ip - 1] == src[match - 1])
+                {
+                    --ip;
+                    --match;
+                }
+
+                u64 length = kLZ4MinMatch;
+                while (ip + length < matchLimit && src[ip + length] == src[match + length])
+                    ++length;
+
+                if (!WriteLZ4Sequence(op, oend, src + anchor, ip - anchor, ip - match, length))
+                    return 0;
+
+                ip += length;
+                anchor = ip;
+
+                if (ip + kLZ4MatchFindLimit < srcSize)
+                    table[HashLZ4(Read32(src + ip - 2))] = static_cast<u32>(ip - 1);
+            }
+        }
+
+        if (!WriteLZ4Sequence(op, oend, src + anchor, srcSize - anchor, 0, 0))
+            return 0;
+
+        return static_cast<u64>(op - dst);
+    }
+
+    bool Compression::DecompressLZ4(const u8 *src, u64 srcSize, u8 *dst, u64 dstSize)
+    {
+        u64 ip = 0;
+        u64 op = 0;
+
+        while (ip < srcSize)
+        {
+            const u8 token = src[ip++];
+
+            u64 literalLength = token >> 4;
+            if (literalLength == 15 && !ReadLZ4Length(src, srcSize, ip, literalLength))
+                return false;
+
+            if (literalLength > srcSize - ip || literalLength > dstSize - op)
+                return false;
+
+            if (literalLength)
+                std::memcpy(dst + op, src + ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+
+            if (ip == srcSize)
+                break;
+
+            if (srcSize - ip < 2)
+                return false;
+
+            const u64 offset = static_cast<u64>(src[ip]) | (static_cast<u64>(src[ip + 1]) << 8);
+            ip += 2;
+
+            if (offset == 0 || offset > op)
+                return false;
+
+            u64 matchLength = token & 0x0f;
+            if (matchLength == 15 && !ReadLZ4Length(src, srcSize, ip, matchLength))
+                return false;
+            matchLength += kLZ4MinMatch;
+
+            if (matchLength > dstSize - op)
+                return false;
+
+            // overlapping copies repeat the pattern, byte by byte
+            u8 *out = dst + op;
+            const u8 *from = out - offset;
+            if (offset >= matchLength)
+            {
+                std::memcpy(out, from, matchLength);
+            }
+            else
+            {
+                for (u64 i = 0; i < matchLength; ++i)
+                    out[i] = from[i];
+            }
+
+            op += matchLength;
+        }
+
+        return op == dstSize;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace ignite
+{
+    // Small codecs for compressed payloads inside asset containers and packs.
+    // Decoder outputs have a known size, nothing is allocated while decoding.
+    class Compression
+    {
+    public:
+        // raw deflate stream (RFC 1951), written receives the decoded size
+        static bool Inflate(const u8 *src, u64 srcSize, u8 *dst, u64 dstSize, u64 *written = nullptr);
+
+        // zlib stream (RFC 1950), checks the adler32 trailer
+        static bool InflateZlib(const u8 *src, u64 srcSize, u8 *dst, u64 dstSize);
+
+        static u32 Adler32(const u8 *data, u64 size, u32 adler = 1);
+
+        // LZ4 block format, compatible with LZ4_decompress_safe
+        static u64 LZ4CompressBound(u64 srcSize);
+
+        // greedy single pass encoder, returns the compressed size or 0 when dst is too small
+        static u64 CompressLZ4(const u8 *src, u64 srcSize, u8 *dst, u64 dstCapacity);
+        static bool DecompressLZ4(const u8 *src, u64 srcSize, u8 *dst, u64 dstSize);
+    };
+}
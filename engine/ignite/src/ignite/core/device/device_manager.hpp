@@ -142,6 +142,9 @@ namespace ignite
         [[nodiscard]] virtual const char *GetRendererString() const = 0;
         [[nodiscard]] virtual nvrhi::GraphicsAPI GetGraphicsAPI() const = 0;
 
+        // timestamps can be written on the graphics queue, required by timer queries
+        [[nodiscard]] virtual bool IsTimerQuerySupported() const { return true; }
+
         const DeviceCreationParameters &GetDeviceParams();
         [[nodiscard]] double GetAverageFrameTimeSeconds() const { return m_AverageFrameTime; }
         [[nodiscard]] double GetPreviousFrameTimestamp() const { return m_PreviousFrameTimestamp; }
@@ -1095,6 +1095,11 @@ namespace ignite
         // remember the bufferDeviceAddress feature enable
         m_BufferDeviceAddressSupported = vulkan12features.bufferDeviceAddress;
 
+        // software rasterizers report this too, some mobile and older drivers do not
+        const vk::PhysicalDeviceLimits limits = m_VulkanPhysicalDevice.getProperties().limits;
+        const u32 timestampBits = m_VulkanPhysicalDevice.getQueueFamilyProperties()[m_GraphicsQueueFamily].timestampValidBits;
+        m_TimerQuerySupported = limits.timestampComputeAndGraphics && limits.timestampPeriod > 0.0f && timestampBits > 0;
+
         LOG_INFO("Created Vulkan device: {}", m_RendererString.c_str());
 
         return true;
@@ -54,6 +54,7 @@ namespace ignite
         bool Present() override;
 
         const char *GetRendererString() const override;
+        [[nodiscard]] bool IsTimerQuerySupported() const override { return m_TimerQuerySupported; }
         bool IsVulkanInstanceExtensionEnabled(const char *extensionName) const override;
         bool IsVulkanDeviceExtensionEnabled(const char *extensionName) const override;
         bool IsVulkanLayerEnabled(const char *layerName) const override;
@@ -169,6 +170,7 @@ namespace ignite
         std::vector<nvrhi::EventQueryHandle> m_QueryPool;
 
         bool m_BufferDeviceAddressSupported = false;
+        bool m_TimerQuerySupported = false;
 
 #if defined(VK_HEADER_VERSION) && (VK_HEADER_VERSION >= 301)
         typedef vk::detail::DynamicLoader VulkanDynamicLoader;
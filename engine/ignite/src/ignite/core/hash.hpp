@@ -0,0 +1,48 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstring>
+#include <string_view>
+
+namespace ignite
+{
+    // FNV-1a, processes 8 bytes per step. Stable across runs and platforms,
+    // so it can be used for on-disk cache keys.
+    static u64 HashBytes(const void *data, size_t size, u64 seed = 0xcbf29ce484222325ull)
+    {
+        constexpr u64 prime = 0x100000001b3ull;
+
+        const u8 *bytes = static_cast<const u8 *>(data);
+        u64 hash = seed;
+
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            u64 word;
+            std::memcpy(&word, bytes + i, sizeof(u64));
+            hash = (hash ^ word) * prime;
+        }
+
+        for (; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * prime;
+        }
+
+        // final avalanche
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    static u64 HashString(std::string_view str, u64 seed = 0xcbf29ce484222325ull)
+    {
+        return HashBytes(str.data(), str.size(), seed);
+    }
+
+    static u64 HashCombine(u64 hash, u64 value)
+    {
+        return hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2));
+    }
+}
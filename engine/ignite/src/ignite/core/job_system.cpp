@@ -0,0 +1,401 @@
+#include "job_system.hpp"
+
+#include "logger.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <format>
+#include <thread>
+
+namespace ignite {
+
+    namespace
+    {
+        constexpr u32 kInvalidThreadIndex = ~0u;
+
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        struct JobSystemData
+        {
+            std::vector<std::thread> workers;
+            std::vector<Scope<WorkQueue>> queues; // [0] main thread, then one per worker
+            WorkQueue mainThreadJobs; // pinned to the main thread, never stolen
+
+            std::atomic<bool> running = false;
+            std::atomic<u32> queuedCount = 0; // jobs in the deques
+            std::atomic<u32> nextQueue = 0; // where threads outside the pool push
+
+            // idle workers sleep here until a job is pushed
+            std::mutex sleepMutex;
+            std::condition_variable sleepCondition;
+            std::atomic<u32> sleepingCount = 0;
+
+            std::thread::id mainThreadId;
+        };
+
+        JobSystemData &GetData()
+        {
+            static JobSystemData data;
+            return data;
+        }
+
+        thread_local u32 t_ThreadIndex = kInvalidThreadIndex;
+
+        void Push(Job job)
+        {
+            JobSystemData &data = GetData();
+
+            if (job.affinity == JobAffinity::MainThread)
+            {
+                std::lock_guard lock(data.mainThreadJobs.mutex);
+                data.mainThreadJobs.jobs.push_back(std::move(job));
+                return;
+            }
+
+            u32 index = t_ThreadIndex;
+            if (index == kInvalidThreadIndex)
+                index = 1 + data.nextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<u32>(data.workers.size());
+
+            {
+                WorkQueue &queue = *data.queues[index];
+                std::lock_guard lock(queue.mutex);
+                queue.jobs.push_back(std::move(job));
+            }
+
+            data.queuedCount.fetch_add(1);
+
+            // the lock orders the wake up after a worker that is about to sleep checked the count
+            if (data.sleepingCount.load() > 0)
+            {
+                { std::lock_guard lock(data.sleepMutex); }
+                data.sleepCondition.notify_one();
+            }
+        }
+
+        bool TryPop(WorkQueue &queue, bool newest, Job &outJob)
+        {
+            std::lock_guard lock(queue.mutex);
+            if (queue.jobs.empty())
+                return false;
+
+            if (newest)
+            {
+                outJob = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+            }
+            else
+            {
+                outJob = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+            }
+
+            return true;
+        }
+
+        // oldest job of the counter's batch
+        bool TryPopBatch(WorkQueue &queue, const JobCounter &counter, Job &outJob)
+        {
+            std::lock_guard lock(queue.mutex);
+            auto it = std::ranges::find(queue.jobs, &counter, &Job::counter);
+            if (it == queue.jobs.end())
+                return false;
+
+            outJob = std::move(*it);
+            queue.jobs.erase(it);
+            return true;
+        }
+    }
+
+    void JobSystem::Enqueue(Job job)
+    {
+        if (!IsRunning())
+        {
+            Execute(job);
+            return;
+        }
+
+        Push(std::move(job));
+    }
+
+    void JobSystem::Execute(Job &job)
+    {
+        {
+            IGN_PROFILE_SCOPE("Job");
+            job.func();
+            job.func = nullptr;
+        }
+
+        JobCounter *counter = job.counter;
+        if (!counter)
+            return;
+
+        // under the lock, Wait takes it once more before the owner may destroy the counter
+        std::vector<Job> dependents;
+        {
+            std::lock_guard lock(counter->m_Mutex);
+            if (counter->m_Value.fetch_sub(1, std::memory_order_release) == 1)
+            {
+                dependents.swap(counter->m_Dependents);
+
+                // still under the lock, a waiter can not return and destroy the counter before this
+                counter->m_Condition.notify_all();
+            }
+        }
+
+        // last job of the group, the jobs that waited on it can go
+        for (Job &dependent : dependents)
+            Enqueue(std::move(dependent));
+    }
+
+    // own deque first, then steals starting after the own one
+    bool JobSystem::TryRunOne()
+    {
+        JobSystemData &data = GetData();
+        if (data.queuedCount.load(std::memory_order_acquire) == 0)
+            return false;
+
+        const u32 self = t_ThreadIndex;
+        const u32 queueCount = static_cast<u32>(data.queues.size());
+
+        Job job;
+        bool found = TryPop(*data.queues[self], true, job);
+        for (u32 i = 1; !found && i < queueCount; ++i)
+            found = TryPop(*data.queues[(self + i) % queueCount], false, job);
+
+        if (!found)
+            return false;
+
+        data.queuedCount.fetch_sub(1);
+        Execute(job);
+        return true;
+    }
+
+    bool JobSystem::TryRunBatchJob(JobCounter &counter)
+    {
+        JobSystemData &data = GetData();
+        if (data.queuedCount.load(std::memory_order_acquire) == 0)
+            return false;
+
+        Job job;
+        bool found = false;
+        for (u32 i = 0; !found && i < data.queues.size(); ++i)
+            found = TryPopBatch(*data.queues[i], counter, job);
+
+        if (!found)
+            return false;
+
+        data.queuedCount.fetch_sub(1);
+        Execute(job);
+        return true;
+    }
+
+    bool JobSystem::TryRunMainThreadJob()
+    {
+        Job job;
+        if (!TryPop(GetData().mainThreadJobs, false, job))
+            return false;
+
+        Execute(job);
+        return true;
+    }
+
+    void JobSystem::WorkerLoop(u32 index)
+    {
+        t_ThreadIndex = index;
+        IGN_PROFILE_THREAD(std::format("Worker {}", index));
+
+        JobSystemData &data = GetData();
+        while (data.running.load(std::memory_order_acquire))
+        {
+            if (TryRunOne())
+                continue;
+
+            std::unique_lock lock(data.sleepMutex);
+            data.sleepingCount.fetch_add(1);
+            data.sleepCondition.wait(lock, [&data]()
+            {
+                return data.queuedCount.load() > 0 || !data.running.load();
+            });
+            data.sleepingCount.fetch_sub(1);
+        }
+    }
+
+    void JobSystem::Init(u32 workerCount)
+    {
+        JobSystemData &data = GetData();
+        LOG_ASSERT(!data.running, "[Job System] Already initialized");
+
+        if (workerCount == 0)
+            workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        workerCount = std::min(workerCount, static_cast<u32>(JOB_SYSTEM_MAX_WORKERS));
+
+        data.mainThreadId = std::this_thread::get_id();
+        t_ThreadIndex = 0;
+
+        data.queues.clear();
+        for (u32 i = 0; i <= workerCount; ++i)
+            data.queues.push_back(CreateScope<WorkQueue>());
+
+        data.running = true;
+        for (u32 i = 1; i <= workerCount; ++i)
+            data.workers.emplace_back(WorkerLoop, i);
+
+        LOG_WARN("[Job System] Initialized with {} workers", workerCount);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        JobSystemData &data = GetData();
+        if (!data.running)
+            return;
+
+        {
+            std::lock_guard lock(data.sleepMutex);
+            data.running = false;
+        }
+        data.sleepCondition.notify_all();
+
+        for (std::thread &worker : data.workers)
+            worker.join();
+        data.workers.clear();
+
+        // nothing is lost, what is left runs here and the counters reach zero
+        Job job;
+        for (const Scope<WorkQueue> &queue : data.queues)
+        {
+            while (TryPop(*queue, false, job))
+                Execute(job);
+        }
+
+        while (TryRunMainThreadJob())
+        {
+        }
+
+        data.queuedCount = 0;
+        data.queues.clear();
+
+        LOG_WARN("[Job System] Shutdown");
+    }
+
+    void JobSystem::Run(JobFunc func, JobCounter *counter, JobAffinity affinity, JobCounter *dependency)
+    {
+        if (counter)
+            counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+
+        Job job{ std::move(func), counter, affinity };
+
+        if (dependency)
+        {
+            // checked under the lock the last job of the dependency takes to release its dependents
+            std::lock_guard lock(dependency->m_Mutex);
+            if (!dependency->IsDone())
+            {
+                dependency->m_Dependents.push_back(std::move(job));
+                return;
+            }
+        }
+
+        Enqueue(std::move(job));
+    }
+
+    void JobSystem::Wait(JobCounter &counter)
+    {
+        const bool mainThread = IsMainThread();
+        const bool worker = t_ThreadIndex != kInvalidThreadIndex && !mainThread;
+
+        while (!counter.IsDone())
+        {
+            // main thread jobs run here anyway, a job of the batch may be waiting on one of them
+            if (mainThread && (TryRunMainThreadJob() || TryRunBatchJob(counter)))
+                continue;
+
+            if (worker && TryRunOne())
+                continue;
+
+            // nothing to help with, sleep instead of spinning next to the workers.
+            // threads that may help wake up now and then for jobs queued meanwhile
+            std::unique_lock lock(counter.m_Mutex);
+            if (mainThread || worker)
+                counter.m_Condition.wait_for(lock, std::chrono::milliseconds(JOB_SYSTEM_WAIT_RECHECK_MS), [&counter]() { return counter.IsDone(); });
+            else
+                counter.m_Condition.wait(lock, [&counter]() { return counter.IsDone(); });
+        }
+
+        // the last job may still be unlocking it
+        std::lock_guard lock(counter.m_Mutex);
+    }
+
+    void JobSystem::ParallelFor(u32 count, u32 minItemsPerRange, const std::function<void(u32 begin, u32 end)> &func)
+    {
+        const u32 maxRanges = IsRunning() ? GetThreadCount() * JOB_SYSTEM_RANGES_PER_THREAD : 1;
+
+        u32 rangeCount = std::min(maxRanges, count / std::max(1u, minItemsPerRange));
+        rangeCount = std::min(rangeCount, count);
+
+        if (rangeCount <= 1)
+        {
+            func(0, count);
+            return;
+        }
+
+        const u32 itemsPerRange = (count + rangeCount - 1) / rangeCount;
+
+        JobCounter counter;
+        for (u32 begin = itemsPerRange; begin < count; begin += itemsPerRange)
+        {
+            const u32 end = std::min(count, begin + itemsPerRange);
+            Run([&func, begin, end]() { func(begin, end); }, &counter);
+        }
+
+        // first range on the calling thread
+        func(0, std::min(count, itemsPerRange));
+
+        Wait(counter);
+    }
+
+    void JobSystem::ProcessMainThreadJobs()
+    {
+        // only the jobs queued so far, a job queueing another one does not keep the frame here
+        std::deque<Job> jobs;
+        {
+            WorkQueue &queue = GetData().mainThreadJobs;
+            std::lock_guard lock(queue.mutex);
+            jobs.swap(queue.jobs);
+        }
+
+        for (Job &job : jobs)
+            Execute(job);
+    }
+
+    bool JobSystem::IsRunning()
+    {
+        return GetData().running.load(std::memory_order_acquire);
+    }
+
+    u32 JobSystem::GetWorkerCount()
+    {
+        return static_cast<u32>(GetData().workers.size());
+    }
+
+    u32 JobSystem::GetThreadCount()
+    {
+        return GetWorkerCount() + 1;
+    }
+
+    u32 JobSystem::GetThreadIndex()
+    {
+        return t_ThreadIndex != kInvalidThreadIndex ? t_ThreadIndex : GetThreadCount();
+    }
+
+    bool JobSystem::IsMainThread()
+    {
+        return std::this_thread::get_id() == GetData().mainThreadId;
+    }
+}
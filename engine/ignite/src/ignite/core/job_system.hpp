@@ -0,0 +1,102 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace ignite {
+
+#define JOB_SYSTEM_MAX_WORKERS 32
+#define JOB_SYSTEM_RANGES_PER_THREAD 4 // ParallelFor ranges per thread, left over ones are stolen by idle threads
+#define JOB_SYSTEM_WAIT_RECHECK_MS 1 // a blocked Wait that may help looks for new jobs this often
+
+    using JobFunc = std::function<void()>;
+
+    enum class JobAffinity : u8
+    {
+        Any = 0,
+        MainThread // run by JobSystem::ProcessMainThreadJobs or a Wait on the main thread
+    };
+
+    class JobCounter;
+
+    struct Job
+    {
+        JobFunc func;
+        JobCounter *counter = nullptr; // decremented once func returned
+        JobAffinity affinity = JobAffinity::Any;
+    };
+
+    // Number of jobs still running for a group, the owner keeps it alive until JobSystem::Wait
+    // returned. Jobs started with it as a dependency are held here and queued when it reaches zero.
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+
+        JobCounter(const JobCounter &) = delete;
+        JobCounter &operator=(const JobCounter &) = delete;
+
+        [[nodiscard]] bool IsDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+        [[nodiscard]] u32 GetValue() const { return m_Value.load(std::memory_order_acquire); }
+
+    private:
+        std::atomic<u32> m_Value = 0;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition; // notified when the value reaches zero
+        std::vector<Job> m_Dependents;
+
+        friend class JobSystem;
+    };
+
+    // Shared worker pool of the engine. Every worker owns a deque, jobs pushed by a worker
+    // go to its own deque and are popped newest first, idle workers steal the oldest job of
+    // another one. Threads outside the pool spread their jobs over the workers.
+    // Before Init, and after Shutdown, jobs run inline on the calling thread.
+    class JobSystem
+    {
+    public:
+        // workerCount 0 leaves one hardware thread to the caller, which becomes the main thread
+        static void Init(u32 workerCount = 0);
+
+        // finishes the jobs still queued
+        static void Shutdown();
+
+        // counter is incremented now and decremented once func returned, with a dependency
+        // the job is only queued once that counter reached zero
+        static void Run(JobFunc func, JobCounter *counter = nullptr, JobAffinity affinity = JobAffinity::Any, JobCounter *dependency = nullptr);
+
+        // blocks until counter reaches zero. Workers run any queued job meanwhile, the main thread only
+        // the jobs of this counter and main thread jobs so a long unrelated job does not stall the frame
+        static void Wait(JobCounter &counter);
+
+        // splits [0, count) into ranges of at least minItemsPerRange, the calling thread takes the first
+        static void ParallelFor(u32 count, u32 minItemsPerRange, const std::function<void(u32 begin, u32 end)> &func);
+
+        // main thread, once per frame
+        static void ProcessMainThreadJobs();
+
+        [[nodiscard]] static bool IsRunning();
+        [[nodiscard]] static u32 GetWorkerCount();
+
+        // workers plus the main thread, GetThreadIndex is below it on those threads
+        [[nodiscard]] static u32 GetThreadCount();
+
+        // 0 on the main thread, 1 to GetWorkerCount on workers, GetThreadCount elsewhere
+        [[nodiscard]] static u32 GetThreadIndex();
+        [[nodiscard]] static bool IsMainThread();
+
+    private:
+        static void Enqueue(Job job);
+        static void Execute(Job &job);
+        static bool TryRunOne();
+        static bool TryRunBatchJob(JobCounter &counter);
+        static bool TryRunMainThreadJob();
+        static void WorkerLoop(u32 index);
+    };
+}
@@ -0,0 +1,96 @@
+#include "main_thread_queue.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace ignite {
+
+    MainThreadQueue::~MainThreadQueue()
+    {
+        for (std::atomic<Node *> &head : m_Heads)
+        {
+            Node *node = head.exchange(nullptr, std::memory_order_acquire);
+            while (node)
+            {
+                Node *next = node->next;
+                delete node;
+                node = next;
+            }
+        }
+    }
+
+    void MainThreadQueue::Push(MainThreadFunc func, MainThreadPriority priority)
+    {
+        Node *node = new Node{ std::move(func), nullptr };
+
+        std::atomic<Node *> &head = m_Heads[static_cast<u8>(priority)];
+        node->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+
+        m_PendingCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void MainThreadQueue::Collect()
+    {
+        for (u8 priority = 0; priority < static_cast<u8>(MainThreadPriority::Count); ++priority)
+        {
+            Node *node = m_Heads[priority].exchange(nullptr, std::memory_order_acquire);
+
+            // the stack is newest first
+            Node *reversed = nullptr;
+            while (node)
+            {
+                Node *next = node->next;
+                node->next = reversed;
+                reversed = node;
+                node = next;
+            }
+
+            while (reversed)
+            {
+                Node *next = reversed->next;
+                m_Ready[priority].push_back(std::move(reversed->func));
+                delete reversed;
+                reversed = next;
+            }
+        }
+    }
+
+    void MainThreadQueue::Process(f64 budgetMs)
+    {
+        Collect();
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<MainThreadFunc> deferred;
+
+        bool first = true;
+        for (i32 priority = static_cast<i32>(MainThreadPriority::Count) - 1; priority >= 0; --priority)
+        {
+            std::deque<MainThreadFunc> &ready = m_Ready[priority];
+            const size_t readyCount = ready.size();
+
+            for (size_t i = 0; i < readyCount; ++i)
+            {
+                const f64 elapsedMs = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (!first && elapsedMs >= budgetMs)
+                    break;
+                first = false;
+
+                MainThreadFunc func = std::move(ready.front());
+                ready.pop_front();
+
+                if (func())
+                    m_PendingCount.fetch_sub(1, std::memory_order_relaxed);
+                else
+                    deferred.push_back(std::move(func));
+            }
+
+            // in front of what was not reached, so they keep their place for the next frame
+            for (auto it = deferred.rbegin(); it != deferred.rend(); ++it)
+                ready.push_front(std::move(*it));
+            deferred.clear();
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+
+namespace ignite {
+
+#define MAIN_THREAD_QUEUE_FRAME_BUDGET_MS 2.0
+
+    enum class MainThreadPriority : u8
+    {
+        Low = 0,
+        Normal,
+        High,
+        Count
+    };
+
+    // returns false to be called again on a later frame
+    using MainThreadFunc = std::function<bool()>;
+
+    // Work handed to the main thread by any thread. Producers push onto a lock-free stack per
+    // priority, Process takes the stacks at once and keeps the work in FIFO order per priority.
+    // Process runs the highest priority first and stops once the budget is spent, at least one
+    // function runs per call so a flood of work still drains.
+    class MainThreadQueue
+    {
+    public:
+        MainThreadQueue() = default;
+        ~MainThreadQueue();
+
+        MainThreadQueue(const MainThreadQueue &) = delete;
+        MainThreadQueue &operator=(const MainThreadQueue &) = delete;
+
+        // any thread
+        void Push(MainThreadFunc func, MainThreadPriority priority = MainThreadPriority::Normal);
+
+        // main thread, once per frame. Functions returning false are retried next call
+        // and do not hold back the ones queued after them
+        void Process(f64 budgetMs);
+
+        [[nodiscard]] u32 GetPendingCount() const { return m_PendingCount.load(std::memory_order_relaxed); }
+
+    private:
+        struct Node
+        {
+            MainThreadFunc func;
+            Node *next = nullptr;
+        };
+
+        // moves the pushed nodes of every priority behind the ones already taken
+        void Collect();
+
+        std::atomic<Node *> m_Heads[static_cast<u8>(MainThreadPriority::Count)] = {};
+        std::deque<MainThreadFunc> m_Ready[static_cast<u8>(MainThreadPriority::Count)]; // main thread only
+        std::atomic<u32> m_PendingCount = 0;
+    };
+}
@@ -0,0 +1,286 @@
+#include "memory.hpp"
+
+#include "logger.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace ignite {
+
+    namespace
+    {
+        struct TagCounters
+        {
+            std::atomic<u64> liveBytes = 0;
+            std::atomic<u64> peakBytes = 0;
+            std::atomic<u64> liveAllocations = 0;
+            std::atomic<u64> totalAllocations = 0;
+        };
+
+        TagCounters s_Counters[static_cast<u8>(MemoryTag::Count)];
+
+        // right before the returned pointer, 16 bytes so any power of two alignment up to it holds
+        struct BlockHeader
+        {
+            u64 size;
+            u32 offset; // from the start of the heap block, at most alignment + sizeof(BlockHeader)
+            u16 alignment;
+            MemoryTag tag;
+            u8 padding;
+        };
+        static_assert(sizeof(BlockHeader) == 16);
+
+        size_t AlignUp(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        struct FrameAllocatorData
+        {
+            Scope<LinearArena> arenas[2];
+            u32 current = 0;
+        };
+
+        FrameAllocatorData &GetFrameData()
+        {
+            static FrameAllocatorData data;
+            return data;
+        }
+    }
+
+    void *MemoryTracker::Allocate(MemoryTag tag, size_t size, size_t alignment)
+    {
+        alignment = std::max(alignment, sizeof(BlockHeader));
+
+        u8 *raw = static_cast<u8 *>(std::malloc(size + alignment + sizeof(BlockHeader)));
+        if (!raw)
+            return nullptr;
+
+        // malloc only guarantees 16 bytes, align the address itself
+        u8 *block = reinterpret_cast<u8 *>(AlignUp(reinterpret_cast<uintptr_t>(raw) + sizeof(BlockHeader), alignment));
+        BlockHeader *header = reinterpret_cast<BlockHeader *>(block) - 1;
+        header->size = size;
+        header->offset = static_cast<u32>(block - raw);
+        header->alignment = static_cast<u16>(alignment);
+        header->tag = tag;
+
+        OnAllocate(tag, size);
+        return block;
+    }
+
+    void *MemoryTracker::Reallocate(void *block, size_t size)
+    {
+        if (!block)
+            return Allocate(MemoryTag::Core, size);
+
+        const BlockHeader *header = static_cast<BlockHeader *>(block) - 1;
+        if (header->size >= size)
+            return block;
+
+        void *newBlock = Allocate(header->tag, size, header->alignment);
+        if (newBlock)
+        {
+            std::memcpy(newBlock, block, header->size);
+            Free(block);
+        }
+        return newBlock;
+    }
+
+    void MemoryTracker::Free(void *block)
+    {
+        if (!block)
+            return;
+
+        const BlockHeader *header = static_cast<BlockHeader *>(block) - 1;
+        OnFree(header->tag, header->size);
+        std::free(static_cast<u8 *>(block) - header->offset);
+    }
+
+    void MemoryTracker::OnAllocate(MemoryTag tag, size_t size)
+    {
+        TagCounters &counters = s_Counters[static_cast<u8>(tag)];
+
+        const u64 live = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+        u64 peak = counters.peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void MemoryTracker::OnFree(MemoryTag tag, size_t size)
+    {
+        TagCounters &counters = s_Counters[static_cast<u8>(tag)];
+        counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+        counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    MemoryStats MemoryTracker::GetStats(MemoryTag tag)
+    {
+        const TagCounters &counters = s_Counters[static_cast<u8>(tag)];
+
+        MemoryStats stats;
+        stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        stats.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+        stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    const char *MemoryTracker::GetTagName(MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::Core: return "Core";
+        case MemoryTag::Renderer: return "Renderer";
+        case MemoryTag::Scene: return "Scene";
+        case MemoryTag::Assets: return "Assets";
+        case MemoryTag::Scripting: return "Scripting";
+        case MemoryTag::Physics: return "Physics";
+        default: return "Unknown";
+        }
+    }
+
+    LinearArena::LinearArena(size_t capacity, MemoryTag tag)
+        : m_Capacity(capacity), m_Tag(tag)
+    {
+        m_Block = static_cast<u8 *>(MemoryTracker::Allocate(m_Tag, m_Capacity));
+    }
+
+    LinearArena::~LinearArena()
+    {
+        Reset();
+        MemoryTracker::Free(m_Block);
+    }
+
+    void *LinearArena::Allocate(size_t size, size_t alignment)
+    {
+        const size_t offset = AlignUp(m_Offset, alignment);
+        if (offset + size <= m_Capacity)
+        {
+            m_Offset = offset + size;
+            return m_Block + offset;
+        }
+
+        void *block = MemoryTracker::Allocate(m_Tag, size, alignment);
+        m_Overflow.push_back(block);
+        m_OverflowBytes += size;
+        return block;
+    }
+
+    void LinearArena::Reset()
+    {
+        if (!m_Overflow.empty())
+        {
+            for (void *block : m_Overflow)
+                MemoryTracker::Free(block);
+            m_Overflow.clear();
+
+            // room for the whole peak next time, the block is unused at this point
+            const size_t peak = m_Offset + m_OverflowBytes;
+            LOG_WARN("[Linear Arena] Overflowed {} of {} bytes, growing", peak, m_Capacity);
+
+            MemoryTracker::Free(m_Block);
+            m_Capacity = AlignUp(peak, 64 * 1024);
+            m_Block = static_cast<u8 *>(MemoryTracker::Allocate(m_Tag, m_Capacity));
+        }
+
+        m_Offset = 0;
+        m_OverflowBytes = 0;
+    }
+
+    void FrameAllocator::Init(size_t capacity)
+    {
+        FrameAllocatorData &data = GetFrameData();
+        for (Scope<LinearArena> &arena : data.arenas)
+            arena = CreateScope<LinearArena>(capacity, MemoryTag::Core);
+        data.current = 0;
+    }
+
+    void FrameAllocator::Shutdown()
+    {
+        FrameAllocatorData &data = GetFrameData();
+        for (Scope<LinearArena> &arena : data.arenas)
+            arena.reset();
+    }
+
+    void FrameAllocator::BeginFrame()
+    {
+        // the arena of two frames ago, nothing refers to it anymore
+        FrameAllocatorData &data = GetFrameData();
+        data.current ^= 1;
+        data.arenas[data.current]->Reset();
+    }
+
+    void *FrameAllocator::Allocate(size_t size, size_t alignment)
+    {
+        FrameAllocatorData &data = GetFrameData();
+        LOG_ASSERT(data.arenas[data.current], "[Frame Allocator] Not initialized");
+        return data.arenas[data.current]->Allocate(size, alignment);
+    }
+
+    size_t FrameAllocator::GetUsed()
+    {
+        const FrameAllocatorData &data = GetFrameData();
+        return data.arenas[data.current] ? data.arenas[data.current]->GetUsed() : 0;
+    }
+
+    size_t FrameAllocator::GetCapacity()
+    {
+        const FrameAllocatorData &data = GetFrameData();
+        return data.arenas[data.current] ? data.arenas[data.current]->GetCapacity() : 0;
+    }
+
+    PoolAllocator::PoolAllocator(size_t blockSize, size_t blockAlignment, MemoryTag tag, u32 blocksPerPage)
+        : m_BlockAlignment(std::max(blockAlignment, alignof(FreeBlock))), m_Tag(tag), m_BlocksPerPage(blocksPerPage)
+    {
+        m_BlockSize = AlignUp(std::max(blockSize, sizeof(FreeBlock)), m_BlockAlignment);
+    }
+
+    PoolAllocator::~PoolAllocator()
+    {
+        for (void *page : m_Pages)
+            MemoryTracker::Free(page);
+    }
+
+    void *PoolAllocator::Allocate()
+    {
+        std::lock_guard lock(m_Mutex);
+
+        if (!m_FreeList)
+        {
+            u8 *page = static_cast<u8 *>(MemoryTracker::Allocate(m_Tag, m_BlockSize * m_BlocksPerPage, m_BlockAlignment));
+            m_Pages.push_back(page);
+
+            // first block on top of the list
+            for (u32 i = m_BlocksPerPage; i > 0; --i)
+            {
+                FreeBlock *block = reinterpret_cast<FreeBlock *>(page + (i - 1) * m_BlockSize);
+                block->next = m_FreeList;
+                m_FreeList = block;
+            }
+        }
+
+        FreeBlock *block = m_FreeList;
+        m_FreeList = block->next;
+        m_LiveCount.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    void PoolAllocator::Free(void *block)
+    {
+        if (!block)
+            return;
+
+        std::lock_guard lock(m_Mutex);
+
+        FreeBlock *freeBlock = static_cast<FreeBlock *>(block);
+        freeBlock->next = m_FreeList;
+        m_FreeList = freeBlock;
+        m_LiveCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
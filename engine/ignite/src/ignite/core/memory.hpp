@@ -0,0 +1,235 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace ignite {
+
+#define FRAME_ALLOCATOR_CAPACITY (4 * 1024 * 1024) // bytes per frame, the arena grows to the peak after an overflow
+#define POOL_ALLOCATOR_BLOCKS_PER_PAGE 64
+
+    enum class MemoryTag : u8
+    {
+        Core = 0, // frame arena, job system
+        Renderer,
+        Scene,
+        Assets,
+        Scripting,
+        Physics,
+        Count
+    };
+
+    struct MemoryStats
+    {
+        u64 liveBytes = 0;
+        u64 peakBytes = 0;
+        u64 liveAllocations = 0;
+        u64 totalAllocations = 0;
+    };
+
+    // Live bytes and allocation counts per subsystem. Only memory going through the
+    // allocators below, or reported with OnAllocate, is counted.
+    class MemoryTracker
+    {
+    public:
+        // heap blocks with a header holding the size, for C APIs that free without one
+        static void *Allocate(MemoryTag tag, size_t size, size_t alignment = alignof(std::max_align_t));
+        static void *Reallocate(void *block, size_t size); // keeps the tag and alignment of block
+        static void Free(void *block);
+
+        // accounting only, for allocators that know the size when freeing
+        static void OnAllocate(MemoryTag tag, size_t size);
+        static void OnFree(MemoryTag tag, size_t size);
+
+        static MemoryStats GetStats(MemoryTag tag);
+        static const char *GetTagName(MemoryTag tag);
+    };
+
+    // STL allocator counted under Tag
+    template<typename T, MemoryTag Tag>
+    class TrackedAllocator
+    {
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = TrackedAllocator<U, Tag>; };
+
+        TrackedAllocator() = default;
+
+        template<typename U>
+        TrackedAllocator(const TrackedAllocator<U, Tag> &) {}
+
+        T *allocate(size_t count)
+        {
+            MemoryTracker::OnAllocate(Tag, count * sizeof(T));
+            return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        void deallocate(T *ptr, size_t count)
+        {
+            MemoryTracker::OnFree(Tag, count * sizeof(T));
+            ::operator delete(ptr, std::align_val_t(alignof(T)));
+        }
+
+        template<typename U>
+        bool operator==(const TrackedAllocator<U, Tag> &) const { return true; }
+    };
+
+    template<typename T, MemoryTag Tag>
+    using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+
+    // Bump allocator over one block, Reset releases everything at once. Allocations past the block
+    // come from the heap until the next Reset, which grows the block to the peak so it fits next time.
+    class LinearArena
+    {
+    public:
+        explicit LinearArena(size_t capacity, MemoryTag tag = MemoryTag::Core);
+        ~LinearArena();
+
+        LinearArena(const LinearArena &) = delete;
+        LinearArena &operator=(const LinearArena &) = delete;
+
+        void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+        void Reset();
+
+        // in use since the last Reset, overflow included
+        [[nodiscard]] size_t GetUsed() const { return m_Offset + m_OverflowBytes; }
+        [[nodiscard]] size_t GetCapacity() const { return m_Capacity; }
+
+    private:
+        u8 *m_Block = nullptr;
+        size_t m_Capacity = 0;
+        size_t m_Offset = 0;
+
+        std::vector<void *> m_Overflow;
+        size_t m_OverflowBytes = 0;
+
+        MemoryTag m_Tag;
+    };
+
+    // Two linear arenas swapped by Application at the start of every frame. Memory taken during a
+    // frame stays valid through the next one, so it may back data still read while that frame is
+    // recorded. Main thread only.
+    class FrameAllocator
+    {
+    public:
+        static void Init(size_t capacity = FRAME_ALLOCATOR_CAPACITY);
+        static void Shutdown();
+
+        static void BeginFrame();
+
+        static void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template<typename T>
+        static T *AllocateArray(size_t count)
+        {
+            return static_cast<T *>(Allocate(count * sizeof(T), alignof(T)));
+        }
+
+        [[nodiscard]] static size_t GetUsed();
+        [[nodiscard]] static size_t GetCapacity();
+    };
+
+    // STL allocator on the frame arena, deallocate does nothing, reserve to avoid wasting the arena on growth
+    template<typename T>
+    class FrameStdAllocator
+    {
+    public:
+        using value_type = T;
+
+        FrameStdAllocator() = default;
+
+        template<typename U>
+        FrameStdAllocator(const FrameStdAllocator<U> &) {}
+
+        T *allocate(size_t count) { return FrameAllocator::AllocateArray<T>(count); }
+        void deallocate(T *, size_t) {}
+
+        template<typename U>
+        bool operator==(const FrameStdAllocator<U> &) const { return true; }
+    };
+
+    template<typename T>
+    using FrameVector = std::vector<T, FrameStdAllocator<T>>;
+
+    // Fixed size blocks carved from pages, freed blocks are handed out again first.
+    // Pages are only released with the pool.
+    class PoolAllocator
+    {
+    public:
+        PoolAllocator(size_t blockSize, size_t blockAlignment, MemoryTag tag, u32 blocksPerPage = POOL_ALLOCATOR_BLOCKS_PER_PAGE);
+        ~PoolAllocator();
+
+        PoolAllocator(const PoolAllocator &) = delete;
+        PoolAllocator &operator=(const PoolAllocator &) = delete;
+
+        void *Allocate();
+        void Free(void *block);
+
+        [[nodiscard]] u32 GetLiveCount() const { return m_LiveCount.load(std::memory_order_relaxed); }
+        [[nodiscard]] size_t GetPageCount() const { return m_Pages.size(); }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        std::mutex m_Mutex;
+        FreeBlock *m_FreeList = nullptr;
+        std::vector<void *> m_Pages;
+
+        size_t m_BlockSize;
+        size_t m_BlockAlignment;
+        MemoryTag m_Tag;
+        u32 m_BlocksPerPage;
+        std::atomic<u32> m_LiveCount = 0;
+    };
+
+    // STL allocator taking single objects from a pool shared by every T of the same tag,
+    // with std::allocate_shared the object and its control block share one block
+    template<typename T, MemoryTag Tag>
+    class PoolStdAllocator
+    {
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = PoolStdAllocator<U, Tag>; };
+
+        PoolStdAllocator() = default;
+
+        template<typename U>
+        PoolStdAllocator(const PoolStdAllocator<U, Tag> &) {}
+
+        T *allocate(size_t count)
+        {
+            if (count != 1)
+                return TrackedAllocator<T, Tag>().allocate(count);
+            return static_cast<T *>(GetPool().Allocate());
+        }
+
+        void deallocate(T *ptr, size_t count)
+        {
+            if (count != 1)
+                TrackedAllocator<T, Tag>().deallocate(ptr, count);
+            else
+                GetPool().Free(ptr);
+        }
+
+        template<typename U>
+        bool operator==(const PoolStdAllocator<U, Tag> &) const { return true; }
+
+        static PoolAllocator &GetPool()
+        {
+            static PoolAllocator pool(sizeof(T), alignof(T), Tag);
+            return pool;
+        }
+    };
+}
@@ -0,0 +1,310 @@
+#include "profiler.hpp"
+
+#include "logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <mutex>
+
+namespace ignite {
+
+    namespace
+    {
+        struct ThreadRing
+        {
+            std::string name;
+            u32 id = 0;
+            std::vector<ProfileEvent> events = std::vector<ProfileEvent>(PROFILER_EVENTS_PER_THREAD);
+            std::atomic<u64> written = 0; // events ever recorded, the slot is written % size
+        };
+
+        struct ProfilerData
+        {
+            std::mutex mutex; // rings and thread names, never taken while recording
+            std::vector<Scope<ThreadRing>> rings;
+            std::vector<ThreadRing *> freeRings; // of threads that exited, their events stay until a new thread takes one
+            std::atomic<bool> enabled = true;
+
+            std::mutex frameMutex;
+            ProfileFrame frames[PROFILER_FRAME_HISTORY];
+            u64 frameCount = 0;
+
+            const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        };
+
+        ProfilerData &GetData()
+        {
+            static ProfilerData data;
+            return data;
+        }
+
+        // hands the ring back when the thread exits, short lived threads (scene loads and saves) reuse them
+        struct RingOwner
+        {
+            ThreadRing *ring = nullptr;
+
+            ~RingOwner()
+            {
+                if (!ring)
+                    return;
+
+                ProfilerData &data = GetData();
+                std::lock_guard lock(data.mutex);
+                data.freeRings.push_back(ring);
+            }
+        };
+
+        thread_local RingOwner t_Ring;
+        thread_local u32 t_Depth = 0;
+
+        ThreadRing *AddRing(ProfilerData &data)
+        {
+            Scope<ThreadRing> ring = CreateScope<ThreadRing>();
+            ring->id = static_cast<u32>(data.rings.size());
+            ring->name = std::format("Thread {}", ring->id);
+
+            data.rings.push_back(std::move(ring));
+            return data.rings.back().get();
+        }
+
+        ThreadRing &GetRing()
+        {
+            if (!t_Ring.ring)
+            {
+                ProfilerData &data = GetData();
+                std::lock_guard lock(data.mutex);
+
+                if (data.freeRings.empty())
+                {
+                    t_Ring.ring = AddRing(data);
+                }
+                else
+                {
+                    // readers only look at rings under the lock, the old events go now
+                    ThreadRing *ring = data.freeRings.back();
+                    data.freeRings.pop_back();
+                    ring->name = std::format("Thread {}", ring->id);
+                    ring->written.store(0, std::memory_order_relaxed);
+                    t_Ring.ring = ring;
+                }
+            }
+            return *t_Ring.ring;
+        }
+
+        void Write(ThreadRing &ring, const ProfileEvent &event)
+        {
+            const u64 index = ring.written.load(std::memory_order_relaxed);
+            ring.events[index % PROFILER_EVENTS_PER_THREAD] = event;
+            ring.written.store(index + 1, std::memory_order_release);
+        }
+
+        void WriteEscaped(std::ofstream &file, const char *text)
+        {
+            for (const char *c = text; *c; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    file << '\\';
+                file << *c;
+            }
+        }
+    }
+
+    void Profiler::BeginFrame()
+    {
+        ProfilerData &data = GetData();
+        const u64 now = Now();
+
+        std::lock_guard lock(data.frameMutex);
+        if (data.frameCount > 0)
+            data.frames[(data.frameCount - 1) % PROFILER_FRAME_HISTORY].end = now;
+
+        data.frames[data.frameCount % PROFILER_FRAME_HISTORY] = { data.frameCount, now, 0 };
+        data.frameCount++;
+    }
+
+    void Profiler::SetThreadName(const std::string &name)
+    {
+        ThreadRing &ring = GetRing();
+
+        std::lock_guard lock(GetData().mutex);
+        ring.name = name;
+    }
+
+    void Profiler::SetEnabled(bool enabled)
+    {
+        GetData().enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool Profiler::IsEnabled()
+    {
+        return GetData().enabled.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::Record(const char *name, u64 start, u64 end, u32 depth)
+    {
+        if (!IsEnabled())
+            return;
+
+        Write(GetRing(), { name, start, end, depth });
+    }
+
+    u32 Profiler::CreateTrack(const std::string &name)
+    {
+        ProfilerData &data = GetData();
+        std::lock_guard lock(data.mutex);
+
+        ThreadRing *ring = AddRing(data);
+        ring->name = name;
+        return ring->id;
+    }
+
+    void Profiler::RecordTrack(u32 track, const char *name, u64 start, u64 end, u32 depth)
+    {
+        if (!IsEnabled())
+            return;
+
+        ProfilerData &data = GetData();
+        ThreadRing *ring = nullptr;
+        {
+            std::lock_guard lock(data.mutex);
+            LOG_ASSERT(track < data.rings.size(), "[Profiler] Invalid track {}", track);
+            ring = data.rings[track].get();
+        }
+
+        Write(*ring, { name, start, end, depth });
+    }
+
+    std::vector<ProfileFrame> Profiler::GetFrames()
+    {
+        ProfilerData &data = GetData();
+        std::lock_guard lock(data.frameMutex);
+
+        const u64 count = std::min<u64>(data.frameCount, PROFILER_FRAME_HISTORY);
+        std::vector<ProfileFrame> frames;
+        frames.reserve(count);
+
+        for (u64 i = data.frameCount - count; i < data.frameCount; ++i)
+            frames.push_back(data.frames[i % PROFILER_FRAME_HISTORY]);
+        return frames;
+    }
+
+    void Profiler::Collect(u64 start, u64 end, std::vector<ProfileThreadEvents> &outThreads)
+    {
+        ProfilerData &data = GetData();
+        std::lock_guard lock(data.mutex);
+
+        outThreads.clear();
+        outThreads.reserve(data.rings.size());
+
+        std::vector<u64> sequence;
+        for (const Scope<ThreadRing> &ring : data.rings)
+        {
+            ProfileThreadEvents &thread = outThreads.emplace_back();
+            thread.threadName = ring->name;
+            thread.threadID = ring->id;
+
+            const u64 written = ring->written.load(std::memory_order_acquire);
+            const u64 first = written > PROFILER_EVENTS_PER_THREAD ? written - PROFILER_EVENTS_PER_THREAD : 0;
+
+            sequence.clear();
+            for (u64 i = first; i < written; ++i)
+            {
+                const ProfileEvent &event = ring->events[i % PROFILER_EVENTS_PER_THREAD];
+                if (event.end >= start && event.end < end)
+                {
+                    thread.events.push_back(event);
+                    sequence.push_back(i);
+                }
+            }
+
+            // the owner kept recording while this copied, slots it reached again may be torn
+            const u64 writtenAfter = ring->written.load(std::memory_order_acquire);
+            if (writtenAfter > PROFILER_EVENTS_PER_THREAD)
+            {
+                const u64 valid = writtenAfter - PROFILER_EVENTS_PER_THREAD + 1;
+                const auto keep = std::ranges::lower_bound(sequence, valid) - sequence.begin();
+                thread.events.erase(thread.events.begin(), thread.events.begin() + keep);
+            }
+
+            if (thread.events.empty())
+                outThreads.pop_back();
+        }
+    }
+
+    bool Profiler::ExportChromeTrace(const std::filesystem::path &filepath, u32 frameCount)
+    {
+        std::vector<ProfileFrame> frames = GetFrames();
+        if (frames.size() < 2)
+            return false;
+
+        // the last one is still running
+        frames.pop_back();
+        if (frames.size() > frameCount)
+            frames.erase(frames.begin(), frames.end() - frameCount);
+
+        const u64 start = frames.front().start;
+        std::vector<ProfileThreadEvents> threads;
+        Collect(start, frames.back().end, threads);
+
+        std::ofstream file(filepath, std::ios::trunc);
+        if (!file)
+        {
+            LOG_ERROR("[Profiler] Failed to write {}", filepath.generic_string());
+            return false;
+        }
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        bool first = true;
+        auto separator = [&file, &first]()
+        {
+            if (!first)
+                file << ",\n";
+            first = false;
+        };
+
+        for (const ProfileThreadEvents &thread : threads)
+        {
+            separator();
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.threadID << ",\"args\":{\"name\":\"";
+            WriteEscaped(file, thread.threadName.c_str());
+            file << "\"}}";
+
+            for (const ProfileEvent &event : thread.events)
+            {
+                // scopes that started before the first frame are cut at its start
+                const u64 eventStart = std::max(event.start, start);
+
+                separator();
+                file << "{\"name\":\"";
+                WriteEscaped(file, event.name);
+                file << std::format("\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                    thread.threadID, static_cast<f64>(eventStart - start) / 1000.0, static_cast<f64>(event.end - eventStart) / 1000.0);
+            }
+        }
+
+        for (const ProfileFrame &frame : frames)
+        {
+            separator();
+            file << std::format("{{\"name\":\"Frame {}\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":{:.3f}}}",
+                frame.index, static_cast<f64>(frame.start - start) / 1000.0);
+        }
+
+        file << "\n]}\n";
+
+        LOG_INFO("[Profiler] Exported {} frames to {}", frames.size(), filepath.generic_string());
+        return true;
+    }
+
+    u64 Profiler::Now()
+    {
+        return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - GetData().epoch).count());
+    }
+
+    u32 &Profiler::Depth()
+    {
+        return t_Depth;
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace ignite {
+
+#define PROFILER_EVENTS_PER_THREAD 16384 // ring buffer size, older events are overwritten
+#define PROFILER_FRAME_HISTORY 256 // frame boundaries kept for the timeline and exports
+
+#if !defined(IGNITE_DIST)
+    #define IGNITE_PROFILE 1
+#else
+    #define IGNITE_PROFILE 0
+#endif
+
+    // name must outlive the profiler, string literals and __FUNCTION__ do
+    struct ProfileEvent
+    {
+        const char *name = nullptr;
+        u64 start = 0; // nanoseconds, see Profiler::Now
+        u64 end = 0;
+        u32 depth = 0; // nesting level on its thread
+    };
+
+    struct ProfileThreadEvents
+    {
+        std::string threadName;
+        u32 threadID = 0;
+        std::vector<ProfileEvent> events; // ordered by end time
+    };
+
+    struct ProfileFrame
+    {
+        u64 index = 0;
+        u64 start = 0;
+        u64 end = 0;
+    };
+
+    // Scoped CPU timings. Each thread writes its events into its own ring buffer, nothing is locked
+    // on the recording path. Readers copy a ring and drop what the thread overwrote meanwhile.
+    // Instrument with IGN_PROFILE_SCOPE and IGN_PROFILE_FRAME, both compile to nothing in Dist.
+    class Profiler
+    {
+    public:
+        static void BeginFrame();
+
+        // the ring of the calling thread is created on its first event
+        static void SetThreadName(const std::string &name);
+
+        static void SetEnabled(bool enabled);
+        [[nodiscard]] static bool IsEnabled();
+
+        static void Record(const char *name, u64 start, u64 end, u32 depth);
+
+        // a lane not bound to a thread, for timings measured elsewhere like on the GPU, recorded from one thread at a time
+        [[nodiscard]] static u32 CreateTrack(const std::string &name);
+        static void RecordTrack(u32 track, const char *name, u64 start, u64 end, u32 depth = 0);
+
+        // the ones still in the rings, oldest first, the last one is the frame in progress
+        [[nodiscard]] static std::vector<ProfileFrame> GetFrames();
+
+        // events ending in [start, end) of every thread that recorded any
+        static void Collect(u64 start, u64 end, std::vector<ProfileThreadEvents> &outThreads);
+
+        // Chrome trace event JSON of the last frameCount completed frames, opens in chrome://tracing or Perfetto
+        static bool ExportChromeTrace(const std::filesystem::path &filepath, u32 frameCount = PROFILER_FRAME_HISTORY);
+
+        [[nodiscard]] static u64 Now();
+
+    private:
+        static u32 &Depth();
+
+        friend class ProfileScope;
+    };
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char *name)
+            : m_Name(name), m_Start(Profiler::Now()), m_Depth(Profiler::Depth()++)
+        {
+        }
+
+        ~ProfileScope()
+        {
+            --Profiler::Depth();
+            Profiler::Record(m_Name, m_Start, Profiler::Now(), m_Depth);
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        const char *m_Name;
+        u64 m_Start;
+        u32 m_Depth;
+    };
+}
+
+#if IGNITE_PROFILE
+    #define IGN_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define IGN_PROFILE_CONCAT(a, b) IGN_PROFILE_CONCAT_IMPL(a, b)
+    #define IGN_PROFILE_SCOPE(name) ::ignite::ProfileScope IGN_PROFILE_CONCAT(profileScope, __LINE__)(name)
+    #define IGN_PROFILE_FUNCTION() IGN_PROFILE_SCOPE(__FUNCTION__)
+    #define IGN_PROFILE_FRAME() ::ignite::Profiler::BeginFrame()
+    #define IGN_PROFILE_THREAD(name) ::ignite::Profiler::SetThreadName(name)
+#else
+    #define IGN_PROFILE_SCOPE(name)
+    #define IGN_PROFILE_FUNCTION()
+    #define IGN_PROFILE_FRAME()
+    #define IGN_PROFILE_THREAD(name)
+#endif
@@ -0,0 +1,586 @@
+#include "async_reader.hpp"
+
+#include "ignite/core/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#ifdef PLATFORM_LINUX
+#   include <linux/io_uring.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <sys/syscall.h>
+#   include <sys/uio.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <cerrno>
+#endif
+
+namespace ignite::vfs
+{
+    namespace
+    {
+        struct Request
+        {
+            IFileSystem *fs = nullptr;
+            std::filesystem::path path;
+            std::string key;
+            std::promise<Ref<IBlob>> promise;
+            ReadFuture future;
+            std::vector<ReadCallback> callbacks;
+        };
+
+#ifdef PLATFORM_LINUX
+        // a single read larger than this is split, sqe lengths are 32 bit
+        constexpr u64 RingMaxReadSize = 1ull << 30;
+
+        struct RingRead
+        {
+            Ref<Request> request;
+            int fd = -1;
+            u8 *data = nullptr;
+            u64 size = 0;
+            u64 offset = 0;
+            iovec iov = {};
+        };
+
+        // minimal io_uring without liburing, one submitting and reaping thread
+        class Ring
+        {
+        public:
+            ~Ring()
+            {
+                if (m_SQEs)
+                    munmap(m_SQEs, m_SQEsSize);
+                if (m_CQRing && m_CQRing != m_SQRing)
+                    munmap(m_CQRing, m_CQRingSize);
+                if (m_SQRing)
+                    munmap(m_SQRing, m_SQRingSize);
+                if (m_Fd >= 0)
+                    close(m_Fd);
+            }
+
+            bool Init(u32 entries)
+            {
+                io_uring_params params = {};
+                m_Fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+                if (m_Fd < 0)
+                    return false;
+
+                m_SQRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+                m_CQRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+                const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (singleMap)
+                    m_SQRingSize = m_CQRingSize = std::max(m_SQRingSize, m_CQRingSize);
+
+                m_SQRing = static_cast<u8 *>(mmap(nullptr, m_SQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Fd, IORING_OFF_SQ_RING));
+                if (m_SQRing == MAP_FAILED)
+                {
+                    m_SQRing = nullptr;
+                    return false;
+                }
+
+                if (singleMap)
+                {
+                    m_CQRing = m_SQRing;
+                }
+                else
+                {
+                    m_CQRing = static_cast<u8 *>(mmap(nullptr, m_CQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Fd, IORING_OFF_CQ_RING));
+                    if (m_CQRing == MAP_FAILED)
+                    {
+                        m_CQRing = nullptr;
+                        return false;
+                    }
+                }
+
+                m_SQEsSize = params.sq_entries * sizeof(io_uring_sqe);
+                m_SQEs = static_cast<io_uring_sqe *>(mmap(nullptr, m_SQEsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Fd, IORING_OFF_SQES));
+                if (m_SQEs == MAP_FAILED)
+                {
+                    m_SQEs = nullptr;
+                    return false;
+                }
+
+                m_SQTail = reinterpret_cast<u32 *>(m_SQRing + params.sq_off.tail);
+                m_SQMask = *reinterpret_cast<u32 *>(m_SQRing + params.sq_off.ring_mask);
+                m_SQArray = reinterpret_cast<u32 *>(m_SQRing + params.sq_off.array);
+                m_CQHead = reinterpret_cast<u32 *>(m_CQRing + params.cq_off.head);
+                m_CQTail = reinterpret_cast<u32 *>(m_CQRing + params.cq_off.tail);
+                m_CQMask = *reinterpret_cast<u32 *>(m_CQRing + params.cq_off.ring_mask);
+                m_CQEs = reinterpret_cast<io_uring_cqe *>(m_CQRing + params.cq_off.cqes);
+                m_Entries = params.sq_entries;
+
+                return true;
+            }
+
+            u32 GetEntries() const { return m_Entries; }
+
+            void PushRead(RingRead *read)
+            {
+                const u32 tail = *m_SQTail;
+                const u32 index = tail & m_SQMask;
+
+                read->iov.iov_base = read->data + read->offset;
+                read->iov.iov_len = static_cast<size_t>(std::min(read->size - read->offset, RingMaxReadSize));
+
+                io_uring_sqe &sqe = m_SQEs[index];
+                sqe = {};
+                sqe.opcode = IORING_OP_READV;
+                sqe.fd = read->fd;
+                sqe.addr = reinterpret_cast<u64>(&read->iov);
+                sqe.len = 1;
+                sqe.off = read->offset;
+                sqe.user_data = reinterpret_cast<u64>(read);
+
+                m_SQArray[index] = index;
+                __atomic_store_n(m_SQTail, tail + 1, __ATOMIC_RELEASE);
+                ++m_Unsubmitted;
+            }
+
+            // submits the queued reads and optionally blocks until one completes
+            bool Enter(bool wait)
+            {
+                const u32 submit = m_Unsubmitted;
+                const int result = static_cast<int>(syscall(__NR_io_uring_enter, m_Fd, submit, wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0, nullptr, 0));
+                if (result < 0)
+                    return errno == EINTR || errno == EAGAIN || errno == EBUSY;
+
+                m_Unsubmitted -= std::min<u32>(static_cast<u32>(result), submit);
+                return true;
+            }
+
+            template<typename Func>
+            void Reap(Func &&func)
+            {
+                u32 head = *m_CQHead;
+                const u32 tail = __atomic_load_n(m_CQTail, __ATOMIC_ACQUIRE);
+
+                for (; head != tail; ++head)
+                {
+                    const io_uring_cqe &cqe = m_CQEs[head & m_CQMask];
+                    func(reinterpret_cast<RingRead *>(cqe.user_data), cqe.res);
+                }
+
+                __atomic_store_n(m_CQHead, head, __ATOMIC_RELEASE);
+            }
+
+        private:
+            int m_Fd = -1;
+            u8 *m_SQRing = nullptr;
+            u8 *m_CQRing = nullptr;
+            size_t m_SQRingSize = 0;
+            size_t m_CQRingSize = 0;
+            io_uring_sqe *m_SQEs = nullptr;
+            size_t m_SQEsSize = 0;
+
+            u32 *m_SQTail = nullptr;
+            u32 *m_SQArray = nullptr;
+            u32 m_SQMask = 0;
+            u32 *m_CQHead = nullptr;
+            u32 *m_CQTail = nullptr;
+            io_uring_cqe *m_CQEs = nullptr;
+            u32 m_CQMask = 0;
+            u32 m_Entries = 0;
+            u32 m_Unsubmitted = 0;
+        };
+#endif
+
+        struct AsyncReaderData
+        {
+            std::mutex mutex;
+            std::condition_variable condition;
+            bool started = false;
+            bool poolStopping = false;
+
+            std::unordered_map<std::string, Ref<Request>> inFlight;
+            std::atomic<u32> pendingCount = 0;
+
+            std::deque<Ref<Request>> poolQueue;
+            std::vector<std::thread> workers;
+
+            NativeFileSystem nativeFS;
+
+#ifdef PLATFORM_LINUX
+            Scope<Ring> ring;
+            bool ringActive = false;
+            bool ringStopping = false;
+            std::deque<Ref<Request>> ringQueue;
+            std::condition_variable ringCondition;
+            std::thread ringThread;
+#endif
+        };
+
+        AsyncReaderData &GetData()
+        {
+            static AsyncReaderData data;
+            return data;
+        }
+
+        std::string MakeKey(IFileSystem *fs, const std::filesystem::path &path)
+        {
+            return std::to_string(reinterpret_cast<uintptr_t>(fs)) + '|' + path.lexically_normal().generic_string();
+        }
+
+        void Complete(const Ref<Request> &request, const Ref<IBlob> &blob)
+        {
+            AsyncReaderData &data = GetData();
+
+            // removed before the callbacks run, a later request for the file starts a new read
+            std::vector<ReadCallback> callbacks;
+            {
+                std::lock_guard lock(data.mutex);
+                data.inFlight.erase(request->key);
+                callbacks = std::move(request->callbacks);
+            }
+
+            request->promise.set_value(blob);
+
+            for (const ReadCallback &callback : callbacks)
+                callback(blob);
+
+            data.pendingCount.fetch_sub(1, std::memory_order_release);
+        }
+
+        void WorkerThread()
+        {
+            AsyncReaderData &data = GetData();
+
+            while (true)
+            {
+                Ref<Request> request;
+                {
+                    std::unique_lock lock(data.mutex);
+                    data.condition.wait(lock, [&data] { return data.poolStopping || !data.poolQueue.empty(); });
+
+                    // the queue is drained before the worker stops
+                    if (data.poolQueue.empty())
+                        return;
+
+                    request = std::move(data.poolQueue.front());
+                    data.poolQueue.pop_front();
+                }
+
+                IFileSystem *fs = request->fs ? request->fs : &data.nativeFS;
+                Complete(request, fs->ReadFile(request->path));
+            }
+        }
+
+#ifdef PLATFORM_LINUX
+        // the ring could not read the file, the pool retries it with ReadFile
+        void FallbackToPool(const Ref<Request> &request)
+        {
+            AsyncReaderData &data = GetData();
+            {
+                std::lock_guard lock(data.mutex);
+                data.poolQueue.push_back(request);
+            }
+            data.condition.notify_one();
+        }
+
+        void FinishRingRead(RingRead *read, bool success)
+        {
+            close(read->fd);
+
+            if (success)
+            {
+                Complete(read->request, CreateRef<Blob>(read->data, static_cast<size_t>(read->size)));
+            }
+            else
+            {
+                free(read->data);
+                FallbackToPool(read->request);
+            }
+
+            delete read;
+        }
+
+        // opens the file and queues the first read, false when the request completed right away
+        RingRead *StartRingRead(const Ref<Request> &request)
+        {
+            const int fd = open(request->path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                Complete(request, nullptr);
+                return nullptr;
+            }
+
+            struct stat st = {};
+            if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+            {
+                close(fd);
+                Complete(request, nullptr);
+                return nullptr;
+            }
+
+            if (st.st_size == 0)
+            {
+                close(fd);
+                Complete(request, CreateRef<Blob>(nullptr, 0));
+                return nullptr;
+            }
+
+            u8 *buffer = static_cast<u8 *>(malloc(static_cast<size_t>(st.st_size)));
+            if (buffer == nullptr)
+            {
+                close(fd);
+                LOG_ASSERT(false, "Out of memory");
+                Complete(request, nullptr);
+                return nullptr;
+            }
+
+            RingRead *read = new RingRead();
+            read->request = request;
+            read->fd = fd;
+            read->data = buffer;
+            read->size = static_cast<u64>(st.st_size);
+            return read;
+        }
+
+        void RingThread()
+        {
+            AsyncReaderData &data = GetData();
+            Ring &ring = *data.ring;
+
+            // the completion queue is twice the submission queue, it never overflows at this depth
+            const u32 maxActive = ring.GetEntries();
+            std::vector<RingRead *> active;
+
+            while (true)
+            {
+                std::deque<Ref<Request>> incoming;
+                {
+                    std::unique_lock lock(data.mutex);
+                    if (active.empty())
+                    {
+                        data.ringCondition.wait(lock, [&data] { return data.ringStopping || !data.ringQueue.empty(); });
+                        if (data.ringQueue.empty())
+                            return;
+                    }
+
+                    while (!data.ringQueue.empty() && active.size() + incoming.size() < maxActive)
+                    {
+                        incoming.push_back(std::move(data.ringQueue.front()));
+                        data.ringQueue.pop_front();
+                    }
+                }
+
+                for (const Ref<Request> &request : incoming)
+                {
+                    if (RingRead *read = StartRingRead(request))
+                    {
+                        ring.PushRead(read);
+                        active.push_back(read);
+                    }
+                }
+
+                if (active.empty())
+                    continue;
+
+                if (!ring.Enter(true))
+                {
+                    LOG_ERROR("[Async Reader] io_uring_enter failed ({}), using the thread pool", errno);
+
+                    // the kernel may still write into the active buffers, they are left allocated
+                    std::lock_guard lock(data.mutex);
+                    data.ringActive = false;
+                    for (RingRead *read : active)
+                        data.poolQueue.push_back(read->request);
+                    for (Ref<Request> &request : data.ringQueue)
+                        data.poolQueue.push_back(std::move(request));
+                    data.ringQueue.clear();
+                    data.condition.notify_all();
+                    return;
+                }
+
+                ring.Reap([&](RingRead *read, int result)
+                {
+                    if (result == -EINTR || result == -EAGAIN)
+                    {
+                        ring.PushRead(read);
+                        return;
+                    }
+
+                    read->offset += result > 0 ? static_cast<u64>(result) : 0;
+                    if (result > 0 && read->offset < read->size)
+                    {
+                        ring.PushRead(read);
+                        return;
+                    }
+
+                    // errors and a file that shrank while read both go through ReadFile
+                    active.erase(std::find(active.begin(), active.end(), read));
+                    FinishRingRead(read, result > 0);
+                });
+            }
+        }
+#endif
+
+        void Start()
+        {
+            AsyncReaderData &data = GetData();
+            data.started = true;
+            data.poolStopping = false;
+
+            for (u32 i = 0; i < ASYNC_READER_WORKERS; ++i)
+                data.workers.emplace_back(WorkerThread);
+
+#ifdef PLATFORM_LINUX
+            // seccomp filters in containers and sandboxes often deny io_uring
+            Scope<Ring> ring = CreateScope<Ring>();
+            if (ring->Init(ASYNC_READER_QUEUE_DEPTH))
+            {
+                data.ring = std::move(ring);
+                data.ringActive = true;
+                data.ringStopping = false;
+                data.ringThread = std::thread(RingThread);
+            }
+            else
+            {
+                LOG_INFO("[Async Reader] io_uring is not available ({}), using the thread pool", errno);
+            }
+#endif
+        }
+    }
+
+    std::vector<ReadFuture> AsyncReader::Submit(IFileSystem *fs, std::vector<AsyncRead> reads)
+    {
+        AsyncReaderData &data = GetData();
+        std::vector<ReadFuture> futures;
+        futures.reserve(reads.size());
+
+        bool queuedPool = false;
+        bool queuedRing = false;
+        {
+            std::lock_guard lock(data.mutex);
+            if (!data.started)
+                Start();
+
+            for (AsyncRead &read : reads)
+            {
+                std::string key = MakeKey(fs, read.path);
+
+                // coalesce with a read of the same file that is still in flight
+                auto it = data.inFlight.find(key);
+                if (it != data.inFlight.end())
+                {
+                    if (read.callback)
+                        it->second->callbacks.push_back(std::move(read.callback));
+                    futures.push_back(it->second->future);
+                    continue;
+                }
+
+                Ref<Request> request = CreateRef<Request>();
+                request->fs = fs;
+                request->path = std::move(read.path);
+                request->key = key;
+                request->future = request->promise.get_future().share();
+                if (read.callback)
+                    request->callbacks.push_back(std::move(read.callback));
+
+                data.inFlight.emplace(std::move(key), request);
+                data.pendingCount.fetch_add(1, std::memory_order_relaxed);
+                futures.push_back(request->future);
+
+#ifdef PLATFORM_LINUX
+                if (fs == nullptr && data.ringActive)
+                {
+                    data.ringQueue.push_back(std::move(request));
+                    queuedRing = true;
+                    continue;
+                }
+#endif
+                data.poolQueue.push_back(std::move(request));
+                queuedPool = true;
+            }
+        }
+
+        if (queuedPool)
+            data.condition.notify_all();
+
+#ifdef PLATFORM_LINUX
+        if (queuedRing)
+            data.ringCondition.notify_one();
+#else
+        (void)queuedRing;
+#endif
+
+        return futures;
+    }
+
+    void AsyncReader::Prefetch(const std::vector<std::filesystem::path> &paths)
+    {
+#ifdef PLATFORM_LINUX
+        // WILLNEED starts the readahead and returns, the pages are not copied out
+        for (const std::filesystem::path &path : paths)
+        {
+            const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                continue;
+
+            posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+            close(fd);
+        }
+#else
+        (void)paths;
+#endif
+    }
+
+    void AsyncReader::Shutdown()
+    {
+        AsyncReaderData &data = GetData();
+        {
+            std::lock_guard lock(data.mutex);
+            if (!data.started)
+                return;
+        }
+
+#ifdef PLATFORM_LINUX
+        // the ring thread first, it can still hand failed reads to the pool
+        {
+            std::lock_guard lock(data.mutex);
+            data.ringStopping = true;
+        }
+        data.ringCondition.notify_all();
+        if (data.ringThread.joinable())
+            data.ringThread.join();
+        data.ringActive = false;
+        data.ring.reset();
+#endif
+
+        {
+            std::lock_guard lock(data.mutex);
+            data.poolStopping = true;
+        }
+        data.condition.notify_all();
+
+        for (std::thread &worker : data.workers)
+            worker.join();
+        data.workers.clear();
+
+        std::lock_guard lock(data.mutex);
+        data.started = false;
+    }
+
+    const char *AsyncReader::GetBackendName()
+    {
+#ifdef PLATFORM_LINUX
+        AsyncReaderData &data = GetData();
+        std::lock_guard lock(data.mutex);
+        if (data.ringActive)
+            return "io_uring";
+#endif
+        return "thread pool";
+    }
+
+    u32 AsyncReader::GetPendingCount()
+    {
+        return GetData().pendingCount.load(std::memory_order_acquire);
+    }
+}
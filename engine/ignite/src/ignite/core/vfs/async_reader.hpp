@@ -0,0 +1,35 @@
+#pragma once
+
+#include "vfs.hpp"
+
+#include <future>
+#include <string>
+#include <vector>
+
+namespace ignite::vfs
+{
+#define ASYNC_READER_QUEUE_DEPTH 64
+#define ASYNC_READER_WORKERS 4
+
+    // Requests to the same file that are still in flight share one read and one future.
+    // Native reads go through io_uring on Linux when the kernel allows it,
+    // everything else is read by a small thread pool. Callbacks run on the reader threads,
+    // hand main thread work to Application::SubmitToMainThread.
+    class AsyncReader
+    {
+    public:
+        // fs == nullptr reads native paths directly. fs must outlive its requests
+        static std::vector<ReadFuture> Submit(IFileSystem *fs, std::vector<AsyncRead> reads);
+
+        // asks the OS to read native files into the page cache without copying them anywhere,
+        // for files that are opened or mapped by someone else later. a no-op without such a hint
+        static void Prefetch(const std::vector<std::filesystem::path> &paths);
+
+        // waits for every request and stops the reader threads
+        static void Shutdown();
+
+        // "io_uring" or "thread pool"
+        static const char *GetBackendName();
+        static u32 GetPendingCount();
+    };
+}
@@ -0,0 +1,475 @@
+#include "directory_index.hpp"
+
+#include "ignite/core/logger.hpp"
+
+#include <algorithm>
+
+#ifdef PLATFORM_LINUX
+#   include <sys/eventfd.h>
+#   include <sys/inotify.h>
+#   include <poll.h>
+#   include <unistd.h>
+#   include <cerrno>
+#else
+#   include "FileWatch.hpp"
+#endif
+
+namespace ignite::vfs
+{
+    namespace
+    {
+        std::string GetParent(const std::string &path)
+        {
+            const size_t slash = path.rfind('/');
+            return slash == std::string::npos ? std::string() : path.substr(0, slash);
+        }
+
+        std::string GetFilename(const std::string &path)
+        {
+            const size_t slash = path.rfind('/');
+            return slash == std::string::npos ? path : path.substr(slash + 1);
+        }
+
+        std::string Join(const std::string &directory, const std::string &name)
+        {
+            return directory.empty() ? name : directory + '/' + name;
+        }
+
+        bool Contains(const std::vector<std::string> &names, const std::string &name)
+        {
+            return std::binary_search(names.begin(), names.end(), name);
+        }
+
+#ifdef PLATFORM_LINUX
+        constexpr u32 WatchMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+#endif
+    }
+
+#ifndef PLATFORM_LINUX
+    // ReadDirectoryChangesW reports the whole tree with paths relative to the root
+    class DirectoryWatcher
+    {
+    public:
+        DirectoryWatcher(const std::filesystem::path &rootPath, std::function<void(const std::string &, filewatch::Event)> callback)
+            : m_Watch(rootPath.string(), [callback](const std::string &path, const filewatch::Event event) { callback(path, event); })
+        {
+        }
+
+    private:
+        filewatch::FileWatch<std::string> m_Watch;
+    };
+#endif
+
+    DirectoryIndex::DirectoryIndex(const std::filesystem::path &rootPath)
+        : m_RootPath(rootPath.lexically_normal())
+    {
+#ifdef PLATFORM_LINUX
+        m_InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        m_WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (m_InotifyFd >= 0 && m_WakeFd >= 0)
+        {
+            m_Watching = true;
+            m_WatchThread = std::thread(&DirectoryIndex::WatchThread, this);
+        }
+        else
+        {
+            LOG_WARN("[Directory Index] inotify is not available ({}), {} is not cached", errno, m_RootPath.generic_string());
+        }
+#else
+        try
+        {
+            m_Watcher = CreateScope<DirectoryWatcher>(m_RootPath, [this](const std::string &path, const filewatch::Event event)
+            {
+                const std::string key = NormalizePath(path);
+
+                std::unique_lock lock(m_Mutex);
+                InvalidateLocked(GetParent(key));
+                if (event == filewatch::Event::removed || event == filewatch::Event::renamed_old)
+                    DropSubtreeLocked(key);
+            });
+            m_Watching = true;
+        }
+        catch (const std::exception &e)
+        {
+            LOG_WARN("[Directory Index] Can not watch {}: {}", m_RootPath.generic_string(), e.what());
+        }
+#endif
+    }
+
+    DirectoryIndex::~DirectoryIndex()
+    {
+#ifdef PLATFORM_LINUX
+        if (m_WatchThread.joinable())
+        {
+            const u64 wake = 1;
+            (void)write(m_WakeFd, &wake, sizeof(wake));
+            m_WatchThread.join();
+        }
+
+        if (m_InotifyFd >= 0)
+            close(m_InotifyFd);
+        if (m_WakeFd >= 0)
+            close(m_WakeFd);
+#else
+        m_Watcher.reset();
+#endif
+    }
+
+    bool DirectoryIndex::FileExists(const std::string &path)
+    {
+        bool found = false;
+        WithListing(GetParent(path), [&](const Listing &listing)
+        {
+            found = Contains(listing.files, GetFilename(path));
+        });
+        return found;
+    }
+
+    bool DirectoryIndex::DirectoryExists(const std::string &path)
+    {
+        // the root is read directly, everything below through the parent listing
+        if (path.empty())
+            return WithListing(path, [](const Listing &) {});
+
+        bool found = false;
+        WithListing(GetParent(path), [&](const Listing &listing)
+        {
+            found = Contains(listing.directories, GetFilename(path));
+        });
+        return found;
+    }
+
+    bool DirectoryIndex::GetListing(const std::string &path, std::vector<std::string> *outFiles, std::vector<std::string> *outDirectories)
+    {
+        return WithListing(path, [&](const Listing &listing)
+        {
+            if (outFiles)
+                *outFiles = listing.files;
+            if (outDirectories)
+                *outDirectories = listing.directories;
+        });
+    }
+
+    void DirectoryIndex::Invalidate(const std::string &path)
+    {
+        std::unique_lock lock(m_Mutex);
+        InvalidateLocked(path);
+    }
+
+    std::string DirectoryIndex::NormalizePath(const std::filesystem::path &path)
+    {
+        std::string pathStr = path.generic_string();
+        std::replace(pathStr.begin(), pathStr.end(), '\\', '/');
+        pathStr = std::filesystem::path(pathStr).lexically_normal().generic_string();
+
+        const size_t first = pathStr.find_first_not_of('/');
+        if (first == std::string::npos || pathStr == ".")
+            return {};
+
+        const size_t last = pathStr.find_last_not_of('/');
+        return pathStr.substr(first, last - first + 1);
+    }
+
+    template<typename Func>
+    bool DirectoryIndex::WithListing(const std::string &path, Func &&func)
+    {
+        {
+            std::shared_lock lock(m_Mutex);
+            auto it = m_Directories.find(path);
+            if (it != m_Directories.end() && it->second.valid)
+            {
+                func(it->second);
+                return true;
+            }
+        }
+
+        // a directory is only read when its parent lists it, missing paths never reach the disk
+        if (!path.empty() && !DirectoryExists(path))
+            return false;
+
+        Listing listing;
+        if (!Scan(path, listing))
+            return false;
+
+        func(listing);
+        return true;
+    }
+
+    bool DirectoryIndex::Scan(const std::string &path, Listing &outListing)
+    {
+        const std::filesystem::path nativePath = path.empty() ? m_RootPath : m_RootPath / path;
+
+        int watch = -1;
+#ifdef PLATFORM_LINUX
+        {
+            std::shared_lock lock(m_Mutex);
+            if (auto it = m_Directories.find(path); it != m_Directories.end())
+                watch = it->second.watch;
+        }
+
+        // watched before the read, a change after this point invalidates the new listing
+        if (watch < 0 && m_Watching)
+        {
+            watch = inotify_add_watch(m_InotifyFd, nativePath.c_str(), WatchMask);
+            if (watch < 0 && errno != ENOENT && errno != ENOTDIR)
+                LOG_WARN("[Directory Index] Can not watch {} ({}), it is read on every use", nativePath.generic_string(), errno);
+        }
+#endif
+
+        u64 epoch = 0;
+        {
+            std::unique_lock lock(m_Mutex);
+            Listing &entry = m_Directories[path];
+            epoch = entry.epoch = ++m_Epoch;
+            entry.watch = watch;
+
+#ifdef PLATFORM_LINUX
+            if (watch >= 0)
+                m_Watches[watch] = path;
+#endif
+        }
+
+        std::error_code ec;
+        std::filesystem::directory_iterator it(nativePath, std::filesystem::directory_options::skip_permission_denied, ec);
+        if (ec)
+        {
+            // listed by the parent but unreadable, e.g. permissions
+            std::unique_lock lock(m_Mutex);
+            auto entry = m_Directories.find(path);
+            if (entry != m_Directories.end() && entry->second.epoch == epoch)
+            {
+#ifdef PLATFORM_LINUX
+                if (watch >= 0)
+                {
+                    inotify_rm_watch(m_InotifyFd, watch);
+                    m_Watches.erase(watch);
+                }
+#endif
+                m_Directories.erase(entry);
+            }
+            return false;
+        }
+
+        for (; it != std::filesystem::directory_iterator(); it.increment(ec))
+        {
+            if (ec)
+                break;
+
+            std::error_code typeEc;
+            const std::string name = it->path().filename().generic_string();
+            if (it->is_directory(typeEc))
+                outListing.directories.push_back(name);
+            else if (!typeEc)
+                outListing.files.push_back(name);
+        }
+
+        std::sort(outListing.files.begin(), outListing.files.end());
+        std::sort(outListing.directories.begin(), outListing.directories.end());
+
+        std::unique_lock lock(m_Mutex);
+        auto entry = m_Directories.find(path);
+        if (entry != m_Directories.end() && entry->second.epoch == epoch)
+        {
+            entry->second.files = outListing.files;
+            entry->second.directories = outListing.directories;
+
+#ifdef PLATFORM_LINUX
+            entry->second.valid = m_Watching && watch >= 0 && !ec;
+#else
+            entry->second.valid = m_Watching && !ec;
+#endif
+        }
+
+        return true;
+    }
+
+    void DirectoryIndex::InvalidateLocked(const std::string &path)
+    {
+        auto it = m_Directories.find(path);
+        if (it == m_Directories.end())
+            return;
+
+        Listing &listing = it->second;
+        listing.epoch = ++m_Epoch;
+        listing.valid = false;
+        listing.files.clear();
+        listing.directories.clear();
+
+        m_Version.fetch_add(1, std::memory_order_release);
+    }
+
+    void DirectoryIndex::DropSubtreeLocked(const std::string &path)
+    {
+        const std::string prefix = path + '/';
+        bool dropped = false;
+
+        for (auto it = m_Directories.begin(); it != m_Directories.end();)
+        {
+            const bool inside = path.empty() || it->first == path || it->first.starts_with(prefix);
+            if (!inside)
+            {
+                ++it;
+                continue;
+            }
+
+#ifdef PLATFORM_LINUX
+            if (it->second.watch >= 0)
+            {
+                inotify_rm_watch(m_InotifyFd, it->second.watch);
+                m_Watches.erase(it->second.watch);
+            }
+#endif
+            it = m_Directories.erase(it);
+            dropped = true;
+        }
+
+        if (dropped)
+            m_Version.fetch_add(1, std::memory_order_release);
+    }
+
+    void DirectoryIndex::WatchThread()
+    {
+#ifdef PLATFORM_LINUX
+        alignas(inotify_event) char buffer[4096];
+
+        while (true)
+        {
+            pollfd fds[2] = { { m_InotifyFd, POLLIN, 0 }, { m_WakeFd, POLLIN, 0 } };
+            if (poll(fds, 2, -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                break;
+            }
+
+            if (fds[1].revents & POLLIN)
+                break;
+
+            const ssize_t length = read(m_InotifyFd, buffer, sizeof(buffer));
+            if (length <= 0)
+                continue;
+
+            std::unique_lock lock(m_Mutex);
+
+            for (ssize_t offset = 0; offset < length;)
+            {
+                const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                // events were lost, nothing cached can be trusted
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    for (auto &[path, listing] : m_Directories)
+                        InvalidateLocked(path);
+                    continue;
+                }
+
+                auto watch = m_Watches.find(event->wd);
+                if (watch == m_Watches.end())
+                    continue;
+
+                const std::string directory = watch->second;
+
+                if (event->mask & IN_IGNORED)
+                {
+                    m_Watches.erase(watch);
+                    if (auto it = m_Directories.find(directory); it != m_Directories.end() && it->second.watch == event->wd)
+                        it->second.watch = -1;
+                    InvalidateLocked(directory);
+                    continue;
+                }
+
+                if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+                {
+                    DropSubtreeLocked(directory);
+                    continue;
+                }
+
+                InvalidateLocked(directory);
+
+                // a removed or renamed directory takes its cached children with it
+                if ((event->mask & IN_ISDIR) && (event->mask & (IN_DELETE | IN_MOVED_FROM)) && event->len > 0)
+                    DropSubtreeLocked(Join(directory, event->name));
+            }
+        }
+#endif
+    }
+
+    IndexedFileSystem::IndexedFileSystem(const std::filesystem::path &nativePath)
+        : RelativeFileSystem(std::make_shared<NativeFileSystem>(), nativePath)
+        , m_Index(nativePath)
+    {
+    }
+
+    bool IndexedFileSystem::DirectoryExists(const std::filesystem::path &path)
+    {
+        const std::string key = DirectoryIndex::NormalizePath(path);
+        if (key.starts_with(".."))
+            return RelativeFileSystem::DirectoryExists(path);
+
+        return m_Index.DirectoryExists(key);
+    }
+
+    bool IndexedFileSystem::FileExists(const std::filesystem::path &path)
+    {
+        const std::string key = DirectoryIndex::NormalizePath(path);
+        if (key.starts_with("..") || key.empty())
+            return RelativeFileSystem::FileExists(path);
+
+        return m_Index.FileExists(key);
+    }
+
+    bool IndexedFileSystem::WriteFile(const std::filesystem::path &path, const void *data, const size_t size)
+    {
+        const bool result = RelativeFileSystem::WriteFile(path, data, size);
+
+        // visible right away, the watcher reports it a moment later
+        m_Index.Invalidate(GetParent(DirectoryIndex::NormalizePath(path)));
+        return result;
+    }
+
+    int IndexedFileSystem::EnumerateFiles(const std::filesystem::path &path, const std::vector<std::string> &extensions, enumerate_callback_t callback, bool allowDuplicates)
+    {
+        const std::string key = DirectoryIndex::NormalizePath(path);
+        if (key.starts_with(".."))
+            return RelativeFileSystem::EnumerateFiles(path, extensions, callback, allowDuplicates);
+
+        std::vector<std::string> files;
+        if (!m_Index.GetListing(key, &files, nullptr))
+            return 0;
+
+        int numEntries = 0;
+        for (const std::string &filename : files)
+        {
+            const bool matches = extensions.empty() || std::any_of(extensions.begin(), extensions.end(), [&filename](const std::string &ext)
+            {
+                return filename.ends_with(ext);
+            });
+
+            if (matches)
+            {
+                callback(filename);
+                ++numEntries;
+            }
+        }
+
+        return numEntries;
+    }
+
+    int IndexedFileSystem::EnumerateDirectories(const std::filesystem::path &path, enumerate_callback_t callback, bool allowDuplicates)
+    {
+        const std::string key = DirectoryIndex::NormalizePath(path);
+        if (key.starts_with(".."))
+            return RelativeFileSystem::EnumerateDirectories(path, callback, allowDuplicates);
+
+        std::vector<std::string> directories;
+        if (!m_Index.GetListing(key, nullptr, &directories))
+            return 0;
+
+        for (const std::string &directory : directories)
+            callback(directory);
+
+        return static_cast<int>(directories.size());
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "vfs.hpp"
+
+#include <atomic>
+#include <shared_mutex>
+#include <thread>
+
+namespace ignite::vfs
+{
+    // Listings of a native directory tree, each directory is read once on first use
+    // and dropped when inotify (ReadDirectoryChangesW on Windows) reports a change in it.
+    // paths are relative to the root, see NormalizePath
+    class DirectoryIndex
+    {
+    public:
+        explicit DirectoryIndex(const std::filesystem::path &rootPath);
+        ~DirectoryIndex();
+
+        DirectoryIndex(const DirectoryIndex &) = delete;
+        DirectoryIndex &operator=(const DirectoryIndex &) = delete;
+
+        bool FileExists(const std::string &path);
+        bool DirectoryExists(const std::string &path);
+
+        // sorted names, false when the directory does not exist
+        bool GetListing(const std::string &path, std::vector<std::string> *outFiles, std::vector<std::string> *outDirectories);
+
+        // drop the listing of a directory, e.g. after writing into it
+        void Invalidate(const std::string &path);
+
+        // changes with every invalidation, lets views know when to refresh
+        [[nodiscard]] u64 GetVersion() const { return m_Version.load(std::memory_order_acquire); }
+
+        // relative to the root without leading or trailing separators, paths leaving the root start with ".."
+        static std::string NormalizePath(const std::filesystem::path &path);
+
+    private:
+        struct Listing
+        {
+            std::vector<std::string> files;
+            std::vector<std::string> directories;
+            u64 epoch = 0;
+            bool valid = false;
+            int watch = -1;
+        };
+
+        template<typename Func>
+        bool WithListing(const std::string &path, Func &&func);
+        bool Scan(const std::string &path, Listing &outListing);
+
+        void InvalidateLocked(const std::string &path);
+        void DropSubtreeLocked(const std::string &path);
+        void WatchThread();
+
+        std::filesystem::path m_RootPath;
+
+        std::shared_mutex m_Mutex;
+        std::unordered_map<std::string, Listing> m_Directories;
+        u64 m_Epoch = 0;
+        std::atomic<u64> m_Version = 0;
+
+        // listings are only kept while something reports changes to them
+        bool m_Watching = false;
+
+#ifdef PLATFORM_LINUX
+        int m_InotifyFd = -1;
+        int m_WakeFd = -1;
+        std::unordered_map<int, std::string> m_Watches;
+        std::thread m_WatchThread;
+#else
+        Scope<class DirectoryWatcher> m_Watcher;
+#endif
+    };
+
+    // native directory whose existence checks and enumeration are answered by a DirectoryIndex
+    class IndexedFileSystem : public RelativeFileSystem
+    {
+    public:
+        explicit IndexedFileSystem(const std::filesystem::path &nativePath);
+
+        virtual bool DirectoryExists(const std::filesystem::path &path) override;
+        virtual bool FileExists(const std::filesystem::path &path) override;
+
+        virtual bool WriteFile(const std::filesystem::path &path, const void *data, const size_t size) override;
+
+        virtual int EnumerateFiles(const std::filesystem::path &path, const std::vector<std::string> &extensions, enumerate_callback_t callback, bool allowDuplicates = false) override;
+        virtual int EnumerateDirectories(const std::filesystem::path &path, enumerate_callback_t callback, bool allowDuplicates) override;
+
+        DirectoryIndex &GetIndex() { return m_Index; }
+
+    private:
+        DirectoryIndex m_Index;
+    };
+}
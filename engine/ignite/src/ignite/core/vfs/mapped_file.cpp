@@ -0,0 +1,111 @@
+#include "mapped_file.hpp"
+
+#include "ignite/core/logger.hpp"
+
+#include <algorithm>
+
+#ifdef PLATFORM_WINDOWS
+#   include <Windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace ignite::vfs
+{
+    MappedFile::~MappedFile()
+    {
+#ifdef PLATFORM_WINDOWS
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_Mapping)
+            CloseHandle(m_Mapping);
+        if (m_File && m_File != INVALID_HANDLE_VALUE)
+            CloseHandle(m_File);
+#else
+        if (m_Data)
+            munmap(const_cast<u8 *>(m_Data), m_Size);
+        if (m_File >= 0)
+            close(m_File);
+#endif
+    }
+
+    Ref<MappedFile> MappedFile::Open(const std::filesystem::path &filepath)
+    {
+        Ref<MappedFile> mapped = CreateRef<MappedFile>();
+
+#ifdef PLATFORM_WINDOWS
+        mapped->m_File = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (mapped->m_File == INVALID_HANDLE_VALUE)
+            return nullptr;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(mapped->m_File, &size) || size.QuadPart == 0)
+            return nullptr;
+
+        mapped->m_Mapping = CreateFileMappingW(mapped->m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapped->m_Mapping)
+            return nullptr;
+
+        mapped->m_Data = static_cast<const u8 *>(MapViewOfFile(mapped->m_Mapping, FILE_MAP_READ, 0, 0, 0));
+        mapped->m_Size = static_cast<u64>(size.QuadPart);
+#else
+        mapped->m_File = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (mapped->m_File < 0)
+            return nullptr;
+
+        struct stat st;
+        if (fstat(mapped->m_File, &st) != 0 || st.st_size == 0)
+            return nullptr;
+
+        void *data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, mapped->m_File, 0);
+        if (data == MAP_FAILED)
+            return nullptr;
+
+        mapped->m_Data = static_cast<const u8 *>(data);
+        mapped->m_Size = static_cast<u64>(st.st_size);
+#endif
+
+        if (!mapped->m_Data)
+        {
+            LOG_ERROR("[Mapped File] Failed to map {}", filepath.generic_string());
+            return nullptr;
+        }
+
+        return mapped;
+    }
+
+    void MappedFile::Prefetch(u64 offset, u64 size) const
+    {
+        if (!m_Data || offset >= m_Size)
+            return;
+
+        size = std::min(size, m_Size - offset);
+
+#ifdef PLATFORM_WINDOWS
+        WIN32_MEMORY_RANGE_ENTRY range = { const_cast<u8 *>(m_Data) + offset, static_cast<SIZE_T>(size) };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        // madvise wants a page aligned start
+        const u64 pageSize = static_cast<u64>(sysconf(_SC_PAGESIZE));
+        const u64 alignedOffset = offset - offset % pageSize;
+        madvise(const_cast<u8 *>(m_Data) + alignedOffset, static_cast<size_t>(size + offset - alignedOffset), MADV_WILLNEED);
+#endif
+    }
+
+    MappedBlob::MappedBlob(Ref<MappedFile> file, u64 offset, u64 size)
+        : m_File(std::move(file))
+    {
+        LOG_ASSERT(m_File && offset <= m_File->Size() && size <= m_File->Size() - offset, "[Mapped File] Blob range is out of bounds");
+
+        m_Data = m_File->Data() + offset;
+        m_Size = static_cast<size_t>(size);
+    }
+
+    MappedBlob::MappedBlob(Ref<MappedFile> file)
+        : MappedBlob(file, 0, file ? file->Size() : 0)
+    {
+    }
+}
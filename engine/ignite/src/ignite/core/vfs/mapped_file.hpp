@@ -0,0 +1,58 @@
+#pragma once
+
+#include "vfs.hpp"
+
+#include "ignite/core/types.hpp"
+
+#include <filesystem>
+
+namespace ignite::vfs
+{
+    // Read only view of a whole file mapped into the address space,
+    // pages are read by the OS on first access.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        // nullptr when the file can not be opened or mapped
+        static Ref<MappedFile> Open(const std::filesystem::path &filepath);
+
+        [[nodiscard]] const u8 *Data() const { return m_Data; }
+        [[nodiscard]] u64 Size() const { return m_Size; }
+
+        // hint that the range is read soon, e.g. the table of contents of a pack
+        void Prefetch(u64 offset, u64 size) const;
+
+    private:
+        const u8 *m_Data = nullptr;
+        u64 m_Size = 0;
+
+#ifdef PLATFORM_WINDOWS
+        void *m_File = nullptr;
+        void *m_Mapping = nullptr;
+#else
+        int m_File = -1;
+#endif
+    };
+
+    // Blob over a range of a mapped file, keeps the mapping alive while referenced
+    class MappedBlob : public IBlob
+    {
+    public:
+        MappedBlob(Ref<MappedFile> file, u64 offset, u64 size);
+        explicit MappedBlob(Ref<MappedFile> file);
+
+        [[nodiscard]] const void *Data() const override { return m_Data; }
+        [[nodiscard]] size_t Size() const override { return m_Size; }
+
+    private:
+        Ref<MappedFile> m_File;
+        const void *m_Data = nullptr;
+        size_t m_Size = 0;
+    };
+}
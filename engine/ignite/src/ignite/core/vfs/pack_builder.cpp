@@ -0,0 +1,216 @@
+#include "pack_file_system.hpp"
+
+#include "ignite/core/compression.hpp"
+#include "ignite/core/hash.hpp"
+#include "ignite/core/logger.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+namespace ignite::vfs
+{
+    namespace
+    {
+        u64 AlignUp(u64 value, u64 alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        void WritePadding(std::ofstream &file, u64 size)
+        {
+            static const char zeros[IXPAK_ALIGNMENT] = {};
+            while (size > 0)
+            {
+                const u64 chunk = std::min<u64>(size, sizeof(zeros));
+                file.write(zeros, static_cast<std::streamsize>(chunk));
+                size -= chunk;
+            }
+        }
+
+        bool ReadNativeFile(const std::filesystem::path &filepath, std::vector<u8> &outData)
+        {
+            std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+            if (!file)
+                return false;
+
+            outData.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0, std::ios::beg);
+            file.read(reinterpret_cast<char *>(outData.data()), static_cast<std::streamsize>(outData.size()));
+            return file.good() || outData.empty();
+        }
+    }
+
+    void PackBuilder::AddFile(const std::filesystem::path &path, const std::filesystem::path &nativePath, PackCompression compression)
+    {
+        m_Sources.push_back({ PackFileSystem::NormalizePath(path), nativePath, compression });
+    }
+
+    u32 PackBuilder::AddDirectory(const std::filesystem::path &directory, PackCompression compression)
+    {
+        u32 count = 0;
+
+        std::error_code ec;
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied, ec))
+        {
+            if (!entry.is_regular_file(ec))
+                continue;
+
+            // never pack a previous build of the archive
+            if (entry.path().extension() == ".ixpak")
+                continue;
+
+            AddFile(entry.path().lexically_relative(directory), entry.path(), compression);
+            ++count;
+        }
+
+        if (ec)
+            LOG_WARN("[Pack Builder] Failed to scan {}: {}", directory.generic_string(), ec.message());
+
+        return count;
+    }
+
+    bool PackBuilder::Write(const std::filesystem::path &filepath) const
+    {
+        // lookups binary search the hash, equal hashes are told apart by the path
+        std::vector<std::pair<u64, const Source *>> sorted;
+        sorted.reserve(m_Sources.size());
+        for (const Source &source : m_Sources)
+            sorted.emplace_back(HashString(source.path), &source);
+
+        std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b)
+        {
+            if (a.first != b.first)
+                return a.first < b.first;
+            return a.second->path < b.second->path;
+        });
+
+        for (size_t i = 1; i < sorted.size(); ++i)
+        {
+            if (sorted[i].second->path == sorted[i - 1].second->path)
+            {
+                LOG_ERROR("[Pack Builder] {} was added twice", sorted[i].second->path);
+                return false;
+            }
+        }
+
+        PackHeader header;
+        header.entryCount = static_cast<u32>(sorted.size());
+
+        std::vector<PackEntry> entries(sorted.size());
+        std::string strings;
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            entries[i].pathHash = sorted[i].first;
+            entries[i].nameOffset = static_cast<u32>(strings.size());
+            entries[i].nameLength = static_cast<u32>(sorted[i].second->path.size());
+            strings += sorted[i].second->path;
+        }
+
+        header.tocOffset = sizeof(PackHeader);
+        header.stringsOffset = header.tocOffset + entries.size() * sizeof(PackEntry);
+        header.stringsSize = strings.size();
+
+        std::error_code ec;
+        if (filepath.has_parent_path())
+            std::filesystem::create_directories(filepath.parent_path(), ec);
+
+        std::filesystem::path tempFilepath = filepath;
+        tempFilepath += ".tmp";
+
+        u64 storedTotal = 0;
+        u64 sizeTotal = 0;
+
+        {
+            std::ofstream file(tempFilepath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                LOG_ERROR("[Pack Builder] Failed to write {}", filepath.generic_string());
+                return false;
+            }
+
+            // the table of contents is written last, once the offsets are known
+            u64 offset = AlignUp(header.stringsOffset + header.stringsSize, IXPAK_ALIGNMENT);
+            WritePadding(file, offset);
+
+            std::vector<u8> data;
+            std::vector<u8> compressed;
+
+            for (size_t i = 0; i < sorted.size(); ++i)
+            {
+                const Source &source = *sorted[i].second;
+                PackEntry &entry = entries[i];
+
+                if (!ReadNativeFile(source.nativePath, data))
+                {
+                    LOG_ERROR("[Pack Builder] Failed to read {}", source.nativePath.generic_string());
+                    file.close();
+                    std::filesystem::remove(tempFilepath, ec);
+                    return false;
+                }
+
+                const u8 *stored = data.data();
+                u64 storedSize = data.size();
+                entry.compression = PackCompression::None;
+
+                if (source.compression != PackCompression::None && !data.empty())
+                {
+                    if (source.compression == PackCompression::Zstd)
+                        LOG_WARN("[Pack Builder] Zstd is not supported by this build, using LZ4 for {}", source.path);
+
+                    compressed.resize(Compression::LZ4CompressBound(data.size()));
+                    const u64 compressedSize = Compression::CompressLZ4(data.data(), data.size(), compressed.data(), compressed.size());
+
+                    // already compressed formats (png, jpg, ...) barely shrink, keep them as mappable views
+                    if (compressedSize > 0 && compressedSize < data.size() - data.size() / 8)
+                    {
+                        stored = compressed.data();
+                        storedSize = compressedSize;
+                        entry.compression = PackCompression::LZ4;
+                    }
+                }
+
+                entry.offset = offset;
+                entry.storedSize = storedSize;
+                entry.size = data.size();
+
+                file.write(reinterpret_cast<const char *>(stored), static_cast<std::streamsize>(storedSize));
+                offset += storedSize;
+
+                if (i + 1 < sorted.size())
+                {
+                    const u64 aligned = AlignUp(offset, IXPAK_ALIGNMENT);
+                    WritePadding(file, aligned - offset);
+                    offset = aligned;
+                }
+
+                storedTotal += storedSize;
+                sizeTotal += data.size();
+            }
+
+            file.seekp(0, std::ios::beg);
+            file.write(reinterpret_cast<const char *>(&header), sizeof(PackHeader));
+            file.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+            file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+            if (!file.good())
+            {
+                LOG_ERROR("[Pack Builder] Failed to write {}", filepath.generic_string());
+                file.close();
+                std::filesystem::remove(tempFilepath, ec);
+                return false;
+            }
+        }
+
+        // a mounted pack never sees a partially written file
+        std::filesystem::rename(tempFilepath, filepath, ec);
+        if (ec)
+        {
+            LOG_ERROR("[Pack Builder] Failed to write {}: {}", filepath.generic_string(), ec.message());
+            std::filesystem::remove(tempFilepath, ec);
+            return false;
+        }
+
+        LOG_INFO("[Pack Builder] Wrote {} ({} files, {} -> {} bytes)", filepath.generic_string(), sorted.size(), sizeTotal, storedTotal);
+        return true;
+    }
+}
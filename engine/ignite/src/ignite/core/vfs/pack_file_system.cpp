@@ -0,0 +1,255 @@
+#include "pack_file_system.hpp"
+
+#include "ignite/core/compression.hpp"
+#include "ignite/core/hash.hpp"
+#include "ignite/core/logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ignite::vfs
+{
+    namespace
+    {
+        std::string_view GetFilename(std::string_view path)
+        {
+            const size_t slash = path.rfind('/');
+            return slash == std::string_view::npos ? path : path.substr(slash + 1);
+        }
+
+        std::string_view GetParent(std::string_view path)
+        {
+            const size_t slash = path.rfind('/');
+            return slash == std::string_view::npos ? std::string_view() : path.substr(0, slash);
+        }
+    }
+
+    Ref<PackFileSystem> PackFileSystem::Open(const std::filesystem::path &filepath)
+    {
+        Ref<PackFileSystem> fs = CreateRef<PackFileSystem>();
+        fs->m_Filepath = filepath;
+        fs->m_File = MappedFile::Open(filepath);
+
+        if (!fs->m_File)
+        {
+            LOG_ERROR("[Pack File System] Failed to open {}", filepath.generic_string());
+            return nullptr;
+        }
+
+        if (!fs->Load())
+            return nullptr;
+
+        return fs;
+    }
+
+    bool PackFileSystem::Load()
+    {
+        const u8 *data = m_File->Data();
+        const u64 size = m_File->Size();
+
+        PackHeader header;
+        if (size < sizeof(PackHeader))
+        {
+            LOG_ERROR("[Pack File System] {} is too small to be a pack", m_Filepath.generic_string());
+            return false;
+        }
+
+        std::memcpy(&header, data, sizeof(PackHeader));
+        if (header.magic != IXPAK_MAGIC || header.version != IXPAK_VERSION)
+        {
+            LOG_ERROR("[Pack File System] {} is not a pack or has an unsupported version", m_Filepath.generic_string());
+            return false;
+        }
+
+        const u64 tocSize = static_cast<u64>(header.entryCount) * sizeof(PackEntry);
+        const bool validToc = header.tocOffset % alignof(PackEntry) == 0 && header.tocOffset <= size && tocSize <= size - header.tocOffset;
+        const bool validStrings = header.stringsOffset <= size && header.stringsSize <= size - header.stringsOffset;
+        if (!validToc || !validStrings)
+        {
+            LOG_ERROR("[Pack File System] {} has a corrupted table of contents", m_Filepath.generic_string());
+            return false;
+        }
+
+        // the only random reads on mount, the file data is touched on demand
+        m_File->Prefetch(header.tocOffset, tocSize);
+        m_File->Prefetch(header.stringsOffset, header.stringsSize);
+
+        m_Entries = reinterpret_cast<const PackEntry *>(data + header.tocOffset);
+        m_EntryCount = header.entryCount;
+        m_Strings = reinterpret_cast<const char *>(data + header.stringsOffset);
+
+        for (u32 i = 0; i < m_EntryCount; ++i)
+        {
+            const PackEntry &entry = m_Entries[i];
+
+            const bool validName = static_cast<u64>(entry.nameOffset) + entry.nameLength <= header.stringsSize;
+            const bool validData = entry.offset <= size && entry.storedSize <= size - entry.offset;
+            if (!validName || !validData)
+            {
+                LOG_ERROR("[Pack File System] {} has a corrupted entry {}", m_Filepath.generic_string(), i);
+                return false;
+            }
+
+            const std::string_view name = GetName(entry);
+            std::string_view directory = GetParent(name);
+            m_DirectoryFiles[std::string(directory)].push_back(i);
+
+            // register the directory chain up to the root, stop at the first known one
+            while (!directory.empty())
+            {
+                std::vector<std::string> &children = m_DirectoryChildren[std::string(GetParent(directory))];
+                const std::string child(GetFilename(directory));
+                if (std::find(children.begin(), children.end(), child) != children.end())
+                    break;
+
+                children.push_back(child);
+                directory = GetParent(directory);
+            }
+        }
+
+        LOG_INFO("[Pack File System] Mounted {} ({} files)", m_Filepath.generic_string(), m_EntryCount);
+        return true;
+    }
+
+    bool PackFileSystem::DirectoryExists(const std::filesystem::path &path)
+    {
+        const std::string key = NormalizePath(path);
+        return key.empty() || m_DirectoryFiles.contains(key) || m_DirectoryChildren.contains(key);
+    }
+
+    bool PackFileSystem::FileExists(const std::filesystem::path &path)
+    {
+        return FindEntry(NormalizePath(path)) != nullptr;
+    }
+
+    Ref<IBlob> PackFileSystem::ReadFile(const std::filesystem::path &path)
+    {
+        const std::string key = NormalizePath(path);
+        const PackEntry *entry = FindEntry(key);
+        if (!entry)
+            return nullptr;
+
+        const u8 *stored = m_File->Data() + entry->offset;
+
+        switch (entry->compression)
+        {
+        case PackCompression::None:
+        {
+            return CreateRef<MappedBlob>(m_File, entry->offset, entry->size);
+        }
+        case PackCompression::LZ4:
+        {
+            u8 *data = static_cast<u8 *>(malloc(entry->size));
+            if (data == nullptr)
+            {
+                LOG_ASSERT(false, "Out of memory");
+                return nullptr;
+            }
+
+            if (!Compression::DecompressLZ4(stored, entry->storedSize, data, entry->size))
+            {
+                free(data);
+                LOG_ERROR("[Pack File System] Failed to decompress {} from {}", key, m_Filepath.generic_string());
+                return nullptr;
+            }
+
+            return CreateRef<Blob>(data, static_cast<size_t>(entry->size));
+        }
+        default:
+        {
+            LOG_ERROR("[Pack File System] Unsupported compression for {} in {}", key, m_Filepath.generic_string());
+            return nullptr;
+        }
+        }
+    }
+
+    bool PackFileSystem::WriteFile(const std::filesystem::path &path, const void *data, const size_t size)
+    {
+        // packs are read only, rebuild them with PackBuilder
+        (void)path;
+        (void)data;
+        (void)size;
+        return false;
+    }
+
+    int PackFileSystem::EnumerateFiles(const std::filesystem::path &path, const std::vector<std::string> &extensions, enumerate_callback_t callback, bool allowDuplicates)
+    {
+        (void)allowDuplicates;
+
+        auto it = m_DirectoryFiles.find(NormalizePath(path));
+        if (it == m_DirectoryFiles.end())
+            return 0;
+
+        int numEntries = 0;
+        for (u32 index : it->second)
+        {
+            const std::string_view filename = GetFilename(GetName(m_Entries[index]));
+
+            const bool matches = extensions.empty() || std::any_of(extensions.begin(), extensions.end(), [filename](const std::string &ext)
+            {
+                return filename.ends_with(ext);
+            });
+
+            if (matches)
+            {
+                callback(filename);
+                ++numEntries;
+            }
+        }
+
+        return numEntries;
+    }
+
+    int PackFileSystem::EnumerateDirectories(const std::filesystem::path &path, enumerate_callback_t callback, bool allowDuplicates)
+    {
+        (void)allowDuplicates;
+
+        auto it = m_DirectoryChildren.find(NormalizePath(path));
+        if (it == m_DirectoryChildren.end())
+            return 0;
+
+        for (const std::string &child : it->second)
+            callback(child);
+
+        return static_cast<int>(it->second.size());
+    }
+
+    std::string PackFileSystem::NormalizePath(const std::filesystem::path &path)
+    {
+        std::string pathStr = path.generic_string();
+        std::replace(pathStr.begin(), pathStr.end(), '\\', '/');
+        pathStr = std::filesystem::path(pathStr).lexically_normal().generic_string();
+
+        // relative to the pack root, without leading or trailing separators
+        const size_t first = pathStr.find_first_not_of('/');
+        if (first == std::string::npos || pathStr == ".")
+            return {};
+
+        const size_t last = pathStr.find_last_not_of('/');
+        return pathStr.substr(first, last - first + 1);
+    }
+
+    const PackEntry *PackFileSystem::FindEntry(const std::string &path) const
+    {
+        const u64 hash = HashString(path);
+
+        const PackEntry *end = m_Entries + m_EntryCount;
+        const PackEntry *it = std::lower_bound(m_Entries, end, hash, [](const PackEntry &entry, u64 value)
+        {
+            return entry.pathHash < value;
+        });
+
+        for (; it != end && it->pathHash == hash; ++it)
+        {
+            if (GetName(*it) == path)
+                return it;
+        }
+
+        return nullptr;
+    }
+
+    std::string_view PackFileSystem::GetName(const PackEntry &entry) const
+    {
+        return { m_Strings + entry.nameOffset, entry.nameLength };
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "vfs.hpp"
+#include "mapped_file.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ignite::vfs
+{
+#define IXPAK_MAGIC 0x4B505849 // "IXPK"
+#define IXPAK_VERSION 1
+#define IXPAK_ALIGNMENT 4096
+
+    enum class PackCompression : u8
+    {
+        None = 0,
+        LZ4,
+        Zstd // reserved, not supported by this build
+    };
+
+    // file layout: header, table of contents, string table, then one 4K aligned block per file
+    struct PackHeader
+    {
+        u32 magic = IXPAK_MAGIC;
+        u32 version = IXPAK_VERSION;
+        u32 entryCount = 0;
+        u32 alignment = IXPAK_ALIGNMENT;
+        u64 tocOffset = 0;
+        u64 stringsOffset = 0;
+        u64 stringsSize = 0;
+        u64 reserved[3] = {};
+    };
+
+    // sorted by path hash, then by path
+    struct PackEntry
+    {
+        u64 pathHash = 0;
+        u64 offset = 0;
+        u64 storedSize = 0;
+        u64 size = 0;
+        u32 nameOffset = 0; // into the string table, normalized relative path
+        u32 nameLength = 0;
+        PackCompression compression = PackCompression::None;
+        u8 reserved[7] = {};
+    };
+
+    static_assert(sizeof(PackHeader) == 64);
+    static_assert(sizeof(PackEntry) == 48);
+
+    // Read only file system over a .ixpak archive. The archive is memory mapped,
+    // uncompressed files are returned as views into the mapping without a copy.
+    class PackFileSystem : public IFileSystem
+    {
+    public:
+        // nullptr when the file is not a valid pack
+        static Ref<PackFileSystem> Open(const std::filesystem::path &filepath);
+
+        virtual bool DirectoryExists(const std::filesystem::path &path) override;
+        virtual bool FileExists(const std::filesystem::path &path) override;
+
+        virtual Ref<IBlob> ReadFile(const std::filesystem::path &path) override;
+        virtual bool WriteFile(const std::filesystem::path &path, const void *data, const size_t size) override;
+
+        virtual int EnumerateFiles(const std::filesystem::path &path, const std::vector<std::string> &extensions, enumerate_callback_t callback, bool allowDuplicates = false) override;
+        virtual int EnumerateDirectories(const std::filesystem::path &path, enumerate_callback_t callback, bool allowDuplicates) override;
+
+        [[nodiscard]] const std::filesystem::path &GetFilepath() const { return m_Filepath; }
+        [[nodiscard]] u32 GetFileCount() const { return m_EntryCount; }
+
+        // normalized form of the paths stored in the table of contents
+        static std::string NormalizePath(const std::filesystem::path &path);
+
+    private:
+        bool Load();
+        const PackEntry *FindEntry(const std::string &path) const;
+        std::string_view GetName(const PackEntry &entry) const;
+
+        std::filesystem::path m_Filepath;
+        Ref<MappedFile> m_File;
+
+        const PackEntry *m_Entries = nullptr;
+        u32 m_EntryCount = 0;
+        const char *m_Strings = nullptr;
+
+        // directory -> direct children, "" is the root
+        std::unordered_map<std::string, std::vector<u32>> m_DirectoryFiles;
+        std::unordered_map<std::string, std::vector<std::string>> m_DirectoryChildren;
+    };
+
+    // Collects loose files and writes them into a .ixpak archive.
+    class PackBuilder
+    {
+    public:
+        void AddFile(const std::filesystem::path &path, const std::filesystem::path &nativePath, PackCompression compression = PackCompression::LZ4);
+
+        // every file below directory, paths are relative to it. returns the number of files added
+        u32 AddDirectory(const std::filesystem::path &directory, PackCompression compression = PackCompression::LZ4);
+
+        // written to a temporary file first and renamed once complete
+        bool Write(const std::filesystem::path &filepath) const;
+
+        [[nodiscard]] u32 GetFileCount() const { return static_cast<u32>(m_Sources.size()); }
+
+    private:
+        struct Source
+        {
+            std::string path;
+            std::filesystem::path nativePath;
+            PackCompression compression;
+        };
+
+        std::vector<Source> m_Sources;
+    };
+}
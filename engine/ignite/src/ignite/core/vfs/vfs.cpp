@@ -1,4 +1,8 @@
 #include "vfs.hpp"
+#include "async_reader.hpp"
+#include "directory_index.hpp"
+#include "mapped_file.hpp"
+#include "pack_file_system.hpp"
 
 #include "ignite/core/logger.hpp"
 #include "ignite/core/string_utils.hpp"
@@ -45,6 +49,18 @@ namespace ignite::vfs
         m_Size = 0;
     }
 
+    std::vector<ReadFuture> IFileSystem::ReadFilesAsync(std::vector<AsyncRead> reads)
+    {
+        return AsyncReader::Submit(this, std::move(reads));
+    }
+
+    ReadFuture IFileSystem::ReadFileAsync(const std::filesystem::path &path, ReadCallback callback)
+    {
+        std::vector<AsyncRead> reads;
+        reads.push_back({ path, std::move(callback) });
+        return ReadFilesAsync(std::move(reads)).front();
+    }
+
     bool NativeFileSystem::DirectoryExists(const std::filesystem::path &path)
     {
         return std::filesystem::exists(path) && std::filesystem::is_directory(path);
@@ -113,6 +129,21 @@ namespace ignite::vfs
         return true;
     }
 
+    Ref<IBlob> NativeFileSystem::MapFile(const std::filesystem::path &path)
+    {
+        if (Ref<MappedFile> mapped = MappedFile::Open(path))
+            return CreateRef<MappedBlob>(mapped);
+
+        // empty files can not be mapped
+        return ReadFile(path);
+    }
+
+    std::vector<ReadFuture> NativeFileSystem::ReadFilesAsync(std::vector<AsyncRead> reads)
+    {
+        // native paths skip ReadFile, the reader can hand them to io_uring
+        return AsyncReader::Submit(nullptr, std::move(reads));
+    }
+
     static int EnumerateNativeFiles(const char *pattern, bool directories, enumerate_callback_t callback)
     {
 #ifdef _WIN32
@@ -231,6 +262,19 @@ namespace ignite::vfs
         return m_UnderlyingFS->ReadFile(m_BasePath / name.relative_path());
     }
 
+    Ref<IBlob> RelativeFileSystem::MapFile(const std::filesystem::path& name)
+    {
+        return m_UnderlyingFS->MapFile(m_BasePath / name.relative_path());
+    }
+
+    std::vector<ReadFuture> RelativeFileSystem::ReadFilesAsync(std::vector<AsyncRead> reads)
+    {
+        for (AsyncRead &read : reads)
+            read.path = m_BasePath / read.path.relative_path();
+
+        return m_UnderlyingFS->ReadFilesAsync(std::move(reads));
+    }
+
     bool RelativeFileSystem::WriteFile(const std::filesystem::path& name, const void* data, size_t size)
     {
         return m_UnderlyingFS->WriteFile(m_BasePath / name.relative_path(), data, size);
@@ -246,6 +290,32 @@ namespace ignite::vfs
         return m_UnderlyingFS->EnumerateDirectories(m_BasePath / path.relative_path(), callback, allowDuplicates);
     }
 
+    static std::string NormalizeMountPath(const std::filesystem::path &path)
+    {
+        std::string spath = path.lexically_normal().generic_string();
+        if (spath.size() > 1 && spath.back() == '/')
+            spath.pop_back();
+        return spath;
+    }
+
+    // "/assets/textures" is { "", "assets", "textures" }, func gets each component and where it ends
+    template<typename Func>
+    static void ForEachMountComponent(std::string_view spath, Func &&func)
+    {
+        size_t begin = 0;
+        while (true)
+        {
+            const size_t end = spath.find('/', begin);
+            const std::string_view component = spath.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+
+            // "/" is the root component only
+            if (!func(component, end == std::string_view::npos ? spath.size() : end) || end == std::string_view::npos || end + 1 == spath.size())
+                return;
+
+            begin = end + 1;
+        }
+    }
+
     void RootFileSystem::Mount(const std::filesystem::path& path, std::shared_ptr<IFileSystem> fs)
     {
         if (FindMountPoint(path, nullptr, nullptr))
@@ -254,54 +324,91 @@ namespace ignite::vfs
             return;
         }
 
-        m_MountPoints.push_back(std::make_pair(path.lexically_normal().generic_string(), fs));
+        MountNode *node = &m_MountRoot;
+        ForEachMountComponent(NormalizeMountPath(path), [&node](std::string_view component, size_t)
+        {
+            auto it = node->children.find(component);
+            if (it == node->children.end())
+                it = node->children.emplace(std::string(component), CreateScope<MountNode>()).first;
+
+            node = it->second.get();
+            return true;
+        });
+
+        node->fs = std::move(fs);
     }
 
     void RootFileSystem::Mount(const std::filesystem::path& path, const std::filesystem::path& nativePath)
     {
-        Mount(path, std::make_shared<RelativeFileSystem>(std::make_shared<NativeFileSystem>(), nativePath));
+        // packed archives are mounted as a whole, everything else as an indexed native directory
+        if (nativePath.extension() == ".ixpak")
+        {
+            if (Ref<PackFileSystem> pack = PackFileSystem::Open(nativePath))
+                Mount(path, pack);
+            return;
+        }
+
+        Mount(path, std::make_shared<IndexedFileSystem>(nativePath));
     }
 
     bool RootFileSystem::Unmount(const std::filesystem::path &path)
     {
-        std::string spath = path.lexically_normal().generic_string();
-
-        for (size_t index = 0; index < m_MountPoints.size(); index++)
+        MountNode *node = &m_MountRoot;
+        bool found = true;
+        ForEachMountComponent(NormalizeMountPath(path), [&](std::string_view component, size_t)
         {
-            if (m_MountPoints[index].first == spath)
-            {
-                m_MountPoints.erase(m_MountPoints.begin() + index);
-                return true;
-            }
-        }
+            auto it = node->children.find(component);
+            found = it != node->children.end();
+            if (found)
+                node = it->second.get();
+            return found;
+        });
+
+        if (!found || !node->fs)
+            return false;
 
-        return false;
+        node->fs.reset();
+        return true;
     }
 
     bool RootFileSystem::FindMountPoint(const std::filesystem::path& path, std::filesystem::path* pRelativePath, IFileSystem** ppFS)
     {
-        std::string spath = path.lexically_normal().generic_string();
+        const std::string spath = NormalizeMountPath(path);
+
+        // the deepest mount point on the path wins
+        const MountNode *node = &m_MountRoot;
+        const MountNode *mount = nullptr;
+        size_t mountEnd = 0;
 
-        for (auto it : m_MountPoints)
+        ForEachMountComponent(spath, [&](std::string_view component, size_t end)
         {
-            if (spath.find(it.first, 0) == 0 && ((spath.length() == it.first.length()) || (spath[it.first.length()] == '/')))
+            auto it = node->children.find(component);
+            if (it == node->children.end())
+                return false;
+
+            node = it->second.get();
+            if (node->fs)
             {
-                if (pRelativePath)
-                {
-                    std::string relative = (spath.length() == it.first.length()) ? "" : spath.substr(it.first.size() + 1);
-                    *pRelativePath = relative;
-                }
+                mount = node;
+                mountEnd = end;
+            }
+            return true;
+        });
 
-                if (ppFS)
-                {
-                    *ppFS = it.second.get();
-                }
+        if (!mount)
+            return false;
 
-                return true;
-            }
+        if (pRelativePath)
+        {
+            *pRelativePath = mountEnd < spath.size() ? spath.substr(mountEnd + 1) : std::string();
         }
 
-        return false;
+        if (ppFS)
+        {
+            *ppFS = mount->fs.get();
+        }
+
+        return true;
     }
 
     bool RootFileSystem::DirectoryExists(const std::filesystem::path& name)
@@ -343,6 +450,65 @@ namespace ignite::vfs
         return nullptr;
     }
 
+    Ref<IBlob> RootFileSystem::MapFile(const std::filesystem::path& name)
+    {
+        std::filesystem::path relativePath;
+        IFileSystem* fs = nullptr;
+
+        if (FindMountPoint(name, &relativePath, &fs))
+        {
+            return fs->MapFile(relativePath);
+        }
+
+        return nullptr;
+    }
+
+    std::vector<ReadFuture> RootFileSystem::ReadFilesAsync(std::vector<AsyncRead> reads)
+    {
+        std::vector<ReadFuture> futures(reads.size());
+
+        // one batch per mount point, so each file system sees all of its reads at once
+        std::vector<std::pair<IFileSystem *, std::vector<size_t>>> batches;
+
+        for (size_t i = 0; i < reads.size(); ++i)
+        {
+            std::filesystem::path relativePath;
+            IFileSystem *fs = nullptr;
+
+            if (!FindMountPoint(reads[i].path, &relativePath, &fs))
+            {
+                std::promise<Ref<IBlob>> promise;
+                promise.set_value(nullptr);
+                futures[i] = promise.get_future().share();
+
+                if (reads[i].callback)
+                    reads[i].callback(nullptr);
+                continue;
+            }
+
+            reads[i].path = std::move(relativePath);
+
+            auto it = std::find_if(batches.begin(), batches.end(), [fs](const auto &batch) { return batch.first == fs; });
+            if (it == batches.end())
+                it = batches.insert(batches.end(), { fs, {} });
+            it->second.push_back(i);
+        }
+
+        for (auto &[fs, indices] : batches)
+        {
+            std::vector<AsyncRead> batch;
+            batch.reserve(indices.size());
+            for (size_t index : indices)
+                batch.push_back(std::move(reads[index]));
+
+            std::vector<ReadFuture> batchFutures = fs->ReadFilesAsync(std::move(batch));
+            for (size_t i = 0; i < indices.size(); ++i)
+                futures[indices[i]] = std::move(batchFutures[i]);
+        }
+
+        return futures;
+    }
+
     bool RootFileSystem::WriteFile(const std::filesystem::path& name, const void* data, size_t size)
     {
         std::filesystem::path relativePath;
@@ -4,6 +4,11 @@
 
 #include <filesystem>
 #include <functional>
+#include <future>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace ignite::vfs
 {
@@ -43,6 +48,16 @@ namespace ignite::vfs
         size_t m_Size = 0;
     };
 
+    // completion callback of an asynchronous read, called on a reader thread with nullptr on failure
+    using ReadCallback = std::function<void(const Ref<IBlob> &)>;
+    using ReadFuture = std::shared_future<Ref<IBlob>>;
+
+    struct AsyncRead
+    {
+        std::filesystem::path path;
+        ReadCallback callback;
+    };
+
     class IFileSystem
     {
     public:
@@ -54,6 +69,15 @@ namespace ignite::vfs
         virtual Ref<IBlob> ReadFile(const std::filesystem::path &path) = 0;
         virtual bool WriteFile(const std::filesystem::path &path, const void *data, const size_t size) = 0;
 
+        // read only view without a copy where the file system can map files, a ReadFile copy otherwise.
+        // the view stays valid while the blob is referenced
+        virtual Ref<IBlob> MapFile(const std::filesystem::path &path) { return ReadFile(path); }
+
+        // issues every read at once, one future per request in the same order.
+        // by default ReadFile runs on the AsyncReader thread pool
+        virtual std::vector<ReadFuture> ReadFilesAsync(std::vector<AsyncRead> reads);
+        ReadFuture ReadFileAsync(const std::filesystem::path &path, ReadCallback callback = nullptr);
+
         virtual int EnumerateFiles(const std::filesystem::path &path, const std::vector<std::string> &extensions, enumerate_callback_t callback, bool allowDuplicates = false) = 0;
         virtual int EnumerateDirectories(const std::filesystem::path &path, enumerate_callback_t callback, bool allowDuplicates) = 0;
     };
@@ -66,6 +90,8 @@ namespace ignite::vfs
 
         virtual Ref<IBlob> ReadFile(const std::filesystem::path &path) override;
         virtual bool WriteFile(const std::filesystem::path &path, const void *data, const size_t size) override;
+        virtual Ref<IBlob> MapFile(const std::filesystem::path &path) override;
+        virtual std::vector<ReadFuture> ReadFilesAsync(std::vector<AsyncRead> reads) override;
 
         virtual int EnumerateFiles(const std::filesystem::path &path, const std::vector<std::string> &extensions, enumerate_callback_t callback, bool allowDuplicates = false) override;
         virtual int EnumerateDirectories(const std::filesystem::path &path, enumerate_callback_t callback, bool allowDuplicates) override;
@@ -82,6 +108,8 @@ namespace ignite::vfs
 
         virtual Ref<IBlob> ReadFile(const std::filesystem::path &path) override;
         virtual bool WriteFile(const std::filesystem::path &path, const void *data, const size_t size) override;
+        virtual Ref<IBlob> MapFile(const std::filesystem::path &path) override;
+        virtual std::vector<ReadFuture> ReadFilesAsync(std::vector<AsyncRead> reads) override;
 
         virtual int EnumerateFiles(const std::filesystem::path &path, const std::vector<std::string> &extensions, enumerate_callback_t callback, bool allowDuplicates = false) override;
         virtual int EnumerateDirectories(const std::filesystem::path &path, enumerate_callback_t callback, bool allowDuplicates) override;
@@ -95,6 +123,7 @@ namespace ignite::vfs
     {
     public:
         void Mount(const std::filesystem::path &path, Ref<IFileSystem> fs);
+        // a native directory, or a .ixpak archive
         void Mount(const std::filesystem::path &path, const std::filesystem::path &nativePath);
         bool Unmount(const std::filesystem::path &path);
 
@@ -103,11 +132,26 @@ namespace ignite::vfs
 
         virtual Ref<IBlob> ReadFile(const std::filesystem::path &path) override;
         virtual bool WriteFile(const std::filesystem::path &path, const void *data, const size_t size) override;
+        virtual Ref<IBlob> MapFile(const std::filesystem::path &path) override;
+        virtual std::vector<ReadFuture> ReadFilesAsync(std::vector<AsyncRead> reads) override;
 
         virtual int EnumerateFiles(const std::filesystem::path &path, const std::vector<std::string> &extensions, enumerate_callback_t callback, bool allowDuplicates = false) override;
         virtual int EnumerateDirectories(const std::filesystem::path &path, enumerate_callback_t callback, bool allowDuplicates) override;
     private:
-        std::vector<std::pair<std::string, Ref<IFileSystem>>> m_MountPoints;
+        struct MountNameHash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+        };
+
+        // one node per path component, nodes with a file system are mount points
+        struct MountNode
+        {
+            std::unordered_map<std::string, Scope<MountNode>, MountNameHash, std::equal_to<>> children;
+            Ref<IFileSystem> fs;
+        };
+
+        MountNode m_MountRoot;
         bool FindMountPoint(const std::filesystem::path& path, std::filesystem::path* pRelativePath, IFileSystem** ppFS);
     };
 
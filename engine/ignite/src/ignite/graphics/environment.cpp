@@ -8,7 +8,7 @@
 
 #include "renderer.hpp"
 
-#include <stb_image.h>
+#include <algorithm>
 
 namespace ignite {
 
@@ -129,22 +129,75 @@ namespace ignite {
     }
 
     void Environment::LoadTexture(const std::string &filepath)
+    {
+        // the equirect is baked once into a prefiltered cubemap and read back from the cache
+        BakedEnvironment baked;
+        if (!EnvironmentBaker::Load(filepath, baked))
+        {
+            LOG_ERROR("[Environment] Failed to load {}", filepath);
+            return;
+        }
+
+        LoadTexture(baked, filepath);
+    }
+
+    void Environment::LoadTexture(const BakedEnvironment &baked, const std::string &debugName, nvrhi::ICommandList *commandList)
     {
         nvrhi::IDevice *device = Application::GetRenderDevice();
 
-        TextureCreateInfo textureCI;
-        textureCI.dimension = nvrhi::TextureDimension::Texture2D;
-        textureCI.format = nvrhi::Format::RGBA32_FLOAT;
-        textureCI.flip = true; // usually HDR textures are flipped
+        const auto &textureDesc = nvrhi::TextureDesc()
+            .setDimension(nvrhi::TextureDimension::TextureCube)
+            .setWidth(baked.faceSize)
+            .setHeight(baked.faceSize)
+            .setArraySize(6)
+            .setFormat(baked.format)
+            .setInitialState(nvrhi::ResourceStates::ShaderResource)
+            .setKeepInitialState(true)
+            .setMipLevels(static_cast<u32>(baked.mips.size()))
+            .setDebugName(debugName);
+
+        m_CubeTexture = device->createTexture(textureDesc);
+        LOG_ASSERT(m_CubeTexture, "[Environment] Failed to create cubemap");
+
+        nvrhi::CommandListHandle uploadCommandList;
+        if (!commandList)
+        {
+            uploadCommandList = device->createCommandList();
+            uploadCommandList->open();
+            commandList = uploadCommandList;
+        }
+
+        for (u32 mip = 0; mip < baked.mips.size(); ++mip)
+        {
+            for (u32 face = 0; face < 6; ++face)
+                commandList->writeTexture(m_CubeTexture, face, mip, baked.GetFaceData(mip, face), baked.mips[mip].rowPitch);
+        }
+
+        if (uploadCommandList)
+        {
+            uploadCommandList->close();
+            device->executeCommandList(uploadCommandList);
+        }
+
+        if (!m_Sampler)
+        {
+            const auto samplerDesc = nvrhi::SamplerDesc()
+                .setAllAddressModes(nvrhi::SamplerAddressMode::ClampToEdge)
+                .setAllFilters(true);
+
+            m_Sampler = device->createSampler(samplerDesc);
+            LOG_ASSERT(m_Sampler, "[Environment] Failed to create sampler");
+        }
 
-        m_HDRTexture = Texture::Create(filepath, textureCI);
+        params.specularMipCount = static_cast<float>(baked.mips.size());
+        std::copy(std::begin(baked.irradianceSH), std::end(baked.irradianceSH), std::begin(params.irradianceSH));
 
         // create binding set after load the texture
         nvrhi::BindingSetDesc bsDesc;
         bsDesc.addItem(nvrhi::BindingSetItem::ConstantBuffer(0, Renderer::GetCameraBufferHandle()));
         bsDesc.addItem(nvrhi::BindingSetItem::ConstantBuffer(1, m_ParamsConstantBuffer));
-        bsDesc.addItem(nvrhi::BindingSetItem::Texture_SRV(0, m_HDRTexture->GetHandle()));
-        bsDesc.addItem(nvrhi::BindingSetItem::Sampler(0, m_HDRTexture->GetSampler()));
+        bsDesc.addItem(nvrhi::BindingSetItem::Texture_SRV(0, m_CubeTexture));
+        bsDesc.addItem(nvrhi::BindingSetItem::Sampler(0, m_Sampler));
 
         m_BindingSet = device->createBindingSet(bsDesc, Renderer::GetBindingLayout(GPipeline::ENVIRONMENT));
         LOG_ASSERT(m_BindingSet, "Failed to create binding set");
@@ -2,6 +2,7 @@
 
 #include "lighting.hpp"
 #include "texture.hpp"
+#include "environment_baker.hpp"
 
 #include <string>
 #include <filesystem>
@@ -17,6 +18,9 @@ namespace ignite {
     {
         float exposure = 1.0f;
         float gamma = 2.2f;
+        float specularMipCount = 1.0f; // prefiltered mips, roughness 1 is the last one
+        float padding = 0.0f;
+        glm::vec4 irradianceSH[9] = {};
     };
 
     class Environment
@@ -26,6 +30,8 @@ namespace ignite {
 
         void Render(nvrhi::ICommandList *commandList, nvrhi::IFramebuffer *framebuffer, const Ref<GraphicsPipeline> &pipeline);
         void LoadTexture(const std::string &filepath);
+        // upload an already baked environment, recorded into commandList when given
+        void LoadTexture(const BakedEnvironment &baked, const std::string &debugName, nvrhi::ICommandList *commandList = nullptr);
         void WriteBuffer(nvrhi::ICommandList *commandList);
         void SetSunDirection(float pitch, float yaw);
 
@@ -37,7 +43,8 @@ namespace ignite {
         EnvironmentParams params;
         DirLight dirLight;
 
-        nvrhi::TextureHandle GetHDRTexture() { return m_HDRTexture->GetHandle(); }
+        // prefiltered RGBA16F cubemap
+        nvrhi::TextureHandle GetHDRTexture() { return m_CubeTexture; }
         nvrhi::BufferHandle GetParamsBuffer() { return m_ParamsConstantBuffer; }
         nvrhi::BufferHandle GetDirLightBuffer() { return m_DirLightConstantBuffer; }
 
@@ -51,6 +58,7 @@ namespace ignite {
 
         nvrhi::BindingSetHandle m_BindingSet;
 
-        Ref<Texture> m_HDRTexture;
+        nvrhi::TextureHandle m_CubeTexture;
+        nvrhi::SamplerHandle m_Sampler;
     };
 }
\ No newline at end of file
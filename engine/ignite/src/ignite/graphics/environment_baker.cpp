@@ -0,0 +1,555 @@
+#include "environment_baker.hpp"
+#include "mip_generator.hpp"
+
+#include "ignite/core/hash.hpp"
+#include "ignite/core/logger.hpp"
+#include "ignite/core/job_system.hpp"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace ignite
+{
+    namespace
+    {
+        constexpr u32 kCacheMagic = 0x4e455849; // "IXEN"
+        constexpr f32 kPi = 3.14159265358979f;
+        constexpr u32 kMinTexelsPerTask = 4096;
+        constexpr u32 kMaxSHFaceSize = 64; // irradiance is low frequency, a small level is enough
+
+        struct CacheHeader
+        {
+            u32 magic = kCacheMagic;
+            u32 version = ENVIRONMENT_BAKER_VERSION;
+            u32 format = 0;
+            u32 faceSize = 0;
+            u32 mipCount = 0;
+            u32 padding = 0;
+            u64 dataSize = 0;
+        };
+
+        struct BakerData
+        {
+            EnvironmentBakeSettings settings;
+            std::filesystem::path cacheDirectory = "resources/cache/environment";
+        };
+
+        BakerData &GetData()
+        {
+            static BakerData data;
+            return data;
+        }
+
+        // six faces of size * size texels, faces ordered +X -X +Y -Y +Z -Z
+        struct CubeLevel
+        {
+            u32 size = 0;
+            std::vector<glm::vec3> texels;
+
+            const glm::vec3 &At(u32 face, u32 x, u32 y) const { return texels[(static_cast<size_t>(face) * size + y) * size + x]; }
+            glm::vec3 &At(u32 face, u32 x, u32 y) { return texels[(static_cast<size_t>(face) * size + y) * size + x]; }
+        };
+
+        // u and v in [-1, 1], same face orientation as D3D and Vulkan cubemaps
+        glm::vec3 FaceDirection(u32 face, f32 sc, f32 tc)
+        {
+            switch (face)
+            {
+            case 0: return glm::normalize(glm::vec3(1.0f, -tc, -sc));
+            case 1: return glm::normalize(glm::vec3(-1.0f, -tc, sc));
+            case 2: return glm::normalize(glm::vec3(sc, 1.0f, tc));
+            case 3: return glm::normalize(glm::vec3(sc, -1.0f, -tc));
+            case 4: return glm::normalize(glm::vec3(sc, -tc, 1.0f));
+            default: return glm::normalize(glm::vec3(-sc, -tc, -1.0f));
+            }
+        }
+
+        // returns u and v in [0, 1]
+        u32 DirectionToFace(const glm::vec3 &dir, f32 &u, f32 &v)
+        {
+            const glm::vec3 a = glm::abs(dir);
+            u32 face;
+            f32 sc, tc, ma;
+
+            if (a.x >= a.y && a.x >= a.z)
+            {
+                face = dir.x >= 0.0f ? 0 : 1;
+                sc = dir.x >= 0.0f ? -dir.z : dir.z;
+                tc = -dir.y;
+                ma = a.x;
+            }
+            else if (a.y >= a.z)
+            {
+                face = dir.y >= 0.0f ? 2 : 3;
+                sc = dir.x;
+                tc = dir.y >= 0.0f ? dir.z : -dir.z;
+                ma = a.y;
+            }
+            else
+            {
+                face = dir.z >= 0.0f ? 4 : 5;
+                sc = dir.z >= 0.0f ? dir.x : -dir.x;
+                tc = -dir.y;
+                ma = a.z;
+            }
+
+            u = 0.5f * (sc / ma + 1.0f);
+            v = 0.5f * (tc / ma + 1.0f);
+            return face;
+        }
+
+        // matches SampleSphericalMap in the shaders
+        glm::vec3 SampleEquirect(const f32 *pixels, u32 width, u32 height, const glm::vec3 &dir)
+        {
+            const f32 u = std::atan2(dir.z, dir.x) / (2.0f * kPi) + 0.5f;
+            const f32 v = std::asin(std::clamp(dir.y, -1.0f, 1.0f)) / kPi + 0.5f;
+
+            // v = 0 is the bottom of the image
+            const f32 x = u * width - 0.5f;
+            const f32 y = std::clamp((1.0f - v) * height - 0.5f, 0.0f, static_cast<f32>(height - 1));
+
+            const i32 x0 = static_cast<i32>(std::floor(x));
+            const u32 y0 = static_cast<u32>(y);
+            const u32 y1 = std::min(y0 + 1, height - 1);
+            const f32 fx = x - x0;
+            const f32 fy = y - y0;
+
+            // wrap horizontally
+            const u32 xa = static_cast<u32>((x0 % static_cast<i32>(width) + width) % width);
+            const u32 xb = (xa + 1) % width;
+
+            auto texel = [&](u32 px, u32 py) { const f32 *p = pixels + (static_cast<size_t>(py) * width + px) * 4; return glm::vec3(p[0], p[1], p[2]); };
+
+            const glm::vec3 top = glm::mix(texel(xa, y0), texel(xb, y0), fx);
+            const glm::vec3 bottom = glm::mix(texel(xa, y1), texel(xb, y1), fx);
+            return glm::mix(top, bottom, fy);
+        }
+
+        glm::vec3 SampleLevel(const CubeLevel &level, const glm::vec3 &dir)
+        {
+            f32 u, v;
+            const u32 face = DirectionToFace(dir, u, v);
+
+            const f32 maxCoord = static_cast<f32>(level.size - 1);
+            const f32 x = std::clamp(u * level.size - 0.5f, 0.0f, maxCoord);
+            const f32 y = std::clamp(v * level.size - 0.5f, 0.0f, maxCoord);
+
+            const u32 x0 = static_cast<u32>(x);
+            const u32 y0 = static_cast<u32>(y);
+            const u32 x1 = std::min(x0 + 1, level.size - 1);
+            const u32 y1 = std::min(y0 + 1, level.size - 1);
+            const f32 fx = x - x0;
+            const f32 fy = y - y0;
+
+            const glm::vec3 top = glm::mix(level.At(face, x0, y0), level.At(face, x1, y0), fx);
+            const glm::vec3 bottom = glm::mix(level.At(face, x0, y1), level.At(face, x1, y1), fx);
+            return glm::mix(top, bottom, fy);
+        }
+
+        glm::vec3 SampleCube(const std::vector<CubeLevel> &chain, const glm::vec3 &dir, f32 lod)
+        {
+            lod = std::clamp(lod, 0.0f, static_cast<f32>(chain.size() - 1));
+            const u32 level0 = static_cast<u32>(lod);
+            const u32 level1 = std::min(level0 + 1, static_cast<u32>(chain.size() - 1));
+            const f32 t = lod - level0;
+
+            const glm::vec3 a = SampleLevel(chain[level0], dir);
+            if (t <= 0.0f || level0 == level1)
+                return a;
+
+            return glm::mix(a, SampleLevel(chain[level1], dir), t);
+        }
+
+        CubeLevel Downsample(const CubeLevel &src)
+        {
+            CubeLevel dst;
+            dst.size = std::max(1u, src.size / 2);
+            dst.texels.resize(static_cast<size_t>(6) * dst.size * dst.size);
+
+            for (u32 face = 0; face < 6; ++face)
+            {
+                for (u32 y = 0; y < dst.size; ++y)
+                {
+                    for (u32 x = 0; x < dst.size; ++x)
+                    {
+                        dst.At(face, x, y) = 0.25f * (src.At(face, x * 2, y * 2) + src.At(face, x * 2 + 1, y * 2)
+                            + src.At(face, x * 2, y * 2 + 1) + src.At(face, x * 2 + 1, y * 2 + 1));
+                    }
+                }
+            }
+
+            return dst;
+        }
+
+        glm::vec2 Hammersley(u32 i, u32 count)
+        {
+            u32 bits = i;
+            bits = (bits << 16u) | (bits >> 16u);
+            bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+            bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+            bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+            bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+            return glm::vec2(static_cast<f32>(i) / count, bits * 2.3283064365386963e-10f);
+        }
+
+        void WriteHalfRow(u8 *dst, const glm::vec3 *src, u32 count)
+        {
+            u16 *out = reinterpret_cast<u16 *>(dst);
+            for (u32 i = 0; i < count; ++i)
+            {
+                out[i * 4 + 0] = CPUMipGenerator::float_to_half(src[i].x);
+                out[i * 4 + 1] = CPUMipGenerator::float_to_half(src[i].y);
+                out[i * 4 + 2] = CPUMipGenerator::float_to_half(src[i].z);
+                out[i * 4 + 3] = CPUMipGenerator::float_to_half(1.0f);
+            }
+        }
+
+        void ProjectSH(const CubeLevel &level, glm::vec4 outSH[9])
+        {
+            glm::vec3 sh[9] = {};
+            const f32 texelSize = 2.0f / level.size;
+
+            for (u32 face = 0; face < 6; ++face)
+            {
+                for (u32 y = 0; y < level.size; ++y)
+                {
+                    for (u32 x = 0; x < level.size; ++x)
+                    {
+                        const f32 sc = (x + 0.5f) * texelSize - 1.0f;
+                        const f32 tc = (y + 0.5f) * texelSize - 1.0f;
+                        const glm::vec3 n = FaceDirection(face, sc, tc);
+
+                        // solid angle of the texel
+                        const f32 weight = texelSize * texelSize / std::pow(1.0f + sc * sc + tc * tc, 1.5f);
+                        const glm::vec3 color = level.At(face, x, y) * weight;
+
+                        sh[0] += color * 0.282095f;
+                        sh[1] += color * (0.488603f * n.y);
+                        sh[2] += color * (0.488603f * n.z);
+                        sh[3] += color * (0.488603f * n.x);
+                        sh[4] += color * (1.092548f * n.x * n.y);
+                        sh[5] += color * (1.092548f * n.y * n.z);
+                        sh[6] += color * (0.315392f * (3.0f * n.z * n.z - 1.0f));
+                        sh[7] += color * (1.092548f * n.x * n.z);
+                        sh[8] += color * (0.546274f * (n.x * n.x - n.y * n.y));
+                    }
+                }
+            }
+
+            // cosine lobe convolution (pi, 2pi/3, pi/4) divided by pi for lambertian radiance
+            constexpr f32 kBand[9] = { 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+            for (u32 i = 0; i < 9; ++i)
+                outSH[i] = glm::vec4(sh[i] * kBand[i], 0.0f);
+        }
+    }
+
+    bool EnvironmentBaker::Load(const std::filesystem::path &filepath, BakedEnvironment &outEnvironment)
+    {
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            LOG_ERROR("[Environment Baker] Failed to open {}", filepath.generic_string());
+            return false;
+        }
+
+        std::vector<u8> encoded(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+        file.close();
+
+        const EnvironmentBakeSettings &settings = GetData().settings;
+        u64 cacheKey = HashBytes(encoded.data(), encoded.size());
+        cacheKey = HashCombine(cacheKey, settings.maxFaceSize);
+        cacheKey = HashCombine(cacheKey, settings.specularMipCount);
+        cacheKey = HashCombine(cacheKey, settings.sampleCount);
+        cacheKey = HashCombine(cacheKey, ENVIRONMENT_BAKER_VERSION);
+
+        if (LoadFromCache(cacheKey, outEnvironment))
+            return true;
+
+        i32 width = 0, height = 0, channels = 4;
+        stbi_set_flip_vertically_on_load_thread(0);
+        f32 *pixels = stbi_loadf_from_memory(encoded.data(), static_cast<i32>(encoded.size()), &width, &height, &channels, 4);
+        if (!pixels)
+        {
+            LOG_ERROR("[Environment Baker] Failed to decode {}", filepath.generic_string());
+            return false;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool baked = Bake(pixels, static_cast<u32>(width), static_cast<u32>(height), settings, outEnvironment);
+        stbi_image_free(pixels);
+
+        if (!baked)
+            return false;
+
+        const f64 elapsed = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+        LOG_INFO("[Environment Baker] Baked {} to a {}px cubemap with {} mips in {:.1f} ms", filepath.generic_string(), outEnvironment.faceSize, outEnvironment.mips.size(), elapsed);
+
+        SaveToCache(cacheKey, outEnvironment);
+        return true;
+    }
+
+    bool EnvironmentBaker::Bake(const f32 *equirect, u32 width, u32 height, const EnvironmentBakeSettings &settings, BakedEnvironment &outEnvironment)
+    {
+        if (!equirect || width == 0 || height == 0)
+            return false;
+
+        // a quarter of the equirect width keeps roughly the source texel density at the horizon
+        u32 faceSize = 1;
+        while (faceSize * 2 <= width / 4 && faceSize * 2 <= settings.maxFaceSize)
+            faceSize *= 2;
+
+        const u32 mipCount = std::clamp(settings.specularMipCount, 1u, CPUMipGenerator::GetMaxMipLevels(faceSize, faceSize));
+        const u32 sampleCount = std::max(1u, settings.sampleCount);
+
+        // base level, 2x2 supersampled from the equirect
+        std::vector<CubeLevel> chain(1);
+        chain[0].size = faceSize;
+        chain[0].texels.resize(static_cast<size_t>(6) * faceSize * faceSize);
+
+        JobSystem::ParallelFor(6 * faceSize, std::max(1u, kMinTexelsPerTask / faceSize), [&](u32 begin, u32 end)
+        {
+            const f32 texelSize = 2.0f / faceSize;
+            for (u32 row = begin; row < end; ++row)
+            {
+                const u32 face = row / faceSize;
+                const u32 y = row % faceSize;
+                for (u32 x = 0; x < faceSize; ++x)
+                {
+                    glm::vec3 color(0.0f);
+                    for (u32 s = 0; s < 4; ++s)
+                    {
+                        const f32 sc = (x + 0.25f + 0.5f * (s & 1)) * texelSize - 1.0f;
+                        const f32 tc = (y + 0.25f + 0.5f * (s >> 1)) * texelSize - 1.0f;
+                        color += SampleEquirect(equirect, width, height, FaceDirection(face, sc, tc));
+                    }
+                    chain[0].At(face, x, y) = color * 0.25f;
+                }
+            }
+        });
+
+        // box filtered chain, the prefilter reads lower levels for wide lobes
+        while (chain.back().size > 1)
+            chain.push_back(Downsample(chain.back()));
+
+        BakedEnvironment baked;
+        baked.format = nvrhi::Format::RGBA16_FLOAT;
+        baked.faceSize = faceSize;
+        baked.mips.resize(mipCount);
+
+        u64 offset = 0;
+        for (u32 mip = 0; mip < mipCount; ++mip)
+        {
+            BakedEnvironmentMip &mipInfo = baked.mips[mip];
+            mipInfo.size = std::max(1u, faceSize >> mip);
+            mipInfo.rowPitch = mipInfo.size * 8;
+            mipInfo.faceByteSize = static_cast<u64>(mipInfo.rowPitch) * mipInfo.size;
+            mipInfo.offset = offset;
+            offset += mipInfo.faceByteSize * 6;
+        }
+        baked.data.resize(offset);
+
+        // mip 0 is the mirror reflection
+        for (u32 face = 0; face < 6; ++face)
+        {
+            for (u32 y = 0; y < faceSize; ++y)
+                WriteHalfRow(baked.data.data() + baked.mips[0].faceByteSize * face + static_cast<size_t>(y) * baked.mips[0].rowPitch, &chain[0].At(face, 0, y), faceSize);
+        }
+
+        struct LobeSample
+        {
+            glm::vec3 direction; // tangent space, z is the normal
+            f32 weight;
+            f32 lod;
+        };
+
+        const f32 texelSolidAngle = 4.0f * kPi / (6.0f * faceSize * faceSize);
+
+        for (u32 mip = 1; mip < mipCount; ++mip)
+        {
+            const f32 roughness = static_cast<f32>(mip) / (mipCount - 1);
+            const f32 alpha = roughness * roughness;
+            const f32 alpha2 = alpha * alpha;
+
+            // GGX importance samples with N = V, filtered by reading a matching chain level
+            std::vector<LobeSample> samples;
+            samples.reserve(sampleCount);
+            for (u32 i = 0; i < sampleCount; ++i)
+            {
+                const glm::vec2 xi = Hammersley(i, sampleCount);
+                const f32 phi = 2.0f * kPi * xi.x;
+                const f32 cosTheta = std::sqrt((1.0f - xi.y) / (1.0f + (alpha2 - 1.0f) * xi.y));
+                const f32 sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+
+                const glm::vec3 h(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+                const glm::vec3 l = 2.0f * cosTheta * h - glm::vec3(0.0f, 0.0f, 1.0f);
+                if (l.z <= 0.0f)
+                    continue;
+
+                const f32 d = (cosTheta * cosTheta * (alpha2 - 1.0f) + 1.0f);
+                const f32 pdf = alpha2 / (kPi * d * d) * 0.25f;
+                const f32 sampleSolidAngle = 1.0f / (sampleCount * pdf + 1e-6f);
+                const f32 lod = std::max(0.0f, 0.5f * std::log2(sampleSolidAngle / texelSolidAngle) + 1.0f);
+
+                samples.push_back({ l, l.z, lod });
+            }
+
+            const BakedEnvironmentMip &mipInfo = baked.mips[mip];
+            const u32 size = mipInfo.size;
+
+            // every texel reads the whole lobe, one row is already enough work for a task
+            JobSystem::ParallelFor(6 * size, 1, [&](u32 begin, u32 end)
+            {
+                std::vector<glm::vec3> row(size);
+                const f32 texelSize = 2.0f / size;
+
+                for (u32 r = begin; r < end; ++r)
+                {
+                    const u32 face = r / size;
+                    const u32 y = r % size;
+
+                    for (u32 x = 0; x < size; ++x)
+                    {
+                        const glm::vec3 n = FaceDirection(face, (x + 0.5f) * texelSize - 1.0f, (y + 0.5f) * texelSize - 1.0f);
+                        const glm::vec3 up = std::abs(n.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+                        const glm::vec3 tangent = glm::normalize(glm::cross(up, n));
+                        const glm::vec3 bitangent = glm::cross(n, tangent);
+
+                        glm::vec3 color(0.0f);
+                        f32 totalWeight = 0.0f;
+                        for (const LobeSample &sample : samples)
+                        {
+                            const glm::vec3 l = tangent * sample.direction.x + bitangent * sample.direction.y + n * sample.direction.z;
+                            color += SampleCube(chain, l, sample.lod) * sample.weight;
+                            totalWeight += sample.weight;
+                        }
+
+                        row[x] = totalWeight > 0.0f ? color / totalWeight : SampleLevel(chain[0], n);
+                    }
+
+                    WriteHalfRow(baked.data.data() + mipInfo.offset + mipInfo.faceByteSize * face + static_cast<size_t>(y) * mipInfo.rowPitch, row.data(), size);
+                }
+            });
+        }
+
+        // diffuse irradiance from a small level
+        const auto shLevel = std::find_if(chain.begin(), chain.end(), [](const CubeLevel &level) { return level.size <= kMaxSHFaceSize; });
+        ProjectSH(*shLevel, baked.irradianceSH);
+
+        outEnvironment = std::move(baked);
+        return true;
+    }
+
+    bool EnvironmentBaker::LoadFromCache(u64 cacheKey, BakedEnvironment &outEnvironment)
+    {
+        const std::filesystem::path &directory = GetData().cacheDirectory;
+        if (directory.empty())
+            return false;
+
+        std::ifstream file(directory / fmt::format("{:016x}.ixenv", cacheKey), std::ios::binary);
+        if (!file)
+            return false;
+
+        CacheHeader header;
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (!file || header.magic != kCacheMagic || header.version != ENVIRONMENT_BAKER_VERSION || header.mipCount == 0)
+            return false;
+
+        BakedEnvironment environment;
+        environment.format = static_cast<nvrhi::Format>(header.format);
+        environment.faceSize = header.faceSize;
+        environment.mips.resize(header.mipCount);
+        environment.data.resize(header.dataSize);
+
+        file.read(reinterpret_cast<char *>(environment.irradianceSH), sizeof(environment.irradianceSH));
+        file.read(reinterpret_cast<char *>(environment.mips.data()), static_cast<std::streamsize>(sizeof(BakedEnvironmentMip) * header.mipCount));
+        file.read(reinterpret_cast<char *>(environment.data.data()), static_cast<std::streamsize>(header.dataSize));
+        if (!file)
+        {
+            LOG_WARN("[Environment Baker] Corrupted cache entry {:016x}", cacheKey);
+            return false;
+        }
+
+        for (const BakedEnvironmentMip &mip : environment.mips)
+        {
+            if (mip.offset + mip.faceByteSize * 6 > header.dataSize)
+            {
+                LOG_WARN("[Environment Baker] Corrupted cache entry {:016x}", cacheKey);
+                return false;
+            }
+        }
+
+        outEnvironment = std::move(environment);
+        return true;
+    }
+
+    void EnvironmentBaker::SaveToCache(u64 cacheKey, const BakedEnvironment &environment)
+    {
+        const std::filesystem::path &directory = GetData().cacheDirectory;
+        if (directory.empty() || !environment.IsValid())
+            return;
+
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+
+        const std::filesystem::path filepath = directory / fmt::format("{:016x}.ixenv", cacheKey);
+        std::filesystem::path tempFilepath = filepath;
+        // bakes of the same environment can run on several workers at once, each writes its own temp file
+        tempFilepath += fmt::format(".{:x}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+        {
+            std::ofstream file(tempFilepath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                LOG_WARN("[Environment Baker] Failed to write cache {}", filepath.generic_string());
+                return;
+            }
+
+            CacheHeader header;
+            header.format = static_cast<u32>(environment.format);
+            header.faceSize = environment.faceSize;
+            header.mipCount = static_cast<u32>(environment.mips.size());
+            header.dataSize = environment.data.size();
+
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char *>(environment.irradianceSH), sizeof(environment.irradianceSH));
+            file.write(reinterpret_cast<const char *>(environment.mips.data()), static_cast<std::streamsize>(sizeof(BakedEnvironmentMip) * environment.mips.size()));
+            file.write(reinterpret_cast<const char *>(environment.data.data()), static_cast<std::streamsize>(environment.data.size()));
+        }
+
+        // readers never see a partially written file
+        std::filesystem::rename(tempFilepath, filepath, ec);
+        if (ec)
+        {
+            LOG_WARN("[Environment Baker] Failed to write cache {}: {}", filepath.generic_string(), ec.message());
+            std::filesystem::remove(tempFilepath, ec);
+        }
+    }
+
+    void EnvironmentBaker::SetSettings(const EnvironmentBakeSettings &settings)
+    {
+        GetData().settings = settings;
+    }
+
+    const EnvironmentBakeSettings &EnvironmentBaker::GetSettings()
+    {
+        return GetData().settings;
+    }
+
+    void EnvironmentBaker::SetCacheDirectory(const std::filesystem::path &directory)
+    {
+        GetData().cacheDirectory = directory;
+    }
+
+    const std::filesystem::path &EnvironmentBaker::GetCacheDirectory()
+    {
+        return GetData().cacheDirectory;
+    }
+}
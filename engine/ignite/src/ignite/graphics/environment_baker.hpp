@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+
+#include <glm/glm.hpp>
+#include <nvrhi/nvrhi.h>
+
+#include <filesystem>
+#include <vector>
+
+namespace ignite
+{
+#define ENVIRONMENT_BAKER_VERSION 1
+
+    struct EnvironmentBakeSettings
+    {
+        u32 maxFaceSize = 512;
+        u32 specularMipCount = 6; // roughness 0 at mip 0 up to 1 at the last mip
+        u32 sampleCount = 64; // GGX samples per prefiltered texel
+    };
+
+    struct BakedEnvironmentMip
+    {
+        u32 size = 0;
+        u32 rowPitch = 0;
+        u64 offset = 0; // first face, the others follow every faceByteSize
+        u64 faceByteSize = 0;
+    };
+
+    // RGBA16F cubemap with GGX prefiltered mips and L2 spherical harmonics for diffuse lighting
+    struct BakedEnvironment
+    {
+        nvrhi::Format format = nvrhi::Format::RGBA16_FLOAT;
+        u32 faceSize = 0;
+        std::vector<BakedEnvironmentMip> mips;
+        std::vector<u8> data;
+
+        // cosine convolved radiance divided by pi, evaluate with the standard L2 basis
+        glm::vec4 irradianceSH[9] = {};
+
+        const u8 *GetFaceData(u32 mip, u32 face) const { return data.data() + mips[mip].offset + mips[mip].faceByteSize * face; }
+        bool IsValid() const { return faceSize > 0 && !mips.empty(); }
+    };
+
+    // Converts equirectangular HDR images into the baked form used by Environment.
+    // Baking runs on all cores, results are cached on disk by content hash.
+    class EnvironmentBaker
+    {
+    public:
+        // reads the cached bake or bakes the image and caches it
+        static bool Load(const std::filesystem::path &filepath, BakedEnvironment &outEnvironment);
+
+        // equirect RGBA32F pixels, row 0 is the top of the image
+        static bool Bake(const f32 *equirect, u32 width, u32 height, const EnvironmentBakeSettings &settings, BakedEnvironment &outEnvironment);
+
+        static bool LoadFromCache(u64 cacheKey, BakedEnvironment &outEnvironment);
+        static void SaveToCache(u64 cacheKey, const BakedEnvironment &environment);
+
+        static void SetSettings(const EnvironmentBakeSettings &settings);
+        static const EnvironmentBakeSettings &GetSettings();
+
+        static void SetCacheDirectory(const std::filesystem::path &directory);
+        static const std::filesystem::path &GetCacheDirectory();
+    };
+}
@@ -0,0 +1,272 @@
+#include "gpu_profiler.hpp"
+
+#include "ignite/core/device/device_manager.hpp"
+#include "ignite/core/logger.hpp"
+#include "ignite/core/memory.hpp"
+
+#include <algorithm>
+#include <span>
+#include <string_view>
+
+namespace ignite
+{
+    namespace
+    {
+        struct QuerySlot
+        {
+            nvrhi::TimerQueryHandle query;
+            u64 cpuStart = 0; // Profiler::Now when the pass was recorded
+        };
+
+        // the recordings of a pass in one frame
+        struct FrameQueries
+        {
+            QuerySlot slots[GPU_PROFILER_MAX_PASS_REPEATS];
+            u32 count = 0; // ended slots
+            u64 frame = 0; // recorded in
+            bool pending = false;
+        };
+
+        struct PassData
+        {
+            const char *name = nullptr;
+            FrameQueries frames[GPU_PROFILER_FRAME_LATENCY];
+            FrameQueries *open = nullptr; // between BeginPass and EndPass, records into slots[count]
+
+            f32 history[GPU_PROFILER_HISTORY] = {};
+            u32 historyCount = 0;
+            u32 historyHead = 0;
+            f32 lastMs = 0.0f;
+        };
+
+        struct FinishedPass
+        {
+            const char *name;
+            u64 cpuStart;
+            u64 duration;
+        };
+
+        struct GPUProfilerData
+        {
+            nvrhi::IDevice *device = nullptr;
+            bool enabled = true;
+
+            // the GPU is done with a frame once its event is, timer queries are only read after that.
+            // a timestamp polled earlier may still hold the value of the previous use of the query
+            nvrhi::EventQueryHandle frameEvents[GPU_PROFILER_FRAME_LATENCY];
+            u64 frameIndex = 0;
+
+            // reserved up front, open points into it
+            std::vector<PassData> passes;
+
+            u32 track = 0;
+            u64 trackEnd = 0; // passes are laid out one after another on the track
+        };
+
+        GPUProfilerData &GetData()
+        {
+            static GPUProfilerData data;
+            return data;
+        }
+
+        PassData *FindPass(const char *name)
+        {
+            GPUProfilerData &data = GetData();
+            for (PassData &pass : data.passes)
+            {
+                if (pass.name == name || std::string_view(pass.name) == name)
+                    return &pass;
+            }
+
+            if (data.passes.size() >= GPU_PROFILER_MAX_PASSES)
+                return nullptr;
+
+            PassData &pass = data.passes.emplace_back();
+            pass.name = name;
+            return &pass;
+        }
+    }
+
+    void GPUProfiler::Init(DeviceManager *deviceManager)
+    {
+        GPUProfilerData &data = GetData();
+
+        if (!deviceManager->IsTimerQuerySupported())
+        {
+            LOG_WARN("[GPU Profiler] Timestamp queries are not supported by {}, GPU timings are disabled", deviceManager->GetRendererString());
+            return;
+        }
+
+        data.device = deviceManager->GetDevice();
+        for (nvrhi::EventQueryHandle &event : data.frameEvents)
+            event = data.device->createEventQuery();
+
+        data.passes.reserve(GPU_PROFILER_MAX_PASSES);
+        data.track = Profiler::CreateTrack("GPU");
+    }
+
+    void GPUProfiler::Shutdown()
+    {
+        GPUProfilerData &data = GetData();
+        data.passes.clear();
+        for (nvrhi::EventQueryHandle &event : data.frameEvents)
+            event = nullptr;
+        data.device = nullptr;
+    }
+
+    void GPUProfiler::BeginFrame()
+    {
+        GPUProfilerData &data = GetData();
+        if (!data.device)
+            return;
+
+        // everything of the last frame has been submitted by now
+        if (data.frameIndex > 0)
+        {
+            nvrhi::IEventQuery *event = data.frameEvents[(data.frameIndex - 1) % GPU_PROFILER_FRAME_LATENCY];
+            data.device->resetEventQuery(event);
+            data.device->setEventQuery(event, nvrhi::CommandQueue::Graphics);
+        }
+
+        FrameVector<FinishedPass> finished;
+        for (PassData &pass : data.passes)
+        {
+            for (FrameQueries &queries : pass.frames)
+            {
+                // an event reused by a later frame covers this one as well
+                if (!queries.pending || !data.device->pollEventQuery(data.frameEvents[queries.frame % GPU_PROFILER_FRAME_LATENCY]))
+                    continue;
+
+                const std::span<QuerySlot> slots(queries.slots, queries.count);
+                if (!std::ranges::all_of(slots, [&data](const QuerySlot &slot) { return data.device->pollTimerQuery(slot.query); }))
+                    continue;
+
+                f32 seconds = 0.0f;
+                for (const QuerySlot &slot : slots)
+                {
+                    const f32 slotSeconds = data.device->getTimerQueryTime(slot.query);
+                    data.device->resetTimerQuery(slot.query);
+                    seconds += slotSeconds;
+
+                    finished.push_back({ pass.name, slot.cpuStart, static_cast<u64>(static_cast<f64>(slotSeconds) * 1'000'000'000.0) });
+                }
+                queries.pending = false;
+
+                pass.lastMs = seconds * 1000.0f;
+                pass.history[pass.historyHead] = pass.lastMs;
+                pass.historyHead = (pass.historyHead + 1) % GPU_PROFILER_HISTORY;
+                pass.historyCount = std::min(pass.historyCount + 1, static_cast<u32>(GPU_PROFILER_HISTORY));
+            }
+        }
+
+        std::ranges::sort(finished, {}, &FinishedPass::cpuStart);
+        for (const FinishedPass &pass : finished)
+        {
+            const u64 start = std::max(pass.cpuStart, data.trackEnd);
+            data.trackEnd = start + pass.duration;
+            Profiler::RecordTrack(data.track, pass.name, start, data.trackEnd);
+        }
+
+        data.frameIndex++;
+    }
+
+    void GPUProfiler::BeginPass(nvrhi::ICommandList *commandList, const char *name)
+    {
+        GPUProfilerData &data = GetData();
+        if (!data.device || !data.enabled)
+            return;
+
+        PassData *pass = FindPass(name);
+        if (!pass)
+            return;
+
+        LOG_ASSERT(!pass->open, "[GPU Profiler] Pass {} began twice", name);
+
+        FrameQueries &queries = pass->frames[data.frameIndex % GPU_PROFILER_FRAME_LATENCY];
+        if (!queries.pending)
+        {
+            queries.count = 0;
+            queries.frame = data.frameIndex;
+        }
+
+        // still in flight from an earlier frame, or recorded too often this frame
+        if (queries.frame != data.frameIndex || queries.count == GPU_PROFILER_MAX_PASS_REPEATS)
+            return;
+
+        QuerySlot &slot = queries.slots[queries.count];
+        if (!slot.query)
+        {
+            slot.query = data.device->createTimerQuery();
+            if (!slot.query)
+            {
+                LOG_ERROR("[GPU Profiler] Failed to create a timer query for {}", name);
+                return;
+            }
+        }
+
+        commandList->beginTimerQuery(slot.query);
+        slot.cpuStart = Profiler::Now();
+        pass->open = &queries;
+    }
+
+    void GPUProfiler::EndPass(nvrhi::ICommandList *commandList, const char *name)
+    {
+        GPUProfilerData &data = GetData();
+        if (!data.device)
+            return;
+
+        PassData *pass = FindPass(name);
+        if (!pass || !pass->open)
+            return;
+
+        FrameQueries &queries = *pass->open;
+        commandList->endTimerQuery(queries.slots[queries.count++].query);
+        queries.pending = true;
+        pass->open = nullptr;
+    }
+
+    void GPUProfiler::SetEnabled(bool enabled)
+    {
+        GetData().enabled = enabled;
+    }
+
+    bool GPUProfiler::IsEnabled()
+    {
+        return GetData().enabled;
+    }
+
+    bool GPUProfiler::IsSupported()
+    {
+        return GetData().device != nullptr;
+    }
+
+    std::vector<GPUPassStats> GPUProfiler::GetStats()
+    {
+        const GPUProfilerData &data = GetData();
+
+        std::vector<GPUPassStats> stats;
+        stats.reserve(data.passes.size());
+
+        for (const PassData &pass : data.passes)
+        {
+            GPUPassStats &passStats = stats.emplace_back();
+            passStats.name = pass.name;
+            passStats.lastMs = pass.lastMs;
+            passStats.samples = pass.historyCount;
+
+            if (pass.historyCount == 0)
+                continue;
+
+            const auto [minMs, maxMs] = std::minmax_element(pass.history, pass.history + pass.historyCount);
+            passStats.minMs = *minMs;
+            passStats.maxMs = *maxMs;
+
+            f32 sum = 0.0f;
+            for (u32 i = 0; i < pass.historyCount; ++i)
+                sum += pass.history[i];
+            passStats.avgMs = sum / static_cast<f32>(pass.historyCount);
+        }
+
+        return stats;
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+#include "ignite/core/profiler.hpp"
+
+#include <nvrhi/nvrhi.h>
+
+#include <vector>
+
+namespace ignite
+{
+#define GPU_PROFILER_FRAME_LATENCY 3 // frames of queries per pass, a result is read back this many frames later at most
+#define GPU_PROFILER_HISTORY 120 // frames in the rolling min/avg/max
+#define GPU_PROFILER_MAX_PASSES 32
+#define GPU_PROFILER_MAX_PASS_REPEATS 8 // timed recordings of a pass per frame, further ones are left out of its time
+
+    class DeviceManager;
+
+    struct GPUPassStats
+    {
+        const char *name = nullptr;
+        f32 lastMs = 0.0f;
+        f32 minMs = 0.0f;
+        f32 avgMs = 0.0f;
+        f32 maxMs = 0.0f;
+        u32 samples = 0; // in the rolling window
+    };
+
+    // GPU time of render passes from timer queries. Each pass owns a ring of queries,
+    // BeginFrame reads back the ones the GPU finished without waiting, a pass whose
+    // query is still in flight is skipped for that frame instead of stalling.
+    // A pass recorded several times in a frame gets a query per recording and reports their sum.
+    // Results also go to the "GPU" track of the Profiler, placed at the CPU time the pass was recorded.
+    // Render thread only.
+    class GPUProfiler
+    {
+    public:
+        // stays disabled when the device can not write timestamps
+        static void Init(DeviceManager *deviceManager);
+        static void Shutdown();
+
+        // once per frame before any pass is recorded
+        static void BeginFrame();
+
+        // name must outlive the profiler, the same name is the same pass
+        static void BeginPass(nvrhi::ICommandList *commandList, const char *name);
+        static void EndPass(nvrhi::ICommandList *commandList, const char *name);
+
+        static void SetEnabled(bool enabled);
+        [[nodiscard]] static bool IsEnabled();
+        [[nodiscard]] static bool IsSupported();
+
+        // in the order the passes were first recorded
+        [[nodiscard]] static std::vector<GPUPassStats> GetStats();
+    };
+
+    class GPUProfileScope
+    {
+    public:
+        GPUProfileScope(nvrhi::ICommandList *commandList, const char *name)
+            : m_CommandList(commandList), m_Name(name)
+        {
+            GPUProfiler::BeginPass(m_CommandList, m_Name);
+        }
+
+        ~GPUProfileScope()
+        {
+            GPUProfiler::EndPass(m_CommandList, m_Name);
+        }
+
+        GPUProfileScope(const GPUProfileScope &) = delete;
+        GPUProfileScope &operator=(const GPUProfileScope &) = delete;
+
+    private:
+        nvrhi::ICommandList *m_CommandList;
+        const char *m_Name;
+    };
+}
+
+#if IGNITE_PROFILE
+    #define IGN_GPU_PROFILE_SCOPE(commandList, name) ::ignite::GPUProfileScope IGN_PROFILE_CONCAT(gpuProfileScope, __LINE__)(commandList, name)
+#else
+    #define IGN_GPU_PROFILE_SCOPE(commandList, name)
+#endif
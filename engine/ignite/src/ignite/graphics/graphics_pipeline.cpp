@@ -55,7 +55,7 @@ namespace ignite {
 
             rasterState.cullMode = m_Params.cullMode;
             rasterState.fillMode = m_Params.fillMode;
-            rasterState.setFrontCounterClockwise(false);
+            rasterState.setFrontCounterClockwise(m_Params.frontCounterClockwise);
             rasterState.setMultisampleEnable(false);
 
             nvrhi::RenderState renderState;
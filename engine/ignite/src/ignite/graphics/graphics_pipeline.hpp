@@ -33,6 +33,7 @@ namespace ignite {
         bool enableDepthStencil = false;
         bool depthWrite = false;
         bool depthTest = false;
+        bool frontCounterClockwise = false;
     };
 
     class GraphicsPipeline
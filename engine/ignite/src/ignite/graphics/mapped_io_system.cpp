@@ -0,0 +1,89 @@
+#include "mapped_io_system.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ignite
+{
+    namespace
+    {
+        class MappedIOStream : public Assimp::IOStream
+        {
+        public:
+            MappedIOStream(Ref<vfs::MappedFile> file)
+                : m_File(std::move(file))
+            {
+            }
+
+            size_t Read(void *buffer, size_t size, size_t count) override
+            {
+                if (size == 0 || count == 0)
+                    return 0;
+
+                const size_t available = (static_cast<size_t>(m_File->Size()) - m_Position) / size;
+                count = std::min(count, available);
+
+                std::memcpy(buffer, m_File->Data() + m_Position, size * count);
+                m_Position += size * count;
+                return count;
+            }
+
+            size_t Write(const void *, size_t, size_t) override
+            {
+                return 0;
+            }
+
+            aiReturn Seek(size_t offset, aiOrigin origin) override
+            {
+                const size_t fileSize = static_cast<size_t>(m_File->Size());
+
+                size_t position = 0;
+                switch (origin)
+                {
+                case aiOrigin_SET: position = offset; break;
+                case aiOrigin_CUR: position = m_Position + offset; break;
+                case aiOrigin_END: position = fileSize - offset; break;
+                default: return aiReturn_FAILURE;
+                }
+
+                if (position > fileSize)
+                    return aiReturn_FAILURE;
+
+                m_Position = position;
+                return aiReturn_SUCCESS;
+            }
+
+            size_t Tell() const override { return m_Position; }
+            size_t FileSize() const override { return static_cast<size_t>(m_File->Size()); }
+            void Flush() override {}
+
+        private:
+            Ref<vfs::MappedFile> m_File;
+            size_t m_Position = 0;
+        };
+    }
+
+    bool MappedIOSystem::Exists(const char *filepath) const
+    {
+        std::error_code ec;
+        return std::filesystem::is_regular_file(filepath, ec);
+    }
+
+    Assimp::IOStream *MappedIOSystem::Open(const char *filepath, const char *mode)
+    {
+        // importers never write, refuse anything but reading
+        if (mode && (std::strchr(mode, 'w') || std::strchr(mode, 'a')))
+            return nullptr;
+
+        Ref<vfs::MappedFile> file = vfs::MappedFile::Open(filepath);
+        if (!file)
+            return nullptr;
+
+        return new MappedIOStream(std::move(file));
+    }
+
+    void MappedIOSystem::Close(Assimp::IOStream *file)
+    {
+        delete file;
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "ignite/core/vfs/mapped_file.hpp"
+
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+
+namespace ignite
+{
+    // Assimp file access through memory mapped views, used for the model file
+    // and everything it references (gltf buffers, mtl files, ...). Read only.
+    class MappedIOSystem : public Assimp::IOSystem
+    {
+    public:
+        bool Exists(const char *filepath) const override;
+        char getOsSeparator() const override { return '/'; }
+
+        Assimp::IOStream *Open(const char *filepath, const char *mode = "rb") override;
+        void Close(Assimp::IOStream *file) override;
+    };
+}
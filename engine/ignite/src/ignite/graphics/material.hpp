@@ -31,6 +31,7 @@ namespace ignite {
             uint32_t height;
             uint32_t rowPitch = 0;
             nvrhi::TextureHandle handle;
+            Ref<Texture> texture; // keeps the cached texture alive
         };
 
         uint32_t mipLevels = 4;
@@ -43,6 +44,21 @@ namespace ignite {
         bool IsReflective() const { return _reflective; }
         bool ShouldWriteTexture() const { return _shouldWriteTexture; }
 
+        // picks up handles replaced by texture streaming, returns true if any changed
+        bool RefreshTextureHandles()
+        {
+            bool changed = false;
+            for (TextureData &texture : textures | std::views::values)
+            {
+                if (texture.texture && texture.handle != texture.texture->GetHandle())
+                {
+                    texture.handle = texture.texture->GetHandle();
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+
         void UploadTextureWithMips(nvrhi::ICommandList *commandList,
             nvrhi::TextureHandle handle,
             const void *baseData,
@@ -53,23 +69,23 @@ namespace ignite {
             uint32_t mipLevels)
         {
             // Generate all mip levels on CPU
-            auto mipChain = CPUMipGenerator::GenerateMipChain(baseData, baseWidth, baseHeight, baseRowPitch, format, mipLevels);
+            const MipChain mipChain = CPUMipGenerator::GenerateMipChain(baseData, baseWidth, baseHeight, baseRowPitch, format, mipLevels);
 
             // Upload all mip levels
-            for (uint32_t mip = 0; mip < mipLevels && mip < mipChain.size(); ++mip)
+            for (uint32_t mip = 0; mip < mipChain.size(); ++mip)
             {
-                const auto &mipData = mipChain[mip];
-                commandList->writeTexture(handle, 0, mip, mipData.data.data(), mipData.rowPitch);
+                const MipLevelData &mipData = mipChain[mip];
+                commandList->writeTexture(handle, 0, mip, mipData.data, mipData.rowPitch);
             }
         }
 
         void WriteBuffer(nvrhi::ICommandList *commandList)
         {
-            for (const auto& [buffer, width, height, rowPitch, handle] : textures | std::views::values)
+            for (const TextureData &texture : textures | std::views::values)
             {
-                if (buffer.Data)
+                if (texture.buffer.Data)
                 {
-                    UploadTextureWithMips(commandList, handle, buffer.Data, width, height, rowPitch, nvrhi::Format::RGBA8_UNORM, mipLevels);
+                    UploadTextureWithMips(commandList, texture.handle, texture.buffer.Data, texture.width, texture.height, texture.rowPitch, nvrhi::Format::RGBA8_UNORM, mipLevels);
                 }
             }
         }
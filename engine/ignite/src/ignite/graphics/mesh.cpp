@@ -4,10 +4,13 @@
 
 namespace ignite
 {
-    void Mesh::CreateBuffers()
+    void MeshGeometry::CreateBuffers()
     {
         nvrhi::IDevice *device = Application::GetDeviceManager()->GetDevice();
 
+        m_VertexCount = static_cast<u32>(data.vertices.size());
+        m_IndexCount = static_cast<u32>(data.indices.size());
+
         // create vertex buffer
         nvrhi::BufferDesc vbDesc = nvrhi::BufferDesc();
         vbDesc.isVertexBuffer = true;
@@ -29,6 +32,39 @@ namespace ignite
 
         indexBuffer = device->createBuffer(ibDesc);
         LOG_ASSERT(indexBuffer, "[Mesh] Failed to create Index Buffer");
+    }
+
+    void MeshGeometry::WriteBuffers(nvrhi::ICommandList *commandList)
+    {
+        if (m_IsUploaded)
+            return;
+
+        commandList->writeBuffer(indexBuffer, data.indices.data(), sizeof(uint32_t) * data.indices.size());
+        commandList->writeBuffer(vertexBuffer, data.vertices.data(), sizeof(VertexMesh) * data.vertices.size());
+
+        m_IsUploaded = true;
+
+        if (!keepCPUData)
+        {
+            ReleaseCPUData();
+        }
+    }
+
+    void MeshGeometry::ReleaseCPUData()
+    {
+        // clusters are kept, they are needed for culling
+        data.vertices = std::vector<VertexMesh>();
+        data.indices = std::vector<uint32_t>();
+    }
+
+    void Mesh::CreateBuffers()
+    {
+        nvrhi::IDevice *device = Application::GetDeviceManager()->GetDevice();
+
+        if (!geometry->vertexBuffer)
+        {
+            geometry->CreateBuffers();
+        }
 
         // Constant buffer
         auto constantBufferDesc = nvrhi::BufferDesc()
@@ -77,24 +113,25 @@ namespace ignite
         }
     }
 
-    void Mesh::WriteBuffers(uint32_t entityID)
+    void Mesh::WriteBuffers()
     {
+        const bool writeGeometry = !geometry->IsUploaded();
+        const bool writeTexture = material.ShouldWriteTexture();
+        if (!writeGeometry && !writeTexture)
+            return;
+
         nvrhi::IDevice *device = Application::GetRenderDevice();
         nvrhi::CommandListHandle commandList = device->createCommandList();
 
         commandList->open();
 
-        commandList->writeBuffer(indexBuffer, data.indices.data(), sizeof(uint32_t) * data.indices.size());
-
-        // default
-        for (auto &vertex : data.vertices)
+        if (writeGeometry)
         {
-            vertex.entityID = entityID;
+            geometry->WriteBuffers(commandList);
         }
-        commandList->writeBuffer(vertexBuffer, data.vertices.data(), sizeof(VertexMesh) * data.vertices.size());
 
         // write textures
-        if (material.ShouldWriteTexture())
+        if (writeTexture)
         {
             material.WriteBuffer(commandList);
         }
@@ -114,6 +151,7 @@ namespace ignite
         }
 
         material.textures[type].handle = texture->GetHandle();
+        material.textures[type].texture = texture;
         CreateBindingSet();
     }
 }
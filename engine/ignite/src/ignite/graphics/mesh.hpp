@@ -2,10 +2,12 @@
 
 #include "vertex_data.hpp"
 #include "material.hpp"
+#include "mesh_cluster.hpp"
 
 #include "renderer.hpp"
 
 #include "ignite/core/uuid.hpp"
+#include "ignite/asset/asset.hpp"
 #include "ignite/math/aabb.hpp"
 #include "ignite/animation/skeletal_animation.hpp"
 #include "ignite/scene/entity.hpp"
@@ -66,24 +68,53 @@ namespace ignite {
     {
         std::vector<VertexMesh> vertices;
         std::vector<uint32_t> indices;
+        std::vector<MeshCluster> clusters; // index ranges in 'indices'
 
         int materialIndex = -1;
     };
 
+    // Immutable vertex and index data, shared by every Mesh that renders it
+    class MeshGeometry : public Asset
+    {
+    public:
+        MeshData data;
+        AABB aabb;
+
+        nvrhi::BufferHandle vertexBuffer;
+        nvrhi::BufferHandle indexBuffer;
+
+        // keep vertices and indices on the CPU after upload
+        bool keepCPUData = false;
+
+        void CreateBuffers();
+        void WriteBuffers(nvrhi::ICommandList *commandList);
+        void ReleaseCPUData();
+
+        bool IsUploaded() const { return m_IsUploaded; }
+        u32 GetVertexCount() const { return m_VertexCount; }
+        u32 GetIndexCount() const { return m_IndexCount; }
+
+        static AssetType GetStaticType() { return AssetType::Mesh; }
+        virtual AssetType GetType() override { return GetStaticType(); }
+
+    private:
+        u32 m_VertexCount = 0;
+        u32 m_IndexCount = 0;
+        bool m_IsUploaded = false;
+    };
+
     class Mesh
     {
     public:
         std::string name;
 
-        MeshData data;
+        Ref<MeshGeometry> geometry;
         Material material;
         Ref<Shader> vertexShader;
         Ref<Shader> pixelShader;
         Ref<Environment> environment;
 
         // do not copy the buffer
-        nvrhi::BufferHandle vertexBuffer;
-        nvrhi::BufferHandle indexBuffer;
         nvrhi::BufferHandle objectBufferHandle;
         nvrhi::BufferHandle materialBufferHandle;
         std::unordered_map<GPipeline, nvrhi::BindingSetHandle> bindingSets;
@@ -94,26 +125,31 @@ namespace ignite {
         std::vector<BoneInfo> boneInfo; // Bone weights and indices
         std::unordered_map<std::string, uint32_t> boneMapping; // Maps bone name to indices
 
-        AABB aabb;
+        Mesh()
+            : geometry(CreateRef<MeshGeometry>())
+        {
+        }
 
-        Mesh() = default;
         Mesh(const Mesh &other)
         {
-            data = other.data;
+            // geometry is shared, only per instance buffers are created
+            geometry = other.geometry;
 
+            name = other.name;
             vertexShader = other.vertexShader;
             pixelShader = other.pixelShader;
             material = other.material;
+            nodeParentID = other.nodeParentID;
+            nodeID = other.nodeID;
             boneInfo = other.boneInfo;
             boneMapping = other.boneMapping;
-            aabb = other.aabb;
 
             CreateBuffers();
         }
 
         void CreateBuffers();
         void CreateBindingSet();
-        void WriteBuffers(uint32_t entityID = -1);
+        void WriteBuffers();
         void UpdateTexture(Ref<Texture> texture, aiTextureType type);
     };
     
@@ -0,0 +1,300 @@
+#include "mesh_cluster.hpp"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace ignite
+{
+    void MeshClusterBuilder::Build(const std::vector<VertexMesh> &vertices, std::vector<u32> &indices, std::vector<MeshCluster> &outClusters, u32 maxVertices, u32 maxTriangles)
+    {
+        outClusters.clear();
+
+        const u32 vertexCount = static_cast<u32>(vertices.size());
+        const u32 triangleCount = static_cast<u32>(indices.size() / 3);
+        if (triangleCount == 0 || vertexCount == 0)
+            return;
+
+        // vertex -> triangle adjacency
+        std::vector<u32> adjacencyOffsets(vertexCount + 1, 0);
+        for (u32 index : indices)
+            adjacencyOffsets[index + 1]++;
+        for (u32 v = 0; v < vertexCount; ++v)
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+
+        std::vector<u32> adjacency(indices.size());
+        {
+            std::vector<u32> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (u32 t = 0; t < triangleCount; ++t)
+            {
+                adjacency[fill[indices[t * 3 + 0]]++] = t;
+                adjacency[fill[indices[t * 3 + 1]]++] = t;
+                adjacency[fill[indices[t * 3 + 2]]++] = t;
+            }
+        }
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<u32> vertexCluster(vertexCount, UINT32_MAX); // last cluster that referenced the vertex
+
+        std::vector<u32> reordered;
+        reordered.reserve(indices.size());
+
+        std::vector<u32> candidates;
+        u32 clusterVertexCount = 0;
+        u32 clusterTriangleCount = 0;
+        u32 seed = 0;
+        u32 emittedCount = 0;
+
+        MeshCluster cluster;
+
+        auto countNewVertices = [&](u32 t, u32 clusterIndex) -> u32
+        {
+            u32 count = 0;
+            for (u32 i = 0; i < 3; ++i)
+                count += vertexCluster[indices[t * 3 + i]] != clusterIndex ? 1 : 0;
+            return count;
+        };
+
+        auto flushCluster = [&]()
+        {
+            cluster.indexCount = clusterTriangleCount * 3;
+            outClusters.push_back(cluster);
+
+            cluster = MeshCluster();
+            cluster.indexOffset = static_cast<u32>(reordered.size());
+            clusterVertexCount = 0;
+            clusterTriangleCount = 0;
+            candidates.clear();
+        };
+
+        while (emittedCount < triangleCount)
+        {
+            const u32 clusterIndex = static_cast<u32>(outClusters.size());
+
+            // pick the best connected triangle: the one that adds the fewest new vertices
+            u32 best = UINT32_MAX;
+            u32 bestNewVertices = UINT32_MAX;
+            for (size_t i = 0; i < candidates.size();)
+            {
+                const u32 t = candidates[i];
+                if (emitted[t])
+                {
+                    candidates[i] = candidates.back();
+                    candidates.pop_back();
+                    continue;
+                }
+
+                const u32 newVertices = countNewVertices(t, clusterIndex);
+                if (newVertices < bestNewVertices && clusterVertexCount + newVertices <= maxVertices)
+                {
+                    best = t;
+                    bestNewVertices = newVertices;
+                    if (newVertices == 0)
+                        break;
+                }
+                ++i;
+            }
+
+            // no connected triangle left, continue with the next one in index order
+            if (best == UINT32_MAX)
+            {
+                while (emitted[seed])
+                    ++seed;
+
+                const u32 newVertices = countNewVertices(seed, clusterIndex);
+                if (clusterTriangleCount > 0 && clusterVertexCount + newVertices > maxVertices)
+                {
+                    flushCluster();
+                    continue;
+                }
+
+                best = seed;
+                bestNewVertices = newVertices;
+            }
+
+            // append triangle to the current cluster
+            emitted[best] = true;
+            ++emittedCount;
+            ++clusterTriangleCount;
+            clusterVertexCount += bestNewVertices;
+
+            for (u32 i = 0; i < 3; ++i)
+            {
+                const u32 v = indices[best * 3 + i];
+                reordered.push_back(v);
+
+                if (vertexCluster[v] != clusterIndex)
+                {
+                    vertexCluster[v] = clusterIndex;
+                    for (u32 a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; ++a)
+                    {
+                        if (!emitted[adjacency[a]])
+                            candidates.push_back(adjacency[a]);
+                    }
+                }
+            }
+
+            if (clusterTriangleCount >= maxTriangles || clusterVertexCount >= maxVertices)
+            {
+                flushCluster();
+            }
+        }
+
+        if (clusterTriangleCount > 0)
+        {
+            flushCluster();
+        }
+
+        indices = std::move(reordered);
+
+        for (MeshCluster &c : outClusters)
+        {
+            ComputeBounds(vertices, indices, c);
+        }
+    }
+
+    void MeshClusterBuilder::ComputeBounds(const std::vector<VertexMesh> &vertices, const std::vector<u32> &indices, MeshCluster &cluster)
+    {
+        // bounding sphere from AABB center
+        glm::vec3 min = glm::vec3(FLT_MAX);
+        glm::vec3 max = glm::vec3(-FLT_MAX);
+        for (u32 i = cluster.indexOffset; i < cluster.indexOffset + cluster.indexCount; ++i)
+        {
+            const glm::vec3 &p = vertices[indices[i]].position;
+            min = glm::min(min, p);
+            max = glm::max(max, p);
+        }
+
+        cluster.center = (min + max) * 0.5f;
+        cluster.radius = 0.0f;
+        for (u32 i = cluster.indexOffset; i < cluster.indexOffset + cluster.indexCount; ++i)
+        {
+            cluster.radius = glm::max(cluster.radius, glm::length(vertices[indices[i]].position - cluster.center));
+        }
+
+        // normal cone from triangle normals
+        glm::vec3 normalSum = glm::vec3(0.0f);
+        for (u32 i = cluster.indexOffset; i < cluster.indexOffset + cluster.indexCount; i += 3)
+        {
+            const glm::vec3 &p0 = vertices[indices[i + 0]].position;
+            const glm::vec3 &p1 = vertices[indices[i + 1]].position;
+            const glm::vec3 &p2 = vertices[indices[i + 2]].position;
+
+            const glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            const f32 length = glm::length(n);
+            if (length > 0.0f)
+                normalSum += n / length;
+        }
+
+        cluster.coneCutoff = 1.0f;
+        cluster.coneApex = cluster.center;
+
+        const f32 axisLength = glm::length(normalSum);
+        if (axisLength <= 0.0f)
+            return;
+
+        cluster.coneAxis = normalSum / axisLength;
+
+        f32 minDot = 1.0f;
+        for (u32 i = cluster.indexOffset; i < cluster.indexOffset + cluster.indexCount; i += 3)
+        {
+            const glm::vec3 &p0 = vertices[indices[i + 0]].position;
+            const glm::vec3 n = glm::cross(vertices[indices[i + 1]].position - p0, vertices[indices[i + 2]].position - p0);
+            const f32 length = glm::length(n);
+            if (length > 0.0f)
+                minDot = glm::min(minDot, glm::dot(n / length, cluster.coneAxis));
+        }
+
+        // normals spread over more than a hemisphere
+        if (minDot <= 0.0f)
+            return;
+
+        // move the apex back along the axis until it is behind every triangle plane
+        f32 maxT = 0.0f;
+        for (u32 i = cluster.indexOffset; i < cluster.indexOffset + cluster.indexCount; i += 3)
+        {
+            const glm::vec3 &p0 = vertices[indices[i + 0]].position;
+            const glm::vec3 n = glm::cross(vertices[indices[i + 1]].position - p0, vertices[indices[i + 2]].position - p0);
+            const f32 length = glm::length(n);
+            if (length <= 0.0f)
+                continue;
+
+            const glm::vec3 normal = n / length;
+            const f32 dc = glm::dot(cluster.center - p0, normal);
+            const f32 dn = glm::dot(cluster.coneAxis, normal);
+
+            // dn >= minDot > 0
+            maxT = glm::max(maxT, dc / dn);
+        }
+
+        cluster.coneApex = cluster.center - cluster.coneAxis * maxT;
+        cluster.coneCutoff = glm::sqrt(1.0f - minDot * minDot);
+    }
+
+    u32 MeshClusterCuller::Cull(const std::vector<MeshCluster> &clusters, const glm::mat4 &transform, const Frustum &frustum, const glm::vec3 &cameraPosition, ClusterFaceCull faceCull, std::vector<MeshClusterDrawRange> &outRanges)
+    {
+        outRanges.clear();
+
+        const f32 maxScale = glm::sqrt(glm::max(glm::max(
+            glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+            glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1]))),
+            glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]))));
+
+        const glm::vec3 localCameraPosition = glm::vec3(glm::inverse(transform) * glm::vec4(cameraPosition, 1.0f));
+
+        // mirrored transforms flip the winding, the object space cones would point the wrong way
+        if (glm::determinant(glm::mat3(transform)) <= 0.0f)
+            faceCull = ClusterFaceCull::None;
+
+        u32 visibleIndexCount = 0;
+        for (const MeshCluster &cluster : clusters)
+        {
+            if (faceCull == ClusterFaceCull::Away && cluster.coneCutoff < 1.0f)
+            {
+                const glm::vec3 toApex = cluster.coneApex - localCameraPosition;
+                const f32 distance = glm::length(toApex);
+                if (distance > 0.0f && glm::dot(toApex, cluster.coneAxis) >= cluster.coneCutoff * distance)
+                    continue;
+            }
+            else if (faceCull == ClusterFaceCull::Toward && cluster.coneCutoff < 1.0f)
+            {
+                // the apex is only behind the triangles, the bounding sphere stands in for it on the front side
+                const glm::vec3 fromCenter = localCameraPosition - cluster.center;
+                if (glm::dot(fromCenter, cluster.coneAxis) >= cluster.coneCutoff * glm::length(fromCenter) + cluster.radius)
+                    continue;
+            }
+
+            const glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(cluster.center, 1.0f));
+            if (!frustum.IsSphereVisible(worldCenter, cluster.radius * maxScale))
+                continue;
+
+            // merge with previous range when contiguous
+            if (!outRanges.empty() && outRanges.back().indexOffset + outRanges.back().indexCount == cluster.indexOffset)
+            {
+                outRanges.back().indexCount += cluster.indexCount;
+            }
+            else
+            {
+                outRanges.push_back({ cluster.indexOffset, cluster.indexCount });
+            }
+
+            visibleIndexCount += cluster.indexCount;
+        }
+
+        return visibleIndexCount / 3;
+    }
+
+    void MeshClusterCuller::CompactIndices(const std::vector<u32> &indices, const std::vector<MeshClusterDrawRange> &ranges, std::vector<u32> &outIndices)
+    {
+        outIndices.clear();
+
+        size_t count = 0;
+        for (const MeshClusterDrawRange &range : ranges)
+            count += range.indexCount;
+        outIndices.reserve(count);
+
+        for (const MeshClusterDrawRange &range : ranges)
+        {
+            outIndices.insert(outIndices.end(), indices.begin() + range.indexOffset, indices.begin() + range.indexOffset + range.indexCount);
+        }
+    }
+}
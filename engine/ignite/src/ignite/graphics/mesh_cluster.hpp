@@ -0,0 +1,67 @@
+#pragma once
+
+#include "vertex_data.hpp"
+#include "ignite/core/types.hpp"
+#include "ignite/math/frustum.hpp"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace ignite
+{
+#define MESH_CLUSTER_MAX_VERTICES 64
+#define MESH_CLUSTER_MAX_TRIANGLES 124
+
+    // A small group of triangles that is stored contiguously in the index buffer
+    struct MeshCluster
+    {
+        u32 indexOffset = 0; // first index in the (reordered) index buffer
+        u32 indexCount = 0;
+
+        // bounding sphere (object space)
+        glm::vec3 center = glm::vec3(0.0f);
+        f32 radius = 0.0f;
+
+        // normal cone (object space), cluster is backfacing if
+        // dot(normalize(coneApex - cameraPosition), coneAxis) >= coneCutoff
+        glm::vec3 coneApex = glm::vec3(0.0f);
+        glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+        f32 coneCutoff = 1.0f; // 1.0 means the cone can not be used for culling
+    };
+
+    // side of the triangles the rasterizer drops, by where their object space normal cross(p1 - p0, p2 - p0) points
+    enum class ClusterFaceCull : u8
+    {
+        None,
+        Away, // normals pointing away from the camera
+        Toward // normals pointing at the camera
+    };
+
+    struct MeshClusterDrawRange
+    {
+        u32 indexOffset = 0;
+        u32 indexCount = 0;
+    };
+
+    class MeshClusterBuilder
+    {
+    public:
+        // Partition triangles into clusters, indices are reordered so every cluster is a contiguous range
+        static void Build(const std::vector<VertexMesh> &vertices, std::vector<u32> &indices, std::vector<MeshCluster> &outClusters,
+            u32 maxVertices = MESH_CLUSTER_MAX_VERTICES, u32 maxTriangles = MESH_CLUSTER_MAX_TRIANGLES);
+
+        static void ComputeBounds(const std::vector<VertexMesh> &vertices, const std::vector<u32> &indices, MeshCluster &cluster);
+    };
+
+    class MeshClusterCuller
+    {
+    public:
+        // Frustum test in world space, cone test in object space (exact for any affine transform).
+        // Adjacent visible clusters are merged into a single draw range. Returns the number of visible triangles.
+        static u32 Cull(const std::vector<MeshCluster> &clusters, const glm::mat4 &transform, const Frustum &frustum, const glm::vec3 &cameraPosition,
+            ClusterFaceCull faceCull, std::vector<MeshClusterDrawRange> &outRanges);
+
+        // Build a compacted index list from draw ranges
+        static void CompactIndices(const std::vector<u32> &indices, const std::vector<MeshClusterDrawRange> &ranges, std::vector<u32> &outIndices);
+    };
+}
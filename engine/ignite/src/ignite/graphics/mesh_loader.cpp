@@ -5,6 +5,7 @@
 
 #include "renderer.hpp"
 #include "texture.hpp"
+#include "texture_cache.hpp"
 #include "lighting.hpp"
 #include "ignite/math/math.hpp"
 #include "ignite/core/logger.hpp"
@@ -13,12 +14,9 @@
 #include "ignite/graphics/graphics_pipeline.hpp"
 
 #include <queue>
-#include <stb_image.h>
 
 namespace ignite
 {
-    static std::unordered_map<std::string, Material::TextureData> textureCache;
-    
     // Mesh loader
     void MeshLoader::ProcessNode(const aiScene *scene, aiNode *node, const std::filesystem::path &filepath, std::vector<Ref<Mesh>> &meshes, std::vector<NodeInfo> &nodes, const Ref<Skeleton> &skeleton, i32 parentNodeID)
     {
@@ -69,12 +67,12 @@ namespace ignite
                 LoadMaterial(scene, mat, meshes[meshIndex]->material, filepath);
             }
 
-            LoadSingleMesh(scene, assimpMesh, meshIndex, meshes[meshIndex]->data, skeleton, meshes[meshIndex]->aabb);
+            LoadSingleMesh(scene, assimpMesh, meshIndex, meshes[meshIndex]->geometry->data, skeleton, meshes[meshIndex]->geometry->aabb);
 
             // Load bones
             if (assimpMesh->HasBones())
             {
-                ProcessBoneWeights(assimpMesh, meshes[meshIndex]->data, meshes[meshIndex]->boneInfo, meshes[meshIndex]->boneMapping, skeleton);
+                ProcessBoneWeights(assimpMesh, meshes[meshIndex]->geometry->data, meshes[meshIndex]->boneInfo, meshes[meshIndex]->boneMapping, skeleton);
             }
 
             LOG_WARN("[Mesh Loader] {} [{}] Loaded", assimpMesh->mName.data, meshIndex);
@@ -133,6 +131,8 @@ namespace ignite
             outMeshData.indices.push_back(face.mIndices[1]);
             outMeshData.indices.push_back(face.mIndices[2]);
         }
+
+        MeshClusterBuilder::Build(outMeshData.vertices, outMeshData.indices, outMeshData.clusters);
     }
 
     void MeshLoader::ProcessBoneWeights(aiMesh *assimpMesh, MeshData &outMeshData, std::vector<BoneInfo> &outBoneInfo, std::unordered_map<std::string, uint32_t> &outBoneMapping, const Ref<Skeleton> &skeleton)
@@ -352,6 +352,28 @@ namespace ignite
         }
     }
 
+    TextureUsage MeshLoader::GetTextureUsage(aiTextureType type)
+    {
+        switch (type)
+        {
+        case aiTextureType_BASE_COLOR:
+        case aiTextureType_DIFFUSE:
+            return TextureUsage::BaseColor;
+        case aiTextureType_NORMALS:
+            return TextureUsage::Normal;
+        case aiTextureType_DIFFUSE_ROUGHNESS:
+        case aiTextureType_METALNESS:
+        case aiTextureType_AMBIENT_OCCLUSION:
+            return TextureUsage::Mask;
+        case aiTextureType_EMISSIVE:
+            return TextureUsage::Emissive;
+        case aiTextureType_SPECULAR:
+            return TextureUsage::Specular;
+        default:
+            return TextureUsage::None;
+        }
+    }
+
     void MeshLoader::LoadTextures(const aiScene *scene, aiMaterial *material, Material *meshMaterial, aiTextureType type, const std::filesystem::path &modelFilepath)
     {
         if (const i32 texCount = material->GetTextureCount(type))
@@ -361,104 +383,61 @@ namespace ignite
                 aiString aiTextureFilepath;
                 material->GetTexture(type, i, &aiTextureFilepath);
 
-                // try to load from cache
-                for (auto &[path, tex] : textureCache)
-                {
-                    if (std::strcmp(path.c_str(), aiTextureFilepath.C_Str()) == 0)
-                    {
-                        meshMaterial->textures[type] = tex;
-                        LOG_WARN("[Material] {} Loaded from cache", path.c_str());
-                        return;
-                    }
-                }
+                TextureCreateInfo createInfo;
+                createInfo.format = nvrhi::Format::RGBA8_UNORM;
+                createInfo.mipLevels = 0; // full chain
+                createInfo.flip = false;
+                createInfo.usage = GetTextureUsage(type);
 
-                nvrhi::IDevice *device = Application::GetDeviceManager()->GetDevice();
-                stbi_set_flip_vertically_on_load(false);
-                i32 width, height, channels;
-                uint8_t *sourceData = nullptr;
+                Ref<Texture> texture;
 
-                // create new texture
                 // Embedded texture
                 const aiTexture *embeddedTexture = scene->GetEmbeddedTexture(aiTextureFilepath.C_Str());
-                if (embeddedTexture && meshMaterial->textures[type].handle == nullptr)
+                if (embeddedTexture)
                 {
+                    const std::string debugName = fmt::format("{}:{}", modelFilepath.filename().generic_string(), aiTextureFilepath.C_Str());
+
                     // handle compressed textures
                     if (embeddedTexture->mHeight == 0)
                     {
-                        LOG_INFO("[Material] Loading embedded compressed format texture of size {} bytes", embeddedTexture->mWidth);
-                        meshMaterial->textures[type].buffer.Data = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(embeddedTexture->pcData),
-                            embeddedTexture->mWidth, &width, &height, &channels, 4);
+                        texture = TextureCache::LoadFromMemory(Buffer(embeddedTexture->pcData, embeddedTexture->mWidth), createInfo, debugName);
                     }
                     else
                     {
-                        width = static_cast<int>(embeddedTexture->mWidth);
-                        height = static_cast<int>(embeddedTexture->mHeight);
+                        createInfo.width = static_cast<i32>(embeddedTexture->mWidth);
+                        createInfo.height = static_cast<i32>(embeddedTexture->mHeight);
 
-                        LOG_INFO("[Material] Loading embedded uncompressed texture of size {}x{}", width, height);
-
-                        // Allocate space for RGBA8 data
-                        uint8_t *destinationData = new uint8_t[width * height * 4];
-
-                        // Assimp embedded uncompressed texture data is usually in RGB format without alpha
-                        // You can test with alpha channel (or assume RGB with alpha set to 255)
-                        for (int i = 0; i < width * height; ++i)
+                        // Assimp stores uncompressed embedded texels as BGRA8
+                        Buffer pixels(static_cast<u64>(createInfo.width) * createInfo.height * 4);
+                        for (u32 t = 0; t < embeddedTexture->mWidth * embeddedTexture->mHeight; ++t)
                         {
-                            destinationData[i * 4 + 0] = sourceData[i * 3 + 0]; // R
-                            destinationData[i * 4 + 1] = sourceData[i * 3 + 1]; // G
-                            destinationData[i * 4 + 2] = sourceData[i * 3 + 2]; // B
-                            destinationData[i * 4 + 3] = 255;                   // A
+                            const aiTexel &texel = embeddedTexture->pcData[t];
+                            pixels.Data[t * 4 + 0] = texel.r;
+                            pixels.Data[t * 4 + 1] = texel.g;
+                            pixels.Data[t * 4 + 2] = texel.b;
+                            pixels.Data[t * 4 + 3] = texel.a;
                         }
 
-                        meshMaterial->textures[type].buffer.Data = destinationData;
-
-                        sourceData = reinterpret_cast<uint8_t *>(embeddedTexture->pcData);
-                        LOG_ASSERT(sourceData, "[Material] Failed to load texture");
+                        texture = TextureCache::Create(pixels, createInfo, debugName);
+                        pixels.Release();
                     }
                 }
                 else
                 {
-                    std::filesystem::path filepath = modelFilepath.parent_path() / std::string(aiTextureFilepath.C_Str());
-
-                    LOG_ASSERT(std::filesystem::exists(filepath), "[Material] texture path is not exists!");
-
-                    LOG_INFO("[Material] Load texture from {}", filepath.generic_string());
-                    
-                    sourceData = stbi_load(filepath.generic_string().c_str(), &width, &height, &channels, 4);
-                    LOG_ASSERT(sourceData, "[Material] Failed to load texture");
+                    const std::filesystem::path filepath = modelFilepath.parent_path() / std::string(aiTextureFilepath.C_Str());
+                    texture = TextureCache::Load(filepath, createInfo);
                 }
 
+                LOG_ASSERT(texture, "[Material] Failed to load texture {}", aiTextureFilepath.C_Str());
 
-                if (sourceData)
+                if (texture)
                 {
-                    meshMaterial->textures[type].buffer.Data = sourceData;
-                }
-                
-                LOG_ASSERT(meshMaterial->textures[type].buffer.Data, "[Material] Failed to load texture");
-
-                if (meshMaterial->textures[type].buffer.Data)
-                {
-                    meshMaterial->textures[type].width = width;
-                    meshMaterial->textures[type].height = height;
-                    meshMaterial->textures[type].buffer.Size = width * height * 4u;
-                    meshMaterial->textures[type].rowPitch = width * 4u;
-
-                    // create texture
-                    const auto textureDesc = nvrhi::TextureDesc()
-                        .setDimension(nvrhi::TextureDimension::Texture2D)
-                        .setWidth(width)
-                        .setHeight(height)
-                        .setFormat(nvrhi::Format::RGBA8_UNORM)
-                        .setInitialState(nvrhi::ResourceStates::ShaderResource)
-                        .setKeepInitialState(true)
-                        .setMipLevels(meshMaterial->mipLevels)
-                        .setDebugName("Material embedded Texture");
-
-                    meshMaterial->textures[type].handle = device->createTexture(textureDesc);
-                    LOG_ASSERT(meshMaterial->textures[type].handle, "[Material] Failed to create texture!");
-
-                    // store to cache
-                    textureCache[aiTextureFilepath.C_Str()] = meshMaterial->textures[type];
-                    meshMaterial->_shouldWriteTexture = true;
+                    Material::TextureData &textureData = meshMaterial->textures[type];
+                    textureData.width = texture->GetWidth();
+                    textureData.height = texture->GetHeight();
+                    textureData.rowPitch = texture->GetWidth() * 4u;
+                    textureData.handle = texture->GetHandle();
+                    textureData.texture = texture;
                 }
             }
         }
@@ -496,9 +475,4 @@ namespace ignite
 #endif
         }
     }
-
-    void MeshLoader::ClearTextureCache()
-    {
-        textureCache.clear();
-    }
 }
\ No newline at end of file
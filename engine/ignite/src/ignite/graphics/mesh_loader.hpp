@@ -4,6 +4,9 @@
 
 namespace ignite
 {
+// bump when the imported geometry or materials change, stale models are re-imported
+#define MESH_LOADER_VERSION 1
+
     class MeshLoader
     {
     public:        
@@ -17,7 +20,7 @@ namespace ignite
         static void LoadAnimation(const aiScene *scene, std::vector<SkeletalAnimation> &animations);
         static void LoadMaterial(const aiScene *scene, aiMaterial *assimpMaterial, Material &material, const std::filesystem::path &filepath);
         static void LoadTextures(const aiScene *scene, aiMaterial *material, Material *meshMaterial, aiTextureType type, const std::filesystem::path &modelFilepath);
+        static TextureUsage GetTextureUsage(aiTextureType type);
         static void CalculateWorldTransforms(std::vector<NodeInfo> &nodes);
-        static void ClearTextureCache();
     };    
 }
\ No newline at end of file
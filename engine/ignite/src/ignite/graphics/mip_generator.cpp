@@ -0,0 +1,562 @@
+#include "mip_generator.hpp"
+
+#include "ignite/core/logger.hpp"
+#include "ignite/core/job_system.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#   define MIP_SIMD_X64 1
+#   include <immintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       include <intrin.h>
+#       define MIP_TARGET_AVX2
+#       define MIP_TARGET_F16C
+#   else
+#       define MIP_TARGET_AVX2 __attribute__((target("avx2")))
+#       define MIP_TARGET_F16C __attribute__((target("avx,f16c")))
+#   endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   define MIP_SIMD_NEON 1
+#   include <arm_neon.h>
+#endif
+
+namespace ignite
+{
+    namespace
+    {
+        // one destination row from two source rows, srcWidth is used to clamp the right edge
+        using RowKernel = void (*)(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, uint32_t dstWidth, uint32_t srcWidth);
+
+        // minimum amount of destination bytes per thread, smaller levels are done inline
+        constexpr uint64_t kMinBytesPerTask = 256 * 1024;
+
+#if MIP_SIMD_X64
+        bool HasAVX2()
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            static const bool supported = []()
+            {
+                int info[4];
+                __cpuidex(info, 0, 0);
+                if (info[0] < 7)
+                    return false;
+
+                __cpuidex(info, 1, 0);
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                const bool avx = (info[2] & (1 << 28)) != 0;
+                if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+                    return false;
+
+                __cpuidex(info, 7, 0);
+                return (info[1] & (1 << 5)) != 0;
+            }();
+            return supported;
+#else
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+#endif
+        }
+
+        bool HasF16C()
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            static const bool supported = []()
+            {
+                int info[4];
+                __cpuidex(info, 1, 0);
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                const bool avx = (info[2] & (1 << 28)) != 0;
+                const bool f16c = (info[2] & (1 << 29)) != 0;
+                return osxsave && avx && f16c && (_xgetbv(0) & 0x6) == 0x6;
+            }();
+            return supported;
+#else
+            static const bool supported = __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+            return supported;
+#endif
+        }
+#endif
+
+        // 8 bit unorm
+
+        template<uint32_t BPP>
+        void DownsampleRowU8Scalar(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, uint32_t dstBegin, uint32_t dstWidth, uint32_t srcWidth)
+        {
+            for (uint32_t x = dstBegin; x < dstWidth; ++x)
+            {
+                const uint32_t x0 = x * 2 * BPP;
+                const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1) * BPP;
+
+                for (uint32_t c = 0; c < BPP; ++c)
+                {
+                    const uint32_t sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                    dst[x * BPP + c] = static_cast<uint8_t>((sum + 2) >> 2);
+                }
+            }
+        }
+
+        template<uint32_t BPP>
+        void DownsampleRowU8(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, uint32_t dstWidth, uint32_t srcWidth)
+        {
+            uint32_t x = 0;
+
+            if (srcWidth >= 2)
+            {
+#if MIP_SIMD_X64
+                // 16 source bytes per row -> 8 destination bytes
+                constexpr uint32_t dstPixelsPerStep = 8 / BPP;
+
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i rounding = _mm_set1_epi16(2);
+
+                for (; x + dstPixelsPerStep <= dstWidth; x += dstPixelsPerStep)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 2 * BPP));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 2 * BPP));
+
+                    // vertical sum in 16 bit
+                    const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                    const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+                    // horizontal sum of neighbouring pixels
+                    __m128i sum;
+                    if constexpr (BPP == 4)
+                    {
+                        sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+                    }
+                    else if constexpr (BPP == 2)
+                    {
+                        const __m128i even = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+                        const __m128i odd = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(3, 1, 3, 1)));
+                        sum = _mm_add_epi16(even, odd);
+                    }
+                    else
+                    {
+                        const __m128i mask = _mm_set1_epi32(0xFFFF);
+                        const __m128i sumLo = _mm_add_epi32(_mm_and_si128(lo, mask), _mm_srli_epi32(lo, 16));
+                        const __m128i sumHi = _mm_add_epi32(_mm_and_si128(hi, mask), _mm_srli_epi32(hi, 16));
+                        sum = _mm_packs_epi32(sumLo, sumHi);
+                    }
+
+                    sum = _mm_srli_epi16(_mm_add_epi16(sum, rounding), 2);
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + x * BPP), _mm_packus_epi16(sum, sum));
+                }
+#elif MIP_SIMD_NEON
+                // 32 source bytes per row -> 16 destination bytes
+                constexpr uint32_t dstPixelsPerStep = 16 / BPP;
+
+                for (; x + dstPixelsPerStep <= dstWidth; x += dstPixelsPerStep)
+                {
+                    uint8x16_t a0, a1, b0, b1; // even and odd pixels of both rows
+                    if constexpr (BPP == 4)
+                    {
+                        const uint32x4x2_t a = vld2q_u32(reinterpret_cast<const uint32_t *>(row0 + x * 2 * BPP));
+                        const uint32x4x2_t b = vld2q_u32(reinterpret_cast<const uint32_t *>(row1 + x * 2 * BPP));
+                        a0 = vreinterpretq_u8_u32(a.val[0]); a1 = vreinterpretq_u8_u32(a.val[1]);
+                        b0 = vreinterpretq_u8_u32(b.val[0]); b1 = vreinterpretq_u8_u32(b.val[1]);
+                    }
+                    else if constexpr (BPP == 2)
+                    {
+                        const uint16x8x2_t a = vld2q_u16(reinterpret_cast<const uint16_t *>(row0 + x * 2 * BPP));
+                        const uint16x8x2_t b = vld2q_u16(reinterpret_cast<const uint16_t *>(row1 + x * 2 * BPP));
+                        a0 = vreinterpretq_u8_u16(a.val[0]); a1 = vreinterpretq_u8_u16(a.val[1]);
+                        b0 = vreinterpretq_u8_u16(b.val[0]); b1 = vreinterpretq_u8_u16(b.val[1]);
+                    }
+                    else
+                    {
+                        const uint8x16x2_t a = vld2q_u8(row0 + x * 2 * BPP);
+                        const uint8x16x2_t b = vld2q_u8(row1 + x * 2 * BPP);
+                        a0 = a.val[0]; a1 = a.val[1];
+                        b0 = b.val[0]; b1 = b.val[1];
+                    }
+
+                    const uint16x8_t sumLo = vaddq_u16(vaddl_u8(vget_low_u8(a0), vget_low_u8(a1)), vaddl_u8(vget_low_u8(b0), vget_low_u8(b1)));
+                    const uint16x8_t sumHi = vaddq_u16(vaddl_u8(vget_high_u8(a0), vget_high_u8(a1)), vaddl_u8(vget_high_u8(b0), vget_high_u8(b1)));
+
+                    // rounding shift: (sum + 2) >> 2
+                    vst1q_u8(dst + x * BPP, vcombine_u8(vrshrn_n_u16(sumLo, 2), vrshrn_n_u16(sumHi, 2)));
+                }
+#endif
+            }
+
+            DownsampleRowU8Scalar<BPP>(row0, row1, dst, x, dstWidth, srcWidth);
+        }
+
+#if MIP_SIMD_X64
+        MIP_TARGET_AVX2
+        void DownsampleRowRGBA8_AVX2(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, uint32_t dstWidth, uint32_t srcWidth)
+        {
+            uint32_t x = 0;
+
+            if (srcWidth >= 2)
+            {
+                const __m256i rounding = _mm256_set1_epi16(2);
+                const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+                // 32 source bytes per row -> 16 destination bytes
+                for (; x + 4 <= dstWidth; x += 4)
+                {
+                    const uint8_t *a = row0 + x * 8;
+                    const uint8_t *b = row1 + x * 8;
+
+                    // p0 p1 | p2 p3 and p4 p5 | p6 p7 in 16 bit
+                    const __m256i s0 = _mm256_add_epi16(
+                        _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a))),
+                        _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(b))));
+                    const __m256i s1 = _mm256_add_epi16(
+                        _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + 16))),
+                        _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(b + 16))));
+
+                    // d0 d2 | d1 d3
+                    __m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(s0, s1), _mm256_unpackhi_epi64(s0, s1));
+                    sum = _mm256_srli_epi16(_mm256_add_epi16(sum, rounding), 2);
+
+                    const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(sum, sum), order);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4), _mm256_castsi256_si128(packed));
+                }
+            }
+
+            DownsampleRowU8Scalar<4>(row0, row1, dst, x, dstWidth, srcWidth);
+        }
+#endif
+
+        // sRGB RGBA8, color is averaged in linear space, alpha is linear
+
+        struct SRGBTables
+        {
+            float toLinear[256];
+            uint8_t fromLinear[4096];
+
+            SRGBTables()
+            {
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    const float c = i / 255.0f;
+                    toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+
+                for (uint32_t i = 0; i < 4096; ++i)
+                {
+                    const float l = i / 4095.0f;
+                    const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                    fromLinear[i] = static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+                }
+            }
+        };
+
+        const SRGBTables &GetSRGBTables()
+        {
+            static const SRGBTables tables;
+            return tables;
+        }
+
+        void DownsampleRowSRGBA8(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, uint32_t dstWidth, uint32_t srcWidth)
+        {
+            const SRGBTables &tables = GetSRGBTables();
+
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                const uint32_t x0 = x * 8;
+                const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1) * 4;
+
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    const float sum = tables.toLinear[row0[x0 + c]] + tables.toLinear[row0[x1 + c]]
+                        + tables.toLinear[row1[x0 + c]] + tables.toLinear[row1[x1 + c]];
+                    dst[x * 4 + c] = tables.fromLinear[static_cast<uint32_t>(sum * 0.25f * 4095.0f + 0.5f)];
+                }
+
+                const uint32_t alpha = row0[x0 + 3] + row0[x1 + 3] + row1[x0 + 3] + row1[x1 + 3];
+                dst[x * 4 + 3] = static_cast<uint8_t>((alpha + 2) >> 2);
+            }
+        }
+
+        // float formats
+
+        void DownsampleRowRGBA32F(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, uint32_t dstWidth, uint32_t srcWidth)
+        {
+            const float *a = reinterpret_cast<const float *>(row0);
+            const float *b = reinterpret_cast<const float *>(row1);
+            float *out = reinterpret_cast<float *>(dst);
+
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                const uint32_t x0 = x * 8;
+                const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1) * 4;
+
+#if MIP_SIMD_X64
+                const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(a + x0), _mm_loadu_ps(a + x1)), _mm_add_ps(_mm_loadu_ps(b + x0), _mm_loadu_ps(b + x1)));
+                _mm_storeu_ps(out + x * 4, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#elif MIP_SIMD_NEON
+                const float32x4_t sum = vaddq_f32(vaddq_f32(vld1q_f32(a + x0), vld1q_f32(a + x1)), vaddq_f32(vld1q_f32(b + x0), vld1q_f32(b + x1)));
+                vst1q_f32(out + x * 4, vmulq_n_f32(sum, 0.25f));
+#else
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    out[x * 4 + c] = (a[x0 + c] + a[x1 + c] + b[x0 + c] + b[x1 + c]) * 0.25f;
+                }
+#endif
+            }
+        }
+
+        void DownsampleRowRGBA16F(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, uint32_t dstWidth, uint32_t srcWidth)
+        {
+            const uint16_t *a = reinterpret_cast<const uint16_t *>(row0);
+            const uint16_t *b = reinterpret_cast<const uint16_t *>(row1);
+            uint16_t *out = reinterpret_cast<uint16_t *>(dst);
+
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                const uint32_t x0 = x * 8;
+                const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1) * 4;
+
+#if MIP_SIMD_NEON
+                const float32x4_t sum = vaddq_f32(
+                    vaddq_f32(vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(a + x0))), vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(a + x1)))),
+                    vaddq_f32(vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(b + x0))), vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(b + x1)))));
+                vst1_u16(out + x * 4, vreinterpret_u16_f16(vcvt_f16_f32(vmulq_n_f32(sum, 0.25f))));
+#else
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    const float sum = CPUMipGenerator::half_to_float(a[x0 + c]) + CPUMipGenerator::half_to_float(a[x1 + c])
+                        + CPUMipGenerator::half_to_float(b[x0 + c]) + CPUMipGenerator::half_to_float(b[x1 + c]);
+                    out[x * 4 + c] = CPUMipGenerator::float_to_half(sum * 0.25f);
+                }
+#endif
+            }
+        }
+
+#if MIP_SIMD_X64
+        MIP_TARGET_F16C
+        void DownsampleRowRGBA16F_F16C(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, uint32_t dstWidth, uint32_t srcWidth)
+        {
+            const uint16_t *a = reinterpret_cast<const uint16_t *>(row0);
+            const uint16_t *b = reinterpret_cast<const uint16_t *>(row1);
+            uint16_t *out = reinterpret_cast<uint16_t *>(dst);
+
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                const uint32_t x0 = x * 8;
+                const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1) * 4;
+
+                const __m128 a0 = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(a + x0)));
+                const __m128 a1 = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(a + x1)));
+                const __m128 b0 = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(b + x0)));
+                const __m128 b1 = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(b + x1)));
+
+                const __m128 avg = _mm_mul_ps(_mm_add_ps(_mm_add_ps(a0, a1), _mm_add_ps(b0, b1)), _mm_set1_ps(0.25f));
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(out + x * 4), _mm_cvtps_ph(avg, _MM_FROUND_TO_NEAREST_INT));
+            }
+        }
+#endif
+
+        RowKernel SelectKernel(nvrhi::Format format)
+        {
+            switch (format)
+            {
+            case nvrhi::Format::SRGBA8_UNORM:
+            case nvrhi::Format::SBGRA8_UNORM:
+                return DownsampleRowSRGBA8;
+            case nvrhi::Format::RGBA8_UNORM:
+            case nvrhi::Format::BGRA8_UNORM:
+#if MIP_SIMD_X64
+                if (HasAVX2())
+                    return DownsampleRowRGBA8_AVX2;
+#endif
+                return DownsampleRowU8<4>;
+            case nvrhi::Format::RG8_UNORM:
+                return DownsampleRowU8<2>;
+            case nvrhi::Format::R8_UNORM:
+                return DownsampleRowU8<1>;
+            case nvrhi::Format::RGBA16_FLOAT:
+#if MIP_SIMD_X64
+                if (HasF16C())
+                    return DownsampleRowRGBA16F_F16C;
+#endif
+                return DownsampleRowRGBA16F;
+            case nvrhi::Format::RGBA32_FLOAT:
+                return DownsampleRowRGBA32F;
+            default:
+                return nullptr;
+            }
+        }
+    }
+
+    MipChain CPUMipGenerator::GenerateMipChain(const void *baseData, uint32_t baseWidth, uint32_t baseHeight, uint32_t baseRowPitch, nvrhi::Format format, uint32_t mipLevels)
+    {
+        MipChain chain;
+
+        const uint32_t maxMipLevels = GetMaxMipLevels(baseWidth, baseHeight);
+        if (mipLevels == 0 || mipLevels > maxMipLevels)
+            mipLevels = maxMipLevels;
+
+        if (!IsFormatSupported(format))
+        {
+            LOG_WARN("[Mip Generator] Unsupported format {}, only the base level is generated", static_cast<u32>(format));
+            mipLevels = 1;
+        }
+
+        const uint32_t bytesPerPixel = GetBytesPerPixel(format);
+
+        chain.levels.resize(mipLevels);
+        chain.levels[0] = { static_cast<const uint8_t *>(baseData), baseWidth, baseHeight, baseRowPitch, baseRowPitch * baseHeight };
+
+        // lay out every level in a single allocation
+        size_t arenaSize = 0;
+        uint32_t width = baseWidth;
+        uint32_t height = baseHeight;
+        for (uint32_t mip = 1; mip < mipLevels; ++mip)
+        {
+            width = std::max(1u, width / 2);
+            height = std::max(1u, height / 2);
+
+            MipLevelData &level = chain.levels[mip];
+            level.width = width;
+            level.height = height;
+            level.rowPitch = width * bytesPerPixel;
+            level.slicePitch = level.rowPitch * height;
+            level.data = reinterpret_cast<const uint8_t *>(arenaSize); // offset, patched below
+
+            arenaSize += level.slicePitch;
+        }
+
+        if (arenaSize == 0)
+            return chain;
+
+        chain.arena.reset(new uint8_t[arenaSize]);
+
+        for (uint32_t mip = 1; mip < mipLevels; ++mip)
+        {
+            MipLevelData &level = chain.levels[mip];
+            uint8_t *dst = chain.arena.get() + reinterpret_cast<size_t>(level.data);
+            level.data = dst;
+
+            Downsample(chain.levels[mip - 1], dst, level.rowPitch, format);
+        }
+
+        return chain;
+    }
+
+    void CPUMipGenerator::Downsample(const MipLevelData &src, uint8_t *dst, uint32_t dstRowPitch, nvrhi::Format format)
+    {
+        const RowKernel kernel = SelectKernel(format);
+        LOG_ASSERT(kernel, "[Mip Generator] Unsupported format");
+        if (!kernel)
+            return;
+
+        const uint32_t dstWidth = std::max(1u, src.width / 2);
+        const uint32_t dstHeight = std::max(1u, src.height / 2);
+
+        const uint32_t minRowsPerTask = static_cast<uint32_t>(std::max<uint64_t>(1, kMinBytesPerTask / std::max(1u, dstRowPitch)));
+        JobSystem::ParallelFor(dstHeight, minRowsPerTask, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t y = begin; y < end; ++y)
+            {
+                const uint8_t *row0 = src.data + static_cast<size_t>(y * 2) * src.rowPitch;
+                const uint8_t *row1 = src.data + static_cast<size_t>(std::min(y * 2 + 1, src.height - 1)) * src.rowPitch;
+                kernel(row0, row1, dst + static_cast<size_t>(y) * dstRowPitch, dstWidth, src.width);
+            }
+        });
+    }
+
+    uint32_t CPUMipGenerator::GetMaxMipLevels(uint32_t width, uint32_t height)
+    {
+        uint32_t levels = 1;
+        uint32_t size = std::max(width, height);
+        while (size > 1)
+        {
+            size /= 2;
+            ++levels;
+        }
+        return levels;
+    }
+
+    uint32_t CPUMipGenerator::GetBytesPerPixel(nvrhi::Format format)
+    {
+        switch (format)
+        {
+        case nvrhi::Format::RGBA8_UNORM:
+        case nvrhi::Format::SRGBA8_UNORM:
+        case nvrhi::Format::BGRA8_UNORM:
+        case nvrhi::Format::SBGRA8_UNORM:
+            return 4;
+        case nvrhi::Format::RG8_UNORM:
+            return 2;
+        case nvrhi::Format::R8_UNORM:
+            return 1;
+        case nvrhi::Format::RGBA16_FLOAT:
+            return 8;
+        case nvrhi::Format::RGBA32_FLOAT:
+            return 16;
+        default:
+            return nvrhi::getFormatInfo(format).bytesPerBlock;
+        }
+    }
+
+    bool CPUMipGenerator::IsFormatSupported(nvrhi::Format format)
+    {
+        return SelectKernel(format) != nullptr;
+    }
+
+    float CPUMipGenerator::half_to_float(uint16_t h)
+    {
+        uint32_t sign = (h & 0x8000) << 16;
+        uint32_t exponent = (h & 0x7C00) >> 10;
+        uint32_t mantissa = h & 0x03FF;
+
+        if (exponent == 0)
+        {
+            if (mantissa == 0)
+            {
+                float zero;
+                std::memcpy(&zero, &sign, sizeof(float));
+                return zero;
+            }
+
+            // Denormalized
+            exponent = 127 - 14;
+            while ((mantissa & 0x400) == 0)
+            {
+                mantissa <<= 1;
+                exponent--;
+            }
+            mantissa &= 0x3FF;
+        }
+        else if (exponent == 31)
+        {
+            exponent = 255; // Infinity or NaN
+        }
+        else
+        {
+            exponent += 127 - 15; // Bias adjustment
+        }
+
+        const uint32_t bits = sign | (exponent << 23) | (mantissa << 13);
+        float result;
+        std::memcpy(&result, &bits, sizeof(float));
+        return result;
+    }
+
+    uint16_t CPUMipGenerator::float_to_half(float f)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(float));
+
+        const uint32_t sign = (bits & 0x80000000) >> 16;
+        const int32_t exponent = static_cast<int32_t>((bits & 0x7F800000) >> 23);
+        const uint32_t mantissa = bits & 0x007FFFFF;
+
+        if (exponent == 0) return static_cast<uint16_t>(sign); // Zero
+        if (exponent == 255) return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0)); // Inf/NaN
+
+        const int32_t halfExponent = exponent - (127 - 15); // Bias adjustment
+        if (halfExponent <= 0) return static_cast<uint16_t>(sign); // Underflow to zero
+        if (halfExponent >= 31) return static_cast<uint16_t>(sign | 0x7C00); // Overflow to infinity
+
+        return static_cast<uint16_t>(sign | (halfExponent << 10) | (mantissa >> 13));
+    }
+}
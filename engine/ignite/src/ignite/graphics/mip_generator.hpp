@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+
+#include <nvrhi/nvrhi.h>
+#include <memory>
+#include <vector>
+
+namespace ignite
+{
+    struct MipLevelData
+    {
+        const uint8_t *data = nullptr;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t rowPitch = 0;
+        uint32_t slicePitch = 0;
+    };
+
+    // Level 0 points to the source pixels, every other level lives in one arena allocation
+    struct MipChain
+    {
+        std::vector<MipLevelData> levels;
+        std::unique_ptr<uint8_t[]> arena;
+
+        size_t size() const { return levels.size(); }
+        const MipLevelData &operator[](size_t mip) const { return levels[mip]; }
+    };
+
+    // 2x2 box filter downsampler.
+    // Supported formats: RGBA8/BGRA8 (sRGB aware), RG8, R8, RGBA16F, RGBA32F.
+    // Uses SSE2/AVX2 on x64 and NEON on arm64, large levels are split by rows across threads.
+    class CPUMipGenerator
+    {
+    public:
+        // mipLevels == 0 generates the full chain down to 1x1
+        static MipChain GenerateMipChain(const void *baseData, uint32_t baseWidth, uint32_t baseHeight, uint32_t baseRowPitch, nvrhi::Format format, uint32_t mipLevels);
+
+        static void Downsample(const MipLevelData &src, uint8_t *dst, uint32_t dstRowPitch, nvrhi::Format format);
+
+        static uint32_t GetMaxMipLevels(uint32_t width, uint32_t height);
+        static uint32_t GetBytesPerPixel(nvrhi::Format format);
+        static bool IsFormatSupported(nvrhi::Format format);
+
+        static float half_to_float(uint16_t h);
+        static uint16_t float_to_half(float f);
+    };
+}
@@ -1,12 +1,15 @@
 #include "renderer.hpp"
 #include "renderer_2d.hpp"
 #include "texture.hpp"
+#include "texture_cache.hpp"
+#include "texture_streamer.hpp"
 #include "shader.hpp"
 
 #include "environment.hpp"
 
 #include "ignite/core/device/device_manager.hpp"
 #include "ignite/core/application.hpp"
+#include "ignite/core/vfs/async_reader.hpp"
 #include <ranges>
 
 namespace ignite
@@ -64,6 +67,10 @@ namespace ignite
             shader[nvrhi::ShaderType::Vertex] = { CreateRef<ShaderMake::ShaderContext>(filepath + ".vertex.hlsl", ShaderMake::ShaderType::Vertex), nullptr };
             shader[nvrhi::ShaderType::Pixel] = { CreateRef<ShaderMake::ShaderContext>(filepath + ".pixel.hlsl", ShaderMake::ShaderType::Pixel), nullptr };
             m_Shaders[name] = shader;
+
+            // compiled together in Compile, the sources are read in the meantime
+            const std::filesystem::path basePath(m_ShaderMakeOptions.baseDirectory);
+            vfs::AsyncReader::Prefetch({ basePath / (filepath + ".vertex.hlsl"), basePath / (filepath + ".pixel.hlsl") });
         }
     }
 
@@ -146,6 +153,8 @@ namespace ignite
     Renderer::~Renderer()
     {
         m_WhiteTexture.reset();
+        TextureStreamer::Shutdown();
+        TextureCache::Clear();
         Renderer2D::Shutdown();
     }
 
@@ -34,7 +34,7 @@ namespace ignite
         nvrhi::IDevice* device = Application::GetRenderDevice();
 
         size_t vertAllocSize = s_Data->quadBatch.maxVertices * sizeof(Vertex2DQuad);
-        s_Data->quadBatch.vertexBufferBase = new Vertex2DQuad[vertAllocSize];
+        s_Data->quadBatch.vertexBufferBase = static_cast<Vertex2DQuad *>(MemoryTracker::Allocate(MemoryTag::Renderer, vertAllocSize, alignof(Vertex2DQuad)));
 
         // create buffers
         const auto desc = nvrhi::BufferDesc()
@@ -113,7 +113,7 @@ namespace ignite
         nvrhi::IDevice* device = Application::GetRenderDevice();
 
         size_t vertAllocSize = s_Data->lineBatch.maxVertices * sizeof(Vertex2DLine);
-        s_Data->lineBatch.vertexBufferBase = new Vertex2DLine[vertAllocSize];
+        s_Data->lineBatch.vertexBufferBase = static_cast<Vertex2DLine *>(MemoryTracker::Allocate(MemoryTag::Renderer, vertAllocSize, alignof(Vertex2DLine)));
 
         // create buffers
         const auto vbDesc = nvrhi::BufferDesc()
@@ -272,7 +272,7 @@ namespace ignite
         s_Data->lineBatch.count++;
     }
 
-    void Renderer2D::DrawLine(const std::vector<glm::vec3>& positions, const glm::vec4& color, uint32_t entityID)
+    void Renderer2D::DrawLine(std::span<const glm::vec3> positions, const glm::vec4& color, uint32_t entityID)
     {
         if (s_Data->lineBatch.count >= s_Data->lineBatch.maxCount)
             Renderer2D::End();
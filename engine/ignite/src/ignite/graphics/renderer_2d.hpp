@@ -1,11 +1,13 @@
 #pragma once
 
 #include "ignite/core/types.hpp"
+#include "ignite/core/memory.hpp"
 #include "vertex_data.hpp"
 #include "graphics_pipeline.hpp"
 #include "renderer.hpp"
 #include "shader.hpp"
 
+#include <span>
 #include <unordered_map>
 
 namespace ignite
@@ -35,8 +37,7 @@ namespace ignite
         ~BatchRender()
         {
             vertexBufferPtr = nullptr;
-            if (vertexBufferBase)
-                delete[] vertexBufferBase;
+            MemoryTracker::Free(vertexBufferBase);
 
             indexCount = 0;
             count = 0;
@@ -66,7 +67,7 @@ namespace ignite
 
         static void DrawBox(const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f), uint32_t entityID = 0);
         static void DrawRect(const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f), uint32_t entityID = 0);
-        static void DrawLine(const std::vector<glm::vec3>& positions, const glm::vec4& color = glm::vec4(1.0f), uint32_t entityID = 0);
+        static void DrawLine(std::span<const glm::vec3> positions, const glm::vec4& color = glm::vec4(1.0f), uint32_t entityID = 0);
         static void DrawLine(const glm::vec3 &pos0, const glm::vec3 &pos1, const glm::vec4& color = glm::vec4(1.0f), uint32_t entityID = 0);
 
         static void DrawQuad(const glm::vec3 &position, const glm::vec2 &size, f32 rotation, const glm::vec4 &color, Ref<Texture> texture = nullptr, const glm::vec2 &tilingFactor = glm::vec2(1.0f), uint32_t entityID = 0);
@@ -4,6 +4,9 @@
 #include "renderer.hpp"
 #include "renderer_2d.hpp"
 #include "environment.hpp"
+#include "texture_streamer.hpp"
+#include "texture_cache.hpp"
+#include "gpu_profiler.hpp"
 
 #include "ignite/scene/scene.hpp"
 #include "ignite/scene/icamera.hpp"
@@ -11,11 +14,50 @@
 #include "ignite/scene/component.hpp"
 
 #include "ignite/core/application.hpp"
+#include "ignite/core/profiler.hpp"
 
 #include <ranges>
 
 namespace ignite
 {
+    namespace
+    {
+        // screen height in pixels covered by the mesh bounds, material UVs are assumed to span the mesh
+        f32 ComputeScreenPixels(const AABB &aabb, const glm::mat4 &transform, ICamera *camera, f32 viewportHeight)
+        {
+            const glm::vec3 scale(glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2])));
+            const f32 radius = glm::length(aabb.GetSize() * scale) * 0.5f;
+            const f32 projectionScale = camera->projectionMatrix[1][1] * viewportHeight;
+
+            if (camera->projectionType != ICamera::Type::Perspective)
+                return radius * projectionScale;
+
+            const glm::vec3 center = glm::vec3(transform * glm::vec4(aabb.GetCenter(), 1.0f));
+            const f32 distance = glm::max(glm::length(center - camera->position), radius);
+            return radius * projectionScale / glm::max(distance, 1e-4f);
+        }
+
+        // the side the cluster cone test drops has to match the one the pipeline drops.
+        // imported meshes are counter-clockwise seen from the side their normals point to
+        ClusterFaceCull GetClusterFaceCull(const GraphicsPipelineParams &params)
+        {
+            if (params.cullMode == nvrhi::RasterCullMode::None)
+                return ClusterFaceCull::None;
+
+            const bool culledCounterClockwise = (params.cullMode == nvrhi::RasterCullMode::Front) == params.frontCounterClockwise;
+            return culledCounterClockwise ? ClusterFaceCull::Toward : ClusterFaceCull::Away;
+        }
+
+        void RequestTextureMips(Material &material, f32 screenPixels)
+        {
+            for (const Material::TextureData &textureData : material.textures | std::views::values)
+            {
+                if (textureData.texture && textureData.texture->IsStreamed())
+                    TextureStreamer::RequestMip(textureData.texture, TextureStreamer::ComputeRequestedMip(textureData.texture, screenPixels));
+            }
+        }
+    }
+
     void SceneRenderer::Init()
     {
         GraphicsPipelineParams params;
@@ -117,13 +159,17 @@ namespace ignite
 
     }
 
-    void SceneRenderer::Render(Scene *scene, nvrhi::ICommandList *commandList, nvrhi::IFramebuffer *framebuffer, bool renderEnvironment)
+    void SceneRenderer::Render(Scene *scene, ICamera *camera, nvrhi::ICommandList *commandList, nvrhi::IFramebuffer *framebuffer, bool renderEnvironment)
     {
+        IGN_PROFILE_FUNCTION();
+
         if (scene->sceneRenderer == nullptr)
             scene->sceneRenderer = this;
 
         if (renderEnvironment)
         {
+            IGN_PROFILE_SCOPE("Environment");
+
             if (m_Environment->isUpdatingTexture)
             {
                 auto meshRendererView = scene->registry->view<MeshRenderer>();
@@ -136,58 +182,119 @@ namespace ignite
                 m_Environment->isUpdatingTexture = false;
             }
 
+            IGN_GPU_PROFILE_SCOPE(commandList, "Environment");
             m_Environment->Render(commandList, framebuffer, m_EnvironmentPipeline);
         }
-        
+
+        // streamed textures changed their resident mips or a texture was hot-reloaded, rebuild the bindings that reference them
+        const u64 residencyVersion = TextureStreamer::GetResidencyVersion() + TextureCache::GetReloadVersion();
+        if (m_TextureResidencyVersion != residencyVersion)
+        {
+            auto meshRendererView = scene->registry->view<MeshRenderer>();
+            for (entt::entity e : meshRendererView)
+            {
+                MeshRenderer &mr = meshRendererView.get<MeshRenderer>(e);
+                if (mr.mesh && mr.mesh->material.RefreshTextureHandles())
+                    mr.mesh->CreateBindingSet();
+            }
+
+            Renderer2D::UpdateTextureBindings();
+            m_TextureResidencyVersion = residencyVersion;
+        }
 
         Renderer2D::Begin(commandList, framebuffer);
 
-        for (entt::entity e : scene->entities | std::views::values)
         {
-            Entity entity = { e, scene };
-            auto &tr = entity.GetTransform();
+            IGN_PROFILE_SCOPE("Geometry");
+            IGN_GPU_PROFILE_SCOPE(commandList, "Geometry");
 
-            if (!tr.visible)
-                continue;
+            const Frustum frustum(camera->GetViewProjectionMatrix());
+            const bool perspective = camera->projectionType == ICamera::Type::Perspective;
+            const f32 viewportHeight = static_cast<f32>(framebuffer->getFramebufferInfo().height);
 
-            if (entity.HasComponent<MeshRenderer>())
-            {
-                MeshRenderer &meshRenderer = entity.GetComponent<MeshRenderer>();
-                
-                // not loaded mesh
-                if (meshRenderer.meshIndex == -1)
-                    continue;
+            // the cone test needs a camera position, orthographic views cull by frustum only
+            const ClusterFaceCull faceCull = perspective ? GetClusterFaceCull(m_GeometryPipeline->GetParams()) : ClusterFaceCull::None;
 
-                // write material constant buffer
-                commandList->writeBuffer(meshRenderer.mesh->materialBufferHandle, &meshRenderer.mesh->material.data, sizeof(meshRenderer.mesh->material.data));
-                commandList->writeBuffer(meshRenderer.mesh->objectBufferHandle, &meshRenderer.meshBuffer, sizeof(meshRenderer.meshBuffer));
-
-                // render
-                auto state = nvrhi::GraphicsState();
-                state.pipeline = m_GeometryPipeline->GetHandle();
-                state.framebuffer = framebuffer;
-                state.viewport = nvrhi::ViewportState().addViewportAndScissorRect(framebuffer->getFramebufferInfo().getViewport());
-                state.addBindingSet(meshRenderer.mesh->bindingSets[GPipeline::MESH]);
-                state.setIndexBuffer({ meshRenderer.mesh->indexBuffer, nvrhi::Format::R32_UINT });
-                state.addVertexBuffer({ meshRenderer.mesh->vertexBuffer, 0, 0 });
+            for (entt::entity e : scene->entities | std::views::values)
+            {
+                Entity entity = { e, scene };
+                auto &tr = entity.GetTransform();
 
-                commandList->setGraphicsState(state);
+                if (!tr.visible)
+                    continue;
 
-                nvrhi::DrawArguments args;
-                args.setVertexCount(static_cast<uint32_t>(meshRenderer.mesh->data.indices.size()));
-                args.instanceCount = 1;
+                if (entity.HasComponent<MeshRenderer>())
+                {
+                    MeshRenderer &meshRenderer = entity.GetComponent<MeshRenderer>();
+                    
+                    // not loaded mesh
+                    if (meshRenderer.meshIndex == -1)
+                        continue;
+
+                    const Ref<Mesh> &mesh = meshRenderer.mesh;
+
+                    // cluster culling, skinned meshes are deformed on the GPU so their bounds are not valid
+                    const bool clusterCulling = !mesh->geometry->data.clusters.empty() && mesh->boneInfo.empty();
+                    if (clusterCulling)
+                    {
+                        if (MeshClusterCuller::Cull(mesh->geometry->data.clusters, meshRenderer.meshBuffer.transformation, frustum, camera->position, faceCull, m_ClusterDrawRanges) == 0)
+                            continue;
+                    }
+
+                    // texel density feedback for mip streaming
+                    RequestTextureMips(mesh->material, ComputeScreenPixels(mesh->geometry->aabb, meshRenderer.meshBuffer.transformation, camera, viewportHeight));
+
+                    // entity id is per draw, the geometry is shared between entities
+                    meshRenderer.meshBuffer.entityID = static_cast<u32>(e);
+
+                    // write material constant buffer
+                    commandList->writeBuffer(meshRenderer.mesh->materialBufferHandle, &meshRenderer.mesh->material.data, sizeof(meshRenderer.mesh->material.data));
+                    commandList->writeBuffer(meshRenderer.mesh->objectBufferHandle, &meshRenderer.meshBuffer, sizeof(meshRenderer.meshBuffer));
+
+                    // render
+                    auto state = nvrhi::GraphicsState();
+                    state.pipeline = m_GeometryPipeline->GetHandle();
+                    state.framebuffer = framebuffer;
+                    state.viewport = nvrhi::ViewportState().addViewportAndScissorRect(framebuffer->getFramebufferInfo().getViewport());
+                    state.addBindingSet(meshRenderer.mesh->bindingSets[GPipeline::MESH]);
+                    state.setIndexBuffer({ mesh->geometry->indexBuffer, nvrhi::Format::R32_UINT });
+                    state.addVertexBuffer({ mesh->geometry->vertexBuffer, 0, 0 });
+
+                    commandList->setGraphicsState(state);
+
+                    nvrhi::DrawArguments args;
+                    args.instanceCount = 1;
+
+                    if (clusterCulling)
+                    {
+                        for (const MeshClusterDrawRange &range : m_ClusterDrawRanges)
+                        {
+                            args.setVertexCount(range.indexCount);
+                            args.startIndexLocation = range.indexOffset;
+                            commandList->drawIndexed(args);
+                        }
+                    }
+                    else
+                    {
+                        args.setVertexCount(mesh->geometry->GetIndexCount());
+                        commandList->drawIndexed(args);
+                    }
+                }
 
-                commandList->drawIndexed(args);
+                if (entity.HasComponent<Sprite2D>())
+                {
+                    auto &sprite = entity.GetComponent<Sprite2D>();
+                    Renderer2D::DrawQuad(tr.GetWorldMatrix(), sprite.color, sprite.texture, sprite.tilingFactor, static_cast<u32>(e));
+                }
             }
+        }
 
-            if (entity.HasComponent<Sprite2D>())
-            {
-                auto &sprite = entity.GetComponent<Sprite2D>();
-                Renderer2D::DrawQuad(tr.GetWorldMatrix(), sprite.color, sprite.texture, sprite.tilingFactor, static_cast<u32>(e));
-            }
+        {
+            IGN_PROFILE_SCOPE("Renderer2D Flush");
+            IGN_GPU_PROFILE_SCOPE(commandList, "Renderer2D Flush");
+            Renderer2D::Flush(m_BatchQuadPipeline, m_BatchLinePipeline);
         }
 
-        Renderer2D::Flush(m_BatchQuadPipeline, m_BatchLinePipeline);
         Renderer2D::End();
     }
 
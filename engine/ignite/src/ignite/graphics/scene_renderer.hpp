@@ -2,6 +2,7 @@
 
 #include "environment.hpp"
 #include "graphics_pipeline.hpp"
+#include "mesh_cluster.hpp"
 
 #include "ignite/scene/entity.hpp"
 
@@ -22,7 +23,7 @@ namespace ignite
         void ResizeRenderTarget(uint32_t width, uint32_t height);
 
         void CreatePipelines(nvrhi::IFramebuffer *framebuffer) const;
-        void Render(Scene *scene, nvrhi::ICommandList *commandList, nvrhi::IFramebuffer *framebuffer, bool renderEnvironment = true);
+        void Render(Scene *scene, ICamera *camera, nvrhi::ICommandList *commandList, nvrhi::IFramebuffer *framebuffer, bool renderEnvironment = true);
 
         void SetFillMode(nvrhi::RasterFillMode mode) const;
 
@@ -43,5 +44,8 @@ namespace ignite
         Ref<GraphicsPipeline> m_EnvironmentPipeline;
 
         Ref<GraphicsPipeline> m_GeometryPipeline;
+
+        std::vector<MeshClusterDrawRange> m_ClusterDrawRanges;
+        u64 m_TextureResidencyVersion = 0;
     };
 }
@@ -19,14 +19,16 @@ namespace ignite
 
     void ShaderFactory::ClearCache()
     {
+        // pending reads still use m_FS
+        for (auto &[path, future] : m_PendingByteCode)
+            future.wait();
+
+        m_PendingByteCode.clear();
         m_ByteCodeCache.clear();
     }
 
-    Ref<vfs::IBlob> ShaderFactory::GetByteCode(const char *filename, const char *entryName)
+    std::filesystem::path ShaderFactory::GetByteCodePath(const char *filename, const char *entryName) const
     {
-        if (!m_FS)
-            return nullptr;
-
         if (entryName == nullptr)
             entryName = "main";
 
@@ -56,7 +58,15 @@ namespace ignite
             }
         }
 
-        std::filesystem::path shaderFilePath = m_BasePath / (adjustedName + GetShaderExtension(Renderer::GetGraphicsAPI()));
+        return m_BasePath / (adjustedName + GetShaderExtension(Renderer::GetGraphicsAPI()));
+    }
+
+    Ref<vfs::IBlob> ShaderFactory::GetByteCode(const char *filename, const char *entryName)
+    {
+        if (!m_FS)
+            return nullptr;
+
+        std::filesystem::path shaderFilePath = GetByteCodePath(filename, entryName);
         std::shared_ptr<vfs::IBlob> &data = m_ByteCodeCache[shaderFilePath.generic_string()];
 
         if (data)
@@ -64,7 +74,15 @@ namespace ignite
             return data;
         }
 
-        data = m_FS->ReadFile(shaderFilePath);
+        if (auto it = m_PendingByteCode.find(shaderFilePath.generic_string()); it != m_PendingByteCode.end())
+        {
+            data = it->second.get();
+            m_PendingByteCode.erase(it);
+        }
+
+        // the bytecode cache keeps the mapping alive, shaders are created straight from the mapped pages
+        if (!data)
+            data = m_FS->MapFile(shaderFilePath);
 
         if (!data)
         {
@@ -75,6 +93,34 @@ namespace ignite
         return data;
     }
 
+    void ShaderFactory::PrefetchByteCode(const std::vector<std::pair<const char *, const char *>> &shaders)
+    {
+        if (!m_FS)
+            return;
+
+        std::vector<vfs::AsyncRead> reads;
+        std::vector<std::string> keys;
+
+        for (const auto &[filename, entryName] : shaders)
+        {
+            std::filesystem::path shaderFilePath = GetByteCodePath(filename, entryName);
+            std::string key = shaderFilePath.generic_string();
+
+            if (m_ByteCodeCache.contains(key) || m_PendingByteCode.contains(key))
+                continue;
+
+            reads.push_back({ std::move(shaderFilePath), nullptr });
+            keys.push_back(std::move(key));
+        }
+
+        if (reads.empty())
+            return;
+
+        std::vector<vfs::ReadFuture> futures = m_FS->ReadFilesAsync(std::move(reads));
+        for (size_t i = 0; i < keys.size(); ++i)
+            m_PendingByteCode.emplace(std::move(keys[i]), std::move(futures[i]));
+    }
+
     nvrhi::ShaderHandle ShaderFactory::CreateShader(const char *filename, const char *entryName, const std::vector<ShaderMacro> *pDefines, const nvrhi::ShaderDesc &desc)
     {
         Ref<vfs::IBlob> byteCode = GetByteCode(filename, entryName);
@@ -85,6 +85,9 @@ namespace ignite
         void ClearCache();
 
         Ref<vfs::IBlob> GetByteCode(const char *filename, const char *entryName);
+
+        // reads the bytecode of { filename, entryName } pairs in one batch, GetByteCode picks it up
+        void PrefetchByteCode(const std::vector<std::pair<const char *, const char *>> &shaders);
         nvrhi::ShaderHandle CreateShader(const char *filename, const char *entryName, const std::vector<ShaderMacro> *pDefines, const nvrhi::ShaderDesc &desc);
         nvrhi::ShaderLibraryHandle CreateShaderLibrary(const char *filename, const std::vector<ShaderMacro> *pDefines);
         nvrhi::ShaderHandle CreateStaticShader(StaticShader shader, const std::vector<ShaderMacro> *pDefines, const nvrhi::ShaderDesc &desc);
@@ -95,8 +98,11 @@ namespace ignite
         nvrhi::ShaderLibraryHandle CreateAutoShaderLibrary(const char *filename, StaticShader dxil, StaticShader spirv, const std::vector<ShaderMacro> *pDefines);
         std::pair<const void *, size_t> FindShaderFromHash(u64 hash, std::function<u64(std::pair<const void *, size_t>, nvrhi::GraphicsAPI)> hashGenerator);
     private:
+        std::filesystem::path GetByteCodePath(const char *filename, const char *entryName) const;
+
         nvrhi::DeviceHandle m_Device;
         std::unordered_map<std::string, Ref<vfs::IBlob>> m_ByteCodeCache;
+        std::unordered_map<std::string, vfs::ReadFuture> m_PendingByteCode;
         Ref<vfs::IFileSystem> m_FS;
         std::filesystem::path m_BasePath;
     };
@@ -7,13 +7,16 @@
 
 namespace ignite
 {
-    Texture::Texture(Buffer buffer, const TextureCreateInfo &createInfo)
+    Texture::Texture(Buffer buffer, const TextureCreateInfo &createInfo, nvrhi::ICommandList *commandList)
         : m_CreateInfo(createInfo), m_Data(buffer.Data)
     {
         nvrhi::IDevice *device = Application::GetRenderDevice();
         
         LOG_ASSERT(m_Data && buffer.Data, "[Texture] Pixel data is null");
 
+        if (m_CreateInfo.mipLevels == 0)
+            m_CreateInfo.mipLevels = CPUMipGenerator::GetMaxMipLevels(m_CreateInfo.width, m_CreateInfo.height);
+
         const auto &textureDesc = nvrhi::TextureDesc()
             .setDimension(m_CreateInfo.dimension)
             .setWidth(m_CreateInfo.width)
@@ -34,11 +37,17 @@ namespace ignite
         m_Sampler = device->createSampler(samplerDesc);
         LOG_ASSERT(m_Sampler, "Failed to create texture sampler");
 
-        nvrhi::CommandListHandle commandList = device->createCommandList();
-        commandList->open();
-        Write(commandList);
-        commandList->close();
-        device->executeCommandList(commandList);
+        if (commandList)
+        {
+            Write(commandList);
+            return;
+        }
+
+        nvrhi::CommandListHandle uploadCommandList = device->createCommandList();
+        uploadCommandList->open();
+        Write(uploadCommandList);
+        uploadCommandList->close();
+        device->executeCommandList(uploadCommandList);
     }
 
     Texture::Texture(const std::filesystem::path &filepath, const TextureCreateInfo &createInfo)
@@ -76,6 +85,9 @@ namespace ignite
 
         nvrhi::IDevice *device = Application::GetRenderDevice();
 
+        if (m_CreateInfo.mipLevels == 0)
+            m_CreateInfo.mipLevels = CPUMipGenerator::GetMaxMipLevels(m_CreateInfo.width, m_CreateInfo.height);
+
         const auto &textureDesc = nvrhi::TextureDesc()
             .setDimension(m_CreateInfo.dimension)
             .setWidth(m_CreateInfo.width)
@@ -103,6 +115,60 @@ namespace ignite
         device->executeCommandList(commandList);
     }
 
+    Texture::Texture(const CompressedTexture &compressed, const TextureCreateInfo &createInfo, nvrhi::ICommandList *commandList)
+        : m_CreateInfo(createInfo)
+    {
+        nvrhi::IDevice *device = Application::GetRenderDevice();
+
+        LOG_ASSERT(compressed.IsValid(), "[Texture] Compressed texture is empty");
+
+        m_CreateInfo.format = compressed.format;
+        m_CreateInfo.width = static_cast<i32>(compressed.width);
+        m_CreateInfo.height = static_cast<i32>(compressed.height);
+        m_CreateInfo.mipLevels = static_cast<uint32_t>(compressed.mips.size());
+
+        const auto &textureDesc = nvrhi::TextureDesc()
+            .setDimension(m_CreateInfo.dimension)
+            .setWidth(m_CreateInfo.width)
+            .setHeight(m_CreateInfo.height)
+            .setFormat(m_CreateInfo.format)
+            .setInitialState(nvrhi::ResourceStates::ShaderResource)
+            .setKeepInitialState(true)
+            .setMipLevels(m_CreateInfo.mipLevels)
+            .setDebugName("Compressed Texture");
+
+        m_Handle = device->createTexture(textureDesc);
+        LOG_ASSERT(m_Handle, "Failed to create texture");
+
+        const auto samplerDesc = nvrhi::SamplerDesc()
+            .setAllAddressModes(nvrhi::SamplerAddressMode::Repeat)
+            .setAllFilters(true);
+
+        m_Sampler = device->createSampler(samplerDesc);
+        LOG_ASSERT(m_Sampler, "Failed to create texture sampler");
+
+        // mips are already encoded, upload the blocks as they are
+        nvrhi::CommandListHandle uploadCommandList;
+        if (!commandList)
+        {
+            uploadCommandList = device->createCommandList();
+            uploadCommandList->open();
+            commandList = uploadCommandList;
+        }
+
+        for (uint32_t mip = 0; mip < compressed.mips.size(); ++mip)
+        {
+            const CompressedMip &mipData = compressed.mips[mip];
+            commandList->writeTexture(m_Handle, 0, mip, compressed.GetMipData(mip), mipData.rowPitch, mipData.size);
+        }
+
+        if (uploadCommandList)
+        {
+            uploadCommandList->close();
+            device->executeCommandList(uploadCommandList);
+        }
+    }
+
     Texture::~Texture()
     {
     }
@@ -111,31 +177,13 @@ namespace ignite
     {
         LOG_ASSERT(m_Data, "[Texture] Pixel data is null");
 
-        // Row Pitch   = width * channels
-        // Depth pitch = Row Pitch * height (for 3D TEXTURE)
+        // Row Pitch = width * bytes per pixel (always RGBA)
+        const uint32_t rowPitch = m_CreateInfo.width * CPUMipGenerator::GetBytesPerPixel(m_CreateInfo.format);
 
-        const int channels = 4; // always use RGBA
-        int rowPitch = m_CreateInfo.width * channels;
-        int depthPitch = rowPitch * m_CreateInfo.height;
-
-        if (m_CreateInfo.format == nvrhi::Format::RGBA8_UNORM)
+        const MipChain mipChain = CPUMipGenerator::GenerateMipChain(m_Data, m_CreateInfo.width, m_CreateInfo.height, rowPitch, m_CreateInfo.format, m_CreateInfo.mipLevels);
+        for (uint32_t mip = 0; mip < mipChain.size(); ++mip)
         {
-            // char = 1 byte, 8 bit
-            uint8_t *byteData = static_cast<uint8_t *>(m_Data);
-
-            for (uint32_t mip = 0; mip < m_CreateInfo.mipLevels; ++mip)
-            {
-                commandList->writeTexture(m_Handle, 0, mip, byteData, rowPitch);
-            }
-        }
-        else if (m_CreateInfo.format == nvrhi::Format::RGBA32_FLOAT)
-        {
-            // float = 4 bytes, 32 bit, we need to multiply sizeof(float)
-            float *floatData = static_cast<float *>(m_Data);
-            for (uint32_t mip = 0; mip < m_CreateInfo.mipLevels; ++mip)
-            {
-                commandList->writeTexture(m_Handle, 0, mip, floatData, rowPitch * sizeof(float), depthPitch * sizeof(float));
-            }
+            commandList->writeTexture(m_Handle, 0, mip, mipChain[mip].data, mipChain[mip].rowPitch, mipChain[mip].slicePitch);
         }
 
         if (m_Data && m_WithSTBI)
@@ -146,13 +194,18 @@ namespace ignite
         }
     }
 
-    Ref<Texture> Texture::Create(Buffer buffer, const TextureCreateInfo &createInfo)
+    Ref<Texture> Texture::Create(Buffer buffer, const TextureCreateInfo &createInfo, nvrhi::ICommandList *commandList)
     {
-        return CreateRef<Texture>(buffer, createInfo);
+        return CreateRef<Texture>(buffer, createInfo, commandList);
     }
 
     Ref<Texture> Texture::Create(const std::filesystem::path &filepath, const TextureCreateInfo &createInfo)
     {
         return CreateRef<Texture>(filepath, createInfo);
     }
+
+    Ref<Texture> Texture::Create(const CompressedTexture &compressed, const TextureCreateInfo &createInfo, nvrhi::ICommandList *commandList)
+    {
+        return CreateRef<Texture>(compressed, createInfo, commandList);
+    }
 }
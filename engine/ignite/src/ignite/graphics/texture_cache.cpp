@@ -0,0 +1,612 @@
+#include "texture_cache.hpp"
+#include "texture_streamer.hpp"
+
+#include "ignite/core/application.hpp"
+#include "ignite/core/hash.hpp"
+#include "ignite/core/logger.hpp"
+#include "ignite/core/vfs/mapped_file.hpp"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ignite
+{
+    namespace
+    {
+        struct CacheEntry
+        {
+            Ref<Texture> texture;
+            u64 byteSize = 0;
+            std::list<u64>::iterator lruIt;
+
+            // source file and requested parameters, kept for Reload
+            std::string pathKey;
+            TextureCreateInfo createInfo;
+        };
+
+        struct PathEntry
+        {
+            u64 contentHash = 0;
+            u64 fileSize = 0;
+            std::filesystem::file_time_type writeTime;
+        };
+
+        struct TextureCacheData
+        {
+            std::mutex mutex; // only held for lookups and inserts, textures are created outside of it
+
+            std::unordered_map<u64, CacheEntry> entries;
+            std::unordered_set<u64> pending; // keys being created, later loads of the same key wait for them
+            std::condition_variable pendingCondition;
+
+            std::unordered_map<std::string, PathEntry> paths; // resolved path -> content hash
+
+            std::list<u64> lru; // front = most recently used
+            u64 memoryUsage = 0;
+            u64 budget = TEXTURE_CACHE_DEFAULT_BUDGET;
+            std::atomic<u64> reloadVersion = 0;
+        };
+
+        TextureCacheData &GetData()
+        {
+            static TextureCacheData data;
+            return data;
+        }
+
+        u64 MakeKey(u64 contentHash, const TextureCreateInfo &createInfo)
+        {
+            u64 key = HashCombine(contentHash, static_cast<u64>(createInfo.format));
+            key = HashCombine(key, createInfo.mipLevels);
+            key = HashCombine(key, createInfo.flip ? 1 : 0);
+            key = HashCombine(key, static_cast<u64>(createInfo.usage));
+            return HashCombine(key, static_cast<u64>(createInfo.samplerMode));
+        }
+
+        // on-disk key of the compressed mip chain, independent of sampler state
+        u64 MakeCompressedKey(u64 contentHash, const TextureCreateInfo &createInfo, const TextureCompressionSettings &settings)
+        {
+            u64 key = HashCombine(contentHash, static_cast<u64>(createInfo.format));
+            key = HashCombine(key, createInfo.mipLevels);
+            key = HashCombine(key, createInfo.flip ? 1 : 0);
+            key = HashCombine(key, static_cast<u64>(settings.compression));
+            key = HashCombine(key, static_cast<u64>(settings.quality));
+            return HashCombine(key, TEXTURE_COMPRESSOR_VERSION);
+        }
+
+        // compression is disabled when the device can not sample the block format
+        TextureCompressionSettings GetCompressionSettings(const TextureCreateInfo &createInfo)
+        {
+            TextureCompressionSettings settings = TextureCompressor::GetSettings(createInfo.usage);
+            if (settings.compression == TextureCompression::None)
+                return settings;
+
+            nvrhi::IDevice *device = Application::GetRenderDevice();
+            const nvrhi::Format format = TextureCompressor::GetFormat(settings.compression);
+            if (!device || (device->queryFormatSupport(format) & nvrhi::FormatSupport::Texture) == nvrhi::FormatSupport::None)
+                settings.compression = TextureCompression::None;
+
+            return settings;
+        }
+
+        u64 CalculateByteSize(const TextureCreateInfo &createInfo)
+        {
+            const nvrhi::FormatInfo &formatInfo = nvrhi::getFormatInfo(createInfo.format);
+            const u64 blockSize = std::max<u64>(1, formatInfo.blockSize);
+
+            u64 size = 0;
+            u64 width = createInfo.width;
+            u64 height = createInfo.height;
+            for (u32 mip = 0; mip < createInfo.mipLevels; ++mip)
+            {
+                size += ((width + blockSize - 1) / blockSize) * ((height + blockSize - 1) / blockSize) * formatInfo.bytesPerBlock;
+                width = std::max<u64>(1, width / 2);
+                height = std::max<u64>(1, height / 2);
+            }
+            return size;
+        }
+
+        // caller must hold the lock
+        Ref<Texture> Find(TextureCacheData &data, u64 key)
+        {
+            auto it = data.entries.find(key);
+            if (it == data.entries.end())
+                return nullptr;
+
+            data.lru.splice(data.lru.begin(), data.lru, it->second.lruIt);
+            return it->second.texture;
+        }
+
+        // caller must hold the lock
+        void EvictUnused(TextureCacheData &data)
+        {
+            auto it = data.lru.end();
+            while (data.memoryUsage > data.budget && it != data.lru.begin())
+            {
+                --it;
+
+                auto entryIt = data.entries.find(*it);
+
+                // still referenced outside the cache
+                if (entryIt->second.texture.use_count() > 1)
+                    continue;
+
+                data.memoryUsage -= entryIt->second.byteSize;
+                data.entries.erase(entryIt);
+                it = data.lru.erase(it);
+            }
+        }
+
+        // previously compressed mips, lets Load skip decoding the source image
+        bool ReadCompressed(u64 contentHash, const TextureCreateInfo &createInfo, CompressedTexture &outCompressed)
+        {
+            const TextureCompressionSettings settings = GetCompressionSettings(createInfo);
+            if (settings.compression == TextureCompression::None)
+                return false;
+
+            return TextureCompressor::LoadFromCache(MakeCompressedKey(contentHash, createInfo, settings), outCompressed);
+        }
+
+        Ref<Texture> LoadCompressed(u64 contentHash, const TextureCreateInfo &createInfo)
+        {
+            CompressedTexture compressed;
+            if (!ReadCompressed(contentHash, createInfo, compressed))
+                return nullptr;
+
+            return Texture::Create(compressed, createInfo);
+        }
+
+        // builds and block compresses the mip chain, false when the texture stays uncompressed
+        bool CompressPixels(u64 contentHash, void *pixels, const TextureCreateInfo &createInfo, const std::string &debugName, CompressedTexture &outCompressed)
+        {
+            const TextureCompressionSettings settings = GetCompressionSettings(createInfo);
+            if (!TextureCompressor::CanCompress(createInfo.width, createInfo.height, createInfo.format, settings.compression))
+                return false;
+
+            const u32 rowPitch = createInfo.width * CPUMipGenerator::GetBytesPerPixel(createInfo.format);
+            const MipChain mipChain = CPUMipGenerator::GenerateMipChain(pixels, createInfo.width, createInfo.height, rowPitch, createInfo.format, createInfo.mipLevels);
+
+            outCompressed = TextureCompressor::Compress(mipChain, createInfo.format, settings);
+            if (!outCompressed.IsValid())
+                return false;
+
+            LOG_INFO("[Texture Cache] Compressed {} to {} ({})", debugName, TextureCompressor::ToString(settings.compression), TextureCompressor::ToString(settings.quality));
+
+            TextureCompressor::SaveToCache(MakeCompressedKey(contentHash, createInfo, settings), outCompressed);
+            return true;
+        }
+
+        Ref<Texture> CreateTexture(u64 contentHash, void *pixels, const TextureCreateInfo &createInfo, const std::string &debugName)
+        {
+            CompressedTexture compressed;
+            if (CompressPixels(contentHash, pixels, createInfo, debugName, compressed))
+                return Texture::Create(compressed, createInfo);
+
+            const u64 bytesPerPixel = nvrhi::getFormatInfo(createInfo.format).bytesPerBlock;
+            return Texture::Create(Buffer(pixels, createInfo.width * createInfo.height * bytesPerPixel), createInfo);
+        }
+
+        // caller must hold the lock
+        void Insert(TextureCacheData &data, u64 key, const Ref<Texture> &texture, const std::string &pathKey = "", const TextureCreateInfo &createInfo = {})
+        {
+            CacheEntry entry;
+            entry.texture = texture;
+            entry.pathKey = pathKey;
+            entry.createInfo = createInfo;
+
+            TextureCreateInfo residentInfo;
+            residentInfo.width = texture->GetWidth();
+            residentInfo.height = texture->GetHeight();
+            residentInfo.format = texture->GetFormat();
+            residentInfo.mipLevels = texture->GetMipLevels();
+            entry.byteSize = CalculateByteSize(residentInfo);
+
+            data.lru.push_front(key);
+            entry.lruIt = data.lru.begin();
+
+            data.memoryUsage += entry.byteSize;
+            data.entries[key] = entry;
+
+            EvictUnused(data);
+        }
+
+        // caller must hold the lock. returns the cached texture, after waiting for a creation of the same key still running,
+        // or reserves the key and returns null. the caller then creates the texture without the lock and hands it to Publish
+        Ref<Texture> FindOrReserve(TextureCacheData &data, std::unique_lock<std::mutex> &lock, u64 key)
+        {
+            data.pendingCondition.wait(lock, [&data, key] { return !data.pending.contains(key); });
+
+            if (Ref<Texture> texture = Find(data, key))
+                return texture;
+
+            data.pending.insert(key);
+            return nullptr;
+        }
+
+        // ends a reservation, without a texture the next load of the key tries again
+        void Publish(TextureCacheData &data, u64 key, const Ref<Texture> &texture, const std::string &pathKey = "", const TextureCreateInfo &createInfo = {})
+        {
+            {
+                std::lock_guard lock(data.mutex);
+                data.pending.erase(key);
+
+                if (texture)
+                    Insert(data, key, texture, pathKey, createInfo);
+            }
+            data.pendingCondition.notify_all();
+        }
+
+        void *Decode(const u8 *encoded, u64 size, TextureCreateInfo &createInfo)
+        {
+            i32 channels = 4;
+
+            // decoding runs on worker threads too, keep the flip flag per thread
+            stbi_set_flip_vertically_on_load_thread(createInfo.flip ? 1 : 0);
+
+            switch (createInfo.format)
+            {
+            case nvrhi::Format::RGBA8_UNORM:
+                return stbi_load_from_memory(encoded, static_cast<i32>(size), &createInfo.width, &createInfo.height, &channels, 4);
+            case nvrhi::Format::RGBA32_FLOAT:
+                return stbi_loadf_from_memory(encoded, static_cast<i32>(size), &createInfo.width, &createInfo.height, &channels, 4);
+            default:
+                LOG_ASSERT(false, "[Texture Cache] Please specify format explicitly!");
+                return nullptr;
+            }
+        }
+    }
+
+    PreparedTexture::~PreparedTexture()
+    {
+        if (pixels)
+            stbi_image_free(pixels);
+    }
+
+    Ref<Texture> TextureCache::Load(const std::filesystem::path &filepath, const TextureCreateInfo &createInfo)
+    {
+        // containers carry their own mip chain, residency is handled by the streamer
+        if (TextureContainer::IsContainerFile(filepath))
+            return TextureStreamer::Load(filepath, createInfo);
+
+        PreparedTexture prepared;
+        if (!Prepare(filepath, createInfo, prepared))
+            return nullptr;
+
+        return Finish(prepared);
+    }
+
+    bool TextureCache::Prepare(const std::filesystem::path &filepath, const TextureCreateInfo &createInfo, PreparedTexture &outPrepared)
+    {
+        outPrepared.filepath = filepath;
+        outPrepared.createInfo = createInfo;
+
+        if (TextureContainer::IsContainerFile(filepath))
+        {
+            outPrepared.container = true;
+            return true;
+        }
+
+        std::error_code ec;
+        std::filesystem::path resolvedPath = std::filesystem::weakly_canonical(filepath, ec);
+        if (ec)
+            resolvedPath = std::filesystem::absolute(filepath);
+
+        const std::string pathKey = resolvedPath.generic_string();
+        outPrepared.pathKey = pathKey;
+
+        const u64 fileSize = std::filesystem::file_size(resolvedPath, ec);
+        if (ec)
+        {
+            LOG_ERROR("[Texture Cache] File does not exists {}", pathKey);
+            return false;
+        }
+
+        const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(resolvedPath, ec);
+
+        TextureCacheData &data = GetData();
+
+        // unchanged file, the content hash is still valid
+        {
+            std::lock_guard lock(data.mutex);
+            if (auto pathIt = data.paths.find(pathKey); pathIt != data.paths.end())
+            {
+                const PathEntry &pathEntry = pathIt->second;
+                if (pathEntry.fileSize == fileSize && pathEntry.writeTime == writeTime)
+                {
+                    outPrepared.key = MakeKey(pathEntry.contentHash, createInfo);
+                    if ((outPrepared.texture = Find(data, outPrepared.key)))
+                        return true;
+                }
+            }
+        }
+
+        // hashed and decoded straight from the mapped pages
+        Ref<vfs::MappedFile> encoded = vfs::MappedFile::Open(resolvedPath);
+        if (!encoded)
+        {
+            LOG_ERROR("[Texture Cache] Failed to open {}", pathKey);
+            return false;
+        }
+
+        const u64 contentHash = HashBytes(encoded->Data(), encoded->Size());
+        outPrepared.key = MakeKey(contentHash, createInfo);
+
+        // same content under a different path
+        {
+            std::lock_guard lock(data.mutex);
+            data.paths[pathKey] = { contentHash, fileSize, writeTime };
+
+            if ((outPrepared.texture = Find(data, outPrepared.key)))
+            {
+                return true;
+            }
+        }
+
+        if (ReadCompressed(contentHash, createInfo, outPrepared.compressed))
+            return true;
+
+        TextureCreateInfo decodedInfo = createInfo;
+        void *pixels = Decode(encoded->Data(), encoded->Size(), decodedInfo);
+        encoded.reset();
+
+        LOG_ASSERT(pixels, "[Texture Cache] Failed to decode {}", pathKey);
+        if (!pixels)
+            return false;
+
+        LOG_INFO("[Texture Cache] Loaded {} ({}x{})", pathKey, decodedInfo.width, decodedInfo.height);
+
+        outPrepared.createInfo = decodedInfo;
+
+        if (CompressPixels(contentHash, pixels, decodedInfo, pathKey, outPrepared.compressed))
+            stbi_image_free(pixels);
+        else
+            outPrepared.pixels = pixels;
+
+        return true;
+    }
+
+    Ref<Texture> TextureCache::Finish(PreparedTexture &prepared, nvrhi::ICommandList *commandList)
+    {
+        if (prepared.container)
+            return TextureStreamer::Load(prepared.filepath, prepared.createInfo);
+
+        if (prepared.texture)
+            return prepared.texture;
+
+        TextureCacheData &data = GetData();
+
+        // another load of the same content finished first
+        {
+            std::unique_lock lock(data.mutex);
+            if (Ref<Texture> texture = FindOrReserve(data, lock, prepared.key))
+                return texture;
+        }
+
+        Ref<Texture> texture;
+        if (prepared.compressed.IsValid())
+        {
+            texture = Texture::Create(prepared.compressed, prepared.createInfo, commandList);
+        }
+        else if (prepared.pixels)
+        {
+            const u64 bytesPerPixel = nvrhi::getFormatInfo(prepared.createInfo.format).bytesPerBlock;
+            const u64 byteSize = prepared.createInfo.width * prepared.createInfo.height * bytesPerPixel;
+            texture = Texture::Create(Buffer(prepared.pixels, byteSize), prepared.createInfo, commandList);
+        }
+
+        if (texture)
+            texture->m_Filepath = prepared.filepath;
+
+        Publish(data, prepared.key, texture, prepared.pathKey, prepared.createInfo);
+        return texture;
+    }
+
+    u32 TextureCache::Reload(const std::filesystem::path &filepath)
+    {
+        // streamed containers are re-read by the streamer on their next residency change
+        if (TextureContainer::IsContainerFile(filepath))
+            return 0;
+
+        std::error_code ec;
+        std::filesystem::path resolvedPath = std::filesystem::weakly_canonical(filepath, ec);
+        if (ec)
+            resolvedPath = std::filesystem::absolute(filepath);
+
+        const std::string pathKey = resolvedPath.generic_string();
+
+        struct Loaded
+        {
+            u64 key;
+            Ref<Texture> texture;
+            TextureCreateInfo createInfo;
+        };
+
+        TextureCacheData &data = GetData();
+
+        std::vector<Loaded> loaded;
+        {
+            std::lock_guard lock(data.mutex);
+            for (auto &[key, entry] : data.entries)
+            {
+                if (entry.pathKey != pathKey)
+                    continue;
+
+                // entries are keyed by content, another file with the same bytes holds the same texture.
+                // swapping it would change that file's users too, so the entry stays with the other file
+                auto sharedIt = std::ranges::find_if(data.paths, [&](const auto &path)
+                {
+                    return path.first != pathKey && MakeKey(path.second.contentHash, entry.createInfo) == key;
+                });
+
+                if (sharedIt != data.paths.end())
+                {
+                    LOG_WARN("[Texture Cache] {} shares its texture with {}, the change shows up once it is loaded again", pathKey, sharedIt->first);
+                    entry.pathKey = sharedIt->first;
+                    continue;
+                }
+
+                loaded.push_back({ key, entry.texture, entry.createInfo });
+            }
+
+            // force Prepare to hash the new content
+            data.paths.erase(pathKey);
+        }
+
+        u32 swapped = 0;
+        for (const Loaded &old : loaded)
+        {
+            PreparedTexture prepared;
+            if (!Prepare(filepath, old.createInfo, prepared) || prepared.key == old.key)
+                continue;
+
+            Ref<Texture> texture = Finish(prepared);
+            if (!texture || texture == old.texture)
+                continue;
+
+            // swap the GPU objects into the texture everyone already holds
+            old.texture->m_Handle = texture->m_Handle;
+            old.texture->m_Sampler = texture->m_Sampler;
+            old.texture->m_CreateInfo = texture->m_CreateInfo;
+
+            std::lock_guard lock(data.mutex);
+            if (auto it = data.entries.find(prepared.key); it != data.entries.end())
+                it->second.texture = old.texture;
+
+            if (auto it = data.entries.find(old.key); it != data.entries.end())
+            {
+                data.memoryUsage -= it->second.byteSize;
+                data.lru.erase(it->second.lruIt);
+                data.entries.erase(it);
+            }
+
+            ++swapped;
+        }
+
+        if (swapped > 0)
+        {
+            data.reloadVersion++;
+            LOG_INFO("[Texture Cache] Reloaded {} ({} textures)", pathKey, swapped);
+        }
+
+        return swapped;
+    }
+
+    u64 TextureCache::GetReloadVersion()
+    {
+        return GetData().reloadVersion;
+    }
+
+    Ref<Texture> TextureCache::LoadFromMemory(Buffer encoded, const TextureCreateInfo &createInfo, const std::string &debugName)
+    {
+        const u64 contentHash = HashBytes(encoded.Data, encoded.Size);
+        const u64 key = MakeKey(contentHash, createInfo);
+
+        TextureCacheData &data = GetData();
+
+        {
+            std::unique_lock lock(data.mutex);
+            if (Ref<Texture> texture = FindOrReserve(data, lock, key))
+                return texture;
+        }
+
+        if (Ref<Texture> texture = LoadCompressed(contentHash, createInfo))
+        {
+            texture->m_Filepath = debugName;
+            Publish(data, key, texture);
+            return texture;
+        }
+
+        TextureCreateInfo decodedInfo = createInfo;
+        void *pixels = Decode(encoded.Data, encoded.Size, decodedInfo);
+
+        LOG_ASSERT(pixels, "[Texture Cache] Failed to decode {}", debugName);
+        if (!pixels)
+        {
+            Publish(data, key, nullptr);
+            return nullptr;
+        }
+
+        Ref<Texture> texture = CreateTexture(contentHash, pixels, decodedInfo, debugName);
+        texture->m_Filepath = debugName;
+        Publish(data, key, texture);
+        stbi_image_free(pixels);
+
+        return texture;
+    }
+
+    Ref<Texture> TextureCache::Create(Buffer pixels, const TextureCreateInfo &createInfo, const std::string &debugName)
+    {
+        LOG_ASSERT(pixels.Data, "[Texture Cache] Pixel data is null");
+
+        u64 contentHash = HashBytes(pixels.Data, pixels.Size);
+        contentHash = HashCombine(contentHash, HashCombine(static_cast<u64>(createInfo.width), static_cast<u64>(createInfo.height)));
+        const u64 key = MakeKey(contentHash, createInfo);
+
+        TextureCacheData &data = GetData();
+
+        {
+            std::unique_lock lock(data.mutex);
+            if (Ref<Texture> texture = FindOrReserve(data, lock, key))
+                return texture;
+        }
+
+        Ref<Texture> texture = LoadCompressed(contentHash, createInfo);
+        if (!texture)
+            texture = CreateTexture(contentHash, pixels.Data, createInfo, debugName);
+
+        texture->m_Filepath = debugName;
+        Publish(data, key, texture);
+        return texture;
+    }
+
+    void TextureCache::Collect()
+    {
+        TextureCacheData &data = GetData();
+        std::lock_guard lock(data.mutex);
+        EvictUnused(data);
+    }
+
+    void TextureCache::Clear()
+    {
+        TextureCacheData &data = GetData();
+        std::lock_guard lock(data.mutex);
+
+        data.entries.clear();
+        data.paths.clear();
+        data.lru.clear();
+        data.memoryUsage = 0;
+    }
+
+    void TextureCache::SetBudget(u64 bytes)
+    {
+        TextureCacheData &data = GetData();
+        std::lock_guard lock(data.mutex);
+
+        data.budget = bytes;
+        EvictUnused(data);
+    }
+
+    u64 TextureCache::GetBudget()
+    {
+        return GetData().budget;
+    }
+
+    u64 TextureCache::GetMemoryUsage()
+    {
+        return GetData().memoryUsage;
+    }
+
+    u32 TextureCache::GetTextureCount()
+    {
+        TextureCacheData &data = GetData();
+        std::lock_guard lock(data.mutex);
+        return static_cast<u32>(data.entries.size());
+    }
+}
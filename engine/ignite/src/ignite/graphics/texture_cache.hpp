@@ -0,0 +1,74 @@
+#pragma once
+
+#include "texture.hpp"
+
+#include "ignite/core/types.hpp"
+#include "ignite/core/buffer.hpp"
+
+#include <filesystem>
+#include <string>
+
+namespace ignite
+{
+#define TEXTURE_CACHE_DEFAULT_BUDGET (512ull * 1024ull * 1024ull)
+
+    // CPU side of a file load, filled by TextureCache::Prepare on any thread
+    // and turned into a GPU texture by TextureCache::Finish on the main thread
+    struct PreparedTexture
+    {
+        PreparedTexture() = default;
+        PreparedTexture(const PreparedTexture &) = delete;
+        PreparedTexture &operator=(const PreparedTexture &) = delete;
+        ~PreparedTexture();
+
+        std::filesystem::path filepath;
+        std::string pathKey; // resolved path
+        TextureCreateInfo createInfo; // decoded size
+        u64 key = 0;
+
+        Ref<Texture> texture; // already cached
+        CompressedTexture compressed;
+        void *pixels = nullptr; // decoded, when the format is not block compressed
+        bool container = false; // handed to the texture streamer
+    };
+
+    // Shared texture cache, entries are keyed by content hash and creation parameters.
+    // A texture is in use while anyone outside the cache holds a Ref to it,
+    // unused textures are evicted in LRU order once the memory budget is exceeded.
+    // Textures with a compressed usage are block compressed once and read back from the on-disk cache.
+    class TextureCache
+    {
+    public:
+        // load from disk, the resolved path is only used to skip re-hashing unchanged files
+        static Ref<Texture> Load(const std::filesystem::path &filepath, const TextureCreateInfo &createInfo);
+
+        // read, decode and compress without touching the GPU, safe to call from worker threads
+        static bool Prepare(const std::filesystem::path &filepath, const TextureCreateInfo &createInfo, PreparedTexture &outPrepared);
+
+        // create the texture on the main thread, uploads are recorded into commandList when given
+        static Ref<Texture> Finish(PreparedTexture &prepared, nvrhi::ICommandList *commandList = nullptr);
+
+        // decode an encoded image (png, jpg, ...) from memory
+        static Ref<Texture> LoadFromMemory(Buffer encoded, const TextureCreateInfo &createInfo, const std::string &debugName = "");
+
+        // create from raw RGBA8 pixels (createInfo.width and height must be set)
+        static Ref<Texture> Create(Buffer pixels, const TextureCreateInfo &createInfo, const std::string &debugName = "");
+
+        // re-read a file that changed on disk, cached textures loaded from it get the new image in place.
+        // a texture shared with another file of the same content is left to that file.
+        // returns the number of textures swapped, main thread only
+        static u32 Reload(const std::filesystem::path &filepath);
+
+        // bumped by every swap, binding sets referencing the old images have to be rebuilt
+        static u64 GetReloadVersion();
+
+        // evict unused textures until the memory usage is within the budget
+        static void Collect();
+        static void Clear();
+
+        static void SetBudget(u64 bytes);
+        static u64 GetBudget();
+        static u64 GetMemoryUsage();
+        static u32 GetTextureCount();
+    };
+}
@@ -0,0 +1,1375 @@
+#include "texture_compressor.hpp"
+
+#include "ignite/core/logger.hpp"
+#include "ignite/core/job_system.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+namespace ignite
+{
+    namespace
+    {
+        // interpolation weights of 4 bit BC6H / BC7 indices, out of 64
+        constexpr u32 kWeights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        // blocks per worker task, smaller mips are encoded on the calling thread
+        constexpr u32 kMinBlocksPerTask = 4096;
+
+        constexpr u32 kCacheMagic = 0x43545849; // "IXTC"
+
+        struct CacheHeader
+        {
+            u32 magic = kCacheMagic;
+            u32 version = TEXTURE_COMPRESSOR_VERSION;
+            u32 format = 0;
+            u32 width = 0;
+            u32 height = 0;
+            u32 mipCount = 0;
+            u64 dataSize = 0;
+        };
+
+        struct CompressorData
+        {
+            std::array<TextureCompressionSettings, static_cast<size_t>(TextureUsage::Count)> settings =
+            {{
+                { TextureCompression::None, CompressionQuality::Normal }, // None
+                { TextureCompression::BC7, CompressionQuality::Normal }, // Sprite
+                { TextureCompression::BC7, CompressionQuality::Normal }, // BaseColor
+                { TextureCompression::BC7, CompressionQuality::Normal }, // Normal, the mesh shader reads all three channels so BC5 would drop z
+                { TextureCompression::BC4, CompressionQuality::Normal }, // Mask
+                { TextureCompression::BC1, CompressionQuality::Normal }, // Emissive
+                { TextureCompression::BC1, CompressionQuality::Normal }, // Specular
+                { TextureCompression::BC6H, CompressionQuality::Normal }, // HDR
+            }};
+
+            std::filesystem::path cacheDirectory;
+        };
+
+        CompressorData &GetData()
+        {
+            static CompressorData data;
+            return data;
+        }
+
+        struct BitWriter
+        {
+            u8 bytes[16] = {};
+            u32 position = 0;
+
+            void Write(u32 value, u32 bitCount)
+            {
+                for (u32 i = 0; i < bitCount; ++i, ++position)
+                {
+                    if (value & (1u << i))
+                        bytes[position >> 3] |= static_cast<u8>(1u << (position & 7));
+                }
+            }
+        };
+
+        struct BitReader
+        {
+            const u8 *bytes = nullptr;
+            u32 position = 0;
+
+            u32 Read(u32 bitCount)
+            {
+                u32 value = 0;
+                for (u32 i = 0; i < bitCount; ++i, ++position)
+                {
+                    value |= static_cast<u32>((bytes[position >> 3] >> (position & 7)) & 1) << i;
+                }
+                return value;
+            }
+        };
+
+        template<typename T>
+        T Clamp(T value, T minValue, T maxValue)
+        {
+            return std::min(std::max(value, minValue), maxValue);
+        }
+
+        // 4x4 block with clamped edges, always RGBA
+        void FetchBlock(const MipLevelData &level, u32 blockX, u32 blockY, f32 out[16][4])
+        {
+            for (u32 y = 0; y < 4; ++y)
+            {
+                const u32 py = std::min(blockY * 4 + y, level.height - 1);
+                const u8 *row = level.data + static_cast<size_t>(py) * level.rowPitch;
+                for (u32 x = 0; x < 4; ++x)
+                {
+                    const u32 px = std::min(blockX * 4 + x, level.width - 1);
+                    for (u32 c = 0; c < 4; ++c)
+                        out[y * 4 + x][c] = row[px * 4 + c];
+                }
+            }
+        }
+
+        // HDR blocks are encoded in half float bit space, which is close to logarithmic
+        void FetchBlockHalf(const MipLevelData &level, u32 blockX, u32 blockY, f32 out[16][4])
+        {
+            for (u32 y = 0; y < 4; ++y)
+            {
+                const u32 py = std::min(blockY * 4 + y, level.height - 1);
+                const f32 *row = reinterpret_cast<const f32 *>(level.data + static_cast<size_t>(py) * level.rowPitch);
+                for (u32 x = 0; x < 4; ++x)
+                {
+                    const u32 px = std::min(blockX * 4 + x, level.width - 1);
+                    for (u32 c = 0; c < 3; ++c)
+                    {
+                        f32 value = row[px * 4 + c];
+                        if (!(value > 0.0f)) // negative and NaN
+                            value = 0.0f;
+                        value = std::min(value, 65504.0f);
+                        out[y * 4 + x][c] = static_cast<f32>(CPUMipGenerator::float_to_half(value));
+                    }
+                    out[y * 4 + x][3] = 0.0f;
+                }
+            }
+        }
+
+        // principal axis of the block colors through the mean, power iteration on the covariance matrix
+        template<u32 N>
+        void PrincipalAxis(const f32 points[16][4], f32 mean[4], f32 axis[4])
+        {
+            for (u32 c = 0; c < N; ++c)
+            {
+                mean[c] = 0.0f;
+                for (u32 i = 0; i < 16; ++i)
+                    mean[c] += points[i][c];
+                mean[c] /= 16.0f;
+            }
+
+            f32 cov[N][N] = {};
+            for (u32 i = 0; i < 16; ++i)
+            {
+                for (u32 a = 0; a < N; ++a)
+                {
+                    const f32 da = points[i][a] - mean[a];
+                    for (u32 b = a; b < N; ++b)
+                        cov[a][b] += da * (points[i][b] - mean[b]);
+                }
+            }
+
+            for (u32 a = 0; a < N; ++a)
+                for (u32 b = 0; b < a; ++b)
+                    cov[a][b] = cov[b][a];
+
+            // start from the channel with the largest variance
+            u32 dominant = 0;
+            for (u32 c = 1; c < N; ++c)
+            {
+                if (cov[c][c] > cov[dominant][dominant])
+                    dominant = c;
+            }
+
+            f32 v[N];
+            for (u32 c = 0; c < N; ++c)
+                v[c] = cov[dominant][c];
+
+            for (u32 iteration = 0; iteration < 8; ++iteration)
+            {
+                f32 next[N] = {};
+                f32 length = 0.0f;
+                for (u32 a = 0; a < N; ++a)
+                {
+                    for (u32 b = 0; b < N; ++b)
+                        next[a] += cov[a][b] * v[b];
+                    length = std::max(length, std::abs(next[a]));
+                }
+
+                if (length <= 0.0f)
+                    break;
+
+                for (u32 c = 0; c < N; ++c)
+                    v[c] = next[c] / length;
+            }
+
+            f32 length = 0.0f;
+            for (u32 c = 0; c < N; ++c)
+                length += v[c] * v[c];
+
+            length = std::sqrt(length);
+            for (u32 c = 0; c < N; ++c)
+                axis[c] = length > 0.0f ? v[c] / length : 1.0f / std::sqrt(static_cast<f32>(N));
+        }
+
+        // endpoints at the extremes of the block projected on an axis
+        template<u32 N>
+        void AxisEndpoints(const f32 points[16][4], const f32 mean[4], const f32 axis[4], f32 e0[4], f32 e1[4])
+        {
+            f32 minT = std::numeric_limits<f32>::max();
+            f32 maxT = std::numeric_limits<f32>::lowest();
+            for (u32 i = 0; i < 16; ++i)
+            {
+                f32 t = 0.0f;
+                for (u32 c = 0; c < N; ++c)
+                    t += (points[i][c] - mean[c]) * axis[c];
+
+                minT = std::min(minT, t);
+                maxT = std::max(maxT, t);
+            }
+
+            for (u32 c = 0; c < N; ++c)
+            {
+                e0[c] = mean[c] + axis[c] * minT;
+                e1[c] = mean[c] + axis[c] * maxT;
+            }
+        }
+
+        // bounding box diagonal, flipped per channel to follow the correlation with the dominant channel
+        template<u32 N>
+        void BoxEndpoints(const f32 points[16][4], f32 e0[4], f32 e1[4])
+        {
+            f32 minC[4], maxC[4], mean[4];
+            for (u32 c = 0; c < N; ++c)
+            {
+                minC[c] = maxC[c] = points[0][c];
+                mean[c] = 0.0f;
+                for (u32 i = 0; i < 16; ++i)
+                {
+                    minC[c] = std::min(minC[c], points[i][c]);
+                    maxC[c] = std::max(maxC[c], points[i][c]);
+                    mean[c] += points[i][c] / 16.0f;
+                }
+            }
+
+            u32 dominant = 0;
+            for (u32 c = 1; c < N; ++c)
+            {
+                if (maxC[c] - minC[c] > maxC[dominant] - minC[dominant])
+                    dominant = c;
+            }
+
+            for (u32 c = 0; c < N; ++c)
+            {
+                f32 covariance = 0.0f;
+                for (u32 i = 0; i < 16; ++i)
+                    covariance += (points[i][c] - mean[c]) * (points[i][dominant] - mean[dominant]);
+
+                e0[c] = covariance < 0.0f ? maxC[c] : minC[c];
+                e1[c] = covariance < 0.0f ? minC[c] : maxC[c];
+            }
+        }
+
+        template<u32 N>
+        void InitialEndpoints(const f32 points[16][4], CompressionQuality quality, f32 e0[4], f32 e1[4])
+        {
+            if (quality == CompressionQuality::Fast)
+            {
+                BoxEndpoints<N>(points, e0, e1);
+                return;
+            }
+
+            f32 mean[4], axis[4];
+            PrincipalAxis<N>(points, mean, axis);
+            AxisEndpoints<N>(points, mean, axis, e0, e1);
+        }
+
+        // least squares endpoints for fixed interpolation weights (weight of e1, 0..1)
+        template<u32 N>
+        bool SolveEndpoints(const f32 points[16][4], const f32 weights[16], f32 e0[4], f32 e1[4])
+        {
+            f32 aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            f32 ax[4] = {}, bx[4] = {};
+
+            for (u32 i = 0; i < 16; ++i)
+            {
+                const f32 b = weights[i];
+                const f32 a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (u32 c = 0; c < N; ++c)
+                {
+                    ax[c] += a * points[i][c];
+                    bx[c] += b * points[i][c];
+                }
+            }
+
+            const f32 det = aa * bb - ab * ab;
+            if (std::abs(det) < 1e-6f)
+                return false;
+
+            const f32 invDet = 1.0f / det;
+            for (u32 c = 0; c < N; ++c)
+            {
+                e0[c] = (ax[c] * bb - bx[c] * ab) * invDet;
+                e1[c] = (bx[c] * aa - ax[c] * ab) * invDet;
+            }
+            return true;
+        }
+
+        template<u32 N>
+        f32 DistanceSq(const f32 a[4], const f32 b[4])
+        {
+            f32 d = 0.0f;
+            for (u32 c = 0; c < N; ++c)
+                d += (a[c] - b[c]) * (a[c] - b[c]);
+            return d;
+        }
+
+        template<u32 N, u32 PaletteSize>
+        f32 AssignIndices(const f32 points[16][4], const f32 palette[PaletteSize][4], u8 indices[16])
+        {
+            f32 error = 0.0f;
+            for (u32 i = 0; i < 16; ++i)
+            {
+                f32 best = std::numeric_limits<f32>::max();
+                for (u32 p = 0; p < PaletteSize; ++p)
+                {
+                    const f32 d = DistanceSq<N>(points[i], palette[p]);
+                    if (d < best)
+                    {
+                        best = d;
+                        indices[i] = static_cast<u8>(p);
+                    }
+                }
+                error += best;
+            }
+            return error;
+        }
+
+        u32 RefinePasses(CompressionQuality quality)
+        {
+            switch (quality)
+            {
+            case CompressionQuality::Fast: return 0;
+            case CompressionQuality::Normal: return 1;
+            case CompressionQuality::High: return 4;
+            }
+            return 1;
+        }
+
+        // ------------------------------------------------------------------
+        // BC1
+        // ------------------------------------------------------------------
+
+        u16 Pack565(const f32 color[4])
+        {
+            const u32 r = static_cast<u32>(Clamp(std::round(color[0] * 31.0f / 255.0f), 0.0f, 31.0f));
+            const u32 g = static_cast<u32>(Clamp(std::round(color[1] * 63.0f / 255.0f), 0.0f, 63.0f));
+            const u32 b = static_cast<u32>(Clamp(std::round(color[2] * 31.0f / 255.0f), 0.0f, 31.0f));
+            return static_cast<u16>((r << 11) | (g << 5) | b);
+        }
+
+        void Unpack565(u16 value, u32 out[3])
+        {
+            const u32 r = (value >> 11) & 31;
+            const u32 g = (value >> 5) & 63;
+            const u32 b = value & 31;
+            out[0] = (r << 3) | (r >> 2);
+            out[1] = (g << 2) | (g >> 4);
+            out[2] = (b << 3) | (b >> 2);
+        }
+
+        // fourColor is false for BC1 blocks with c0 <= c1 (three colors + transparent black)
+        void BC1Palette(u16 c0, u16 c1, bool allowThreeColor, u32 palette[4][4])
+        {
+            u32 p0[3], p1[3];
+            Unpack565(c0, p0);
+            Unpack565(c1, p1);
+
+            const bool fourColor = !allowThreeColor || c0 > c1;
+            for (u32 c = 0; c < 3; ++c)
+            {
+                palette[0][c] = p0[c];
+                palette[1][c] = p1[c];
+                if (fourColor)
+                {
+                    palette[2][c] = (2 * p0[c] + p1[c] + 1) / 3;
+                    palette[3][c] = (p0[c] + 2 * p1[c] + 1) / 3;
+                }
+                else
+                {
+                    palette[2][c] = (p0[c] + p1[c]) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+
+            palette[0][3] = palette[1][3] = palette[2][3] = 255;
+            palette[3][3] = fourColor ? 255 : 0;
+        }
+
+        // always four color mode, which is also what BC3 requires
+        f32 EncodeBC1Endpoints(const f32 points[16][4], const f32 e0[4], const f32 e1[4], u16 &c0, u16 &c1, u8 indices[16])
+        {
+            // the first packed color must be the larger one
+            c0 = Pack565(e0);
+            c1 = Pack565(e1);
+            if (c0 < c1)
+                std::swap(c0, c1);
+
+            if (c0 == c1)
+            {
+                u32 color[3];
+                Unpack565(c0, color);
+                const f32 palette[1][4] = { { static_cast<f32>(color[0]), static_cast<f32>(color[1]), static_cast<f32>(color[2]), 0.0f } };
+                return AssignIndices<3, 1>(points, palette, indices);
+            }
+
+            u32 palette[4][4];
+            BC1Palette(c0, c1, false, palette);
+
+            f32 paletteF[4][4];
+            for (u32 p = 0; p < 4; ++p)
+                for (u32 c = 0; c < 4; ++c)
+                    paletteF[p][c] = static_cast<f32>(palette[p][c]);
+
+            return AssignIndices<3, 4>(points, paletteF, indices);
+        }
+
+        void EncodeBC1(const f32 points[16][4], CompressionQuality quality, u8 *out)
+        {
+            // weight of the second endpoint for each palette index
+            constexpr f32 kIndexWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+            f32 e0[4], e1[4];
+            InitialEndpoints<3>(points, quality, e0, e1);
+
+            u16 bestC0 = 0, bestC1 = 0;
+            u8 bestIndices[16] = {};
+            f32 bestError = EncodeBC1Endpoints(points, e0, e1, bestC0, bestC1, bestIndices);
+
+            const u32 passes = RefinePasses(quality);
+            for (u32 pass = 0; pass < passes && bestError > 0.0f; ++pass)
+            {
+                f32 weights[16];
+                for (u32 i = 0; i < 16; ++i)
+                    weights[i] = kIndexWeights[bestIndices[i]];
+
+                f32 r0[4], r1[4];
+                if (!SolveEndpoints<3>(points, weights, r0, r1))
+                    break;
+
+                u16 c0, c1;
+                u8 indices[16];
+                const f32 error = EncodeBC1Endpoints(points, r0, r1, c0, c1, indices);
+                if (error >= bestError)
+                    break;
+
+                bestError = error;
+                bestC0 = c0;
+                bestC1 = c1;
+                std::memcpy(bestIndices, indices, 16);
+            }
+
+            u32 bits = 0;
+            for (u32 i = 0; i < 16; ++i)
+                bits |= static_cast<u32>(bestIndices[i]) << (i * 2);
+
+            std::memcpy(out + 0, &bestC0, 2);
+            std::memcpy(out + 2, &bestC1, 2);
+            std::memcpy(out + 4, &bits, 4);
+        }
+
+        void DecodeBC1(const u8 *block, bool allowThreeColor, u8 out[16][4])
+        {
+            u16 c0, c1;
+            u32 bits;
+            std::memcpy(&c0, block + 0, 2);
+            std::memcpy(&c1, block + 2, 2);
+            std::memcpy(&bits, block + 4, 4);
+
+            u32 palette[4][4];
+            BC1Palette(c0, c1, allowThreeColor, palette);
+
+            for (u32 i = 0; i < 16; ++i)
+            {
+                const u32 index = (bits >> (i * 2)) & 3;
+                for (u32 c = 0; c < 4; ++c)
+                    out[i][c] = static_cast<u8>(palette[index][c]);
+            }
+        }
+
+        // ------------------------------------------------------------------
+        // BC4, single channel, also used for BC3 alpha and BC5
+        // ------------------------------------------------------------------
+
+        void BC4Palette(u32 a0, u32 a1, u32 palette[8])
+        {
+            palette[0] = a0;
+            palette[1] = a1;
+            if (a0 > a1)
+            {
+                for (u32 i = 1; i < 7; ++i)
+                    palette[i + 1] = ((7 - i) * a0 + i * a1 + 3) / 7;
+            }
+            else
+            {
+                for (u32 i = 1; i < 5; ++i)
+                    palette[i + 1] = ((5 - i) * a0 + i * a1 + 2) / 5;
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        u32 EncodeBC4Endpoints(const f32 values[16], u32 a0, u32 a1, u8 indices[16])
+        {
+            u32 palette[8];
+            BC4Palette(a0, a1, palette);
+
+            u32 error = 0;
+            for (u32 i = 0; i < 16; ++i)
+            {
+                const i32 value = static_cast<i32>(values[i]);
+                u32 best = std::numeric_limits<u32>::max();
+                for (u32 p = 0; p < 8; ++p)
+                {
+                    const i32 d = value - static_cast<i32>(palette[p]);
+                    const u32 e = static_cast<u32>(d * d);
+                    if (e < best)
+                    {
+                        best = e;
+                        indices[i] = static_cast<u8>(p);
+                    }
+                }
+                error += best;
+            }
+            return error;
+        }
+
+        void EncodeBC4(const f32 values[16], CompressionQuality quality, u8 *out)
+        {
+            f32 minV = values[0], maxV = values[0];
+            f32 minInner = 255.0f, maxInner = 0.0f;
+            for (u32 i = 0; i < 16; ++i)
+            {
+                minV = std::min(minV, values[i]);
+                maxV = std::max(maxV, values[i]);
+                if (values[i] > 0.0f && values[i] < 255.0f)
+                {
+                    minInner = std::min(minInner, values[i]);
+                    maxInner = std::max(maxInner, values[i]);
+                }
+            }
+
+            // eight value mode, a0 > a1
+            u32 bestA0 = static_cast<u32>(maxV);
+            u32 bestA1 = static_cast<u32>(minV);
+            u8 bestIndices[16] = {};
+            u32 bestError = EncodeBC4Endpoints(values, bestA0, bestA1, bestIndices);
+
+            const u32 passes = RefinePasses(quality);
+            for (u32 pass = 0; pass < passes && bestError > 0 && bestA0 > bestA1; ++pass)
+            {
+                f32 points[16][4] = {};
+                f32 weights[16];
+                for (u32 i = 0; i < 16; ++i)
+                {
+                    points[i][0] = values[i];
+                    weights[i] = bestIndices[i] == 0 ? 0.0f : bestIndices[i] == 1 ? 1.0f : static_cast<f32>(bestIndices[i] - 1) / 7.0f;
+                }
+
+                f32 r0[4], r1[4];
+                if (!SolveEndpoints<1>(points, weights, r0, r1))
+                    break;
+
+                const u32 a0 = static_cast<u32>(Clamp(std::round(r0[0]), 0.0f, 255.0f));
+                const u32 a1 = static_cast<u32>(Clamp(std::round(r1[0]), 0.0f, 255.0f));
+                if (a0 <= a1)
+                    break;
+
+                u8 indices[16];
+                const u32 error = EncodeBC4Endpoints(values, a0, a1, indices);
+                if (error >= bestError)
+                    break;
+
+                bestError = error;
+                bestA0 = a0;
+                bestA1 = a1;
+                std::memcpy(bestIndices, indices, 16);
+            }
+
+            // six value mode keeps exact 0 and 255, helps blocks with hard edges
+            if (quality == CompressionQuality::High && bestError > 0 && minInner <= maxInner)
+            {
+                u8 indices[16];
+                const u32 a0 = static_cast<u32>(minInner);
+                const u32 a1 = static_cast<u32>(maxInner);
+                const u32 error = EncodeBC4Endpoints(values, a0, a1, indices);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestA0 = a0;
+                    bestA1 = a1;
+                    std::memcpy(bestIndices, indices, 16);
+                }
+            }
+
+            u64 bits = 0;
+            for (u32 i = 0; i < 16; ++i)
+                bits |= static_cast<u64>(bestIndices[i]) << (i * 3);
+
+            out[0] = static_cast<u8>(bestA0);
+            out[1] = static_cast<u8>(bestA1);
+            for (u32 i = 0; i < 6; ++i)
+                out[2 + i] = static_cast<u8>(bits >> (i * 8));
+        }
+
+        void DecodeBC4(const u8 *block, u8 out[16])
+        {
+            u32 palette[8];
+            BC4Palette(block[0], block[1], palette);
+
+            u64 bits = 0;
+            for (u32 i = 0; i < 6; ++i)
+                bits |= static_cast<u64>(block[2 + i]) << (i * 8);
+
+            for (u32 i = 0; i < 16; ++i)
+                out[i] = static_cast<u8>(palette[(bits >> (i * 3)) & 7]);
+        }
+
+        void EncodeBC4Channel(const f32 points[16][4], u32 channel, CompressionQuality quality, u8 *out)
+        {
+            f32 values[16];
+            for (u32 i = 0; i < 16; ++i)
+                values[i] = points[i][channel];
+            EncodeBC4(values, quality, out);
+        }
+
+        // ------------------------------------------------------------------
+        // BC7 mode 6: one subset, RGBA 7.7.7.7 endpoints + p-bit, 4 bit indices
+        // ------------------------------------------------------------------
+
+        u32 Interpolate64(u32 e0, u32 e1, u32 weight)
+        {
+            return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+        }
+
+        void QuantizeBC7Endpoint(const f32 endpoint[4], u32 pbit, u32 q[4])
+        {
+            for (u32 c = 0; c < 4; ++c)
+                q[c] = static_cast<u32>(Clamp(std::round((endpoint[c] - static_cast<f32>(pbit)) / 2.0f), 0.0f, 127.0f));
+        }
+
+        f32 BC7EndpointError(const f32 endpoint[4], const u32 q[4], u32 pbit)
+        {
+            f32 error = 0.0f;
+            for (u32 c = 0; c < 4; ++c)
+            {
+                const f32 d = endpoint[c] - static_cast<f32>((q[c] << 1) | pbit);
+                error += d * d;
+            }
+            return error;
+        }
+
+        struct BC7Mode6
+        {
+            u32 q0[4], q1[4];
+            u32 p0, p1;
+            u8 indices[16];
+            f32 error;
+        };
+
+        f32 EvaluateBC7(const f32 points[16][4], const u32 q0[4], u32 p0, const u32 q1[4], u32 p1, u8 indices[16])
+        {
+            f32 palette[16][4];
+            for (u32 c = 0; c < 4; ++c)
+            {
+                const u32 e0 = (q0[c] << 1) | p0;
+                const u32 e1 = (q1[c] << 1) | p1;
+                for (u32 i = 0; i < 16; ++i)
+                    palette[i][c] = static_cast<f32>(Interpolate64(e0, e1, kWeights4[i]));
+            }
+            return AssignIndices<4, 16>(points, palette, indices);
+        }
+
+        void EncodeBC7Endpoints(const f32 points[16][4], const f32 e0[4], const f32 e1[4], bool exhaustivePBits, BC7Mode6 &result)
+        {
+            result.error = std::numeric_limits<f32>::max();
+
+            u32 q[2][2][4]; // [endpoint][pbit]
+            QuantizeBC7Endpoint(e0, 0, q[0][0]);
+            QuantizeBC7Endpoint(e0, 1, q[0][1]);
+            QuantizeBC7Endpoint(e1, 0, q[1][0]);
+            QuantizeBC7Endpoint(e1, 1, q[1][1]);
+
+            if (!exhaustivePBits)
+            {
+                const u32 p0 = BC7EndpointError(e0, q[0][1], 1) < BC7EndpointError(e0, q[0][0], 0) ? 1 : 0;
+                const u32 p1 = BC7EndpointError(e1, q[1][1], 1) < BC7EndpointError(e1, q[1][0], 0) ? 1 : 0;
+
+                std::memcpy(result.q0, q[0][p0], sizeof(result.q0));
+                std::memcpy(result.q1, q[1][p1], sizeof(result.q1));
+                result.p0 = p0;
+                result.p1 = p1;
+                result.error = EvaluateBC7(points, result.q0, p0, result.q1, p1, result.indices);
+                return;
+            }
+
+            for (u32 p0 = 0; p0 < 2; ++p0)
+            {
+                for (u32 p1 = 0; p1 < 2; ++p1)
+                {
+                    u8 indices[16];
+                    const f32 error = EvaluateBC7(points, q[0][p0], p0, q[1][p1], p1, indices);
+                    if (error < result.error)
+                    {
+                        result.error = error;
+                        std::memcpy(result.q0, q[0][p0], sizeof(result.q0));
+                        std::memcpy(result.q1, q[1][p1], sizeof(result.q1));
+                        result.p0 = p0;
+                        result.p1 = p1;
+                        std::memcpy(result.indices, indices, 16);
+                    }
+                }
+            }
+        }
+
+        void EncodeBC7(const f32 points[16][4], CompressionQuality quality, u8 *out)
+        {
+            const bool exhaustivePBits = quality == CompressionQuality::High;
+
+            f32 e0[4], e1[4];
+            InitialEndpoints<4>(points, quality, e0, e1);
+
+            BC7Mode6 best;
+            EncodeBC7Endpoints(points, e0, e1, exhaustivePBits, best);
+
+            const u32 passes = RefinePasses(quality);
+            for (u32 pass = 0; pass < passes && best.error > 0.0f; ++pass)
+            {
+                f32 weights[16];
+                for (u32 i = 0; i < 16; ++i)
+                    weights[i] = static_cast<f32>(kWeights4[best.indices[i]]) / 64.0f;
+
+                f32 r0[4], r1[4];
+                if (!SolveEndpoints<4>(points, weights, r0, r1))
+                    break;
+
+                BC7Mode6 candidate;
+                EncodeBC7Endpoints(points, r0, r1, exhaustivePBits, candidate);
+                if (candidate.error >= best.error)
+                    break;
+
+                best = candidate;
+            }
+
+            // the anchor index is stored with 3 bits, its top bit must be zero
+            if (best.indices[0] & 8)
+            {
+                std::swap(best.q0, best.q1);
+                std::swap(best.p0, best.p1);
+                for (u32 i = 0; i < 16; ++i)
+                    best.indices[i] = static_cast<u8>(15 - best.indices[i]);
+            }
+
+            BitWriter writer;
+            writer.Write(1u << 6, 7); // mode 6
+            for (u32 c = 0; c < 4; ++c)
+            {
+                writer.Write(best.q0[c], 7);
+                writer.Write(best.q1[c], 7);
+            }
+            writer.Write(best.p0, 1);
+            writer.Write(best.p1, 1);
+
+            writer.Write(best.indices[0], 3);
+            for (u32 i = 1; i < 16; ++i)
+                writer.Write(best.indices[i], 4);
+
+            std::memcpy(out, writer.bytes, 16);
+        }
+
+        void DecodeBC7(const u8 *block, u8 out[16][4])
+        {
+            BitReader reader{ block };
+            if (reader.Read(7) != (1u << 6))
+            {
+                // other modes are never written by the encoder
+                std::memset(out, 0, 16 * 4);
+                return;
+            }
+
+            u32 q0[4], q1[4];
+            for (u32 c = 0; c < 4; ++c)
+            {
+                q0[c] = reader.Read(7);
+                q1[c] = reader.Read(7);
+            }
+            const u32 p0 = reader.Read(1);
+            const u32 p1 = reader.Read(1);
+
+            for (u32 i = 0; i < 16; ++i)
+            {
+                const u32 index = reader.Read(i == 0 ? 3 : 4);
+                for (u32 c = 0; c < 4; ++c)
+                    out[i][c] = static_cast<u8>(Interpolate64((q0[c] << 1) | p0, (q1[c] << 1) | p1, kWeights4[index]));
+            }
+        }
+
+        // ------------------------------------------------------------------
+        // BC6H mode 11: one region, 10 bit unsigned endpoints, 4 bit indices
+        // ------------------------------------------------------------------
+
+        u32 UnquantizeBC6H(u32 q)
+        {
+            if (q == 0)
+                return 0;
+            if (q == 1023)
+                return 0xFFFF;
+            return ((q << 16) + 0x8000) >> 10;
+        }
+
+        // unquantized 16 bit value to half float bits
+        u32 FinishBC6H(u32 value)
+        {
+            return (value * 31) >> 6;
+        }
+
+        u32 QuantizeBC6H(f32 half)
+        {
+            const i32 guess = static_cast<i32>(std::round((half - 15.0f) / 31.0f));
+
+            u32 best = 0;
+            f32 bestError = std::numeric_limits<f32>::max();
+            for (i32 q = guess - 1; q <= guess + 1; ++q)
+            {
+                const u32 candidate = static_cast<u32>(Clamp(q, 0, 1023));
+                const f32 error = std::abs(static_cast<f32>(FinishBC6H(UnquantizeBC6H(candidate))) - half);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = candidate;
+                }
+            }
+            return best;
+        }
+
+        f32 EvaluateBC6H(const f32 points[16][4], const u32 q0[3], const u32 q1[3], u8 indices[16])
+        {
+            f32 palette[16][4] = {};
+            for (u32 c = 0; c < 3; ++c)
+            {
+                const u32 u0 = UnquantizeBC6H(q0[c]);
+                const u32 u1 = UnquantizeBC6H(q1[c]);
+                for (u32 i = 0; i < 16; ++i)
+                    palette[i][c] = static_cast<f32>(FinishBC6H(Interpolate64(u0, u1, kWeights4[i])));
+            }
+            return AssignIndices<3, 16>(points, palette, indices);
+        }
+
+        void EncodeBC6H(const f32 points[16][4], CompressionQuality quality, u8 *out)
+        {
+            f32 e0[4], e1[4];
+            InitialEndpoints<3>(points, quality, e0, e1);
+
+            u32 q0[3], q1[3];
+            for (u32 c = 0; c < 3; ++c)
+            {
+                q0[c] = QuantizeBC6H(Clamp(e0[c], 0.0f, 31743.0f));
+                q1[c] = QuantizeBC6H(Clamp(e1[c], 0.0f, 31743.0f));
+            }
+
+            u8 indices[16];
+            f32 error = EvaluateBC6H(points, q0, q1, indices);
+
+            const u32 passes = RefinePasses(quality);
+            for (u32 pass = 0; pass < passes && error > 0.0f; ++pass)
+            {
+                f32 weights[16];
+                for (u32 i = 0; i < 16; ++i)
+                    weights[i] = static_cast<f32>(kWeights4[indices[i]]) / 64.0f;
+
+                f32 r0[4], r1[4];
+                if (!SolveEndpoints<3>(points, weights, r0, r1))
+                    break;
+
+                u32 n0[3], n1[3];
+                for (u32 c = 0; c < 3; ++c)
+                {
+                    n0[c] = QuantizeBC6H(Clamp(r0[c], 0.0f, 31743.0f));
+                    n1[c] = QuantizeBC6H(Clamp(r1[c], 0.0f, 31743.0f));
+                }
+
+                u8 candidateIndices[16];
+                const f32 candidateError = EvaluateBC6H(points, n0, n1, candidateIndices);
+                if (candidateError >= error)
+                    break;
+
+                error = candidateError;
+                std::memcpy(q0, n0, sizeof(q0));
+                std::memcpy(q1, n1, sizeof(q1));
+                std::memcpy(indices, candidateIndices, 16);
+            }
+
+            if (indices[0] & 8)
+            {
+                std::swap(q0, q1);
+                for (u32 i = 0; i < 16; ++i)
+                    indices[i] = static_cast<u8>(15 - indices[i]);
+            }
+
+            BitWriter writer;
+            writer.Write(0x03, 5); // mode 11
+            for (u32 c = 0; c < 3; ++c)
+                writer.Write(q0[c], 10);
+            for (u32 c = 0; c < 3; ++c)
+                writer.Write(q1[c], 10);
+
+            writer.Write(indices[0], 3);
+            for (u32 i = 1; i < 16; ++i)
+                writer.Write(indices[i], 4);
+
+            std::memcpy(out, writer.bytes, 16);
+        }
+
+        void DecodeBC6H(const u8 *block, f32 out[16][4])
+        {
+            BitReader reader{ block };
+            if (reader.Read(5) != 0x03)
+            {
+                // other modes are never written by the encoder
+                std::memset(out, 0, 16 * 4 * sizeof(f32));
+                return;
+            }
+
+            u32 u0[3], u1[3];
+            for (u32 c = 0; c < 3; ++c)
+                u0[c] = UnquantizeBC6H(reader.Read(10));
+            for (u32 c = 0; c < 3; ++c)
+                u1[c] = UnquantizeBC6H(reader.Read(10));
+
+            for (u32 i = 0; i < 16; ++i)
+            {
+                const u32 index = reader.Read(i == 0 ? 3 : 4);
+                for (u32 c = 0; c < 3; ++c)
+                {
+                    const u32 half = FinishBC6H(Interpolate64(u0[c], u1[c], kWeights4[index]));
+                    out[i][c] = CPUMipGenerator::half_to_float(static_cast<uint16_t>(half));
+                }
+                out[i][3] = 1.0f;
+            }
+        }
+
+        // ------------------------------------------------------------------
+
+        u32 GetBlockBytes(TextureCompression compression)
+        {
+            switch (compression)
+            {
+            case TextureCompression::BC1:
+            case TextureCompression::BC4:
+                return 8;
+            case TextureCompression::BC3:
+            case TextureCompression::BC5:
+            case TextureCompression::BC6H:
+            case TextureCompression::BC7:
+                return 16;
+            default:
+                return 0;
+            }
+        }
+
+        TextureCompression CompressionFromFormat(nvrhi::Format format)
+        {
+            switch (format)
+            {
+            case nvrhi::Format::BC1_UNORM: return TextureCompression::BC1;
+            case nvrhi::Format::BC3_UNORM: return TextureCompression::BC3;
+            case nvrhi::Format::BC4_UNORM: return TextureCompression::BC4;
+            case nvrhi::Format::BC5_UNORM: return TextureCompression::BC5;
+            case nvrhi::Format::BC6H_UFLOAT: return TextureCompression::BC6H;
+            case nvrhi::Format::BC7_UNORM: return TextureCompression::BC7;
+            default: return TextureCompression::None;
+            }
+        }
+
+        void EncodeBlock(const MipLevelData &level, u32 blockX, u32 blockY, const TextureCompressionSettings &settings, u8 *out)
+        {
+            f32 points[16][4];
+            if (settings.compression == TextureCompression::BC6H)
+                FetchBlockHalf(level, blockX, blockY, points);
+            else
+                FetchBlock(level, blockX, blockY, points);
+
+            switch (settings.compression)
+            {
+            case TextureCompression::BC1:
+                EncodeBC1(points, settings.quality, out);
+                break;
+            case TextureCompression::BC3:
+                EncodeBC4Channel(points, 3, settings.quality, out);
+                EncodeBC1(points, settings.quality, out + 8);
+                break;
+            case TextureCompression::BC4:
+                EncodeBC4Channel(points, 0, settings.quality, out);
+                break;
+            case TextureCompression::BC5:
+                EncodeBC4Channel(points, 0, settings.quality, out);
+                EncodeBC4Channel(points, 1, settings.quality, out + 8);
+                break;
+            case TextureCompression::BC6H:
+                EncodeBC6H(points, settings.quality, out);
+                break;
+            case TextureCompression::BC7:
+                EncodeBC7(points, settings.quality, out);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    CompressedTexture TextureCompressor::Compress(const MipChain &mipChain, nvrhi::Format sourceFormat, const TextureCompressionSettings &settings)
+    {
+        CompressedTexture result;
+        if (mipChain.size() == 0 || !CanCompress(mipChain[0].width, mipChain[0].height, sourceFormat, settings.compression))
+        {
+            LOG_ERROR("[Texture Compressor] Can not compress {}x{} to {}", mipChain.size() ? mipChain[0].width : 0, mipChain.size() ? mipChain[0].height : 0, ToString(settings.compression));
+            return result;
+        }
+
+        const u32 blockBytes = GetBlockBytes(settings.compression);
+
+        result.format = GetFormat(settings.compression);
+        result.width = mipChain[0].width;
+        result.height = mipChain[0].height;
+        result.mips.resize(mipChain.size());
+
+        u64 totalSize = 0;
+        for (u32 mip = 0; mip < mipChain.size(); ++mip)
+        {
+            CompressedMip &compressedMip = result.mips[mip];
+            compressedMip.width = mipChain[mip].width;
+            compressedMip.height = mipChain[mip].height;
+            compressedMip.rowPitch = std::max(1u, (compressedMip.width + 3) / 4) * blockBytes;
+            compressedMip.offset = totalSize;
+            compressedMip.size = static_cast<u64>(compressedMip.rowPitch) * std::max(1u, (compressedMip.height + 3) / 4);
+            totalSize += compressedMip.size;
+        }
+
+        result.data.resize(totalSize);
+
+        for (u32 mip = 0; mip < mipChain.size(); ++mip)
+        {
+            const MipLevelData &level = mipChain[mip];
+            const CompressedMip &compressedMip = result.mips[mip];
+
+            const u32 blocksX = std::max(1u, (level.width + 3) / 4);
+            const u32 blocksY = std::max(1u, (level.height + 3) / 4);
+            u8 *dst = result.data.data() + compressedMip.offset;
+
+            JobSystem::ParallelFor(blocksY, std::max(1u, kMinBlocksPerTask / blocksX), [&](u32 begin, u32 end)
+            {
+                for (u32 by = begin; by < end; ++by)
+                {
+                    u8 *row = dst + static_cast<size_t>(by) * compressedMip.rowPitch;
+                    for (u32 bx = 0; bx < blocksX; ++bx)
+                        EncodeBlock(level, bx, by, settings, row + bx * blockBytes);
+                }
+            });
+        }
+
+        return result;
+    }
+
+    std::vector<u8> TextureCompressor::Decompress(const CompressedTexture &texture, u32 mip)
+    {
+        const TextureCompression compression = CompressionFromFormat(texture.format);
+        LOG_ASSERT(compression != TextureCompression::None && mip < texture.mips.size(), "[Texture Compressor] Invalid texture");
+
+        const CompressedMip &compressedMip = texture.mips[mip];
+        const u32 blockBytes = GetBlockBytes(compression);
+        const u32 blocksX = std::max(1u, (compressedMip.width + 3) / 4);
+        const u32 blocksY = std::max(1u, (compressedMip.height + 3) / 4);
+        const bool hdr = compression == TextureCompression::BC6H;
+        const u32 pixelBytes = hdr ? 16 : 4;
+
+        std::vector<u8> pixels(static_cast<size_t>(compressedMip.width) * compressedMip.height * pixelBytes);
+
+        for (u32 by = 0; by < blocksY; ++by)
+        {
+            for (u32 bx = 0; bx < blocksX; ++bx)
+            {
+                const u8 *block = texture.GetMipData(mip) + static_cast<size_t>(by) * compressedMip.rowPitch + bx * blockBytes;
+
+                u8 decoded[16][4] = {};
+                f32 decodedF[16][4] = {};
+
+                switch (compression)
+                {
+                case TextureCompression::BC1:
+                    DecodeBC1(block, true, decoded);
+                    break;
+                case TextureCompression::BC3:
+                {
+                    u8 alpha[16];
+                    DecodeBC4(block, alpha);
+                    DecodeBC1(block + 8, false, decoded);
+                    for (u32 i = 0; i < 16; ++i)
+                        decoded[i][3] = alpha[i];
+                    break;
+                }
+                case TextureCompression::BC4:
+                {
+                    u8 red[16];
+                    DecodeBC4(block, red);
+                    for (u32 i = 0; i < 16; ++i)
+                    {
+                        decoded[i][0] = red[i];
+                        decoded[i][3] = 255;
+                    }
+                    break;
+                }
+                case TextureCompression::BC5:
+                {
+                    u8 red[16], green[16];
+                    DecodeBC4(block, red);
+                    DecodeBC4(block + 8, green);
+                    for (u32 i = 0; i < 16; ++i)
+                    {
+                        decoded[i][0] = red[i];
+                        decoded[i][1] = green[i];
+                        decoded[i][3] = 255;
+                    }
+                    break;
+                }
+                case TextureCompression::BC6H:
+                    DecodeBC6H(block, decodedF);
+                    break;
+                case TextureCompression::BC7:
+                    DecodeBC7(block, decoded);
+                    break;
+                default:
+                    break;
+                }
+
+                for (u32 y = 0; y < 4; ++y)
+                {
+                    const u32 py = by * 4 + y;
+                    if (py >= compressedMip.height)
+                        break;
+
+                    for (u32 x = 0; x < 4; ++x)
+                    {
+                        const u32 px = bx * 4 + x;
+                        if (px >= compressedMip.width)
+                            break;
+
+                        u8 *dst = pixels.data() + (static_cast<size_t>(py) * compressedMip.width + px) * pixelBytes;
+                        if (hdr)
+                            std::memcpy(dst, decodedF[y * 4 + x], 16);
+                        else
+                            std::memcpy(dst, decoded[y * 4 + x], 4);
+                    }
+                }
+            }
+        }
+
+        return pixels;
+    }
+
+    f64 TextureCompressor::ComputePSNR(const u8 *reference, const u8 *decoded, u32 width, u32 height, u32 channels)
+    {
+        // both images are RGBA, only the first channels are compared
+        f64 sum = 0.0;
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            for (u32 c = 0; c < channels; ++c)
+            {
+                const f64 d = static_cast<f64>(reference[i * 4 + c]) - static_cast<f64>(decoded[i * 4 + c]);
+                sum += d * d;
+            }
+        }
+
+        const f64 mse = sum / static_cast<f64>(pixelCount * channels);
+        if (mse <= 0.0)
+            return std::numeric_limits<f64>::infinity();
+
+        return 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+    f64 TextureCompressor::ComputePSNR(const f32 *reference, const f32 *decoded, u32 width, u32 height, u32 channels, f32 peak)
+    {
+        f64 sum = 0.0;
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            for (u32 c = 0; c < channels; ++c)
+            {
+                const f64 d = static_cast<f64>(reference[i * 4 + c]) - static_cast<f64>(decoded[i * 4 + c]);
+                sum += d * d;
+            }
+        }
+
+        const f64 mse = sum / static_cast<f64>(pixelCount * channels);
+        if (mse <= 0.0)
+            return std::numeric_limits<f64>::infinity();
+
+        return 10.0 * std::log10(static_cast<f64>(peak) * peak / mse);
+    }
+
+    nvrhi::Format TextureCompressor::GetFormat(TextureCompression compression)
+    {
+        switch (compression)
+        {
+        case TextureCompression::BC1: return nvrhi::Format::BC1_UNORM;
+        case TextureCompression::BC3: return nvrhi::Format::BC3_UNORM;
+        case TextureCompression::BC4: return nvrhi::Format::BC4_UNORM;
+        case TextureCompression::BC5: return nvrhi::Format::BC5_UNORM;
+        case TextureCompression::BC6H: return nvrhi::Format::BC6H_UFLOAT;
+        case TextureCompression::BC7: return nvrhi::Format::BC7_UNORM;
+        default: return nvrhi::Format::UNKNOWN;
+        }
+    }
+
+    u32 TextureCompressor::GetBlockSize(TextureCompression compression)
+    {
+        return GetBlockBytes(compression);
+    }
+
+    bool TextureCompressor::CanCompress(u32 width, u32 height, nvrhi::Format sourceFormat, TextureCompression compression)
+    {
+        if (compression == TextureCompression::None || width == 0 || height == 0)
+            return false;
+
+        if (width % 4 != 0 || height % 4 != 0)
+            return false;
+
+        if (compression == TextureCompression::BC6H)
+            return sourceFormat == nvrhi::Format::RGBA32_FLOAT;
+
+        return sourceFormat == nvrhi::Format::RGBA8_UNORM;
+    }
+
+    void TextureCompressor::SetSettings(TextureUsage usage, const TextureCompressionSettings &settings)
+    {
+        LOG_ASSERT(usage < TextureUsage::Count, "[Texture Compressor] Invalid usage");
+        GetData().settings[static_cast<size_t>(usage)] = settings;
+    }
+
+    const TextureCompressionSettings &TextureCompressor::GetSettings(TextureUsage usage)
+    {
+        LOG_ASSERT(usage < TextureUsage::Count, "[Texture Compressor] Invalid usage");
+        return GetData().settings[static_cast<size_t>(usage)];
+    }
+
+    void TextureCompressor::SetCacheDirectory(const std::filesystem::path &directory)
+    {
+        GetData().cacheDirectory = directory;
+    }
+
+    const std::filesystem::path &TextureCompressor::GetCacheDirectory()
+    {
+        return GetData().cacheDirectory;
+    }
+
+    bool TextureCompressor::LoadFromCache(u64 cacheKey, CompressedTexture &outTexture)
+    {
+        const std::filesystem::path &directory = GetData().cacheDirectory;
+        if (directory.empty())
+            return false;
+
+        std::ifstream file(directory / fmt::format("{:016x}.ixtex", cacheKey), std::ios::binary);
+        if (!file)
+            return false;
+
+        CacheHeader header;
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (!file || header.magic != kCacheMagic || header.version != TEXTURE_COMPRESSOR_VERSION || header.mipCount == 0)
+            return false;
+
+        CompressedTexture texture;
+        texture.format = static_cast<nvrhi::Format>(header.format);
+        texture.width = header.width;
+        texture.height = header.height;
+        texture.mips.resize(header.mipCount);
+        texture.data.resize(header.dataSize);
+
+        file.read(reinterpret_cast<char *>(texture.mips.data()), static_cast<std::streamsize>(sizeof(CompressedMip) * header.mipCount));
+        file.read(reinterpret_cast<char *>(texture.data.data()), static_cast<std::streamsize>(header.dataSize));
+        if (!file)
+        {
+            LOG_WARN("[Texture Compressor] Corrupted cache entry {:016x}", cacheKey);
+            return false;
+        }
+
+        for (const CompressedMip &mip : texture.mips)
+        {
+            if (mip.offset + mip.size > header.dataSize)
+            {
+                LOG_WARN("[Texture Compressor] Corrupted cache entry {:016x}", cacheKey);
+                return false;
+            }
+        }
+
+        outTexture = std::move(texture);
+        return true;
+    }
+
+    void TextureCompressor::SaveToCache(u64 cacheKey, const CompressedTexture &texture)
+    {
+        const std::filesystem::path &directory = GetData().cacheDirectory;
+        if (directory.empty() || !texture.IsValid())
+            return;
+
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+
+        const std::filesystem::path filepath = directory / fmt::format("{:016x}.ixtex", cacheKey);
+        // unique per thread, the same texture may be compressed by two loads at once
+        std::filesystem::path tempFilepath = filepath;
+        tempFilepath += fmt::format(".{:x}.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+        {
+            std::ofstream file(tempFilepath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                LOG_WARN("[Texture Compressor] Failed to write cache {}", filepath.generic_string());
+                return;
+            }
+
+            CacheHeader header;
+            header.format = static_cast<u32>(texture.format);
+            header.width = texture.width;
+            header.height = texture.height;
+            header.mipCount = static_cast<u32>(texture.mips.size());
+            header.dataSize = texture.data.size();
+
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char *>(texture.mips.data()), static_cast<std::streamsize>(sizeof(CompressedMip) * texture.mips.size()));
+            file.write(reinterpret_cast<const char *>(texture.data.data()), static_cast<std::streamsize>(texture.data.size()));
+        }
+
+        // readers never see a partially written file
+        std::filesystem::rename(tempFilepath, filepath, ec);
+        if (ec)
+        {
+            LOG_WARN("[Texture Compressor] Failed to write cache {}: {}", filepath.generic_string(), ec.message());
+            std::filesystem::remove(tempFilepath, ec);
+        }
+    }
+
+    const char *TextureCompressor::ToString(TextureCompression compression)
+    {
+        switch (compression)
+        {
+        case TextureCompression::BC1: return "BC1";
+        case TextureCompression::BC3: return "BC3";
+        case TextureCompression::BC4: return "BC4";
+        case TextureCompression::BC5: return "BC5";
+        case TextureCompression::BC6H: return "BC6H";
+        case TextureCompression::BC7: return "BC7";
+        case TextureCompression::None:
+        default: return "None";
+        }
+    }
+
+    const char *TextureCompressor::ToString(CompressionQuality quality)
+    {
+        switch (quality)
+        {
+        case CompressionQuality::Fast: return "Fast";
+        case CompressionQuality::High: return "High";
+        case CompressionQuality::Normal:
+        default: return "Normal";
+        }
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+#include "mip_generator.hpp"
+
+#include <nvrhi/nvrhi.h>
+
+#include <array>
+#include <filesystem>
+#include <vector>
+
+namespace ignite
+{
+    // bump when the encoder output changes, invalidates the on-disk cache
+#define TEXTURE_COMPRESSOR_VERSION 1
+
+    enum class TextureCompression : u8
+    {
+        None,
+        BC1, // RGB, 4 bpp
+        BC3, // RGBA, BC1 color + BC4 alpha, 8 bpp
+        BC4, // R, 4 bpp
+        BC5, // RG, 8 bpp
+        BC6H, // HDR RGB, 8 bpp
+        BC7 // RGBA, 8 bpp
+    };
+
+    enum class CompressionQuality : u8
+    {
+        Fast, // bounding box endpoints
+        Normal, // principal axis endpoints with one least squares refinement
+        High // more refinement passes and extra encoding modes
+    };
+
+    // what the texture is used for, selects the compression settings
+    enum class TextureUsage : u8
+    {
+        None, // never compressed (ui, icons, render targets)
+        Sprite,
+        BaseColor,
+        Normal,
+        Mask, // single channel data (roughness, ao, ...)
+        Emissive,
+        Specular,
+        HDR,
+        Count
+    };
+
+    struct TextureCompressionSettings
+    {
+        TextureCompression compression = TextureCompression::None;
+        CompressionQuality quality = CompressionQuality::Normal;
+    };
+
+    struct CompressedMip
+    {
+        u32 width = 0;
+        u32 height = 0;
+        u32 rowPitch = 0; // bytes per row of blocks
+        u64 offset = 0;
+        u64 size = 0;
+    };
+
+    struct CompressedTexture
+    {
+        nvrhi::Format format = nvrhi::Format::UNKNOWN;
+        u32 width = 0;
+        u32 height = 0;
+        std::vector<CompressedMip> mips;
+        std::vector<u8> data;
+
+        const u8 *GetMipData(u32 mip) const { return data.data() + mips[mip].offset; }
+        bool IsValid() const { return format != nvrhi::Format::UNKNOWN && !mips.empty(); }
+    };
+
+    // CPU block compressor. Blocks are encoded on worker threads and the results
+    // are cached on disk keyed by source content, so every texture is encoded only once.
+    //
+    // BC7 is written with mode 6 only and BC6H with mode 11 only (single subset),
+    // the decoders handle exactly what the encoder writes.
+    class TextureCompressor
+    {
+    public:
+        // source levels must be RGBA8_UNORM, or RGBA32_FLOAT for BC6H
+        static CompressedTexture Compress(const MipChain &mipChain, nvrhi::Format sourceFormat, const TextureCompressionSettings &settings);
+
+        // decode one mip back to RGBA8, or RGBA32_FLOAT for BC6H
+        static std::vector<u8> Decompress(const CompressedTexture &texture, u32 mip);
+
+        static f64 ComputePSNR(const u8 *reference, const u8 *decoded, u32 width, u32 height, u32 channels = 4);
+        static f64 ComputePSNR(const f32 *reference, const f32 *decoded, u32 width, u32 height, u32 channels, f32 peak);
+
+        static nvrhi::Format GetFormat(TextureCompression compression);
+        static u32 GetBlockSize(TextureCompression compression);
+
+        // BC formats need 4 aligned top level dimensions on every backend
+        static bool CanCompress(u32 width, u32 height, nvrhi::Format sourceFormat, TextureCompression compression);
+
+        static void SetSettings(TextureUsage usage, const TextureCompressionSettings &settings);
+        static const TextureCompressionSettings &GetSettings(TextureUsage usage);
+
+        static void SetCacheDirectory(const std::filesystem::path &directory);
+        static const std::filesystem::path &GetCacheDirectory();
+
+        // cacheKey should include the source content hash and every parameter that changes the output
+        static bool LoadFromCache(u64 cacheKey, CompressedTexture &outTexture);
+        static void SaveToCache(u64 cacheKey, const CompressedTexture &texture);
+
+        static const char *ToString(TextureCompression compression);
+        static const char *ToString(CompressionQuality quality);
+    };
+}
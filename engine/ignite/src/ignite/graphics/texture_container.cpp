@@ -0,0 +1,471 @@
+#include "texture_container.hpp"
+
+#include "ignite/core/compression.hpp"
+#include "ignite/core/logger.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+
+namespace ignite
+{
+    namespace
+    {
+        constexpr u32 kDDSMagic = 0x20534444; // "DDS "
+        constexpr u32 kDDSFourCCDX10 = 0x30315844; // "DX10"
+        constexpr u32 kDDSFlagFourCC = 0x4;
+        constexpr u32 kDDSFlagRGB = 0x40;
+        constexpr u32 kDDSCaps2Cubemap = 0x200;
+        constexpr u32 kDDSCaps2Volume = 0x200000;
+        constexpr u32 kDDSHeaderSize = 124;
+        constexpr u32 kDDSDX10HeaderSize = 20;
+
+        constexpr u8 kKTX2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+        constexpr u32 kKTX2HeaderSize = 80;
+        constexpr u32 kKTX2LevelIndexEntrySize = 24;
+
+        // headers are small, the level index of a 16 level KTX2 fits easily
+        constexpr u64 kHeaderReadSize = 4096;
+
+        constexpr u32 MakeFourCC(char a, char b, char c, char d)
+        {
+            return static_cast<u32>(a) | (static_cast<u32>(b) << 8) | (static_cast<u32>(c) << 16) | (static_cast<u32>(d) << 24);
+        }
+
+        template<typename T>
+        T ReadValue(const u8 *data)
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        nvrhi::Format FormatFromDXGI(u32 dxgiFormat)
+        {
+            switch (dxgiFormat)
+            {
+            case 2: return nvrhi::Format::RGBA32_FLOAT;
+            case 10: return nvrhi::Format::RGBA16_FLOAT;
+            case 28: return nvrhi::Format::RGBA8_UNORM;
+            case 29: return nvrhi::Format::SRGBA8_UNORM;
+            case 49: return nvrhi::Format::RG8_UNORM;
+            case 61: return nvrhi::Format::R8_UNORM;
+            case 71: return nvrhi::Format::BC1_UNORM;
+            case 72: return nvrhi::Format::BC1_UNORM_SRGB;
+            case 74: return nvrhi::Format::BC2_UNORM;
+            case 75: return nvrhi::Format::BC2_UNORM_SRGB;
+            case 77: return nvrhi::Format::BC3_UNORM;
+            case 78: return nvrhi::Format::BC3_UNORM_SRGB;
+            case 80: return nvrhi::Format::BC4_UNORM;
+            case 81: return nvrhi::Format::BC4_SNORM;
+            case 83: return nvrhi::Format::BC5_UNORM;
+            case 84: return nvrhi::Format::BC5_SNORM;
+            case 87: return nvrhi::Format::BGRA8_UNORM;
+            case 91: return nvrhi::Format::SBGRA8_UNORM;
+            case 95: return nvrhi::Format::BC6H_UFLOAT;
+            case 96: return nvrhi::Format::BC6H_SFLOAT;
+            case 98: return nvrhi::Format::BC7_UNORM;
+            case 99: return nvrhi::Format::BC7_UNORM_SRGB;
+            default: return nvrhi::Format::UNKNOWN;
+            }
+        }
+
+        u32 FormatToDXGI(nvrhi::Format format)
+        {
+            for (u32 dxgiFormat = 0; dxgiFormat < 128; ++dxgiFormat)
+            {
+                if (FormatFromDXGI(dxgiFormat) == format)
+                    return dxgiFormat;
+            }
+            return 0;
+        }
+
+        nvrhi::Format FormatFromVulkan(u32 vkFormat)
+        {
+            switch (vkFormat)
+            {
+            case 9: return nvrhi::Format::R8_UNORM;
+            case 16: return nvrhi::Format::RG8_UNORM;
+            case 37: return nvrhi::Format::RGBA8_UNORM;
+            case 43: return nvrhi::Format::SRGBA8_UNORM;
+            case 44: return nvrhi::Format::BGRA8_UNORM;
+            case 50: return nvrhi::Format::SBGRA8_UNORM;
+            case 97: return nvrhi::Format::RGBA16_FLOAT;
+            case 109: return nvrhi::Format::RGBA32_FLOAT;
+            case 131: // BC1 RGB
+            case 133: return nvrhi::Format::BC1_UNORM;
+            case 132:
+            case 134: return nvrhi::Format::BC1_UNORM_SRGB;
+            case 135: return nvrhi::Format::BC2_UNORM;
+            case 136: return nvrhi::Format::BC2_UNORM_SRGB;
+            case 137: return nvrhi::Format::BC3_UNORM;
+            case 138: return nvrhi::Format::BC3_UNORM_SRGB;
+            case 139: return nvrhi::Format::BC4_UNORM;
+            case 140: return nvrhi::Format::BC4_SNORM;
+            case 141: return nvrhi::Format::BC5_UNORM;
+            case 142: return nvrhi::Format::BC5_SNORM;
+            case 143: return nvrhi::Format::BC6H_UFLOAT;
+            case 144: return nvrhi::Format::BC6H_SFLOAT;
+            case 145: return nvrhi::Format::BC7_UNORM;
+            case 146: return nvrhi::Format::BC7_UNORM_SRGB;
+            default: return nvrhi::Format::UNKNOWN;
+            }
+        }
+
+        nvrhi::Format FormatFromDDSPixelFormat(const u8 *pixelFormat)
+        {
+            const u32 flags = ReadValue<u32>(pixelFormat + 4);
+            const u32 fourCC = ReadValue<u32>(pixelFormat + 8);
+
+            if (flags & kDDSFlagFourCC)
+            {
+                switch (fourCC)
+                {
+                case MakeFourCC('D', 'X', 'T', '1'): return nvrhi::Format::BC1_UNORM;
+                case MakeFourCC('D', 'X', 'T', '2'):
+                case MakeFourCC('D', 'X', 'T', '3'): return nvrhi::Format::BC2_UNORM;
+                case MakeFourCC('D', 'X', 'T', '4'):
+                case MakeFourCC('D', 'X', 'T', '5'): return nvrhi::Format::BC3_UNORM;
+                case MakeFourCC('A', 'T', 'I', '1'):
+                case MakeFourCC('B', 'C', '4', 'U'): return nvrhi::Format::BC4_UNORM;
+                case MakeFourCC('B', 'C', '4', 'S'): return nvrhi::Format::BC4_SNORM;
+                case MakeFourCC('A', 'T', 'I', '2'):
+                case MakeFourCC('B', 'C', '5', 'U'): return nvrhi::Format::BC5_UNORM;
+                case MakeFourCC('B', 'C', '5', 'S'): return nvrhi::Format::BC5_SNORM;
+                case 113: return nvrhi::Format::RGBA16_FLOAT; // D3DFMT_A16B16G16R16F
+                case 116: return nvrhi::Format::RGBA32_FLOAT; // D3DFMT_A32B32G32R32F
+                default: return nvrhi::Format::UNKNOWN;
+                }
+            }
+
+            if (flags & kDDSFlagRGB)
+            {
+                const u32 bitCount = ReadValue<u32>(pixelFormat + 12);
+                const u32 redMask = ReadValue<u32>(pixelFormat + 16);
+                if (bitCount == 32 && redMask == 0x000000ff)
+                    return nvrhi::Format::RGBA8_UNORM;
+                if (bitCount == 32 && redMask == 0x00ff0000)
+                    return nvrhi::Format::BGRA8_UNORM;
+            }
+
+            return nvrhi::Format::UNKNOWN;
+        }
+
+        void FillLevel(TextureContainerLevel &level, nvrhi::Format format, u32 width, u32 height)
+        {
+            const nvrhi::FormatInfo &formatInfo = nvrhi::getFormatInfo(format);
+            const u32 blockSize = std::max<u32>(1, formatInfo.blockSize);
+
+            level.width = width;
+            level.height = height;
+            level.rowPitch = ((width + blockSize - 1) / blockSize) * formatInfo.bytesPerBlock;
+            level.uncompressedSize = static_cast<u64>(level.rowPitch) * ((height + blockSize - 1) / blockSize);
+        }
+
+        // a full chain ends at 1x1, floor(log2(max(w, h))) + 1 levels
+        u32 MaxMipCount(u32 width, u32 height)
+        {
+            return static_cast<u32>(std::bit_width(std::max(width, height)));
+        }
+
+        bool ParseDDS(const u8 *data, u64 size, TextureContainerInfo &outInfo)
+        {
+            if (size < 4 + kDDSHeaderSize || ReadValue<u32>(data + 4) != kDDSHeaderSize)
+                return false;
+
+            const u8 *header = data + 4;
+            const u32 height = ReadValue<u32>(header + 8);
+            const u32 width = ReadValue<u32>(header + 12);
+            const u32 mipCount = std::max(1u, ReadValue<u32>(header + 24));
+            const u8 *pixelFormat = header + 72;
+            const u32 caps2 = ReadValue<u32>(header + 108);
+
+            if (caps2 & (kDDSCaps2Cubemap | kDDSCaps2Volume))
+            {
+                LOG_ERROR("[Texture Container] Only 2D DDS textures are supported");
+                return false;
+            }
+
+            u64 offset = 4 + kDDSHeaderSize;
+            nvrhi::Format format = nvrhi::Format::UNKNOWN;
+
+            if ((ReadValue<u32>(pixelFormat + 4) & kDDSFlagFourCC) && ReadValue<u32>(pixelFormat + 8) == kDDSFourCCDX10)
+            {
+                if (size < offset + kDDSDX10HeaderSize)
+                    return false;
+
+                const u8 *dx10 = data + offset;
+                format = FormatFromDXGI(ReadValue<u32>(dx10));
+                const u32 resourceDimension = ReadValue<u32>(dx10 + 4);
+                const u32 miscFlags = ReadValue<u32>(dx10 + 8);
+                const u32 arraySize = ReadValue<u32>(dx10 + 12);
+
+                // 3 = TEXTURE2D, 0x4 = TEXTURECUBE
+                if (resourceDimension != 3 || (miscFlags & 0x4) || arraySize > 1)
+                {
+                    LOG_ERROR("[Texture Container] Only 2D DDS textures are supported");
+                    return false;
+                }
+
+                offset += kDDSDX10HeaderSize;
+            }
+            else
+            {
+                format = FormatFromDDSPixelFormat(pixelFormat);
+            }
+
+            if (format == nvrhi::Format::UNKNOWN)
+            {
+                LOG_ERROR("[Texture Container] Unsupported DDS pixel format");
+                return false;
+            }
+
+            if (width == 0 || height == 0 || mipCount > MaxMipCount(width, height))
+            {
+                LOG_ERROR("[Texture Container] Invalid DDS dimensions {}x{} with {} mips", width, height, mipCount);
+                return false;
+            }
+
+            outInfo.type = TextureContainerType::DDS;
+            outInfo.format = format;
+            outInfo.width = width;
+            outInfo.height = height;
+            outInfo.supercompression = Supercompression::None;
+            outInfo.levels.resize(mipCount);
+
+            // levels are stored back to back, largest first
+            for (u32 mip = 0; mip < mipCount; ++mip)
+            {
+                TextureContainerLevel &level = outInfo.levels[mip];
+                FillLevel(level, format, std::max(1u, width >> mip), std::max(1u, height >> mip));
+                level.offset = offset;
+                level.byteSize = level.uncompressedSize;
+                offset += level.byteSize;
+            }
+
+            return true;
+        }
+
+        bool ParseKTX2(const u8 *data, u64 size, TextureContainerInfo &outInfo)
+        {
+            if (size < kKTX2HeaderSize)
+                return false;
+
+            const u32 vkFormat = ReadValue<u32>(data + 12);
+            const u32 width = ReadValue<u32>(data + 20);
+            const u32 height = ReadValue<u32>(data + 24);
+            const u32 depth = ReadValue<u32>(data + 28);
+            const u32 layerCount = ReadValue<u32>(data + 32);
+            const u32 faceCount = ReadValue<u32>(data + 36);
+            const u32 levelCount = std::max(1u, ReadValue<u32>(data + 40));
+            const u32 scheme = ReadValue<u32>(data + 44);
+
+            if (depth > 1 || layerCount > 1 || faceCount != 1 || height == 0)
+            {
+                LOG_ERROR("[Texture Container] Only 2D KTX2 textures are supported");
+                return false;
+            }
+
+            if (width == 0 || levelCount > MaxMipCount(width, height))
+            {
+                LOG_ERROR("[Texture Container] Invalid KTX2 dimensions {}x{} with {} levels", width, height, levelCount);
+                return false;
+            }
+
+            const nvrhi::Format format = FormatFromVulkan(vkFormat);
+            if (format == nvrhi::Format::UNKNOWN)
+            {
+                LOG_ERROR("[Texture Container] Unsupported KTX2 vkFormat {}", vkFormat);
+                return false;
+            }
+
+            const Supercompression supercompression = static_cast<Supercompression>(scheme);
+            if (supercompression != Supercompression::None && supercompression != Supercompression::Zlib)
+            {
+                LOG_ERROR("[Texture Container] Unsupported KTX2 supercompression scheme {}", scheme);
+                return false;
+            }
+
+            if (size < kKTX2HeaderSize + static_cast<u64>(levelCount) * kKTX2LevelIndexEntrySize)
+                return false;
+
+            outInfo.type = TextureContainerType::KTX2;
+            outInfo.format = format;
+            outInfo.width = width;
+            outInfo.height = height;
+            outInfo.supercompression = supercompression;
+            outInfo.levels.resize(levelCount);
+
+            for (u32 mip = 0; mip < levelCount; ++mip)
+            {
+                const u8 *entry = data + kKTX2HeaderSize + mip * kKTX2LevelIndexEntrySize;
+
+                TextureContainerLevel &level = outInfo.levels[mip];
+                FillLevel(level, format, std::max(1u, width >> mip), std::max(1u, height >> mip));
+                level.offset = ReadValue<u64>(entry);
+                level.byteSize = ReadValue<u64>(entry + 8);
+
+                if (ReadValue<u64>(entry + 16) != level.uncompressedSize)
+                {
+                    LOG_ERROR("[Texture Container] KTX2 level {} has an unexpected size", mip);
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    bool TextureContainer::IsContainerFile(const std::filesystem::path &filepath)
+    {
+        const std::string extension = filepath.extension().generic_string();
+        return extension == ".dds" || extension == ".DDS" || extension == ".ktx2" || extension == ".KTX2";
+    }
+
+    bool TextureContainer::ReadInfo(const std::filesystem::path &filepath, TextureContainerInfo &outInfo)
+    {
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            LOG_ERROR("[Texture Container] Failed to open {}", filepath.generic_string());
+            return false;
+        }
+
+        const u64 fileSize = static_cast<u64>(file.tellg());
+        const u64 readSize = std::min(fileSize, kHeaderReadSize);
+
+        std::vector<u8> header(readSize);
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(header.data()), static_cast<std::streamsize>(readSize));
+
+        if (!file || !ParseInfo(header.data(), readSize, outInfo))
+        {
+            LOG_ERROR("[Texture Container] Invalid container {}", filepath.generic_string());
+            return false;
+        }
+
+        for (const TextureContainerLevel &level : outInfo.levels)
+        {
+            if (level.offset + level.byteSize > fileSize)
+            {
+                LOG_ERROR("[Texture Container] Truncated container {}", filepath.generic_string());
+                return false;
+            }
+        }
+
+        outInfo.filepath = filepath;
+        return true;
+    }
+
+    bool TextureContainer::ParseInfo(const u8 *data, u64 size, TextureContainerInfo &outInfo)
+    {
+        if (size >= sizeof(kKTX2Identifier) && std::memcmp(data, kKTX2Identifier, sizeof(kKTX2Identifier)) == 0)
+            return ParseKTX2(data, size, outInfo);
+
+        if (size >= 4 && ReadValue<u32>(data) == kDDSMagic)
+            return ParseDDS(data, size, outInfo);
+
+        return false;
+    }
+
+    bool TextureContainer::ReadLevel(const TextureContainerInfo &info, u32 mip, TextureLevelData &outData)
+    {
+        if (mip >= info.levels.size())
+            return false;
+
+        const TextureContainerLevel &level = info.levels[mip];
+
+        std::ifstream file(info.filepath, std::ios::binary);
+        if (!file)
+            return false;
+
+        TextureLevelData payload(level.byteSize);
+        file.seekg(static_cast<std::streamoff>(level.offset));
+        file.read(reinterpret_cast<char *>(payload.data()), static_cast<std::streamsize>(level.byteSize));
+        if (!file)
+        {
+            LOG_ERROR("[Texture Container] Failed to read level {} of {}", mip, info.filepath.generic_string());
+            return false;
+        }
+
+        if (info.supercompression == Supercompression::None)
+        {
+            outData = std::move(payload);
+            return outData.size() == level.uncompressedSize;
+        }
+
+        return DecodeLevel(info, mip, payload.data(), payload.size(), outData);
+    }
+
+    bool TextureContainer::DecodeLevel(const TextureContainerInfo &info, u32 mip, const u8 *payload, u64 payloadSize, TextureLevelData &outData)
+    {
+        if (mip >= info.levels.size())
+            return false;
+
+        const TextureContainerLevel &level = info.levels[mip];
+        outData.resize(level.uncompressedSize);
+
+        switch (info.supercompression)
+        {
+        case Supercompression::None:
+        {
+            if (payloadSize != level.uncompressedSize)
+                return false;
+
+            std::memcpy(outData.data(), payload, payloadSize);
+            return true;
+        }
+        case Supercompression::Zlib:
+        {
+            if (!Compression::InflateZlib(payload, payloadSize, outData.data(), outData.size()))
+            {
+                LOG_ERROR("[Texture Container] Corrupted zlib payload in level {} of {}", mip, info.filepath.generic_string());
+                return false;
+            }
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    bool TextureContainer::WriteDDS(const std::filesystem::path &filepath, const CompressedTexture &texture)
+    {
+        const u32 dxgiFormat = FormatToDXGI(texture.format);
+        if (!texture.IsValid() || dxgiFormat == 0)
+            return false;
+
+        std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            LOG_ERROR("[Texture Container] Failed to write {}", filepath.generic_string());
+            return false;
+        }
+
+        u8 header[4 + kDDSHeaderSize + kDDSDX10HeaderSize] = {};
+        auto write = [&header](u32 offset, u32 value) { std::memcpy(header + offset, &value, sizeof(u32)); };
+
+        write(0, kDDSMagic);
+        write(4, kDDSHeaderSize);
+        write(8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000); // caps, height, width, pixel format, mip count, linear size
+        write(12, texture.height);
+        write(16, texture.width);
+        write(20, static_cast<u32>(texture.mips[0].size));
+        write(28, static_cast<u32>(texture.mips.size()));
+        write(76, 32); // pixel format size
+        write(80, kDDSFlagFourCC);
+        write(84, kDDSFourCCDX10);
+        write(108, 0x1000 | 0x400000 | 0x8); // texture, mipmap, complex
+
+        write(128, dxgiFormat);
+        write(132, 3); // TEXTURE2D
+        write(140, 1); // array size
+
+        file.write(reinterpret_cast<const char *>(header), sizeof(header));
+        for (u32 mip = 0; mip < texture.mips.size(); ++mip)
+            file.write(reinterpret_cast<const char *>(texture.GetMipData(mip)), static_cast<std::streamsize>(texture.mips[mip].size));
+
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+#include "ignite/core/memory.hpp"
+#include "texture_compressor.hpp"
+
+#include <nvrhi/nvrhi.h>
+
+#include <filesystem>
+#include <vector>
+
+namespace ignite
+{
+    enum class TextureContainerType : u8
+    {
+        Unknown,
+        DDS,
+        KTX2
+    };
+
+    // KTX2 supercompression schemes
+    enum class Supercompression : u32
+    {
+        None = 0,
+        BasisLZ = 1,
+        Zstd = 2,
+        Zlib = 3
+    };
+
+    struct TextureContainerLevel
+    {
+        u32 width = 0;
+        u32 height = 0;
+        u32 rowPitch = 0;
+        u64 offset = 0; // file offset of the stored payload
+        u64 byteSize = 0; // stored payload size
+        u64 uncompressedSize = 0;
+    };
+
+    // parsed header and level index, pixel data is read per level on demand
+    struct TextureContainerInfo
+    {
+        TextureContainerType type = TextureContainerType::Unknown;
+        nvrhi::Format format = nvrhi::Format::UNKNOWN;
+        u32 width = 0;
+        u32 height = 0;
+        Supercompression supercompression = Supercompression::None;
+        std::vector<TextureContainerLevel> levels; // level 0 is the full resolution
+        std::filesystem::path filepath;
+
+        u32 GetMipLevels() const { return static_cast<u32>(levels.size()); }
+        bool IsValid() const { return format != nvrhi::Format::UNKNOWN && !levels.empty(); }
+    };
+
+    // decoded pixels of one level, counted under MemoryTag::Assets
+    using TextureLevelData = TrackedVector<u8, MemoryTag::Assets>;
+
+    // DDS (legacy and DX10 header) and KTX2 readers for 2D textures with pre-built mip chains.
+    // KTX2 zlib supercompression is decoded, Zstd and BasisLZ payloads are rejected.
+    class TextureContainer
+    {
+    public:
+        static bool IsContainerFile(const std::filesystem::path &filepath);
+
+        // reads only the header and level index
+        static bool ReadInfo(const std::filesystem::path &filepath, TextureContainerInfo &outInfo);
+        static bool ParseInfo(const u8 *data, u64 size, TextureContainerInfo &outInfo);
+
+        // reads and decodes one level into tightly packed rows of blocks
+        static bool ReadLevel(const TextureContainerInfo &info, u32 mip, TextureLevelData &outData);
+        static bool DecodeLevel(const TextureContainerInfo &info, u32 mip, const u8 *payload, u64 payloadSize, TextureLevelData &outData);
+
+        // writes a DX10 DDS, used to bake compressed textures for streaming
+        static bool WriteDDS(const std::filesystem::path &filepath, const CompressedTexture &texture);
+    };
+}
@@ -0,0 +1,455 @@
+#include "texture_streamer.hpp"
+
+#include "ignite/core/application.hpp"
+#include "ignite/core/logger.hpp"
+#include "ignite/core/memory.hpp"
+#include "ignite/core/job_system.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+
+namespace ignite
+{
+    namespace
+    {
+        constexpr u32 kTailSize = 128; // mips up to this size are loaded with the texture
+        constexpr u32 kMaxPendingReads = 4;
+        constexpr u64 kFeedbackTimeoutFrames = 120;
+        constexpr u32 kNoMip = ~0u;
+
+        struct StreamedTexture
+        {
+            std::weak_ptr<Texture> texture;
+            Ref<const TextureContainerInfo> info;
+
+            u32 tailMip = 0;
+            u32 requestedMip = 0; // textures without feedback stay fully resident
+            u32 frameRequestedMip = kNoMip;
+            u32 pendingMip = kNoMip;
+            u64 lastRequestFrame = 0;
+            bool hasFeedback = false;
+        };
+
+        struct ReadJob
+        {
+            u64 id = 0;
+            u32 mip = 0;
+            Ref<const TextureContainerInfo> info;
+        };
+
+        struct ReadResult
+        {
+            u64 id = 0;
+            u32 mip = 0;
+            TextureLevelData data;
+            bool success = false;
+        };
+
+        struct TextureStreamerData
+        {
+            std::mutex mutex;
+            std::unordered_map<u64, StreamedTexture> entries;
+            std::unordered_map<std::string, u64> paths; // resolved path -> entry id
+            u64 nextID = 1;
+            u64 frame = 0;
+
+            // reads run as jobs, their results wait here for SyncMainThread
+            std::mutex queueMutex;
+            std::vector<ReadResult> results;
+            JobCounter reads;
+            std::atomic<bool> running = true;
+
+            std::atomic<u64> budget = TEXTURE_STREAMER_DEFAULT_BUDGET;
+            std::atomic<u64> memoryUsage = 0;
+            std::atomic<u64> residencyVersion = 0;
+        };
+
+        TextureStreamerData &GetData()
+        {
+            static TextureStreamerData data;
+            return data;
+        }
+
+        u64 ResidentBytes(const TextureContainerInfo &info, u32 firstMip)
+        {
+            u64 size = 0;
+            for (u32 mip = firstMip; mip < info.GetMipLevels(); ++mip)
+                size += info.levels[mip].uncompressedSize;
+            return size;
+        }
+
+        nvrhi::TextureHandle CreateHandle(nvrhi::IDevice *device, const TextureContainerInfo &info, u32 firstMip)
+        {
+            const TextureContainerLevel &level = info.levels[firstMip];
+
+            const auto &textureDesc = nvrhi::TextureDesc()
+                .setDimension(nvrhi::TextureDimension::Texture2D)
+                .setWidth(level.width)
+                .setHeight(level.height)
+                .setFormat(info.format)
+                .setInitialState(nvrhi::ResourceStates::ShaderResource)
+                .setKeepInitialState(true)
+                .setMipLevels(info.GetMipLevels() - firstMip)
+                .setDebugName(info.filepath.generic_string());
+
+            return device->createTexture(textureDesc);
+        }
+
+        void ReadLevel(TextureStreamerData &data, const ReadJob &job)
+        {
+            if (!data.running)
+                return;
+
+            ReadResult result;
+            result.id = job.id;
+            result.mip = job.mip;
+            result.success = TextureContainer::ReadLevel(*job.info, job.mip, result.data);
+
+            std::lock_guard lock(data.queueMutex);
+            if (data.running)
+                data.results.push_back(std::move(result));
+        }
+    }
+
+    Ref<Texture> TextureStreamer::Load(const std::filesystem::path &filepath, const TextureCreateInfo &createInfo)
+    {
+        std::error_code ec;
+        std::filesystem::path resolvedPath = std::filesystem::weakly_canonical(filepath, ec);
+        if (ec)
+            resolvedPath = std::filesystem::absolute(filepath);
+
+        const std::string pathKey = resolvedPath.generic_string();
+
+        TextureStreamerData &data = GetData();
+        {
+            std::lock_guard lock(data.mutex);
+            if (auto pathIt = data.paths.find(pathKey); pathIt != data.paths.end())
+            {
+                if (auto entryIt = data.entries.find(pathIt->second); entryIt != data.entries.end())
+                {
+                    if (Ref<Texture> texture = entryIt->second.texture.lock())
+                        return texture;
+                }
+            }
+        }
+
+        Ref<TextureContainerInfo> info = CreateRef<TextureContainerInfo>();
+        if (!TextureContainer::ReadInfo(resolvedPath, *info))
+            return nullptr;
+
+        nvrhi::IDevice *device = Application::GetRenderDevice();
+        if ((device->queryFormatSupport(info->format) & nvrhi::FormatSupport::Texture) == nvrhi::FormatSupport::None)
+        {
+            LOG_ERROR("[Texture Streamer] Format of {} is not supported by the device", pathKey);
+            return nullptr;
+        }
+
+        // smallest mips are always resident
+        const u32 levelCount = info->GetMipLevels();
+        u32 tailMip = 0;
+        while (tailMip + 1 < levelCount && std::max(info->levels[tailMip].width, info->levels[tailMip].height) > kTailSize)
+            ++tailMip;
+
+        std::vector<TextureLevelData> levels(levelCount - tailMip);
+        for (u32 mip = tailMip; mip < levelCount; ++mip)
+        {
+            if (!TextureContainer::ReadLevel(*info, mip, levels[mip - tailMip]))
+                return nullptr;
+        }
+
+        Ref<Texture> texture = CreateRef<Texture>();
+        texture->m_CreateInfo = createInfo;
+        texture->m_CreateInfo.format = info->format;
+        texture->m_CreateInfo.width = static_cast<i32>(info->width);
+        texture->m_CreateInfo.height = static_cast<i32>(info->height);
+        texture->m_CreateInfo.mipLevels = levelCount;
+        texture->m_Filepath = filepath;
+        texture->m_ResidentMip = tailMip;
+
+        texture->m_Handle = CreateHandle(device, *info, tailMip);
+        LOG_ASSERT(texture->m_Handle, "Failed to create texture");
+
+        const auto samplerDesc = nvrhi::SamplerDesc()
+            .setAllAddressModes(nvrhi::SamplerAddressMode::Repeat)
+            .setAllFilters(true);
+
+        texture->m_Sampler = device->createSampler(samplerDesc);
+        LOG_ASSERT(texture->m_Sampler, "Failed to create texture sampler");
+
+        nvrhi::CommandListHandle commandList = device->createCommandList();
+        commandList->open();
+        for (u32 mip = tailMip; mip < levelCount; ++mip)
+            commandList->writeTexture(texture->m_Handle, 0, mip - tailMip, levels[mip - tailMip].data(), info->levels[mip].rowPitch);
+        commandList->close();
+        device->executeCommandList(commandList);
+
+        LOG_INFO("[Texture Streamer] Loaded {} ({}x{}, {} mips, {} resident)", pathKey, info->width, info->height, levelCount, levelCount - tailMip);
+
+        {
+            std::lock_guard lock(data.mutex);
+
+            StreamedTexture entry;
+            entry.texture = texture;
+            entry.info = info;
+            entry.tailMip = tailMip;
+
+            texture->m_StreamID = data.nextID++;
+            data.entries[texture->m_StreamID] = std::move(entry);
+            data.paths[pathKey] = texture->m_StreamID;
+        }
+
+        return texture;
+    }
+
+    void TextureStreamer::RequestMip(const Ref<Texture> &texture, u32 mip)
+    {
+        if (!texture || !texture->IsStreamed())
+            return;
+
+        TextureStreamerData &data = GetData();
+        std::lock_guard lock(data.mutex);
+
+        auto it = data.entries.find(texture->m_StreamID);
+        if (it == data.entries.end())
+            return;
+
+        it->second.frameRequestedMip = std::min(it->second.frameRequestedMip, mip);
+        it->second.lastRequestFrame = data.frame;
+    }
+
+    u32 TextureStreamer::ComputeRequestedMip(const Ref<Texture> &texture, f32 screenPixels)
+    {
+        if (!texture)
+            return 0;
+
+        const u32 lastMip = texture->GetMipLevels() > 0 ? texture->GetMipLevels() - 1 : 0;
+        if (screenPixels < 1.0f)
+            return lastMip;
+
+        const f32 texels = static_cast<f32>(std::max(texture->GetWidth(), texture->GetHeight()));
+        const f32 mip = std::floor(std::log2(texels / screenPixels));
+        if (mip <= 0.0f)
+            return 0;
+
+        return std::min(static_cast<u32>(mip), lastMip);
+    }
+
+    void TextureStreamer::SyncMainThread(nvrhi::ICommandList *commandList, nvrhi::IDevice *device)
+    {
+        TextureStreamerData &data = GetData();
+
+        std::vector<ReadResult> results;
+        {
+            std::lock_guard lock(data.queueMutex);
+            results.swap(data.results);
+        }
+
+        std::lock_guard lock(data.mutex);
+        data.frame++;
+
+        bool commandListOpen = false;
+
+        // copy the resident levels into a texture starting at firstMip, the old handle
+        // stays alive until the command list has executed
+        auto reallocate = [&](const TextureContainerInfo &info, Texture &texture, u32 firstMip, const TextureLevelData *newLevel)
+        {
+            if (!commandListOpen)
+            {
+                commandList->open();
+                commandListOpen = true;
+            }
+
+            nvrhi::TextureHandle handle = CreateHandle(device, info, firstMip);
+            const u32 oldFirstMip = texture.m_ResidentMip;
+
+            for (u32 mip = std::max(oldFirstMip, firstMip); mip < info.GetMipLevels(); ++mip)
+            {
+                commandList->copyTexture(handle, nvrhi::TextureSlice().setMipLevel(mip - firstMip),
+                    texture.m_Handle, nvrhi::TextureSlice().setMipLevel(mip - oldFirstMip));
+            }
+
+            if (newLevel)
+                commandList->writeTexture(handle, 0, 0, newLevel->data(), info.levels[firstMip].rowPitch);
+
+            texture.m_Handle = handle;
+            texture.m_ResidentMip = firstMip;
+            data.residencyVersion++;
+        };
+
+        for (ReadResult &result : results)
+        {
+            auto it = data.entries.find(result.id);
+            if (it == data.entries.end())
+                continue;
+
+            StreamedTexture &entry = it->second;
+            entry.pendingMip = kNoMip;
+
+            Ref<Texture> texture = entry.texture.lock();
+            if (!texture)
+                continue;
+
+            if (!result.success)
+            {
+                LOG_WARN("[Texture Streamer] Failed to stream mip {} of {}", result.mip, entry.info->filepath.generic_string());
+                continue;
+            }
+
+            // the texture was trimmed while the read was in flight
+            if (result.mip + 1 != texture->m_ResidentMip)
+                continue;
+
+            reallocate(*entry.info, *texture, result.mip, &result.data);
+        }
+
+        u64 memoryUsage = 0;
+        FrameVector<std::pair<StreamedTexture *, Ref<Texture>>> resident;
+        resident.reserve(data.entries.size());
+
+        for (auto it = data.entries.begin(); it != data.entries.end();)
+        {
+            StreamedTexture &entry = it->second;
+            Ref<Texture> texture = entry.texture.lock();
+            if (!texture)
+            {
+                it = data.entries.erase(it);
+                continue;
+            }
+
+            // requests of the previous frame, or back to the tail once they stop arriving
+            if (entry.frameRequestedMip != kNoMip)
+            {
+                entry.requestedMip = std::min(entry.frameRequestedMip, entry.tailMip);
+                entry.frameRequestedMip = kNoMip;
+                entry.hasFeedback = true;
+            }
+            else if (entry.hasFeedback && data.frame - entry.lastRequestFrame > kFeedbackTimeoutFrames)
+            {
+                entry.requestedMip = entry.tailMip;
+            }
+
+            memoryUsage += ResidentBytes(*entry.info, texture->m_ResidentMip);
+            resident.emplace_back(&entry, std::move(texture));
+            ++it;
+        }
+
+        const u64 budget = data.budget;
+
+        // over budget, drop the top mip of textures resident beyond their request, least recently requested first
+        if (memoryUsage > budget)
+        {
+            std::sort(resident.begin(), resident.end(), [](const auto &a, const auto &b)
+            {
+                return a.first->lastRequestFrame < b.first->lastRequestFrame;
+            });
+
+            for (auto &[entry, texture] : resident)
+            {
+                if (memoryUsage <= budget)
+                    break;
+
+                if (texture->m_ResidentMip >= entry->requestedMip || texture->m_ResidentMip >= entry->tailMip)
+                    continue;
+
+                memoryUsage -= entry->info->levels[texture->m_ResidentMip].uncompressedSize;
+                reallocate(*entry->info, *texture, texture->m_ResidentMip + 1, nullptr);
+            }
+        }
+
+        // queue the next level of the textures furthest from their request
+        std::sort(resident.begin(), resident.end(), [](const auto &a, const auto &b)
+        {
+            const i64 gapA = static_cast<i64>(a.second->m_ResidentMip) - static_cast<i64>(a.first->requestedMip);
+            const i64 gapB = static_cast<i64>(b.second->m_ResidentMip) - static_cast<i64>(b.first->requestedMip);
+            return gapA != gapB ? gapA > gapB : a.first->lastRequestFrame > b.first->lastRequestFrame;
+        });
+
+        u32 pendingReads = 0;
+        u64 pendingBytes = 0;
+        for (auto &[entry, texture] : resident)
+        {
+            if (entry->pendingMip != kNoMip)
+            {
+                pendingReads++;
+                pendingBytes += entry->info->levels[entry->pendingMip].uncompressedSize;
+            }
+        }
+
+        FrameVector<ReadJob> jobs;
+        jobs.reserve(kMaxPendingReads);
+        for (auto &[entry, texture] : resident)
+        {
+            if (pendingReads >= kMaxPendingReads)
+                break;
+
+            if (entry->pendingMip != kNoMip || texture->m_ResidentMip <= entry->requestedMip)
+                continue;
+
+            const u32 mip = texture->m_ResidentMip - 1;
+            const u64 levelBytes = entry->info->levels[mip].uncompressedSize;
+            if (memoryUsage + pendingBytes + levelBytes > budget)
+                continue;
+
+            entry->pendingMip = mip;
+            pendingReads++;
+            pendingBytes += levelBytes;
+            jobs.push_back({ texture->m_StreamID, mip, entry->info });
+        }
+
+        // file reads on the shared job system, at most kMaxPendingReads in flight
+        for (ReadJob &job : jobs)
+            JobSystem::Run([&data, job = std::move(job)]() { ReadLevel(data, job); }, &data.reads);
+
+        if (commandListOpen)
+        {
+            commandList->close();
+            device->executeCommandList(commandList);
+        }
+
+        data.memoryUsage = memoryUsage;
+    }
+
+    void TextureStreamer::Shutdown()
+    {
+        TextureStreamerData &data = GetData();
+        {
+            std::lock_guard lock(data.queueMutex);
+            data.running = false;
+            data.results.clear();
+        }
+
+        // reads not started yet return right away
+        JobSystem::Wait(data.reads);
+
+        std::lock_guard lock(data.mutex);
+        data.entries.clear();
+        data.paths.clear();
+        data.memoryUsage = 0;
+
+        // nothing is in flight anymore, textures loaded after this stream again
+        data.running = true;
+    }
+
+    void TextureStreamer::SetBudget(u64 bytes)
+    {
+        GetData().budget = bytes;
+    }
+
+    u64 TextureStreamer::GetBudget()
+    {
+        return GetData().budget;
+    }
+
+    u64 TextureStreamer::GetMemoryUsage()
+    {
+        return GetData().memoryUsage;
+    }
+
+    u64 TextureStreamer::GetResidencyVersion()
+    {
+        return GetData().residencyVersion;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "texture.hpp"
+#include "texture_container.hpp"
+
+#include "ignite/core/types.hpp"
+
+#include <nvrhi/nvrhi.h>
+
+#include <filesystem>
+
+namespace ignite
+{
+#define TEXTURE_STREAMER_DEFAULT_BUDGET (256ull * 1024ull * 1024ull)
+
+    // Mip residency for textures stored in DDS/KTX2 containers.
+    // Load uploads only the smallest mips, the larger ones are read on a background thread
+    // and made resident in SyncMainThread as long as the memory budget allows.
+    // The renderer reports the finest mip it needs each frame with RequestMip,
+    // textures that stop receiving requests fall back to their smallest mips.
+    class TextureStreamer
+    {
+    public:
+        // returns a texture with only the tail mips resident, nullptr if the container is invalid
+        static Ref<Texture> Load(const std::filesystem::path &filepath, const TextureCreateInfo &createInfo);
+
+        // finest mip needed this frame, requests within a frame keep the lowest mip
+        static void RequestMip(const Ref<Texture> &texture, u32 mip);
+
+        // mip whose texel density matches a texture covering screenPixels along its larger side
+        static u32 ComputeRequestedMip(const Ref<Texture> &texture, f32 screenPixels);
+
+        // apply finished reads, evict and queue the next levels, called once per frame
+        static void SyncMainThread(nvrhi::ICommandList *commandList, nvrhi::IDevice *device);
+
+        static void Shutdown();
+
+        static void SetBudget(u64 bytes);
+        static u64 GetBudget();
+        static u64 GetMemoryUsage();
+
+        // increments whenever a texture handle is replaced, binding sets must be rebuilt
+        static u64 GetResidencyVersion();
+    };
+}
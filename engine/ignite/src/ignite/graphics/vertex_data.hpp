@@ -19,6 +19,8 @@ namespace ignite
     {
         glm::mat4 transformation;
         glm::mat4 normal;
+        u32 entityID = static_cast<u32>(-1);
+        u32 padding[3] = { 0 };
         glm::mat4 boneTransforms[MAX_BONES];
     };
 
@@ -31,9 +33,8 @@ namespace ignite
         glm::vec4 color;
         u32 boneIDs[VERTEX_MAX_BONES] = { 0 };
         f32 weights[VERTEX_MAX_BONES] = { 0.0f };
-        u32 entityID;
 
-        static std::array<nvrhi::VertexAttributeDesc, 8> GetAttributes()
+        static std::array<nvrhi::VertexAttributeDesc, 7> GetAttributes()
         {
             return 
             {
@@ -71,11 +72,6 @@ namespace ignite
                     .setName("WEIGHTS")
                     .setFormat(nvrhi::Format::RGBA32_FLOAT)
                     .setOffset(offsetof(VertexMesh, weights))
-                    .setElementStride(sizeof(VertexMesh)),
-                nvrhi::VertexAttributeDesc()
-                    .setName("ENTITYID")
-                    .setFormat(nvrhi::Format::R32_UINT)
-                    .setOffset(offsetof(VertexMesh, entityID))
                     .setElementStride(sizeof(VertexMesh))
             };
         }
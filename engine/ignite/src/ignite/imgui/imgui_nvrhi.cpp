@@ -2,6 +2,7 @@
 #include "ignite/core/logger.hpp"
 
 #include "ignite/graphics/renderer.hpp"
+#include "ignite/graphics/gpu_profiler.hpp"
 
 namespace ignite
 {
@@ -159,45 +160,49 @@ namespace ignite
         drawState.indexBuffer.format = sizeof(ImDrawIdx) == 2 ? nvrhi::Format::R16_UINT : nvrhi::Format::R32_UINT;
         drawState.indexBuffer.offset = 0;
 
-        // render command list
-        i32 vtxOffset = 0;
-        i32 idxOffset = 0;
-        for (i32 n = 0; n < drawData->CmdListsCount; ++n)
         {
-            const ImDrawList *cmdList = drawData->CmdLists[n];
+            IGN_GPU_PROFILE_SCOPE(commandList, "ImGui");
 
-            for (i32 i = 0; i < cmdList->CmdBuffer.Size; ++i)
+            // render command list
+            i32 vtxOffset = 0;
+            i32 idxOffset = 0;
+            for (i32 n = 0; n < drawData->CmdListsCount; ++n)
             {
-                const ImDrawCmd *pCmd = &cmdList->CmdBuffer[i];
+                const ImDrawList *cmdList = drawData->CmdLists[n];
 
-                if (pCmd->UserCallback)
-                {
-                    pCmd->UserCallback(cmdList, pCmd);
-                }
-                else
+                for (i32 i = 0; i < cmdList->CmdBuffer.Size; ++i)
                 {
-                    drawState.bindings = { GetBindingSet((nvrhi::ITexture *)pCmd->TextureId) };
-                    LOG_ASSERT(drawState.bindings[0], "Invalid draw state binding");
-
-                    drawState.viewport.scissorRects[0] = nvrhi::Rect(
-                        int(pCmd->ClipRect.x),
-                        int(pCmd->ClipRect.z),
-                        int(pCmd->ClipRect.y),
-                        int(pCmd->ClipRect.w)
-                    );
-
-                    nvrhi::DrawArguments drawArguments;
-                    drawArguments.vertexCount = pCmd->ElemCount;
-                    drawArguments.startVertexLocation = vtxOffset;
-                    drawArguments.startIndexLocation = idxOffset;
-
-                    commandList->setGraphicsState(drawState);
-                    commandList->setPushConstants(invDisplaySize, sizeof(invDisplaySize));
-                    commandList->drawIndexed(drawArguments);
+                    const ImDrawCmd *pCmd = &cmdList->CmdBuffer[i];
+
+                    if (pCmd->UserCallback)
+                    {
+                        pCmd->UserCallback(cmdList, pCmd);
+                    }
+                    else
+                    {
+                        drawState.bindings = { GetBindingSet((nvrhi::ITexture *)pCmd->TextureId) };
+                        LOG_ASSERT(drawState.bindings[0], "Invalid draw state binding");
+
+                        drawState.viewport.scissorRects[0] = nvrhi::Rect(
+                            int(pCmd->ClipRect.x),
+                            int(pCmd->ClipRect.z),
+                            int(pCmd->ClipRect.y),
+                            int(pCmd->ClipRect.w)
+                        );
+
+                        nvrhi::DrawArguments drawArguments;
+                        drawArguments.vertexCount = pCmd->ElemCount;
+                        drawArguments.startVertexLocation = vtxOffset;
+                        drawArguments.startIndexLocation = idxOffset;
+
+                        commandList->setGraphicsState(drawState);
+                        commandList->setPushConstants(invDisplaySize, sizeof(invDisplaySize));
+                        commandList->drawIndexed(drawArguments);
+                    }
+                    idxOffset += pCmd->ElemCount;
                 }
-                idxOffset += pCmd->ElemCount;
+                vtxOffset += cmdList->VtxBuffer.Size;
             }
-            vtxOffset += cmdList->VtxBuffer.Size;
         }
 
         commandList->endMarker();
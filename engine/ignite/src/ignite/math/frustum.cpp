@@ -83,13 +83,13 @@ namespace ignite {
         return true;
     }
 
-    std::vector<std::pair<glm::vec3, glm::vec3>> Frustum::GetEdges() const
+    std::array<std::pair<glm::vec3, glm::vec3>, 12> Frustum::GetEdges() const
     {
         return
-        {
+        {{
             {m_Corners[0], m_Corners[1]}, {m_Corners[1], m_Corners[2]}, {m_Corners[2], m_Corners[3]}, {m_Corners[3], m_Corners[0]},
             {m_Corners[4], m_Corners[5]}, {m_Corners[5], m_Corners[6]}, {m_Corners[6], m_Corners[7]}, {m_Corners[7], m_Corners[4]},
             {m_Corners[0], m_Corners[4]}, {m_Corners[1], m_Corners[5]}, {m_Corners[2], m_Corners[6]}, {m_Corners[3], m_Corners[7]}
-        };
+        }};
     }
 }
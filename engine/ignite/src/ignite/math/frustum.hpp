@@ -2,6 +2,7 @@
 
 #include <glm/glm.hpp>
 #include <array>
+#include <vector>
 
 namespace ignite {
     class Frustum
@@ -26,7 +27,7 @@ namespace ignite {
         bool IsAABBVisible(const glm::vec3 &min, const glm::vec3 &max) const;
         const std::array<glm::vec3, 8> &GetCorners() const { return m_Corners; }
         const std::array<glm::vec4, 6> &GetPlanes() const { return m_Planes; }
-        std::vector<std::pair<glm::vec3, glm::vec3>> GetEdges() const;
+        std::array<std::pair<glm::vec3, glm::vec3>, 12> GetEdges() const;
 
     private:
         std::array<glm::vec4, 6> m_Planes;
@@ -4,9 +4,17 @@
 #include "ignite/scene/component.hpp"
 
 #include "ignite/scene/scene_manager.hpp"
+#include "ignite/core/memory.hpp"
+
+#include <algorithm>
 
 namespace ignite
 {
+    static void *Box2DAllocate(u32 size, i32 alignment)
+    {
+        return MemoryTracker::Allocate(MemoryTag::Physics, size, static_cast<size_t>(alignment));
+    }
+
     Physics2D::Physics2D(Scene *scene)
         : m_Scene(scene)
     {
@@ -18,7 +26,22 @@ namespace ignite
 
     void Physics2D::SimulationStart()
     {
+        // before the first world, box2d frees with the function it allocated with
+        static bool allocatorSet = false;
+        if (!allocatorSet)
+        {
+            b2SetAllocator(Box2DAllocate, MemoryTracker::Free);
+            allocatorSet = true;
+        }
+
         b2WorldDef worldDef = b2DefaultWorldDef();
+        if (JobSystem::IsRunning())
+        {
+            worldDef.workerCount = static_cast<i32>(JobSystem::GetThreadCount());
+            worldDef.enqueueTask = EnqueueTask;
+            worldDef.finishTask = FinishTask;
+            worldDef.userTaskContext = this;
+        }
         m_WorldId = b2CreateWorld(&worldDef);
 
         entt::registry *reg = m_Scene->registry;
@@ -70,6 +93,44 @@ namespace ignite
         m_WorldId = b2_nullWorldId;
     }
 
+    void *Physics2D::EnqueueTask(b2TaskCallback *task, i32 itemCount, i32 minRange, void *taskContext, void *userContext)
+    {
+        Physics2D *physics = static_cast<Physics2D *>(userContext);
+
+        // worker indices only have to be unique among the threads running a task at once
+        const u32 threadCount = JobSystem::GetThreadCount();
+
+        // a small task is still a job of its own, box2d queues each solver worker as a task of a single item
+        const u32 rangeCount = std::clamp(static_cast<u32>(itemCount / std::max(minRange, 1)), 1u, threadCount);
+
+        if (physics->m_TaskCount == PHYSICS_2D_MAX_TASKS)
+        {
+            // box2d takes a null task as done
+            const u32 threadIndex = JobSystem::GetThreadIndex();
+            task(0, itemCount, threadIndex < threadCount ? threadIndex : 0, taskContext);
+            return nullptr;
+        }
+
+        JobCounter &counter = physics->m_Tasks[physics->m_TaskCount++];
+        const i32 itemsPerRange = (itemCount + static_cast<i32>(rangeCount) - 1) / static_cast<i32>(rangeCount);
+
+        for (i32 begin = 0; begin < itemCount; begin += itemsPerRange)
+        {
+            const i32 end = std::min(itemCount, begin + itemsPerRange);
+            JobSystem::Run([task, begin, end, taskContext]()
+            {
+                task(begin, end, JobSystem::GetThreadIndex(), taskContext);
+            }, &counter);
+        }
+
+        return &counter;
+    }
+
+    void Physics2D::FinishTask(void *userTask, void *userContext)
+    {
+        JobSystem::Wait(*static_cast<JobCounter *>(userTask));
+    }
+
     void Physics2D::Instantiate(entt::entity e)
     {
         entt::registry *reg = m_Scene->registry;
@@ -141,6 +202,7 @@ namespace ignite
     void Physics2D::Simulate(f32 deltaTime)
     {
         constexpr i32 subStepCount = 12;
+        m_TaskCount = 0;
         b2World_Step(m_WorldId, deltaTime, subStepCount);
 
         const auto reg = m_Scene->registry;
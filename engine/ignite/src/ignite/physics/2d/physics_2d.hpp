@@ -4,9 +4,14 @@
 #include <box2d/box2d.h>
 #include <entt/entt.hpp>
 #include <ignite/core/types.hpp>
+#include <ignite/core/job_system.hpp>
+
+#include <array>
 
 namespace ignite
 {
+#define PHYSICS_2D_MAX_TASKS 64 // box2d tasks in flight during a step, more run serially
+
     class Scene;
     class Physics2D
     {
@@ -26,7 +31,14 @@ namespace ignite
         void ApplyForce(Rigidbody2D *body, const glm::vec2 &force, const glm::vec2 &point, bool wake);
 
     private:
+        // box2d runs its solver stages through these on the engine JobSystem
+        static void *EnqueueTask(b2TaskCallback *task, i32 itemCount, i32 minRange, void *taskContext, void *userContext);
+        static void FinishTask(void *userTask, void *userContext);
+
         Scene *m_Scene;
         b2WorldId m_WorldId{ b2_nullWorldId };
+
+        std::array<JobCounter, PHYSICS_2D_MAX_TASKS> m_Tasks; // reused every step
+        u32 m_TaskCount = 0;
     };
 }
\ No newline at end of file
@@ -57,7 +57,7 @@ namespace ignite
         bool isEnableSleep       = false;
         b2BodyId bodyId          = {};
 
-        static CompType StaticType() { return CompType_Rigidbody2D; }
+        static constexpr CompType StaticType() { return CompType_Rigidbody2D; }
         virtual CompType GetType() override { return StaticType(); }
     };
 
@@ -74,7 +74,7 @@ namespace ignite
 
         b2ShapeId shapeId{};
 
-        static CompType StaticType() { return CompType_BoxCollider2D; }
+        static constexpr CompType StaticType() { return CompType_BoxCollider2D; }
         virtual CompType GetType() override { return StaticType(); }
     };
 }
\ No newline at end of file
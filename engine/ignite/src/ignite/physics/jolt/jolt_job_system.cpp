@@ -0,0 +1,64 @@
+#include "jolt_job_system.hpp"
+
+#include "ignite/core/job_system.hpp"
+#include "ignite/core/logger.hpp"
+#include "ignite/core/profiler.hpp"
+
+#include <thread>
+
+namespace ignite {
+
+    JoltJobSystem::JoltJobSystem(u32 maxJobs, u32 maxBarriers)
+        : JobSystemWithBarrier(maxBarriers)
+    {
+        m_Jobs.Init(maxJobs, maxJobs);
+    }
+
+    int JoltJobSystem::GetMaxConcurrency() const
+    {
+        return static_cast<int>(ignite::JobSystem::GetThreadCount());
+    }
+
+    JPH::JobSystem::JobHandle JoltJobSystem::CreateJob(const char *inName, JPH::ColorArg inColor, const JobFunction &inJobFunction, JPH::uint32 inNumDependencies)
+    {
+        JPH::uint32 index;
+        while ((index = m_Jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies)) == AvailableJobs::cInvalidObjectIndex)
+        {
+            // every job of the step is in flight, the free list fills up again as they finish
+            LOG_WARN("[Jolt] Out of jobs");
+            std::this_thread::yield();
+        }
+
+        Job *job = &m_Jobs.Get(index);
+        JobHandle handle(job);
+
+        // jobs with dependencies are queued by Jolt once those are done
+        if (inNumDependencies == 0)
+            QueueJob(job);
+
+        return handle;
+    }
+
+    void JoltJobSystem::QueueJob(Job *inJob)
+    {
+        // released once executed, a barrier may run it first and then Execute does nothing
+        inJob->AddRef();
+        ignite::JobSystem::Run([inJob]()
+        {
+            IGN_PROFILE_SCOPE("Jolt Job");
+            inJob->Execute();
+            inJob->Release();
+        });
+    }
+
+    void JoltJobSystem::QueueJobs(Job **inJobs, JPH::uint inNumJobs)
+    {
+        for (JPH::uint i = 0; i < inNumJobs; ++i)
+            QueueJob(inJobs[i]);
+    }
+
+    void JoltJobSystem::FreeJob(Job *inJob)
+    {
+        m_Jobs.DestructObject(inJob);
+    }
+}
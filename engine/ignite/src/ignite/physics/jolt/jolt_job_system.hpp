@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+namespace ignite {
+
+    // Runs Jolt jobs on the engine JobSystem instead of a thread pool of its own.
+    // Jolt keeps the job objects and dependencies, only ready jobs are handed over.
+    class JoltJobSystem final : public JPH::JobSystemWithBarrier
+    {
+    public:
+        JoltJobSystem(u32 maxJobs, u32 maxBarriers);
+
+        int GetMaxConcurrency() const override;
+        JobHandle CreateJob(const char *inName, JPH::ColorArg inColor, const JobFunction &inJobFunction, JPH::uint32 inNumDependencies = 0) override;
+
+    protected:
+        void QueueJob(Job *inJob) override;
+        void QueueJobs(Job **inJobs, JPH::uint inNumJobs) override;
+        void FreeJob(Job *inJob) override;
+
+    private:
+        using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+        AvailableJobs m_Jobs;
+    };
+}
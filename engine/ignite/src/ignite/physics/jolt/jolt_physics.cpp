@@ -1,8 +1,12 @@
 #include "jolt_physics.hpp"
+#include "jolt_job_system.hpp"
 #include "ignite/core/types.hpp"
+#include "ignite/core/memory.hpp"
 
 #include "ignite/scene/scene.hpp"
 
+#include <Jolt/Physics/StateRecorder.h>
+
 namespace ignite
 {
     static constexpr int cMaxPhysicsJobs = 2048;
@@ -15,11 +19,31 @@ namespace ignite
 
     static JoltPhysics *s_JoltInstance = nullptr;
 
+    static void *JoltAllocate(size_t size)
+    {
+        return MemoryTracker::Allocate(MemoryTag::Physics, size);
+    }
+
+    static void *JoltReallocate(void *block, size_t oldSize, size_t newSize)
+    {
+        return block ? MemoryTracker::Reallocate(block, newSize) : JoltAllocate(newSize);
+    }
+
+    static void *JoltAlignedAllocate(size_t size, size_t alignment)
+    {
+        return MemoryTracker::Allocate(MemoryTag::Physics, size, alignment);
+    }
+
     void JoltPhysics::Init()
     {
         s_JoltInstance = new JoltPhysics();
 
-        JPH::RegisterDefaultAllocator();
+        // counted under MemoryTag::Physics
+        JPH::Allocate = JoltAllocate;
+        JPH::Reallocate = JoltReallocate;
+        JPH::Free = MemoryTracker::Free;
+        JPH::AlignedAllocate = JoltAlignedAllocate;
+        JPH::AlignedFree = MemoryTracker::Free;
 
         JPH::Trace = TraceImpl;
         //JPH_IF_ENABLE_ASSERTS(AssertFailed = AssertFailedImpl);
@@ -29,8 +53,8 @@ namespace ignite
         JPH::RegisterTypes();
         
         s_JoltInstance->tempAllocator = std::make_unique<JPH::TempAllocatorImpl>(32 * 1024 * 1024);
-        s_JoltInstance->jobSystem = std::make_unique<JPH::JobSystemThreadPool>(cMaxPhysicsJobs, 8,
-            std::thread::hardware_concurrency() - 1);
+        // shares the engine job system, see JobSystem::Init
+        s_JoltInstance->jobSystem = std::make_unique<JoltJobSystem>(cMaxPhysicsJobs, 8);
 
         LOG_WARN("[Jolt Physics] Initalized");
     }
@@ -175,6 +199,72 @@ namespace ignite
         return m_BodyInterface;
     }
 
+    // StateRecorder over a byte vector, StateRecorderImpl goes through a stringstream
+    class JoltStateBuffer final : public JPH::StateRecorder
+    {
+    public:
+        explicit JoltStateBuffer(std::vector<u8> *data)
+            : m_Data(data)
+        {
+        }
+
+        JoltStateBuffer(const u8 *data, size_t size)
+            : m_ReadData(data), m_ReadSize(size)
+        {
+        }
+
+        void WriteBytes(const void *inData, size_t inNumBytes) override
+        {
+            const size_t offset = m_Data->size();
+            m_Data->resize(offset + inNumBytes);
+            memcpy(m_Data->data() + offset, inData, inNumBytes);
+        }
+
+        void ReadBytes(void *outData, size_t inNumBytes) override
+        {
+            if (m_ReadOffset + inNumBytes > m_ReadSize)
+            {
+                memset(outData, 0, inNumBytes);
+                m_Failed = true;
+                return;
+            }
+
+            memcpy(outData, m_ReadData + m_ReadOffset, inNumBytes);
+            m_ReadOffset += inNumBytes;
+        }
+
+        bool IsEOF() const override { return m_ReadOffset >= m_ReadSize; }
+        bool IsFailed() const override { return m_Failed; }
+
+    private:
+        std::vector<u8> *m_Data = nullptr;
+        const u8 *m_ReadData = nullptr;
+        size_t m_ReadSize = 0;
+        size_t m_ReadOffset = 0;
+        bool m_Failed = false;
+    };
+
+    void JoltScene::SaveState(std::vector<u8> &outData)
+    {
+        // keeps the capacity, the size barely changes between steps
+        outData.clear();
+
+        JoltStateBuffer buffer(&outData);
+        m_PhysicsSystem.SaveState(buffer);
+    }
+
+    bool JoltScene::RestoreState(const std::vector<u8> &data)
+    {
+        JoltStateBuffer buffer(data.data(), data.size());
+        if (!m_PhysicsSystem.RestoreState(buffer))
+        {
+            LOG_ERROR("[Jolt] Failed to restore the physics state");
+            return false;
+        }
+
+        return true;
+    }
+
     void JoltScene::CreateBoxCollider(Entity entity)
     {
         auto &tc = entity.GetComponent<Transform>();
@@ -11,7 +11,6 @@
 #include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Core/JobSystemSingleThreaded.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
@@ -20,6 +19,8 @@
 #include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
 #include <Jolt/Physics/Body/BodyActivationListener.h>
 
+#include <vector>
+
 namespace ignite {
 
     static JPH::Vec3 GlmToJoltVec3(const glm::vec3 &v)
@@ -227,6 +228,10 @@ namespace ignite {
 
         JPH::BodyInterface *GetBodyInterface() const;
 
+        // the whole physics system as bytes, see SimulationRollback
+        void SaveState(std::vector<u8> &outData);
+        bool RestoreState(const std::vector<u8> &data);
+
     private:
         Scene *m_Scene;
         JPH::BodyInterface *m_BodyInterface;
@@ -1,6 +1,9 @@
 ﻿#include "project.hpp"
 #include "ignite/core/string_utils.hpp"
 #include "ignite/core/logger.hpp"
+#include "ignite/graphics/texture_compressor.hpp"
+#include "ignite/graphics/environment_baker.hpp"
+#include "ignite/asset/asset_watcher.hpp"
 
 #include <fstream>
 #include <format>
@@ -96,6 +99,7 @@ namespace {PROJECT_NAME}
         : m_Info(info)
     {
         GenerateProject();
+        m_AssetFileSystem = CreateRef<vfs::IndexedFileSystem>(GetAssetDirectory());
     }
 
     Project::~Project()
@@ -126,19 +130,17 @@ namespace {PROJECT_NAME}
     std::vector<std::pair<AssetHandle, AssetMetaData>> Project::ValidateAssetRegistry()
     {
         std::vector<std::pair<AssetHandle, AssetMetaData>> invalidRegistry;
-        AssetRegistry &assetRegistry = GetAssetManager().GetAssetAssetRegistry();
+        AssetManager &assetManager = GetAssetManager();
+        const AssetRegistry &assetRegistry = assetManager.GetAssetAssetRegistry();
 
-        for (auto it = assetRegistry.begin(); it != assetRegistry.end();)
+        // the registry is never changed while iterating it
+        const std::vector<AssetRegistry::Entry> entries(assetRegistry.begin(), assetRegistry.end());
+        for (const auto &[handle, metadata] : entries)
         {
-            const std::filesystem::path &filepath = GetAssetFilepath(it->second.filepath);
-            if (!std::filesystem::exists(filepath))
+            if (!m_AssetFileSystem->FileExists(metadata.filepath))
             {
-                invalidRegistry.emplace_back(it->first, it->second);
-                it = assetRegistry.erase(it);
-            }
-            else
-            {
-                ++it;
+                invalidRegistry.emplace_back(handle, metadata);
+                assetManager.RemoveAsset(handle);
             }
         }
 
@@ -155,6 +157,16 @@ namespace {PROJECT_NAME}
         Ref<Project> project = CreateRef<Project>(info);
         s_ActiveProject = project.get();
 
+        TextureCompressor::SetCacheDirectory(project->GetCacheDirectory() / "Textures");
+        EnvironmentBaker::SetCacheDirectory(project->GetCacheDirectory() / "Environment");
+
+        // content hashes from the last session, files changed while the editor was closed show up as stale
+        AssetDependencyGraph &graph = project->GetAssetManager().GetDependencyGraph();
+        graph.SetRootDirectory(project->GetAssetDirectory());
+        graph.Load(project->GetCacheDirectory() / ASSET_DEPENDENCY_GRAPH_FILENAME);
+
+        AssetWatcher::Start(project->GetAssetDirectory());
+
         return project;
     }
 
@@ -2,6 +2,7 @@
 
 #include "ignite/asset/asset.hpp"
 #include "ignite/asset/asset_manager.hpp"
+#include "ignite/core/vfs/directory_index.hpp"
 
 #include <string>
 #include <filesystem>
@@ -20,6 +21,7 @@ namespace ignite
         std::filesystem::path assetDirectory = "Assets";
         std::filesystem::path scriptsDirectory = "Scripts";
         std::filesystem::path assetRegistryFilepath = "AssetRegistry.ixreg";
+        std::filesystem::path cacheDirectory = "Cache"; // generated import data, safe to delete
         std::filesystem::path premakeFilepath = "premake5.lua";
         std::filesystem::path batchScriptFilepath = "build.bat";
     };
@@ -62,6 +64,11 @@ namespace ignite
             return GetDirectory() / m_Info.scriptsDirectory;
         }
 
+        std::filesystem::path GetCacheDirectory() const
+        {
+            return GetDirectory() / m_Info.cacheDirectory;
+        }
+
         // Static methods
         static std::filesystem::path GetActiveScriptsDirectory()
         {
@@ -90,7 +97,15 @@ namespace ignite
             return std::static_pointer_cast<T>(asset);
         }
 
+        static AssetLoadHandle LoadAssetAsync(AssetHandle handle, AssetLoadPriority priority = AssetLoadPriority::Normal)
+        {
+            return GetActive()->GetAssetManager().LoadAsync(handle, priority);
+        }
+
         AssetManager &GetAssetManager() { return m_AssetManager; }
+
+        // the asset directory, existence checks and listings come from its cached index
+        const Ref<vfs::IndexedFileSystem> &GetAssetFileSystem() const { return m_AssetFileSystem; }
         ProjectInfo &GetInfo() { return m_Info; }
         const Ref<Scene> &GetActiveScene() { return m_ActiveScene; }
 
@@ -108,6 +123,7 @@ namespace ignite
         ProjectInfo m_Info;
 
         AssetManager m_AssetManager;
+        Ref<vfs::IndexedFileSystem> m_AssetFileSystem;
     };
 
 }
\ No newline at end of file
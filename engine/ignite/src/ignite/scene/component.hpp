@@ -26,21 +26,6 @@ namespace ignite
     class Mesh;
     struct Skeleton;
     
-    static std::unordered_map<std::string, CompType> s_ComponentsName =
-    {
-        { "Camera", CompType_Camera },
-        { "Rigid Body 2D", CompType_Rigidbody2D },
-        { "Box Collider 2D", CompType_BoxCollider2D },
-        { "Sprite 2D", CompType_Sprite2D},
-        { "Mesh Renderer", CompType_MeshRenderer },
-        { "Skinned Mesh", CompType_SkinnedMesh},
-        { "Rigid Body", CompType_Rigidbody},
-        { "Box Collider", CompType_BoxCollider},
-        { "Sphere Collider", CompType_SphereCollider},
-        { "Audio Source", CompType_AudioSource},
-        { "C# Script", CompType_Script},
-    };
-
     enum EntityType : u8
     {
         EntityType_Node,
@@ -113,7 +98,7 @@ namespace ignite
         {
         }
 
-        static CompType StaticType() { return CompType_ID; }
+        static constexpr CompType StaticType() { return CompType_ID; }
         virtual CompType GetType() override { return StaticType(); }
     };
 
@@ -132,7 +117,7 @@ namespace ignite
 
         Camera() = default;
 
-        static CompType StaticType() { return CompType_Camera; }
+        static constexpr CompType StaticType() { return CompType_Camera; }
         virtual CompType GetType() override { return StaticType(); }
     };
 
@@ -220,7 +205,7 @@ namespace ignite
             return glm::translate(glm::mat4(1.0f), translation) * glm::mat4(rotation) * glm::scale(glm::mat4(1.0f), scale);
         }
 
-        static CompType StaticType() { return CompType_Transform; }
+        static constexpr CompType StaticType() { return CompType_Transform; }
         virtual CompType GetType() override { return StaticType(); }
     };
 
@@ -231,7 +216,7 @@ namespace ignite
         glm::vec2 tilingFactor = { 1.0f, 1.0f };
         Ref<Texture> texture = nullptr;
 
-        static CompType StaticType() { return CompType_Sprite2D; }
+        static constexpr CompType StaticType() { return CompType_Sprite2D; }
         virtual CompType GetType() override { return StaticType(); }
     };
 
@@ -247,7 +232,7 @@ namespace ignite
 
          SkinnedMesh() = default;
 
-         static CompType StaticType() { return CompType_SkinnedMesh; }
+         static constexpr CompType StaticType() { return CompType_SkinnedMesh; }
          virtual CompType GetType() override { return StaticType(); };
      };
 
@@ -268,7 +253,7 @@ namespace ignite
         MeshRenderer() = default;
         MeshRenderer(const MeshRenderer &other);
 
-        static CompType StaticType() { return CompType_MeshRenderer; }
+        static constexpr CompType StaticType() { return CompType_MeshRenderer; }
         virtual CompType GetType() override { return StaticType(); }
     };
 
@@ -297,7 +282,7 @@ namespace ignite
 
         Rigibody() = default;
 
-        static CompType StaticType() { return CompType_Rigidbody; }
+        static constexpr CompType StaticType() { return CompType_Rigidbody; }
         virtual CompType GetType() override { return StaticType(); }
     };
 
@@ -319,7 +304,7 @@ namespace ignite
 
         BoxCollider() = default;
 
-        static CompType StaticType() { return CompType_BoxCollider; }
+        static constexpr CompType StaticType() { return CompType_BoxCollider; }
         virtual CompType GetType() override { return StaticType(); }
     };
 
@@ -330,7 +315,7 @@ namespace ignite
 
         SphereCollider() = default;
 
-        static CompType StaticType() { return CompType_SphereCollider; }
+        static constexpr CompType StaticType() { return CompType_SphereCollider; }
         virtual CompType GetType() override { return StaticType(); }
     };
 
@@ -346,7 +331,7 @@ namespace ignite
 
         AudioSource() = default;
 
-        static CompType StaticType() { return CompType_AudioSource; }
+        static constexpr CompType StaticType() { return CompType_AudioSource; }
         virtual CompType GetType() override { return StaticType(); }
     };
 
@@ -356,7 +341,7 @@ namespace ignite
         std::string className = "null";
         Script() = default;
 
-        static CompType StaticType() { return CompType_Script; }
+        static constexpr CompType StaticType() { return CompType_Script; }
         virtual CompType GetType() override { return StaticType(); }
     };
 }
@@ -9,6 +9,7 @@ namespace ignite
     {
     };
 
+    // scene files write components in this order, see ComponentInfo in component_reflection.hpp
     using AllComponents = ComponentGroup<
         // ID, // do not copy ID component
         Transform, 
@@ -18,10 +19,10 @@ namespace ignite
         BoxCollider2D,
         SkinnedMesh,
         MeshRenderer,
-        Rigibody,
-        BoxCollider,
         AudioSource,
         Script,
+        Rigibody,
+        BoxCollider,
         SphereCollider
     >; 
 }
\ No newline at end of file
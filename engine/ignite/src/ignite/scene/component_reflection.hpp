@@ -0,0 +1,401 @@
+#pragma once
+
+#include "component_group.hpp"
+#include "ignite/core/base.hpp"
+#include "ignite/core/types.hpp"
+
+#include <array>
+#include <cfloat>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace ignite
+{
+    // how a field value is stored, shared by the YAML and binary scene formats and the script bindings
+    enum class ComponentFieldType : u8
+    {
+        Bool, Int, Float, Vec2, Vec3, Vec4, Quat, String, UInt64
+    };
+
+    enum FieldFlags : u8
+    {
+        FieldFlags_None = 0,
+        FieldFlags_Color = BIT(0), // vec4 edited with a color picker
+        FieldFlags_EnumIndex = BIT(1), // enum saved as its value instead of its name
+        FieldFlags_HideInInspector = BIT(2),
+        FieldFlags_ReadOnly = BIT(3), // saved and shown, not editable from the inspector or scripts
+    };
+
+    enum ComponentFlags : u8
+    {
+        ComponentFlags_None = 0,
+        ComponentFlags_Builtin = BIT(0), // every entity has one, never added or removed by hand
+        ComponentFlags_SaveOnly = BIT(1), // written to scene files but not restored, it needs its mesh asset
+        ComponentFlags_NoScript = BIT(2), // no managed class in the script core
+    };
+
+    // enums are stored as their value, UUIDs as u64 and paths as generic strings
+    template<typename Value>
+    struct FieldStorage
+    {
+        using Type = Value;
+    };
+
+    template<typename Value> requires std::is_enum_v<Value>
+    struct FieldStorage<Value>
+    {
+        using Type = i32;
+    };
+
+    template<>
+    struct FieldStorage<UUID>
+    {
+        using Type = u64;
+    };
+
+    template<>
+    struct FieldStorage<std::filesystem::path>
+    {
+        using Type = std::string;
+    };
+
+    template<typename Value>
+    constexpr ComponentFieldType GetComponentFieldType()
+    {
+        using Storage = typename FieldStorage<Value>::Type;
+        if constexpr (std::is_same_v<Storage, bool>) return ComponentFieldType::Bool;
+        else if constexpr (std::is_same_v<Storage, i32>) return ComponentFieldType::Int;
+        else if constexpr (std::is_same_v<Storage, f32>) return ComponentFieldType::Float;
+        else if constexpr (std::is_same_v<Storage, glm::vec2>) return ComponentFieldType::Vec2;
+        else if constexpr (std::is_same_v<Storage, glm::vec3>) return ComponentFieldType::Vec3;
+        else if constexpr (std::is_same_v<Storage, glm::vec4>) return ComponentFieldType::Vec4;
+        else if constexpr (std::is_same_v<Storage, glm::quat>) return ComponentFieldType::Quat;
+        else if constexpr (std::is_same_v<Storage, std::string>) return ComponentFieldType::String;
+        else if constexpr (std::is_same_v<Storage, u64>) return ComponentFieldType::UInt64;
+        else static_assert(!sizeof(Value), "Unsupported component field type");
+    }
+
+    template<typename Value>
+    typename FieldStorage<Value>::Type ToFieldStorage(const Value &value)
+    {
+        if constexpr (std::is_enum_v<Value>) return static_cast<i32>(value);
+        else if constexpr (std::is_same_v<Value, UUID>) return static_cast<u64>(value);
+        else if constexpr (std::is_same_v<Value, std::filesystem::path>) return value.generic_string();
+        else return value;
+    }
+
+    template<typename Value>
+    Value FromFieldStorage(const typename FieldStorage<Value>::Type &stored)
+    {
+        if constexpr (std::is_enum_v<Value>) return static_cast<Value>(stored);
+        else if constexpr (std::is_same_v<Value, UUID>) return UUID(stored);
+        else if constexpr (std::is_same_v<Value, std::filesystem::path>) return std::filesystem::path(stored);
+        else return stored;
+    }
+
+    // one serialized member of a component. Owner may be a base of the component, see the colliders
+    template<typename Owner, typename Value>
+    struct FieldDescriptor
+    {
+        using ValueType = Value;
+        using StorageType = typename FieldStorage<Value>::Type;
+        static constexpr ComponentFieldType type = GetComponentFieldType<Value>();
+
+        const char *name = nullptr; // scene file key and managed property
+        const char *label = nullptr; // inspector
+        Value Owner::*member = nullptr;
+        u8 flags = FieldFlags_None;
+
+        // inspector drag speed and range, no clamp when min equals max
+        f32 speed = 0.025f;
+        f32 min = 0.0f;
+        f32 max = 0.0f;
+
+        // enum names indexed by value
+        std::span<const std::string_view> enumNames;
+
+        template<typename C>
+        Value &Get(C &comp) const { return comp.*member; }
+
+        template<typename C>
+        const Value &Get(const C &comp) const { return comp.*member; }
+
+        constexpr FieldDescriptor Range(f32 dragSpeed, f32 minValue, f32 maxValue) const
+        {
+            FieldDescriptor field = *this;
+            field.speed = dragSpeed;
+            field.min = minValue;
+            field.max = maxValue;
+            return field;
+        }
+
+        constexpr FieldDescriptor Names(std::span<const std::string_view> names) const
+        {
+            FieldDescriptor field = *this;
+            field.enumNames = names;
+            return field;
+        }
+    };
+
+    template<typename Owner, typename Value>
+    constexpr FieldDescriptor<Owner, Value> Field(const char *name, const char *label, Value Owner::*member, u8 flags = FieldFlags_None)
+    {
+        FieldDescriptor<Owner, Value> field;
+        field.name = name;
+        field.label = label;
+        field.member = member;
+        field.flags = flags;
+        return field;
+    }
+
+    // Single declaration of a component for the scene formats, the scene copy,
+    // the inspector and the script bindings. name is the scene file key and the
+    // managed class, fields are written and read in declaration order.
+    template<typename T>
+    struct ComponentInfo;
+
+    inline constexpr std::string_view s_ProjectionTypeNames[] = { "Orthographic", "Perspective" };
+    inline constexpr std::string_view s_Body2DTypeNames[] = { "Static", "Dynamic", "Kinematic" };
+    inline constexpr std::string_view s_MotionQualityNames[] = { "Discrete", "LinearCast" };
+
+    template<>
+    struct ComponentInfo<Transform>
+    {
+        static constexpr const char *name = "Transform";
+        static constexpr const char *displayName = "Transform";
+        static constexpr u8 flags = ComponentFlags_Builtin;
+
+        // world values follow from the locals every update, they are saved for tools reading the file
+        static constexpr auto fields = std::make_tuple(
+            Field("WorldTranslation", "World Translation", &Transform::translation, FieldFlags_HideInInspector),
+            Field("WorldRotation", "World Rotation", &Transform::rotation, FieldFlags_HideInInspector),
+            Field("WorldScale", "World Scale", &Transform::scale, FieldFlags_HideInInspector),
+            Field("LocalTranslation", "Translation", &Transform::localTranslation),
+            Field("LocalRotation", "Rotation", &Transform::localRotation),
+            Field("LocalScale", "Scale", &Transform::localScale),
+            Field("Visible", "Visible", &Transform::visible));
+    };
+
+    template<>
+    struct ComponentInfo<Camera>
+    {
+        static constexpr const char *name = "Camera";
+        static constexpr const char *displayName = "Camera";
+        static constexpr u8 flags = ComponentFlags_None;
+
+        static constexpr auto fields = std::make_tuple(
+            Field("ProjectionType", "Projection", &Camera::projectionType, FieldFlags_EnumIndex).Names(s_ProjectionTypeNames),
+            Field("NearClip", "Near Clip", &Camera::nearClip),
+            Field("FarClip", "Far Clip", &Camera::farClip),
+            Field("Zoom", "Zoom", &Camera::zoom),
+            Field("Fov", "FOV", &Camera::fov),
+            Field("Primary", "Primary", &Camera::primary));
+    };
+
+    template<>
+    struct ComponentInfo<Sprite2D>
+    {
+        static constexpr const char *name = "Sprite2D";
+        static constexpr const char *displayName = "Sprite 2D";
+        static constexpr u8 flags = ComponentFlags_None;
+
+        static constexpr auto fields = std::make_tuple(
+            Field("Color", "Color", &Sprite2D::color, FieldFlags_Color),
+            Field("TilingFactor", "Tiling Factor", &Sprite2D::tilingFactor));
+    };
+
+    template<>
+    struct ComponentInfo<Rigidbody2D>
+    {
+        static constexpr const char *name = "Rigidbody2D";
+        static constexpr const char *displayName = "Rigid Body 2D";
+        static constexpr u8 flags = ComponentFlags_None;
+
+        static constexpr auto fields = std::make_tuple(
+            Field("Type", "Type", &Rigidbody2D::type).Names(s_Body2DTypeNames),
+            Field("LinearVelocity", "Linear Velocity", &Rigidbody2D::linearVelocity),
+            Field("AngularVelocity", "Angular Velocity", &Rigidbody2D::angularVelocity),
+            Field("GravityScale", "Gravity Scale", &Rigidbody2D::gravityScale),
+            Field("LinearDamping", "Linear Damping", &Rigidbody2D::linearDamping),
+            Field("AngularDamping", "Angular Damping", &Rigidbody2D::angularDamping),
+            Field("FixedRotation", "Fixed Rotation", &Rigidbody2D::fixedRotation),
+            Field("IsAwake", "Awake", &Rigidbody2D::isAwake),
+            Field("IsEnabled", "Enabled", &Rigidbody2D::isEnabled),
+            Field("IsEnableSleep", "Enable Sleep", &Rigidbody2D::isEnableSleep));
+    };
+
+    template<>
+    struct ComponentInfo<BoxCollider2D>
+    {
+        static constexpr const char *name = "BoxCollider2D";
+        static constexpr const char *displayName = "Box Collider 2D";
+        static constexpr u8 flags = ComponentFlags_None;
+
+        static constexpr auto fields = std::make_tuple(
+            Field("Size", "Size", &BoxCollider2D::size).Range(0.025f, 0.0f, FLT_MAX),
+            Field("Offset", "Offset", &BoxCollider2D::offset),
+            Field("Restitution", "Restitution", &BoxCollider2D::restitution).Range(0.025f, 0.0f, FLT_MAX),
+            Field("Friction", "Friction", &BoxCollider2D::friction).Range(0.025f, 0.0f, FLT_MAX),
+            Field("Density", "Density", &BoxCollider2D::density),
+            Field("IsSensor", "Is Sensor", &BoxCollider2D::isSensor));
+    };
+
+    template<>
+    struct ComponentInfo<SkinnedMesh>
+    {
+        static constexpr const char *name = "SkinnedMesh";
+        static constexpr const char *displayName = "Skinned Mesh";
+        static constexpr u8 flags = ComponentFlags_SaveOnly | ComponentFlags_NoScript;
+
+        static constexpr auto fields = std::make_tuple(
+            Field("Filepath", "Filepath", &SkinnedMesh::filepath, FieldFlags_ReadOnly));
+    };
+
+    template<>
+    struct ComponentInfo<MeshRenderer>
+    {
+        static constexpr const char *name = "MeshRenderer";
+        static constexpr const char *displayName = "Mesh Renderer";
+        static constexpr u8 flags = ComponentFlags_SaveOnly | ComponentFlags_NoScript;
+
+        static constexpr auto fields = std::make_tuple(
+            Field("Root", "Root", &MeshRenderer::root, FieldFlags_ReadOnly),
+            Field("MeshIndex", "Mesh Index", &MeshRenderer::meshIndex, FieldFlags_ReadOnly));
+    };
+
+    template<>
+    struct ComponentInfo<AudioSource>
+    {
+        static constexpr const char *name = "AudioSource";
+        static constexpr const char *displayName = "Audio Source";
+        static constexpr u8 flags = ComponentFlags_None;
+
+        static constexpr auto fields = std::make_tuple(
+            Field("Handle", "Handle", &AudioSource::handle, FieldFlags_HideInInspector),
+            Field("Volume", "Volume", &AudioSource::volume).Range(0.025f, 0.0f, 1.0f),
+            Field("Pitch", "Pitch", &AudioSource::pitch).Range(0.025f, 0.0f, 10.0f),
+            Field("Pan", "Pan", &AudioSource::pan).Range(0.025f, -1.0f, 1.0f),
+            Field("PlayOnStart", "Play On Start", &AudioSource::playOnStart));
+    };
+
+    template<>
+    struct ComponentInfo<Script>
+    {
+        static constexpr const char *name = "Script";
+        static constexpr const char *displayName = "C# Script";
+        static constexpr u8 flags = ComponentFlags_NoScript;
+
+        // the field values of the class are saved next to it, see SceneSerializer
+        static constexpr auto fields = std::make_tuple(
+            Field("ClassName", "Class", &Script::className));
+    };
+
+    template<>
+    struct ComponentInfo<Rigibody>
+    {
+        static constexpr const char *name = "Rigidbody";
+        static constexpr const char *displayName = "Rigid Body";
+        static constexpr u8 flags = ComponentFlags_None;
+
+        static constexpr auto fields = std::make_tuple(
+            Field("MotionQuality", "Motion Quality", &Rigibody::MotionQuality).Names(s_MotionQualityNames),
+            Field("UseGravity", "Use Gravity", &Rigibody::useGravity),
+            Field("RotateX", "Rotate X", &Rigibody::rotateX),
+            Field("RotateY", "Rotate Y", &Rigibody::rotateY),
+            Field("RotateZ", "Rotate Z", &Rigibody::rotateZ),
+            Field("MoveX", "Move X", &Rigibody::moveX),
+            Field("MoveY", "Move Y", &Rigibody::moveY),
+            Field("MoveZ", "Move Z", &Rigibody::moveZ),
+            Field("IsStatic", "Static", &Rigibody::isStatic),
+            Field("Mass", "Mass", &Rigibody::mass).Range(0.025f, 0.0f, FLT_MAX),
+            Field("AllowSleeping", "Allow Sleeping", &Rigibody::allowSleeping),
+            Field("RetainAcceleration", "Retain Acceleration", &Rigibody::retainAcceleration),
+            Field("GravityFactor", "Gravity Factor", &Rigibody::gravityFactor),
+            Field("CenterMass", "Center Of Mass", &Rigibody::centerMass));
+    };
+
+    template<>
+    struct ComponentInfo<BoxCollider>
+    {
+        static constexpr const char *name = "BoxCollider";
+        static constexpr const char *displayName = "Box Collider";
+        static constexpr u8 flags = ComponentFlags_None;
+
+        static constexpr auto fields = std::make_tuple(
+            Field("Scale", "Scale", &BoxCollider::scale).Range(0.025f, 0.0f, 10000.0f),
+            Field("Friction", "Friction", &BoxCollider::friction),
+            Field("StaticFriction", "Static Friction", &BoxCollider::staticFriction),
+            Field("Restitution", "Restitution", &BoxCollider::restitution),
+            Field("Density", "Density", &BoxCollider::density));
+    };
+
+    template<>
+    struct ComponentInfo<SphereCollider>
+    {
+        static constexpr const char *name = "SphereCollider";
+        static constexpr const char *displayName = "Sphere Collider";
+        static constexpr u8 flags = ComponentFlags_None;
+
+        static constexpr auto fields = std::make_tuple(
+            Field("Radius", "Radius", &SphereCollider::radius).Range(0.025f, 0.01f, 10000.0f),
+            Field("Friction", "Friction", &SphereCollider::friction),
+            Field("StaticFriction", "Static Friction", &SphereCollider::staticFriction),
+            Field("Restitution", "Restitution", &SphereCollider::restitution),
+            Field("Density", "Density", &SphereCollider::density));
+    };
+
+    template<typename T, typename Func>
+    void ForEachField(Func &&func)
+    {
+        std::apply([&func](const auto &...field) { (func(field), ...); }, ComponentInfo<T>::fields);
+    }
+
+    template<typename T>
+    constexpr size_t GetFieldCount()
+    {
+        return std::tuple_size_v<std::decay_t<decltype(ComponentInfo<T>::fields)>>;
+    }
+
+    // calls func.template operator()<T>() for every component of the group, in order
+    template<typename... Component, typename Func>
+    void ForEachComponentType(ComponentGroup<Component...>, Func &&func)
+    {
+        (func.template operator()<Component>(), ...);
+    }
+
+    // calls func.template operator()<T>() for the component of that type, false when none matches
+    template<typename... Component, typename Func>
+    bool VisitComponentType(ComponentGroup<Component...>, CompType type, Func &&func)
+    {
+        return ((Component::StaticType() == type ? (func.template operator()<Component>(), true) : false) || ...);
+    }
+
+    template<typename Func>
+    bool VisitComponentType(CompType type, Func &&func)
+    {
+        return VisitComponentType(AllComponents{}, type, std::forward<Func>(func));
+    }
+
+    struct ComponentTypeInfo
+    {
+        const char *name;
+        const char *displayName;
+        CompType type;
+        u8 flags;
+    };
+
+    template<typename... Component>
+    constexpr auto MakeComponentTypes(ComponentGroup<Component...>)
+    {
+        return std::array<ComponentTypeInfo, sizeof...(Component)>{
+            ComponentTypeInfo{ ComponentInfo<Component>::name, ComponentInfo<Component>::displayName, Component::StaticType(), ComponentInfo<Component>::flags }...
+        };
+    }
+
+    // every component of AllComponents, in the same order
+    inline constexpr auto s_ComponentTypes = MakeComponentTypes(AllComponents{});
+}
@@ -9,6 +9,7 @@
 #include "ignite/physics/2d/physics_2d.hpp"
 #include "ignite/physics/jolt/jolt_physics.hpp"
 #include "ignite/math/math.hpp"
+#include "ignite/core/profiler.hpp"
 #include "scene_manager.hpp"
 #include "ignite/scripting/script_engine.hpp"
 #include "entity.hpp"
@@ -16,6 +17,8 @@
 #include "ignite/animation/animation_system.hpp"
 
 #include "ignite/project/project.hpp"
+#include "ignite/serializer/scene_save_cache.hpp"
+#include "simulation_rollback.hpp"
 
 #include <ranges>
 
@@ -100,6 +103,8 @@ namespace ignite
             }
         }
 
+        rollback.reset();
+
         ScriptEngine::ClearSceneContext();
         
         physics2D->SimulationStop();
@@ -108,20 +113,28 @@ namespace ignite
 
     void Scene::UpdateTransforms(float deltaTime)
     {
-        auto skinnedMeshView = registry->view<SkinnedMesh>();
-        for (auto entity : skinnedMeshView)
+        IGN_PROFILE_FUNCTION();
+
         {
-            SkinnedMesh &skinnedMesh = skinnedMeshView.get<SkinnedMesh>(entity);
-            if (!skinnedMesh.animations.empty() && skinnedMesh.animations[skinnedMesh.activeAnimIndex].isPlaying)
+            IGN_PROFILE_SCOPE("Animation");
+
+            auto skinnedMeshView = registry->view<SkinnedMesh>();
+            for (auto entity : skinnedMeshView)
             {
-                if (AnimationSystem::UpdateSkeleton(skinnedMesh.skeleton, skinnedMesh.animations[skinnedMesh.activeAnimIndex], timeInSeconds))
+                SkinnedMesh &skinnedMesh = skinnedMeshView.get<SkinnedMesh>(entity);
+                if (!skinnedMesh.animations.empty() && skinnedMesh.animations[skinnedMesh.activeAnimIndex].isPlaying)
                 {
-                    AnimationSystem::ApplySkeletonToEntities(this, skinnedMesh.skeleton);
-                    skinnedMesh.boneTransforms = AnimationSystem::GetFinalJointTransforms(skinnedMesh.skeleton);
+                    if (AnimationSystem::UpdateSkeleton(skinnedMesh.skeleton, skinnedMesh.animations[skinnedMesh.activeAnimIndex], timeInSeconds))
+                    {
+                        AnimationSystem::ApplySkeletonToEntities(this, skinnedMesh.skeleton);
+                        AnimationSystem::GetFinalJointTransforms(skinnedMesh.skeleton, skinnedMesh.boneTransforms);
+                    }
                 }
             }
         }
 
+        IGN_PROFILE_SCOPE("Transforms");
+
         auto view = registry->view<ID, Transform>();
         for (auto ent : view)
         {
@@ -246,18 +259,36 @@ namespace ignite
 
     void Scene::OnUpdateRuntimeSimulate(f32 deltaTime)
     {
+        IGN_PROFILE_FUNCTION();
+
         timeInSeconds += deltaTime;
 
-        registry->view<Script>().each([this, deltaTime](entt::entity e, Script &sc)
         {
-            Entity entity{ e, this };
-            ScriptEngine::OnUpdateEntity(entity, deltaTime);
-        });
+            IGN_PROFILE_SCOPE("Scripts");
+            registry->view<Script>().each([this, deltaTime](entt::entity e, Script &sc)
+            {
+                Entity entity{ e, this };
+                ScriptEngine::OnUpdateEntity(entity, deltaTime);
+            });
+        }
 
         UpdateTransforms(deltaTime);
 
-        physics2D->Simulate(deltaTime);
-        physics->Simulate(deltaTime);
+        {
+            IGN_PROFILE_SCOPE("Physics 2D");
+            physics2D->Simulate(deltaTime);
+        }
+
+        {
+            IGN_PROFILE_SCOPE("Physics 3D");
+            physics->Simulate(deltaTime);
+        }
+
+        if (rollback)
+        {
+            IGN_PROFILE_SCOPE("Rollback Capture");
+            rollback->Capture(deltaTime);
+        }
     }
 
     Ref<Scene> Scene::Create(const std::string &name)
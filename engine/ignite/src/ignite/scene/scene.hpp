@@ -19,6 +19,8 @@ namespace ignite
     class Entity;
     class Environment;
     class SceneRenderer;
+    class SceneSaveCache;
+    class SimulationRollback;
 
     using EntityComponents = std::unordered_map<entt::entity, std::vector<IComponent *>>;
 
@@ -58,6 +60,12 @@ namespace ignite
         Scope<Physics2D> physics2D;
         Scope<JoltScene> physics;
 
+        // what the last save wrote, see SceneSerializer
+        Scope<SceneSaveCache> saveCache;
+
+        // set while playing to record every step, dropped by OnStop
+        Scope<SimulationRollback> rollback;
+
         bool IsPlaying() const { return m_Playing; }
 
         static Ref<Scene> Create(const std::string &name);
@@ -244,7 +244,7 @@ namespace ignite
         {
             MeshRenderer &mr = newEntity.GetComponent<MeshRenderer>();
             mr.mesh->environment = scene->sceneRenderer->GetEnvironment();
-            mr.mesh->WriteBuffers(newEntity);
+            mr.mesh->WriteBuffers();
             mr.mesh->CreateBindingSet();
         }
 
@@ -419,7 +419,7 @@ namespace ignite
             MeshRenderer &mr = mrView.get<MeshRenderer>(e);
 
             mr.mesh->environment = newScene->sceneRenderer->GetEnvironment();
-            mr.mesh->WriteBuffers(static_cast<uint32_t>(e));
+            mr.mesh->WriteBuffers();
             mr.mesh->CreateBindingSet();
         }
 
@@ -31,27 +31,44 @@ namespace ignite
         using EntityMap = std::unordered_map<UUID, entt::entity>;
         using EntityComponents = std::unordered_map<entt::entity, std::vector<IComponent *>>;
 
+        // one lookup per source entity and one bulk insert per component type. components are
+        // copied memberwise through their copy constructors, they are polymorphic and some
+        // hold runtime handles that the copy constructor resets
         template<typename... Component>
         static void CopyComponent(entt::registry *destRegistry, entt::registry *srcRegistry, const EntityMap &entityMap, EntityComponents &registerComps)
         {
             ([&]()
                 {
-                    auto view = srcRegistry->view<Component>();
-                    for (auto srcEntity : view)
+                    std::vector<entt::entity> targets;
+                    std::vector<Component> copies;
+
+                    auto view = srcRegistry->view<ID, Component>();
+                    for (auto [srcEntity, id, src] : view.each())
                     {
-                        for (auto [uuid, destEntity] : entityMap)
-                        {
-                            // key (UUID)
-                            if (uuid == srcRegistry->get<ID>(srcEntity).uuid)
-                            {
-                                Component &comp = destRegistry->emplace_or_replace<Component>(destEntity, srcRegistry->get<Component>(srcEntity));
+                        auto it = entityMap.find(id.uuid);
+                        if (it == entityMap.end())
+                            continue;
 
-                                if constexpr (std::is_base_of<IComponent, Component>::value)
-                                {
-                                    registerComps[destEntity].emplace_back(static_cast<IComponent *>(&comp));
-                                }
-                            }
+                        // builtin components already exist on the new entity and are registered
+                        if (destRegistry->all_of<Component>(it->second))
+                        {
+                            destRegistry->replace<Component>(it->second, src);
+                            continue;
                         }
+
+                        targets.push_back(it->second);
+                        copies.push_back(src);
+                    }
+
+                    if (targets.empty())
+                        return;
+
+                    destRegistry->insert<Component>(targets.begin(), targets.end(), copies.begin());
+
+                    if constexpr (std::is_base_of<IComponent, Component>::value)
+                    {
+                        for (entt::entity destEntity : targets)
+                            registerComps[destEntity].emplace_back(static_cast<IComponent *>(&destRegistry->get<Component>(destEntity)));
                     }
                 }(), ...
             );
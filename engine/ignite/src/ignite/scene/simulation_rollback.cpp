@@ -0,0 +1,419 @@
+#include "simulation_rollback.hpp"
+#include "scene.hpp"
+#include "component.hpp"
+
+#include "ignite/core/logger.hpp"
+#include "ignite/core/time.hpp"
+#include "ignite/physics/2d/physics_2d_component.hpp"
+#include "ignite/physics/jolt/jolt_physics.hpp"
+#include "ignite/scripting/script_engine.hpp"
+
+#include <box2d/box2d.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ignite
+{
+    namespace
+    {
+        // world transforms follow from these, see Rewind
+        struct TransformState
+        {
+            glm::vec3 localTranslation;
+            glm::quat localRotation;
+            glm::vec3 localScale;
+        };
+
+        struct Body2DState
+        {
+            b2Vec2 position;
+            b2Rot rotation;
+            b2Vec2 linearVelocity;
+            f32 angularVelocity;
+            u32 awake;
+        };
+
+        struct AnimationState
+        {
+            i32 activeAnimIndex;
+            f32 timeInSeconds;
+            u32 isPlaying;
+            u32 reserved;
+        };
+
+        template<typename T>
+        void WriteState(std::vector<u8> &buffer, size_t index, const T &state)
+        {
+            memcpy(buffer.data() + index * sizeof(T), &state, sizeof(T));
+        }
+
+        template<typename T>
+        T ReadState(const std::vector<u8> &buffer, size_t index)
+        {
+            T state;
+            memcpy(&state, buffer.data() + index * sizeof(T), sizeof(T));
+            return state;
+        }
+
+        // the chunks of current that differ from previous, or all of it when that is smaller
+        void StoreStream(RollbackStream &stream, const std::vector<u8> &previous, const std::vector<u8> &current, bool full)
+        {
+            stream.size = static_cast<u32>(current.size());
+            stream.chunks.clear();
+            stream.data.clear();
+
+            if (!full && previous.size() == current.size())
+            {
+                for (size_t offset = 0; offset < current.size(); offset += SIMULATION_ROLLBACK_CHUNK_SIZE)
+                {
+                    const size_t size = std::min<size_t>(SIMULATION_ROLLBACK_CHUNK_SIZE, current.size() - offset);
+                    if (memcmp(previous.data() + offset, current.data() + offset, size) == 0)
+                        continue;
+
+                    stream.chunks.push_back(static_cast<u32>(offset / SIMULATION_ROLLBACK_CHUNK_SIZE));
+                    stream.data.insert(stream.data.end(), current.begin() + offset, current.begin() + offset + size);
+
+                    if (stream.data.size() + stream.chunks.size() * sizeof(u32) >= current.size())
+                    {
+                        full = true;
+                        break;
+                    }
+                }
+
+                if (!full)
+                {
+                    stream.full = false;
+                    return;
+                }
+            }
+
+            stream.full = true;
+            stream.chunks.clear();
+            stream.data.assign(current.begin(), current.end());
+        }
+
+        void PatchStream(std::vector<u8> &state, const RollbackStream &stream)
+        {
+            if (stream.full)
+            {
+                state.assign(stream.data.begin(), stream.data.end());
+                return;
+            }
+
+            size_t read = 0;
+            for (const u32 chunk : stream.chunks)
+            {
+                const size_t offset = static_cast<size_t>(chunk) * SIMULATION_ROLLBACK_CHUNK_SIZE;
+                const size_t size = std::min<size_t>(SIMULATION_ROLLBACK_CHUNK_SIZE, state.size() - offset);
+                memcpy(state.data() + offset, stream.data.data() + read, size);
+                read += size;
+            }
+        }
+    }
+
+    SimulationRollback::SimulationRollback(Scene *scene, u32 capacity, u32 keyframeInterval)
+        : m_Scene(scene), m_KeyframeInterval(std::max(keyframeInterval, 1u))
+    {
+        // a keyframe must always be left in the ring once the oldest ticks are overwritten
+        m_Ticks.resize(std::max(capacity, m_KeyframeInterval * 2));
+
+        Record(0, 0.0f);
+    }
+
+    void SimulationRollback::Capture(f32 deltaTime)
+    {
+        Timer timer;
+
+        // stepping again after a rewind replaces what came after it
+        m_NewestTick = m_CurrentTick;
+        Record(m_NewestTick + 1, deltaTime);
+
+        m_CaptureMillis = timer.ElapsedMillis();
+    }
+
+    void SimulationRollback::Record(u64 tick, f32 deltaTime)
+    {
+        bool keyframe = !Gather();
+        if (keyframe)
+            BuildLayout();
+
+        GatherScriptFields();
+
+        // drop the tick this slot held, and the deltas left without their keyframe
+        const u64 capacity = m_Ticks.size();
+        if (tick >= capacity && m_OldestTick <= tick - capacity)
+        {
+            m_OldestTick = tick - capacity + 1;
+            while (m_OldestTick < tick && !Slot(m_OldestTick).keyframe)
+                ++m_OldestTick;
+        }
+
+        keyframe |= tick == 0 || tick == m_OldestTick || tick - m_LastKeyframe >= m_KeyframeInterval;
+
+        RollbackTick &slot = Slot(tick);
+        slot.tick = tick;
+        slot.deltaTime = deltaTime;
+        slot.sceneTime = m_Scene->timeInSeconds;
+        slot.keyframe = keyframe;
+        slot.layout = m_Layout;
+
+        for (u32 channel = 0; channel < RollbackChannel_Count; ++channel)
+        {
+            StoreStream(slot.streams[channel], m_State[channel], m_Scratch[channel], keyframe);
+            std::swap(m_State[channel], m_Scratch[channel]);
+        }
+
+        if (keyframe)
+            m_LastKeyframe = tick;
+
+        m_NewestTick = tick;
+        m_CurrentTick = tick;
+    }
+
+    bool SimulationRollback::Gather()
+    {
+        entt::registry *registry = m_Scene->registry;
+
+        for (auto &handles : m_Handles)
+            handles.clear();
+
+        // transforms
+        {
+            const auto view = registry->view<Transform>();
+            std::vector<u8> &buffer = m_Scratch[RollbackChannel_Transform];
+            buffer.resize(view.size() * sizeof(TransformState));
+
+            auto &handles = m_Handles[RollbackChannel_Transform];
+            view.each([&](entt::entity e, const Transform &tr)
+            {
+                WriteState(buffer, handles.size(), TransformState{ tr.localTranslation, tr.localRotation, tr.localScale });
+                handles.push_back(e);
+            });
+        }
+
+        // box2d bodies
+        {
+            const auto view = registry->view<Rigidbody2D>();
+            std::vector<u8> &buffer = m_Scratch[RollbackChannel_Body2D];
+            buffer.resize(view.size() * sizeof(Body2DState));
+
+            auto &handles = m_Handles[RollbackChannel_Body2D];
+            view.each([&](entt::entity e, const Rigidbody2D &rb)
+            {
+                Body2DState state = {};
+                if (b2Body_IsValid(rb.bodyId))
+                {
+                    state.position = b2Body_GetPosition(rb.bodyId);
+                    state.rotation = b2Body_GetRotation(rb.bodyId);
+                    state.linearVelocity = b2Body_GetLinearVelocity(rb.bodyId);
+                    state.angularVelocity = b2Body_GetAngularVelocity(rb.bodyId);
+                    state.awake = b2Body_IsAwake(rb.bodyId);
+                }
+
+                WriteState(buffer, handles.size(), state);
+                handles.push_back(e);
+            });
+        }
+
+        // animations, the skeleton pose follows from the scene time
+        {
+            const auto view = registry->view<SkinnedMesh>();
+            std::vector<u8> &buffer = m_Scratch[RollbackChannel_Animation];
+            buffer.resize(view.size() * sizeof(AnimationState));
+
+            auto &handles = m_Handles[RollbackChannel_Animation];
+            view.each([&](entt::entity e, const SkinnedMesh &mesh)
+            {
+                AnimationState state = {};
+                state.activeAnimIndex = mesh.activeAnimIndex;
+                if (mesh.activeAnimIndex >= 0 && static_cast<size_t>(mesh.activeAnimIndex) < mesh.animations.size())
+                {
+                    const SkeletalAnimation &animation = mesh.animations[mesh.activeAnimIndex];
+                    state.timeInSeconds = animation.timeInSeconds;
+                    state.isPlaying = animation.isPlaying;
+                }
+
+                WriteState(buffer, handles.size(), state);
+                handles.push_back(e);
+            });
+        }
+
+        auto &scriptHandles = m_Handles[RollbackChannel_ScriptFields];
+        for (const entt::entity e : registry->view<Script>())
+            scriptHandles.push_back(e);
+
+        if (m_Scene->physics)
+            m_Scene->physics->SaveState(m_Scratch[RollbackChannel_Jolt]);
+
+        return m_Layout && m_Layout->entities == m_Handles;
+    }
+
+    void SimulationRollback::GatherScriptFields()
+    {
+        std::vector<u8> &buffer = m_Scratch[RollbackChannel_ScriptFields];
+        buffer.resize(m_Layout->scriptBytes);
+
+        for (const RollbackLayout::ScriptValue &value : m_Layout->scriptValues)
+            value.instance->GetFieldValueRaw(value.field, buffer.data() + value.offset);
+    }
+
+    void SimulationRollback::BuildLayout()
+    {
+        Ref<RollbackLayout> layout = CreateRef<RollbackLayout>();
+        layout->entities = m_Handles;
+
+        entt::registry *registry = m_Scene->registry;
+        for (const entt::entity e : layout->entities[RollbackChannel_ScriptFields])
+        {
+            const Script &script = registry->get<Script>(e);
+            if (!ScriptEngine::EntityClassExists(script.className))
+                continue;
+
+            Ref<ScriptInstance> instance = ScriptEngine::GetEntityScriptInstance(registry->get<ID>(e).uuid);
+            if (!instance)
+                continue;
+
+            for (const auto &[name, field] : instance->GetScriptClass()->GetFields())
+            {
+                const u32 size = Utils::ScriptFieldTypeSize(field.Type);
+                if (size == 0)
+                    continue;
+
+                layout->scriptValues.push_back({ instance.get(), field.ClassField, layout->scriptBytes });
+                layout->scriptBytes += size;
+            }
+
+            layout->scriptInstances.push_back(std::move(instance));
+        }
+
+        m_Layout = layout;
+    }
+
+    bool SimulationRollback::Rewind(u64 tick)
+    {
+        if (tick < m_OldestTick || tick > m_NewestTick)
+        {
+            LOG_WARN("[Simulation Rollback] Tick {} is not in [{}, {}]", tick, m_OldestTick, m_NewestTick);
+            return false;
+        }
+
+        u64 keyframe = tick;
+        while (!Slot(keyframe).keyframe)
+            --keyframe;
+
+        // a channel starts from its last full buffer, at the latest the keyframe
+        for (u32 channel = 0; channel < RollbackChannel_Count; ++channel)
+        {
+            u64 base = tick;
+            while (!Slot(base).streams[channel].full)
+                --base;
+
+            for (u64 t = base; t <= tick; ++t)
+                PatchStream(m_State[channel], Slot(t).streams[channel]);
+        }
+
+        const RollbackTick &target = Slot(tick);
+        m_Layout = target.layout;
+        Apply(*m_Layout);
+
+        // world transforms, skeleton poses and mesh buffers again from the restored state
+        m_Scene->timeInSeconds = target.sceneTime;
+        m_Scene->UpdateTransforms(0.0f);
+
+        m_CurrentTick = tick;
+        m_LastKeyframe = keyframe;
+        return true;
+    }
+
+    bool SimulationRollback::Resimulate(u64 tick)
+    {
+        if (tick <= m_CurrentTick || tick > m_NewestTick)
+            return false;
+
+        // the steps are read first, the first capture drops them from the ring
+        std::vector<f32> steps;
+        steps.reserve(tick - m_CurrentTick);
+        for (u64 t = m_CurrentTick + 1; t <= tick; ++t)
+            steps.push_back(Slot(t).deltaTime);
+
+        for (const f32 deltaTime : steps)
+            m_Scene->OnUpdateRuntimeSimulate(deltaTime);
+
+        return true;
+    }
+
+    void SimulationRollback::Apply(const RollbackLayout &layout)
+    {
+        entt::registry *registry = m_Scene->registry;
+
+        const auto &transforms = layout.entities[RollbackChannel_Transform];
+        for (size_t i = 0; i < transforms.size(); ++i)
+        {
+            if (!registry->valid(transforms[i]) || !registry->all_of<Transform>(transforms[i]))
+                continue;
+
+            const auto state = ReadState<TransformState>(m_State[RollbackChannel_Transform], i);
+            Transform &tr = registry->get<Transform>(transforms[i]);
+            tr.localTranslation = state.localTranslation;
+            tr.localRotation = state.localRotation;
+            tr.localScale = state.localScale;
+        }
+
+        const auto &bodies = layout.entities[RollbackChannel_Body2D];
+        for (size_t i = 0; i < bodies.size(); ++i)
+        {
+            if (!registry->valid(bodies[i]) || !registry->all_of<Rigidbody2D>(bodies[i]))
+                continue;
+
+            const Rigidbody2D &rb = registry->get<Rigidbody2D>(bodies[i]);
+            if (!b2Body_IsValid(rb.bodyId))
+                continue;
+
+            const auto state = ReadState<Body2DState>(m_State[RollbackChannel_Body2D], i);
+            b2Body_SetTransform(rb.bodyId, state.position, state.rotation);
+            b2Body_SetLinearVelocity(rb.bodyId, state.linearVelocity);
+            b2Body_SetAngularVelocity(rb.bodyId, state.angularVelocity);
+            b2Body_SetAwake(rb.bodyId, state.awake != 0);
+        }
+
+        const auto &animations = layout.entities[RollbackChannel_Animation];
+        for (size_t i = 0; i < animations.size(); ++i)
+        {
+            if (!registry->valid(animations[i]) || !registry->all_of<SkinnedMesh>(animations[i]))
+                continue;
+
+            const auto state = ReadState<AnimationState>(m_State[RollbackChannel_Animation], i);
+            SkinnedMesh &mesh = registry->get<SkinnedMesh>(animations[i]);
+            if (state.activeAnimIndex < 0 || static_cast<size_t>(state.activeAnimIndex) >= mesh.animations.size())
+                continue;
+
+            mesh.activeAnimIndex = state.activeAnimIndex;
+            SkeletalAnimation &animation = mesh.animations[mesh.activeAnimIndex];
+            animation.timeInSeconds = state.timeInSeconds;
+            animation.isPlaying = state.isPlaying != 0;
+        }
+
+        const std::vector<u8> &scripts = m_State[RollbackChannel_ScriptFields];
+        for (const RollbackLayout::ScriptValue &value : layout.scriptValues)
+            value.instance->SetFieldValueRaw(value.field, scripts.data() + value.offset);
+
+        if (m_Scene->physics && !m_State[RollbackChannel_Jolt].empty())
+            m_Scene->physics->RestoreState(m_State[RollbackChannel_Jolt]);
+    }
+
+    size_t SimulationRollback::GetMemoryUsage() const
+    {
+        size_t bytes = 0;
+        for (const RollbackTick &tick : m_Ticks)
+        {
+            for (const RollbackStream &stream : tick.streams)
+                bytes += stream.data.capacity() + stream.chunks.capacity() * sizeof(u32);
+        }
+
+        for (u32 channel = 0; channel < RollbackChannel_Count; ++channel)
+            bytes += m_State[channel].capacity() + m_Scratch[channel].capacity();
+
+        return bytes;
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+#include "ignite/core/memory.hpp"
+
+#include <entt/entt.hpp>
+
+#include <array>
+#include <vector>
+
+extern "C"
+{
+    typedef struct _MonoClassField MonoClassField;
+}
+
+namespace ignite {
+
+#define SIMULATION_ROLLBACK_CAPACITY 600 // ticks kept, 10 seconds at 60 Hz
+#define SIMULATION_ROLLBACK_KEYFRAME_INTERVAL 60 // ticks between full snapshots, bounds the cost of a rewind
+#define SIMULATION_ROLLBACK_CHUNK_SIZE 16 // bytes compared at once when a tick is stored as a delta
+
+    class Scene;
+    class ScriptInstance;
+
+    enum RollbackChannel : u8
+    {
+        RollbackChannel_Transform = 0,
+        RollbackChannel_Body2D,
+        RollbackChannel_Animation,
+        RollbackChannel_ScriptFields,
+        RollbackChannel_Jolt, // PhysicsSystem::SaveState output
+        RollbackChannel_Count
+    };
+
+    // which entity each record of a channel belongs to, shared by the ticks until the set changes
+    struct RollbackLayout
+    {
+        struct ScriptValue
+        {
+            ScriptInstance *instance = nullptr; // kept alive by scriptInstances
+            MonoClassField *field = nullptr;
+            u32 offset = 0; // into the script fields buffer
+        };
+
+        // per channel up to RollbackChannel_Jolt, in view order
+        std::array<std::vector<entt::entity>, RollbackChannel_Jolt> entities;
+
+        std::vector<Ref<ScriptInstance>> scriptInstances;
+        std::vector<ScriptValue> scriptValues; // value type fields only, entity references are not restored
+        u32 scriptBytes = 0;
+    };
+
+    // one channel of a tick, either the whole buffer or the chunks changed since the tick before
+    struct RollbackStream
+    {
+        bool full = false;
+        u32 size = 0; // bytes of the whole buffer
+        TrackedVector<u32, MemoryTag::Scene> chunks; // changed chunk indices when not full
+        TrackedVector<u8, MemoryTag::Scene> data;
+    };
+
+    struct RollbackTick
+    {
+        u64 tick = 0;
+        f32 deltaTime = 0.0f; // of the step that led here, replayed by Resimulate
+        f32 sceneTime = 0.0f;
+        bool keyframe = false;
+
+        Ref<const RollbackLayout> layout;
+        std::array<RollbackStream, RollbackChannel_Count> streams;
+    };
+
+    // Runtime state of a playing scene for every step, in a ring buffer. Each tick holds the chunks
+    // changed since the tick before, with a full snapshot every keyframe interval or when entities
+    // come and go, so a capture copies component state and never touches the serializer.
+    // Covers transforms, Box2D bodies, Jolt, animation time and value type script fields.
+    //
+    // Box2D has no world snapshot, only body state is restored and warm starting may make a replay
+    // drift slightly. Scripts reading input or random numbers replay what they read at that time.
+    // Entities destroyed after a tick are not brought back by rewinding to it.
+    class SimulationRollback
+    {
+    public:
+        // captures the current state as the first tick
+        explicit SimulationRollback(Scene *scene, u32 capacity = SIMULATION_ROLLBACK_CAPACITY, u32 keyframeInterval = SIMULATION_ROLLBACK_KEYFRAME_INTERVAL);
+
+        SimulationRollback(const SimulationRollback &) = delete;
+        SimulationRollback &operator=(const SimulationRollback &) = delete;
+
+        // records the state after a step of deltaTime, see Scene::OnUpdateRuntimeSimulate.
+        // after a rewind the ticks past the current one are dropped first
+        void Capture(f32 deltaTime);
+
+        // puts the scene back in the state of tick, the ticks after it are kept for Resimulate
+        bool Rewind(u64 tick);
+
+        // steps the scene again from the current tick to tick with the recorded delta times
+        bool Resimulate(u64 tick);
+
+        [[nodiscard]] u64 GetOldestTick() const { return m_OldestTick; }
+        [[nodiscard]] u64 GetNewestTick() const { return m_NewestTick; }
+        [[nodiscard]] u64 GetCurrentTick() const { return m_CurrentTick; }
+        [[nodiscard]] u32 GetCapacity() const { return static_cast<u32>(m_Ticks.size()); }
+        [[nodiscard]] f32 GetCaptureMillis() const { return m_CaptureMillis; }
+        [[nodiscard]] size_t GetMemoryUsage() const;
+
+    private:
+        RollbackTick &Slot(u64 tick) { return m_Ticks[tick % m_Ticks.size()]; }
+
+        void Record(u64 tick, f32 deltaTime);
+
+        // fills m_Scratch but the script fields, false when the entities differ from m_Layout
+        bool Gather();
+        void GatherScriptFields();
+        void BuildLayout();
+        void Apply(const RollbackLayout &layout);
+
+        Scene *m_Scene;
+        u32 m_KeyframeInterval;
+
+        std::vector<RollbackTick> m_Ticks;
+        u64 m_OldestTick = 0;
+        u64 m_NewestTick = 0;
+        u64 m_CurrentTick = 0;
+        u64 m_LastKeyframe = 0;
+
+        Ref<const RollbackLayout> m_Layout;
+        std::array<std::vector<u8>, RollbackChannel_Count> m_State; // whole buffers of the current tick
+        std::array<std::vector<u8>, RollbackChannel_Count> m_Scratch;
+        std::array<std::vector<entt::entity>, RollbackChannel_Jolt> m_Handles;
+
+        f32 m_CaptureMillis = 0.0f;
+    };
+}
@@ -7,6 +7,7 @@
 #include "ignite/core/application.hpp"
 #include "ignite/core/string_utils.hpp"
 #include "ignite/core/platform_utils.hpp"
+#include "ignite/core/memory.hpp"
 
 #include "FileWatch.hpp"
 
@@ -360,7 +361,9 @@ namespace ignite
         {
             const UUID uuid = entity.GetUUID();
 
-            const auto instance = std::make_shared<ScriptInstance>(scriptEngineData->entityClasses[sc.className], entity);
+            // pooled, instances come and go with entities while playing
+            const auto instance = std::allocate_shared<ScriptInstance>(PoolStdAllocator<ScriptInstance, MemoryTag::Scripting>(),
+                scriptEngineData->entityClasses[sc.className], entity);
             scriptEngineData->entityInstances[uuid] = instance;
 
             // Copy Fields Value from Editor to Runtime
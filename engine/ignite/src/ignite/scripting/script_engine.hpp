@@ -114,5 +114,29 @@ namespace ignite
 
             return ScriptFieldType::Invalid;
         }
+
+        // bytes of a value type field, 0 for entity references
+        inline u32 ScriptFieldTypeSize(ScriptFieldType type)
+        {
+            switch (type)
+            {
+            case ScriptFieldType::Bool:
+            case ScriptFieldType::Byte:
+            case ScriptFieldType::UByte:   return 1;
+            case ScriptFieldType::Char:
+            case ScriptFieldType::Short:
+            case ScriptFieldType::UShort:  return 2;
+            case ScriptFieldType::Float:
+            case ScriptFieldType::Int:
+            case ScriptFieldType::UInt:    return 4;
+            case ScriptFieldType::Double:
+            case ScriptFieldType::Long:
+            case ScriptFieldType::ULong:
+            case ScriptFieldType::Vector2: return 8;
+            case ScriptFieldType::Vector3: return 12;
+            case ScriptFieldType::Vector4: return 16;
+            default:                       return 0;
+            }
+        }
     }
 }
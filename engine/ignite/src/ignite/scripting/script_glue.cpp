@@ -2,6 +2,7 @@
 #include "script_engine.hpp"
 
 #include "ignite/scene/component.hpp"
+#include "ignite/scene/component_reflection.hpp"
 #include "ignite/scene/icomponent.hpp"
 #include "ignite/scene/scene.hpp"
 #include "ignite/scene/entity.hpp"
@@ -16,10 +17,6 @@
 
 #include <string>
 
-#ifdef __linux
-#include <cxxabi.h>
-#endif
-
 namespace ignite
 {
 #define SCRIPTING_ADD_INTERNAL_CALLS(method) mono_add_internal_call("Ignite.InternalCalls::"#method, reinterpret_cast<const void*>(method))
@@ -39,6 +36,10 @@ namespace ignite
     static std::unordered_map<MonoType *, std::function<bool(Entity)>> s_EntityHasComponentFuncs;
     static std::unordered_map<MonoType *, std::function<void(Entity)>> s_EntityAddComponentFuncs;
 
+    // reads or writes one ComponentInfo field, value points to its storage type
+    using ComponentFieldFunc = bool(*)(Entity entity, std::string_view fieldName, ComponentFieldType type, void *value, bool write);
+    static std::unordered_map<MonoType *, ComponentFieldFunc> s_ComponentFieldFuncs;
+
     // ==============================================
     // Entity
 
@@ -245,45 +246,162 @@ namespace ignite
         }
     }
 
+    // ==============================================
+    // Reflected component fields
+
+    template<typename T>
+    static bool AccessComponentField(Entity entity, std::string_view fieldName, ComponentFieldType type, void *value, bool write)
+    {
+        if (!entity.HasComponent<T>())
+            return false;
+
+        T &comp = entity.GetComponent<T>();
+        bool found = false;
+        ForEachField<T>([&](const auto &field)
+        {
+            using Field = std::decay_t<decltype(field)>;
+            if (found || Field::type != type || fieldName != field.name)
+                return;
+
+            found = true;
+            if (!write)
+            {
+                *static_cast<typename Field::StorageType *>(value) = ToFieldStorage(field.Get(comp));
+            }
+            else if (field.flags & FieldFlags_ReadOnly)
+            {
+                LOG_WARN("[Script Glue] {}.{} is read only", ComponentInfo<T>::name, field.name);
+            }
+            else
+            {
+                field.Get(comp) = FromFieldStorage<typename Field::ValueType>(*static_cast<const typename Field::StorageType *>(value));
+                comp.dirty = true;
+            }
+        });
+
+        return found;
+    }
+
+    static void AccessEntityComponentField(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, ComponentFieldType type, void *value, bool write)
+    {
+        Scene *scene = ScriptEngine::GetSceneContext();
+        LOG_ASSERT(scene, "[ScriptGlue] Invalid Scene");
+        Entity entity = SceneManager::GetEntity(scene, entityID);
+        if (!entity.IsValid())
+            return;
+
+        MonoType *managedType = mono_reflection_type_get_type(componentType);
+        auto it = s_ComponentFieldFuncs.find(managedType);
+        if (it == s_ComponentFieldFuncs.end())
+        {
+            LOG_ERROR("[Script Glue] Component type has no reflected fields");
+            return;
+        }
+
+        const std::string name = Utils::MonoStringToString(fieldName);
+        if (!it->second(entity, name, type, value, write))
+            LOG_ERROR("[Script Glue] Could not access component field {}", name);
+    }
+
+    static void Component_GetBool(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, bool *outValue)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Bool, outValue, false);
+    }
+
+    static void Component_SetBool(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, bool value)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Bool, &value, true);
+    }
+
+    static void Component_GetInt(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, i32 *outValue)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Int, outValue, false);
+    }
+
+    static void Component_SetInt(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, i32 value)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Int, &value, true);
+    }
+
+    static void Component_GetFloat(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, f32 *outValue)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Float, outValue, false);
+    }
+
+    static void Component_SetFloat(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, f32 value)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Float, &value, true);
+    }
+
+    static void Component_GetVector2(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, glm::vec2 *outValue)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Vec2, outValue, false);
+    }
+
+    static void Component_SetVector2(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, glm::vec2 value)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Vec2, &value, true);
+    }
+
+    static void Component_GetVector3(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, glm::vec3 *outValue)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Vec3, outValue, false);
+    }
+
+    static void Component_SetVector3(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, glm::vec3 value)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Vec3, &value, true);
+    }
+
+    static void Component_GetVector4(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, glm::vec4 *outValue)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Vec4, outValue, false);
+    }
+
+    static void Component_SetVector4(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, glm::vec4 value)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Vec4, &value, true);
+    }
+
+    static void Component_GetQuaternion(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, glm::quat *outValue)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Quat, outValue, false);
+    }
+
+    static void Component_SetQuaternion(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, glm::quat value)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::Quat, &value, true);
+    }
+
+    static void Component_GetULong(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, u64 *outValue)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::UInt64, outValue, false);
+    }
+
+    static void Component_SetULong(UUID entityID, MonoReflectionType *componentType, MonoString *fieldName, u64 value)
+    {
+        AccessEntityComponentField(entityID, componentType, fieldName, ComponentFieldType::UInt64, &value, true);
+    }
+
     template <typename... Component>
     static void RegisterComponent()
     {
         ([]()
             {
-                std::string_view typeName = typeid(Component).name();
-#ifdef OGN_PLATFORM_LINUX
-                int status = 0;
-                char *demangledName = abi::__cxa_demangle(typeName.data(), nullptr, nullptr, &status);
-                if (status == 0 && demangledName != nullptr)
-                {
-                    typeName = demangledName;
-                }
-                else
-                {
-                    LOG_ERROR("Could not demangle type name: {}", typeName);
-                    return;
-                }
-#endif
-                size_t pos = typeName.find_last_of(':');
-                std::string_view structName = (pos == std::string_view::npos) ? typeName : typeName.substr(pos + 1);
-
-                // Remove 'Component'
-                pos = structName.find("Component");
-                structName = structName.substr(0, pos);
-
-                std::string managedTypename = std::format("Ignite.{}", structName);
-                MonoType *managedType = mono_reflection_type_from_name(managedTypename.data(), ScriptEngine::GetCoreAssemblyImage());
-                if (!managedType)
+                if constexpr ((ComponentInfo<Component>::flags & ComponentFlags_NoScript) == 0)
                 {
-                    LOG_ERROR("[Script Glue] Could not find component type {}", managedTypename);
-                    return;
+                    // the managed classes are named after ComponentInfo
+                    std::string managedTypename = std::format("Ignite.{}", ComponentInfo<Component>::name);
+                    MonoType *managedType = mono_reflection_type_from_name(managedTypename.data(), ScriptEngine::GetCoreAssemblyImage());
+                    if (!managedType)
+                    {
+                        LOG_ERROR("[Script Glue] Could not find component type {}", managedTypename);
+                        return;
+                    }
+                    s_EntityHasComponentFuncs[managedType] = [](Entity entity) { return entity.HasComponent<Component>(); };
+                    s_EntityAddComponentFuncs[managedType] = [](Entity entity) { entity.AddOrReplaceComponent<Component>(); };
+                    s_ComponentFieldFuncs[managedType] = AccessComponentField<Component>;
                 }
-                s_EntityHasComponentFuncs[managedType] = [](Entity entity) { return entity.HasComponent<Component>(); };
-                s_EntityAddComponentFuncs[managedType] = [](Entity entity) { entity.AddOrReplaceComponent<Component>(); };
-#ifdef OGN_PLATFORM_LINUX
-                free(demangledName);
-#endif
-
             }(), ...);
     }
 
@@ -296,6 +414,8 @@ namespace ignite
     void ScriptGlue::RegisterComponents()
     {
         s_EntityHasComponentFuncs.clear();
+        s_EntityAddComponentFuncs.clear();
+        s_ComponentFieldFuncs.clear();
         RegisterComponent(AllComponents{});
     }
 
@@ -319,5 +439,23 @@ namespace ignite
         SCRIPTING_ADD_INTERNAL_CALLS(TransformComponent_SetEulerAngles);
         SCRIPTING_ADD_INTERNAL_CALLS(TransformComponent_GetScale);
         SCRIPTING_ADD_INTERNAL_CALLS(TransformComponent_SetScale);
+
+        // Reflected component fields
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_GetBool);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_SetBool);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_GetInt);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_SetInt);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_GetFloat);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_SetFloat);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_GetVector2);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_SetVector2);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_GetVector3);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_SetVector3);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_GetVector4);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_SetVector4);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_GetQuaternion);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_SetQuaternion);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_GetULong);
+        SCRIPTING_ADD_INTERNAL_CALLS(Component_SetULong);
     }
 }
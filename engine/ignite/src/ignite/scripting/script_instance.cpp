@@ -83,6 +83,16 @@ namespace ignite
         return true;
     }
 
+    void ScriptInstance::GetFieldValueRaw(MonoClassField *field, void *buffer) const
+    {
+        mono_field_get_value(m_Instance, field, buffer);
+    }
+
+    void ScriptInstance::SetFieldValueRaw(MonoClassField *field, const void *value)
+    {
+        mono_field_set_value(m_Instance, field, const_cast<void *>(value));
+    }
+
     bool ScriptInstance::SetFieldValueInternal(const std::string &name, const void *value)
     {
         const auto &fields = m_ScriptClass->GetFields();
@@ -77,6 +77,10 @@ namespace ignite
             SetFieldValueInternal(name, &value);
         }
 
+        // value type fields by their class field, without the lookup by name
+        void GetFieldValueRaw(MonoClassField *field, void *buffer) const;
+        void SetFieldValueRaw(MonoClassField *field, const void *value);
+
     private:
         bool GetFieldValueInternal(const std::string &name, void *buffer);
         bool SetFieldValueInternal(const std::string &name, const void *value);
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "serializer.hpp"
+
+#include "ignite/scene/component_reflection.hpp"
+
+#include <algorithm>
+
+namespace ignite {
+
+    // enums with names are written as their name unless the field asks for the value
+    template<typename Field>
+    void WriteYamlField(Serializer &sr, const Field &field, const typename Field::StorageType &value)
+    {
+        if constexpr (std::is_enum_v<typename Field::ValueType>)
+        {
+            const bool named = !field.enumNames.empty() && (field.flags & FieldFlags_EnumIndex) == 0;
+            if (named && value >= 0 && static_cast<size_t>(value) < field.enumNames.size())
+            {
+                sr.AddKeyValue(field.name, std::string(field.enumNames[value]));
+                return;
+            }
+        }
+
+        sr.AddKeyValue(field.name, value);
+    }
+
+    // false when the key is missing, unknown enum names read as the first value
+    template<typename Field>
+    bool ReadYamlField(const YAML::Node &node, const Field &field, typename Field::StorageType &outValue)
+    {
+        const YAML::Node valueNode = node[field.name];
+        if (!valueNode)
+            return false;
+
+        if constexpr (std::is_enum_v<typename Field::ValueType>)
+        {
+            if (!field.enumNames.empty() && (field.flags & FieldFlags_EnumIndex) == 0)
+            {
+                const std::string name = valueNode.as<std::string>();
+                auto it = std::find(field.enumNames.begin(), field.enumNames.end(), name);
+                outValue = it != field.enumNames.end() ? static_cast<i32>(it - field.enumNames.begin()) : 0;
+                return true;
+            }
+        }
+
+        outValue = valueNode.as<typename Field::StorageType>();
+        return true;
+    }
+
+    // writes the ComponentInfo fields of the component into the current map
+    template<typename T>
+    void SerializeComponentFields(Serializer &sr, const T &comp)
+    {
+        ForEachField<T>([&](const auto &field)
+        {
+            WriteYamlField(sr, field, ToFieldStorage(field.Get(comp)));
+        });
+    }
+
+    // missing keys keep the current value, files written before a field existed still load
+    template<typename T>
+    void DeserializeComponentFields(const YAML::Node &node, T &comp)
+    {
+        ForEachField<T>([&](const auto &field)
+        {
+            using Field = std::decay_t<decltype(field)>;
+
+            typename Field::StorageType value;
+            if (ReadYamlField(node, field, value))
+                field.Get(comp) = FromFieldStorage<typename Field::ValueType>(value);
+        });
+    }
+}
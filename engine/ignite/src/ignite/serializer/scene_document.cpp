@@ -0,0 +1,1124 @@
+#include "scene_document.hpp"
+#include "serializer.hpp"
+#include "component_serializer.hpp"
+
+#include "ignite/scripting/script_class.hpp"
+#include "ignite/scripting/script_engine.hpp"
+
+#include "ignite/scene/scene.hpp"
+#include "ignite/scene/entity.hpp"
+#include "ignite/scene/component.hpp"
+#include "ignite/scene/component_reflection.hpp"
+#include "ignite/scene/scene_manager.hpp"
+
+#include "ignite/core/logger.hpp"
+#include "ignite/core/vfs/mapped_file.hpp"
+#include "ignite/core/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <ranges>
+
+namespace ignite {
+
+    namespace
+    {
+        // raw storage of a ScriptFieldInstance
+        struct ScriptFieldValue
+        {
+            u8 bytes[16];
+        };
+
+        u64 AlignUp(u64 value, u64 alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        void Append(std::vector<u8> &out, const void *data, u64 size)
+        {
+            const u8 *bytes = static_cast<const u8 *>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+        void AppendPadding(std::vector<u8> &out)
+        {
+            out.resize(AlignUp(out.size(), 8), 0);
+        }
+
+        void AppendChunk(std::vector<u8> &out, SceneChunk id, const void *data, u32 count, u32 stride, u32 &chunkCount)
+        {
+            SceneChunkHeader header;
+            header.id = static_cast<u32>(id);
+            header.count = count;
+            header.stride = stride;
+            header.size = static_cast<u64>(count) * stride;
+
+            Append(out, &header, sizeof(header));
+            Append(out, data, header.size);
+            AppendPadding(out);
+            ++chunkCount;
+        }
+
+        template<typename T>
+        void AppendBlock(std::vector<u8> &out, SceneChunk id, const SceneComponentBlock<T> &block, u32 &chunkCount)
+        {
+            if (block.records.empty())
+                return;
+
+            const u64 indicesSize = AlignUp(block.entities.size() * sizeof(u32), 8);
+
+            SceneChunkHeader header;
+            header.id = static_cast<u32>(id);
+            header.count = static_cast<u32>(block.records.size());
+            header.stride = sizeof(T);
+            header.size = indicesSize + block.records.size() * sizeof(T);
+
+            Append(out, &header, sizeof(header));
+            Append(out, block.entities.data(), block.entities.size() * sizeof(u32));
+            AppendPadding(out);
+            Append(out, block.records.data(), block.records.size() * sizeof(T));
+            AppendPadding(out);
+            ++chunkCount;
+        }
+
+        // records written by an older build are shorter, the missing fields keep their defaults
+        template<typename T>
+        bool ReadRecords(const u8 *data, u64 size, u32 count, u32 stride, std::vector<T> &outRecords)
+        {
+            if (count > 0 && (stride == 0 || size < static_cast<u64>(count) * stride))
+                return false;
+
+            outRecords.clear();
+            outRecords.resize(count);
+
+            if (stride == sizeof(T))
+            {
+                std::memcpy(outRecords.data(), data, static_cast<size_t>(count) * sizeof(T));
+                return true;
+            }
+
+            const u32 copySize = std::min<u32>(stride, sizeof(T));
+            for (u32 i = 0; i < count; ++i)
+                std::memcpy(&outRecords[i], data + static_cast<u64>(i) * stride, copySize);
+            return true;
+        }
+
+        bool ReadEntityIndices(const u8 *data, u32 count, u32 entityCount, std::vector<u32> &outEntities)
+        {
+            outEntities.resize(count);
+            std::memcpy(outEntities.data(), data, count * sizeof(u32));
+
+            // one component per entity, in entity order
+            for (u32 i = 0; i < count; ++i)
+            {
+                if (outEntities[i] >= entityCount || (i > 0 && outEntities[i] <= outEntities[i - 1]))
+                    return false;
+            }
+            return true;
+        }
+
+        template<typename T>
+        bool ReadBlock(const SceneChunkHeader &header, const u8 *data, u32 entityCount, SceneComponentBlock<T> &outBlock)
+        {
+            const u64 indicesSize = AlignUp(static_cast<u64>(header.count) * sizeof(u32), 8);
+            if (header.size < indicesSize)
+                return false;
+
+            if (!ReadEntityIndices(data, header.count, entityCount, outBlock.entities))
+                return false;
+
+            return ReadRecords(data + indicesSize, header.size - indicesSize, header.count, header.stride, outBlock.records);
+        }
+
+        // records of a block that belong to entities [first, first + count)
+        std::pair<size_t, size_t> BlockRange(const std::vector<u32> &blockEntities, u32 first, u32 count)
+        {
+            auto begin = std::lower_bound(blockEntities.begin(), blockEntities.end(), first);
+            auto end = std::lower_bound(begin, blockEntities.end(), first + count);
+            return { static_cast<size_t>(begin - blockEntities.begin()), static_cast<size_t>(end - blockEntities.begin()) };
+        }
+
+        // fills one storage with a single insert, then registers the components like Entity::AddComponent does.
+        // handles[0] belongs to entity first, func gets the index of the record in the block
+        template<typename T, typename Func>
+        void InsertComponentRange(Scene *scene, const std::vector<entt::entity> &handles, u32 first, const std::vector<u32> &blockEntities, Func &&func)
+        {
+            const auto [begin, end] = BlockRange(blockEntities, first, static_cast<u32>(handles.size()));
+            if (begin == end)
+                return;
+
+            std::vector<entt::entity> targets;
+            targets.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i)
+                targets.push_back(handles[blockEntities[i] - first]);
+
+            std::vector<T> components(end - begin);
+            for (size_t i = begin; i < end; ++i)
+                func(components[i - begin], i);
+
+            scene->registry->insert<T>(targets.begin(), targets.end(), components.begin());
+
+            for (entt::entity handle : targets)
+            {
+                T &comp = scene->registry->get<T>(handle);
+                scene->registeredComps[handle].emplace_back(static_cast<IComponent *>(&comp));
+                scene->OnComponentAdded<T>(Entity{ handle, scene }, comp);
+            }
+        }
+
+        constexpr u32 GetPackedSize(ComponentFieldType type)
+        {
+            switch (type)
+            {
+            case ComponentFieldType::Bool:
+            case ComponentFieldType::Int:
+            case ComponentFieldType::Float: return 4;
+            case ComponentFieldType::Vec2:
+            case ComponentFieldType::String: // SceneString
+            case ComponentFieldType::UInt64: return 8;
+            case ComponentFieldType::Vec3: return 12;
+            case ComponentFieldType::Vec4:
+            case ComponentFieldType::Quat: return 16;
+            }
+            return 0;
+        }
+
+        // stride of a reflected record of T, the present mask and the values
+        template<typename T>
+        u32 GetReflectedSize()
+        {
+            return std::apply([](const auto &...field) { return (static_cast<u32>(sizeof(u32)) + ... + GetPackedSize(field.type)); }, ComponentInfo<T>::fields);
+        }
+
+        template<typename Storage>
+        void PackValue(SceneDocument &document, u8 *dst, const Storage &value)
+        {
+            if constexpr (std::is_same_v<Storage, bool>)
+            {
+                const u32 packed = value ? 1 : 0;
+                std::memcpy(dst, &packed, sizeof(packed));
+            }
+            else if constexpr (std::is_same_v<Storage, std::string>)
+            {
+                const SceneString packed = document.AddString(value);
+                std::memcpy(dst, &packed, sizeof(packed));
+            }
+            else
+            {
+                std::memcpy(dst, &value, sizeof(Storage));
+            }
+        }
+
+        template<typename Storage>
+        Storage UnpackValue(const SceneDocument &document, const u8 *src)
+        {
+            if constexpr (std::is_same_v<Storage, bool>)
+            {
+                u32 packed;
+                std::memcpy(&packed, src, sizeof(packed));
+                return packed != 0;
+            }
+            else if constexpr (std::is_same_v<Storage, std::string>)
+            {
+                SceneString packed;
+                std::memcpy(&packed, src, sizeof(packed));
+                return std::string(document.GetString(packed));
+            }
+            else
+            {
+                Storage value;
+                std::memcpy(&value, src, sizeof(Storage));
+                return value;
+            }
+        }
+
+        const SceneReflectedBlock *FindReflectedBlock(const SceneDocument &document, std::string_view component)
+        {
+            for (const SceneReflectedBlock &block : document.reflected)
+            {
+                if (document.GetString(block.component) == component)
+                    return &block;
+            }
+            return nullptr;
+        }
+
+        template<typename T>
+        SceneReflectedBlock &GetReflectedBlock(SceneDocument &document)
+        {
+            static_assert(GetFieldCount<T>() <= 32, "The present mask of a reflected record holds 32 fields");
+
+            for (SceneReflectedBlock &block : document.reflected)
+            {
+                if (document.GetString(block.component) == ComponentInfo<T>::name)
+                    return block;
+            }
+
+            SceneReflectedBlock &block = document.reflected.emplace_back();
+            block.component = document.AddString(ComponentInfo<T>::name);
+            block.stride = sizeof(u32);
+            ForEachField<T>([&](const auto &field)
+            {
+                SceneFieldRecord &fieldRecord = block.fields.emplace_back();
+                fieldRecord.name = document.AddString(field.name);
+                fieldRecord.type = static_cast<u32>(field.type);
+                fieldRecord.offset = block.stride;
+                block.stride += GetPackedSize(field.type);
+            });
+            return block;
+        }
+
+        // position of each ComponentInfo field in the field table of the block, -1 when the block does not have it
+        template<typename T>
+        std::vector<i32> MapReflectedFields(const SceneDocument &document, const SceneReflectedBlock &block)
+        {
+            std::vector<i32> mapping;
+            mapping.reserve(GetFieldCount<T>());
+            ForEachField<T>([&](const auto &field)
+            {
+                i32 &index = mapping.emplace_back(-1);
+                for (size_t i = 0; i < block.fields.size() && i < 32; ++i)
+                {
+                    const SceneFieldRecord &fieldRecord = block.fields[i];
+                    if (fieldRecord.type == static_cast<u32>(field.type) && document.GetString(fieldRecord.name) == field.name)
+                    {
+                        index = static_cast<i32>(i);
+                        break;
+                    }
+                }
+            });
+            return mapping;
+        }
+
+        // appends the record of the entity, or packs it again into the record it already has
+        template<typename T>
+        bool PackComponent(SceneDocument &document, u32 entity, const T &comp, bool append = true)
+        {
+            SceneReflectedBlock &block = GetReflectedBlock<T>(document);
+
+            u8 *record = nullptr;
+            if (append)
+            {
+                record = block.Add(entity);
+            }
+            else
+            {
+                auto it = std::lower_bound(block.entities.begin(), block.entities.end(), entity);
+                if (it == block.entities.end() || *it != entity)
+                    return false;
+                record = block.records.data() + static_cast<size_t>(it - block.entities.begin()) * block.stride;
+            }
+
+            u32 present = 0;
+            u32 index = 0;
+            ForEachField<T>([&](const auto &field)
+            {
+                PackValue(document, record + block.fields[index].offset, ToFieldStorage(field.Get(comp)));
+                present |= 1u << index++;
+            });
+            std::memcpy(record, &present, sizeof(present));
+            return true;
+        }
+
+        // straight from the YAML node, no component is built since this runs on the loader worker
+        template<typename T>
+        void PackYamlComponent(SceneDocument &document, u32 entity, const YAML::Node &node)
+        {
+            SceneReflectedBlock &block = GetReflectedBlock<T>(document);
+            u8 *record = block.Add(entity);
+
+            u32 present = 0;
+            u32 index = 0;
+            ForEachField<T>([&](const auto &field)
+            {
+                typename std::decay_t<decltype(field)>::StorageType value;
+                if (ReadYamlField(node, field, value))
+                {
+                    PackValue(document, record + block.fields[index].offset, value);
+                    present |= 1u << index;
+                }
+                ++index;
+            });
+            std::memcpy(record, &present, sizeof(present));
+        }
+
+        // fields missing from the record keep the component defaults
+        template<typename T>
+        void UnpackComponent(const SceneDocument &document, const SceneReflectedBlock &block, const std::vector<i32> &mapping, size_t record, T &comp)
+        {
+            const u8 *data = block.Record(record);
+            u32 present;
+            std::memcpy(&present, data, sizeof(present));
+
+            size_t index = 0;
+            ForEachField<T>([&](const auto &field)
+            {
+                using Field = std::decay_t<decltype(field)>;
+
+                const i32 i = mapping[index++];
+                if (i < 0 || (present & (1u << i)) == 0)
+                    return;
+
+                const typename Field::StorageType value = UnpackValue<typename Field::StorageType>(document, data + block.fields[i].offset);
+                if constexpr (std::is_enum_v<typename Field::ValueType>)
+                {
+                    // an enum the build does not know stays at its default
+                    if (!field.enumNames.empty() && (value < 0 || static_cast<size_t>(value) >= field.enumNames.size()))
+                        return;
+                }
+
+                field.Get(comp) = FromFieldStorage<typename Field::ValueType>(value);
+            });
+        }
+
+        // the fields of the record into the current map
+        template<typename T>
+        void WriteReflectedYaml(Serializer &sr, const SceneDocument &document, const SceneReflectedBlock &block, const std::vector<i32> &mapping, size_t record)
+        {
+            const u8 *data = block.Record(record);
+            u32 present;
+            std::memcpy(&present, data, sizeof(present));
+
+            size_t index = 0;
+            ForEachField<T>([&](const auto &field)
+            {
+                using Field = std::decay_t<decltype(field)>;
+
+                const i32 i = mapping[index++];
+                if (i >= 0 && (present & (1u << i)) != 0)
+                    WriteYamlField(sr, field, UnpackValue<typename Field::StorageType>(document, data + block.fields[i].offset));
+            });
+        }
+
+        void AppendReflectedBlock(std::vector<u8> &out, const SceneReflectedBlock &block, u32 &chunkCount)
+        {
+            if (block.entities.empty())
+                return;
+
+            // the table is a multiple of 16 bytes, the indices start aligned
+            const u64 tableSize = sizeof(SceneReflectedHeader) + block.fields.size() * sizeof(SceneFieldRecord);
+            const u64 indicesSize = AlignUp(block.entities.size() * sizeof(u32), 8);
+
+            SceneChunkHeader header;
+            header.id = static_cast<u32>(SceneChunk::Reflected);
+            header.count = static_cast<u32>(block.entities.size());
+            header.stride = block.stride;
+            header.size = tableSize + indicesSize + block.records.size();
+
+            SceneReflectedHeader reflectedHeader;
+            reflectedHeader.component = block.component;
+            reflectedHeader.fieldCount = static_cast<u32>(block.fields.size());
+
+            Append(out, &header, sizeof(header));
+            Append(out, &reflectedHeader, sizeof(reflectedHeader));
+            Append(out, block.fields.data(), block.fields.size() * sizeof(SceneFieldRecord));
+            Append(out, block.entities.data(), block.entities.size() * sizeof(u32));
+            AppendPadding(out);
+            Append(out, block.records.data(), block.records.size());
+            AppendPadding(out);
+            ++chunkCount;
+        }
+
+        bool ReadReflectedBlock(const SceneChunkHeader &header, const u8 *data, u32 entityCount, SceneReflectedBlock &outBlock)
+        {
+            SceneReflectedHeader reflectedHeader;
+            if (header.size < sizeof(reflectedHeader))
+                return false;
+
+            std::memcpy(&reflectedHeader, data, sizeof(reflectedHeader));
+
+            const u64 tableSize = sizeof(reflectedHeader) + static_cast<u64>(reflectedHeader.fieldCount) * sizeof(SceneFieldRecord);
+            const u64 indicesSize = AlignUp(static_cast<u64>(header.count) * sizeof(u32), 8);
+            const u64 recordsSize = static_cast<u64>(header.count) * header.stride;
+            if (header.stride < sizeof(u32) || header.size < tableSize + indicesSize + recordsSize)
+                return false;
+
+            outBlock.component = reflectedHeader.component;
+            outBlock.stride = header.stride;
+            outBlock.fields.resize(reflectedHeader.fieldCount);
+            std::memcpy(outBlock.fields.data(), data + sizeof(reflectedHeader), reflectedHeader.fieldCount * sizeof(SceneFieldRecord));
+
+            for (const SceneFieldRecord &field : outBlock.fields)
+            {
+                const u32 size = field.type <= static_cast<u32>(ComponentFieldType::UInt64) ? GetPackedSize(static_cast<ComponentFieldType>(field.type)) : 0;
+                if (size == 0 || field.offset < sizeof(u32) || static_cast<u64>(field.offset) + size > header.stride)
+                    return false;
+            }
+
+            if (!ReadEntityIndices(data + tableSize, header.count, entityCount, outBlock.entities))
+                return false;
+
+            const u8 *records = data + tableSize + indicesSize;
+            outBlock.records.assign(records, records + recordsSize);
+            return true;
+        }
+
+        // a reflected block and the next record to write
+        struct ReflectedCursor
+        {
+            const SceneReflectedBlock *block = nullptr;
+            std::vector<i32> mapping;
+            size_t cursor = 0;
+        };
+
+        template<typename T>
+        void StoreFieldValue(ScriptFieldRecord &record, const T &value)
+        {
+            static_assert(sizeof(T) <= sizeof(record.value), "Type too large!");
+            std::memcpy(record.value, &value, sizeof(T));
+        }
+
+        template<typename T>
+        T LoadFieldValue(const ScriptFieldRecord &record)
+        {
+            static_assert(sizeof(T) <= sizeof(record.value), "Type too large!");
+            T value;
+            std::memcpy(&value, record.value, sizeof(T));
+            return value;
+        }
+
+        void WriteScriptFieldsYaml(Serializer &sr, const SceneDocument &document, const ScriptRecord &record)
+        {
+            if (record.fieldCount == 0)
+                return;
+
+            sr.BeginSequence("Fields");
+            for (u32 f = record.firstField; f < record.firstField + record.fieldCount; ++f)
+            {
+                const ScriptFieldRecord &field = document.scriptFields[f];
+                const ScriptFieldType fieldType = static_cast<ScriptFieldType>(field.type);
+
+                sr.BeginMap();
+                sr.AddKeyValue("Name", std::string(document.GetString(field.name)));
+                sr.AddKeyValue("Type", Utils::ScriptFieldTypeToString(fieldType));
+
+                switch (fieldType)
+                {
+                case ScriptFieldType::Float: sr.AddKeyValue("Value", LoadFieldValue<float>(field)); break;
+                case ScriptFieldType::Double: sr.AddKeyValue("Value", LoadFieldValue<double>(field)); break;
+                case ScriptFieldType::Bool: sr.AddKeyValue("Value", LoadFieldValue<bool>(field)); break;
+                case ScriptFieldType::Char: sr.AddKeyValue("Value", LoadFieldValue<char>(field)); break;
+                case ScriptFieldType::Byte: sr.AddKeyValue("Value", LoadFieldValue<int8_t>(field)); break;
+                case ScriptFieldType::Short: sr.AddKeyValue("Value", LoadFieldValue<int16_t>(field)); break;
+                case ScriptFieldType::Long: sr.AddKeyValue("Value", LoadFieldValue<int64_t>(field)); break;
+                case ScriptFieldType::UByte: sr.AddKeyValue("Value", LoadFieldValue<uint8_t>(field)); break;
+                case ScriptFieldType::UShort: sr.AddKeyValue("Value", LoadFieldValue<uint16_t>(field)); break;
+                case ScriptFieldType::UInt: sr.AddKeyValue("Value", LoadFieldValue<uint32_t>(field)); break;
+                case ScriptFieldType::ULong: sr.AddKeyValue("Value", LoadFieldValue<uint64_t>(field)); break;
+                case ScriptFieldType::Int: sr.AddKeyValue("Value", LoadFieldValue<int>(field)); break;
+                case ScriptFieldType::Vector2: sr.AddKeyValue("Value", LoadFieldValue<glm::vec2>(field)); break;
+                case ScriptFieldType::Vector3: sr.AddKeyValue("Value", LoadFieldValue<glm::vec3>(field)); break;
+                case ScriptFieldType::Vector4: sr.AddKeyValue("Value", LoadFieldValue<glm::vec4>(field)); break;
+                case ScriptFieldType::Entity: sr.AddKeyValue("Value", LoadFieldValue<uint64_t>(field)); break;
+                default: break;
+                }
+
+                sr.EndMap();
+            }
+            sr.EndSequence();
+        }
+
+        // walks the blocks of a document alongside its entities, see SceneDocument::ToYaml
+        struct YamlEntityWriter
+        {
+            std::array<ReflectedCursor, s_ComponentTypes.size()> cursors; // one per component of AllComponents
+            size_t script = 0; // the field values of the Script components, same walk
+
+            explicit YamlEntityWriter(const SceneDocument &document)
+            {
+                size_t slot = 0;
+                ForEachComponentType(AllComponents{}, [&]<typename T>()
+                {
+                    ReflectedCursor &cursor = cursors[slot++];
+                    cursor.block = FindReflectedBlock(document, ComponentInfo<T>::name);
+                    if (cursor.block)
+                        cursor.mapping = MapReflectedFields<T>(document, *cursor.block);
+                });
+            }
+
+            // moves every cursor to the first record of entity index or after it
+            void Seek(const SceneDocument &document, u32 index)
+            {
+                for (ReflectedCursor &cursor : cursors)
+                {
+                    if (cursor.block)
+                        cursor.cursor = std::lower_bound(cursor.block->entities.begin(), cursor.block->entities.end(), index) - cursor.block->entities.begin();
+                }
+                script = std::lower_bound(document.scripts.entities.begin(), document.scripts.entities.end(), index) - document.scripts.entities.begin();
+            }
+
+            // entities are written in increasing order
+            void Write(Serializer &sr, const SceneDocument &document, u32 index)
+            {
+                const SceneEntityRecord &entityRecord = document.entities[index];
+
+                sr.BeginMap(); // START Entity
+                sr.AddKeyValue("ID", entityRecord.uuid);
+                sr.AddKeyValue("Name", std::string(document.GetString(entityRecord.name)));
+                sr.AddKeyValue("Type", EntityTypeToString(static_cast<EntityType>(entityRecord.type)));
+                sr.AddKeyValue("Parent", entityRecord.parent);
+
+                size_t slot = 0;
+                ForEachComponentType(AllComponents{}, [&]<typename T>()
+                {
+                    ReflectedCursor &cursor = cursors[slot++];
+                    const SceneReflectedBlock *block = cursor.block;
+                    if (!block || cursor.cursor >= block->Size() || block->entities[cursor.cursor] != index)
+                        return;
+
+                    sr.BeginMap(ComponentInfo<T>::name);
+                    WriteReflectedYaml<T>(sr, document, *block, cursor.mapping, cursor.cursor++);
+                    if constexpr (std::is_same_v<T, Script>)
+                    {
+                        while (script < document.scripts.Size() && document.scripts.entities[script] < index)
+                            ++script;
+                        if (script < document.scripts.Size() && document.scripts.entities[script] == index)
+                            WriteScriptFieldsYaml(sr, document, document.scripts.records[script]);
+                    }
+                    sr.EndMap();
+                });
+
+                sr.EndMap(); // END Entity
+            }
+        };
+
+        // the record of the entity in the block. a new document appends it, a repack finds the
+        // one the entity already has and gets null when it has none
+        template<typename Record>
+        Record *PackSlot(SceneComponentBlock<Record> &block, u32 entity, bool append)
+        {
+            if (append)
+                return &block.Add(entity);
+
+            auto it = std::lower_bound(block.entities.begin(), block.entities.end(), entity);
+            if (it == block.entities.end() || *it != entity)
+                return nullptr;
+            return &block.records[static_cast<size_t>(it - block.entities.begin())];
+        }
+
+        // false when a repack finds the records of the entity laid out for other components
+        bool PackEntity(SceneDocument &document, u32 index, Entity entity, bool append)
+        {
+            const ID &idComp = entity.GetComponent<ID>();
+
+            SceneEntityRecord &entityRecord = append ? document.entities.emplace_back() : document.entities[index];
+            entityRecord.uuid = static_cast<u64>(idComp.uuid);
+            entityRecord.parent = static_cast<u64>(idComp.parent);
+            entityRecord.name = document.AddString(idComp.name);
+            entityRecord.type = static_cast<u32>(idComp.type);
+
+            bool packed = true;
+            ForEachComponentType(AllComponents{}, [&]<typename T>()
+            {
+                if (entity.HasComponent<T>())
+                    packed = PackComponent(document, index, entity.GetComponent<T>(), append) && packed;
+            });
+            if (!packed)
+                return false;
+
+            if (entity.HasComponent<Script>())
+            {
+                const Script &comp = entity.GetComponent<Script>();
+                ScriptRecord *record = PackSlot(document.scripts, index, append);
+                if (!record)
+                    return false;
+
+                // same fields as the YAML serializer writes, a repack needs the same field count
+                const u32 firstField = append ? static_cast<u32>(document.scriptFields.size()) : record->firstField;
+                u32 fieldCount = 0;
+                if (const Ref<ScriptClass> scriptClass = ScriptEngine::GetEntityClassesByName(comp.className))
+                {
+                    const auto &classFields = scriptClass->GetFields();
+                    if (!classFields.empty())
+                    {
+                        ScriptFieldMap &fields = ScriptEngine::GetScriptFieldMap(entity);
+                        for (const auto &[fieldName, field] : classFields)
+                        {
+                            auto it = fields.find(fieldName);
+                            if (it == fields.end() || field.Type == ScriptFieldType::Invalid)
+                                continue;
+
+                            if (!append && fieldCount == record->fieldCount)
+                                return false;
+
+                            ScriptFieldRecord &fieldRecord = append ? document.scriptFields.emplace_back() : document.scriptFields[firstField + fieldCount];
+                            fieldRecord.name = document.AddString(fieldName);
+                            fieldRecord.type = static_cast<u32>(field.Type);
+                            StoreFieldValue(fieldRecord, it->second.GetValue<ScriptFieldValue>());
+                            ++fieldCount;
+                        }
+                    }
+                }
+
+                if (!append && fieldCount != record->fieldCount)
+                    return false;
+
+                record->firstField = firstField;
+                record->fieldCount = fieldCount;
+            }
+
+            return true;
+        }
+    }
+
+    SceneString SceneDocument::AddString(std::string_view str)
+    {
+        auto [it, inserted] = m_StringLookup.try_emplace(std::string(str));
+        if (inserted)
+        {
+            it->second.offset = static_cast<u32>(m_Strings.size());
+            it->second.length = static_cast<u32>(str.size());
+            m_Strings += str;
+        }
+        return it->second;
+    }
+
+    std::string_view SceneDocument::GetString(SceneString str) const
+    {
+        if (static_cast<u64>(str.offset) + str.length > m_Strings.size())
+            return {};
+        return std::string_view(m_Strings).substr(str.offset, str.length);
+    }
+
+    std::vector<u64> SceneDocument::GetAudioHandles() const
+    {
+        std::vector<u64> handles;
+        const SceneReflectedBlock *block = FindReflectedBlock(*this, ComponentInfo<AudioSource>::name);
+        if (!block)
+            return handles;
+
+        const std::vector<i32> mapping = MapReflectedFields<AudioSource>(*this, *block);
+        handles.reserve(block->Size());
+        for (size_t i = 0; i < block->Size(); ++i)
+        {
+            AudioSource comp;
+            UnpackComponent(*this, *block, mapping, i, comp);
+            handles.push_back(static_cast<u64>(comp.handle));
+        }
+        return handles;
+    }
+
+    SceneDocument SceneDocument::FromScene(Scene *scene)
+    {
+        IGN_PROFILE_FUNCTION();
+
+        SceneDocument document;
+        document.title = scene->name;
+        document.entities.reserve(scene->entities.size());
+
+        // UUID order, saving the same scene twice writes the same file
+        std::vector<std::pair<UUID, entt::entity>> sorted(scene->entities.begin(), scene->entities.end());
+        std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) { return static_cast<u64>(a.first) < static_cast<u64>(b.first); });
+
+        for (const auto &[uuid, e] : sorted)
+            PackEntity(document, static_cast<u32>(document.entities.size()), Entity{ e, scene }, true);
+
+        return document;
+    }
+
+    void SceneDocument::AppendEntity(Scene *scene, entt::entity handle)
+    {
+        PackEntity(*this, static_cast<u32>(entities.size()), Entity{ handle, scene }, true);
+    }
+
+    bool SceneDocument::RepackEntity(Scene *scene, u32 index, entt::entity handle)
+    {
+        if (index >= entities.size())
+            return false;
+
+        return PackEntity(*this, index, Entity{ handle, scene }, false);
+    }
+
+    Ref<Scene> SceneDocument::CreateScene() const
+    {
+        Ref<Scene> scene = Scene::Create(title);
+        CommitEntities(scene.get(), 0, static_cast<u32>(entities.size()));
+        LinkParents(scene.get(), 0, static_cast<u32>(entities.size()));
+        return scene;
+    }
+
+    void SceneDocument::CommitEntities(Scene *scene, u32 first, u32 count) const
+    {
+        if (first >= entities.size())
+            return;
+
+        count = std::min<u32>(count, static_cast<u32>(entities.size()) - first);
+        entt::registry &registry = *scene->registry;
+
+        std::vector<entt::entity> handles(count);
+        registry.create(handles.begin(), handles.end());
+
+        // every entity has an ID and a Transform, see SceneManager::CreateEntity
+        {
+            std::vector<ID> ids;
+            ids.reserve(count);
+            for (u32 i = first; i < first + count; ++i)
+            {
+                const SceneEntityRecord &record = entities[i];
+                ID &comp = ids.emplace_back(std::string(GetString(record.name)), static_cast<EntityType>(record.type), UUID(record.uuid));
+                comp.parent = UUID(record.parent);
+            }
+            registry.insert<ID>(handles.begin(), handles.end(), ids.begin());
+        }
+
+        {
+            std::vector<Transform> transformComps(count, Transform({ 0.0f, 0.0f, 0.0f }));
+            if (const SceneReflectedBlock *block = FindReflectedBlock(*this, ComponentInfo<Transform>::name))
+            {
+                const std::vector<i32> mapping = MapReflectedFields<Transform>(*this, *block);
+                const auto [begin, end] = BlockRange(block->entities, first, count);
+                for (size_t i = begin; i < end; ++i)
+                    UnpackComponent(*this, *block, mapping, i, transformComps[block->entities[i] - first]);
+            }
+            registry.insert<Transform>(handles.begin(), handles.end(), transformComps.begin());
+        }
+
+        scene->entities.reserve(scene->entities.size() + count);
+        for (u32 i = 0; i < count; ++i)
+        {
+            entt::entity handle = handles[i];
+            scene->entities[UUID(entities[first + i].uuid)] = handle;
+
+            std::vector<IComponent *> &regComps = scene->registeredComps[handle];
+            regComps.emplace_back(static_cast<IComponent *>(&registry.get<ID>(handle)));
+            regComps.emplace_back(static_cast<IComponent *>(&registry.get<Transform>(handle)));
+        }
+
+        // skinned meshes and mesh renderers are kept for the YAML round trip,
+        // the YAML loader does not restore them either
+        ForEachComponentType(AllComponents{}, [&]<typename T>()
+        {
+            if constexpr ((ComponentInfo<T>::flags & (ComponentFlags_Builtin | ComponentFlags_SaveOnly)) == 0)
+            {
+                const SceneReflectedBlock *block = FindReflectedBlock(*this, ComponentInfo<T>::name);
+                if (!block)
+                    return;
+
+                const std::vector<i32> mapping = MapReflectedFields<T>(*this, *block);
+                InsertComponentRange<T>(scene, handles, first, block->entities, [&](T &comp, size_t record)
+                {
+                    UnpackComponent(*this, *block, mapping, record, comp);
+                });
+            }
+        });
+
+        // the Script components exist now, their class gives the field types
+        const auto [scriptBegin, scriptEnd] = BlockRange(scripts.entities, first, count);
+        for (size_t i = scriptBegin; i < scriptEnd; ++i)
+        {
+            const ScriptRecord &record = scripts.records[i];
+            if (record.fieldCount == 0)
+                continue;
+
+            Entity entity = { handles[scripts.entities[i] - first], scene };
+            if (!entity.HasComponent<Script>())
+                continue;
+
+            Ref<ScriptClass> scriptClass = ScriptEngine::GetEntityClassesByName(entity.GetComponent<Script>().className);
+            if (!scriptClass)
+                continue;
+
+            const auto &classFields = scriptClass->GetFields();
+            ScriptFieldMap &fieldMap = ScriptEngine::GetScriptFieldMap(entity);
+
+            for (u32 f = record.firstField; f < record.firstField + record.fieldCount; ++f)
+            {
+                const ScriptFieldRecord &fieldRecord = scriptFields[f];
+                std::string fieldName = std::string(GetString(fieldRecord.name));
+
+                auto classField = classFields.find(fieldName);
+                if (classField == classFields.end())
+                    continue;
+
+                ScriptFieldInstance &fieldInstance = fieldMap[fieldName];
+                fieldInstance.Field = classField->second;
+                fieldInstance.SetValue(LoadFieldValue<ScriptFieldValue>(fieldRecord));
+            }
+        }
+    }
+
+    void SceneDocument::LinkParents(Scene *scene, u32 first, u32 count) const
+    {
+        const u32 last = static_cast<u32>(std::min<u64>(static_cast<u64>(first) + count, entities.size()));
+
+        // attach each node to it's parent
+        for (u32 i = first; i < last; ++i)
+        {
+            const UUID parentUUID = UUID(entities[i].parent);
+            if (parentUUID == UUID(0) || !scene->entities.contains(parentUUID))
+                continue;
+
+            Entity entity = SceneManager::GetEntity(scene, UUID(entities[i].uuid));
+            Entity parent = SceneManager::GetEntity(scene, parentUUID);
+            SceneManager::AddChild(scene, parent, entity);
+        }
+    }
+
+    bool SceneDocument::FromYaml(const YAML::Node &sceneFileNode, SceneDocument &outDocument)
+    {
+        IGN_PROFILE_FUNCTION();
+
+        YAML::Node sceneNode = sceneFileNode["Scene"];
+        if (!sceneNode)
+            return false;
+
+        outDocument = SceneDocument();
+        outDocument.title = sceneNode["Title"].as<std::string>();
+
+        for (YAML::Node entityNode : sceneNode["Entities"])
+            outDocument.AppendYamlEntity(entityNode);
+
+        return true;
+    }
+
+    void SceneDocument::AppendYamlEntity(const YAML::Node &entityNode)
+    {
+        const u32 index = static_cast<u32>(entities.size());
+        SceneEntityRecord &entityRecord = entities.emplace_back();
+        entityRecord.uuid = entityNode["ID"].as<uint64_t>();
+        entityRecord.name = AddString(entityNode["Name"].as<std::string>());
+        entityRecord.type = static_cast<u32>(EntityTypeFromString(entityNode["Type"].as<std::string>()));
+        entityRecord.parent = entityNode["Parent"].as<uint64_t>();
+
+        // missing keys are left out of the present mask, the component keeps its default
+        ForEachComponentType(AllComponents{}, [&]<typename T>()
+        {
+            if (YAML::Node node = entityNode[ComponentInfo<T>::name])
+                PackYamlComponent<T>(*this, index, node);
+        });
+
+        YAML::Node scriptNode = entityNode["Script"];
+        if (!scriptNode)
+            return;
+
+        ScriptRecord &record = scripts.Add(index);
+        record.firstField = static_cast<u32>(scriptFields.size());
+
+        for (YAML::Node fieldNode : scriptNode["Fields"])
+        {
+            const YAML::Node nameNode = fieldNode["Name"];
+            const YAML::Node typeNode = fieldNode["Type"];
+            const YAML::Node valueNode = fieldNode["Value"];
+            if (!nameNode || !typeNode || !valueNode)
+                continue;
+
+            const ScriptFieldType fieldType = Utils::ScriptFieldTypeFromString(typeNode.as<std::string>());
+            if (fieldType == ScriptFieldType::Invalid)
+                continue;
+
+            ScriptFieldRecord &fieldRecord = scriptFields.emplace_back();
+            fieldRecord.name = AddString(nameNode.as<std::string>());
+            fieldRecord.type = static_cast<u32>(fieldType);
+
+            switch (fieldType)
+            {
+            case ScriptFieldType::Float: StoreFieldValue(fieldRecord, valueNode.as<float>()); break;
+            case ScriptFieldType::Double: StoreFieldValue(fieldRecord, valueNode.as<double>()); break;
+            case ScriptFieldType::Bool: StoreFieldValue(fieldRecord, valueNode.as<bool>()); break;
+            case ScriptFieldType::Char: StoreFieldValue(fieldRecord, valueNode.as<char>()); break;
+            case ScriptFieldType::Byte: StoreFieldValue(fieldRecord, valueNode.as<int8_t>()); break;
+            case ScriptFieldType::Short: StoreFieldValue(fieldRecord, valueNode.as<int16_t>()); break;
+            case ScriptFieldType::Long: StoreFieldValue(fieldRecord, valueNode.as<int64_t>()); break;
+            case ScriptFieldType::UByte: StoreFieldValue(fieldRecord, valueNode.as<uint8_t>()); break;
+            case ScriptFieldType::UShort: StoreFieldValue(fieldRecord, valueNode.as<uint16_t>()); break;
+            case ScriptFieldType::UInt: StoreFieldValue(fieldRecord, valueNode.as<uint32_t>()); break;
+            case ScriptFieldType::ULong: StoreFieldValue(fieldRecord, valueNode.as<uint64_t>()); break;
+            case ScriptFieldType::Int: StoreFieldValue(fieldRecord, valueNode.as<int>()); break;
+            case ScriptFieldType::Entity: StoreFieldValue(fieldRecord, valueNode.as<uint64_t>()); break;
+            case ScriptFieldType::Vector2: StoreFieldValue(fieldRecord, valueNode.as<glm::vec2>()); break;
+            case ScriptFieldType::Vector3: StoreFieldValue(fieldRecord, valueNode.as<glm::vec3>()); break;
+            case ScriptFieldType::Vector4: StoreFieldValue(fieldRecord, valueNode.as<glm::vec4>()); break;
+            default: break;
+            }
+        }
+
+        record.fieldCount = static_cast<u32>(scriptFields.size()) - record.firstField;
+    }
+
+    void SceneDocument::ToYaml(Serializer &sr) const
+    {
+        sr.BeginMap(); // START
+
+        sr.BeginMap("Scene");
+        sr.AddKeyValue<std::string>("Version", ENGINE_VERSION);
+        sr.AddKeyValue<std::string>("Title", title);
+        sr.BeginSequence("Entities");
+
+        YamlEntityWriter writer(*this);
+        for (u32 index = 0; index < static_cast<u32>(entities.size()); ++index)
+            writer.Write(sr, *this, index);
+
+        sr.EndSequence(); // Entities
+        sr.EndMap(); // Scene
+
+        sr.EndMap(); // END
+    }
+
+    void SceneDocument::EntityToYaml(Serializer &sr, u32 index) const
+    {
+        if (index >= entities.size())
+            return;
+
+        YamlEntityWriter writer(*this);
+        writer.Seek(*this, index);
+        writer.Write(sr, *this, index);
+    }
+
+    bool SceneDocument::WriteBinary(const std::filesystem::path &filepath) const
+    {
+        IGN_PROFILE_FUNCTION();
+
+        // the title goes at the end of the string table
+        std::string strings = m_Strings;
+        SceneBinaryHeader header;
+        header.entityCount = static_cast<u32>(entities.size());
+        header.title = { static_cast<u32>(strings.size()), static_cast<u32>(title.size()) };
+        strings += title;
+
+        std::vector<u8> data;
+        data.reserve(sizeof(header) + strings.size() + entities.size() * (sizeof(SceneEntityRecord) + GetReflectedSize<Transform>() + 8));
+        data.resize(sizeof(header));
+
+        AppendChunk(data, SceneChunk::Strings, strings.data(), static_cast<u32>(strings.size()), 1, header.chunkCount);
+        AppendChunk(data, SceneChunk::Entities, entities.data(), static_cast<u32>(entities.size()), sizeof(SceneEntityRecord), header.chunkCount);
+        for (const SceneReflectedBlock &block : reflected)
+            AppendReflectedBlock(data, block, header.chunkCount);
+        AppendBlock(data, SceneChunk::Script, scripts, header.chunkCount);
+        if (!scriptFields.empty())
+            AppendChunk(data, SceneChunk::ScriptFields, scriptFields.data(), static_cast<u32>(scriptFields.size()), sizeof(ScriptFieldRecord), header.chunkCount);
+
+        std::memcpy(data.data(), &header, sizeof(header));
+
+        std::error_code ec;
+        if (filepath.has_parent_path())
+            std::filesystem::create_directories(filepath.parent_path(), ec);
+
+        std::filesystem::path tempFilepath = filepath;
+        tempFilepath += ".tmp";
+
+        {
+            std::ofstream file(tempFilepath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!file.good())
+            {
+                LOG_ERROR("[Scene SR] Failed to write {}", filepath.generic_string());
+                file.close();
+                std::filesystem::remove(tempFilepath, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempFilepath, filepath, ec);
+        if (ec)
+        {
+            LOG_ERROR("[Scene SR] Failed to write {}: {}", filepath.generic_string(), ec.message());
+            std::filesystem::remove(tempFilepath, ec);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool SceneDocument::ReadBinary(const std::filesystem::path &filepath, SceneDocument &outDocument)
+    {
+        Ref<vfs::MappedFile> mapped = vfs::MappedFile::Open(filepath);
+        if (!mapped)
+        {
+            LOG_ERROR("[Scene SR] Failed to open {}", filepath.generic_string());
+            return false;
+        }
+
+        if (!ReadBinary(mapped->Data(), mapped->Size(), outDocument))
+        {
+            LOG_ERROR("[Scene SR] Invalid binary scene {}", filepath.generic_string());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool SceneDocument::ReadBinary(const u8 *data, u64 size, SceneDocument &outDocument)
+    {
+        IGN_PROFILE_FUNCTION();
+
+        SceneBinaryHeader header;
+        if (size < sizeof(header))
+            return false;
+
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != IXSCENE_BINARY_MAGIC)
+            return false;
+
+        if (header.version > IXSCENE_BINARY_VERSION)
+        {
+            LOG_ERROR("[Scene SR] Binary scene version {} is newer than this build ({})", header.version, IXSCENE_BINARY_VERSION);
+            return false;
+        }
+
+        // version 1 had a record type per builtin component, those are reflected blocks now
+        if (header.version < IXSCENE_BINARY_VERSION)
+        {
+            LOG_ERROR("[Scene SR] Binary scene version {} is no longer supported, convert it again from its YAML scene", header.version);
+            return false;
+        }
+
+        outDocument = SceneDocument();
+        bool hasEntities = false;
+
+        u64 offset = sizeof(header);
+        for (u32 i = 0; i < header.chunkCount; ++i)
+        {
+            SceneChunkHeader chunk;
+            if (offset + sizeof(chunk) > size)
+                return false;
+
+            std::memcpy(&chunk, data + offset, sizeof(chunk));
+            offset += sizeof(chunk);
+
+            if (chunk.size > size - offset)
+                return false;
+
+            const u8 *payload = data + offset;
+            bool valid = true;
+
+            switch (static_cast<SceneChunk>(chunk.id))
+            {
+            case SceneChunk::Strings:
+                outDocument.m_Strings.assign(reinterpret_cast<const char *>(payload), static_cast<size_t>(chunk.size));
+                break;
+            case SceneChunk::Entities:
+                valid = chunk.count == header.entityCount && ReadRecords(payload, chunk.size, chunk.count, chunk.stride, outDocument.entities);
+                hasEntities = valid;
+                break;
+            case SceneChunk::Script: valid = ReadBlock(chunk, payload, header.entityCount, outDocument.scripts); break;
+            case SceneChunk::ScriptFields:
+                valid = ReadRecords(payload, chunk.size, chunk.count, chunk.stride, outDocument.scriptFields);
+                break;
+            case SceneChunk::Reflected:
+                valid = ReadReflectedBlock(chunk, payload, header.entityCount, outDocument.reflected.emplace_back());
+                break;
+            default:
+                // written by a newer build, nothing this one can use
+                break;
+            }
+
+            if (!valid)
+                return false;
+
+            offset += AlignUp(chunk.size, 8);
+        }
+
+        if (!hasEntities && header.entityCount > 0)
+            return false;
+
+        for (const ScriptRecord &record : outDocument.scripts.records)
+        {
+            if (static_cast<u64>(record.firstField) + record.fieldCount > outDocument.scriptFields.size())
+                return false;
+        }
+
+        outDocument.title = std::string(outDocument.GetString(header.title));
+        return true;
+    }
+}
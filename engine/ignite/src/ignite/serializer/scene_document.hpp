@@ -0,0 +1,209 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+
+#include <entt/entt.hpp>
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace YAML
+{
+    class Node;
+}
+
+namespace ignite
+{
+#define IXSCENE_BINARY_MAGIC 0x42435849 // "IXCB"
+#define IXSCENE_BINARY_VERSION 2
+#define IXSCENE_BINARY_EXTENSION ".ixbscene"
+
+    class Scene;
+    class Serializer;
+
+    constexpr u32 SceneChunkId(const char (&id)[5])
+    {
+        return static_cast<u32>(id[0]) | static_cast<u32>(id[1]) << 8 | static_cast<u32>(id[2]) << 16 | static_cast<u32>(id[3]) << 24;
+    }
+
+    // file layout: header, then chunks aligned to 8 bytes. unknown chunks are skipped,
+    // records only ever grow at the end and the stride tells the reader how much was written
+    enum class SceneChunk : u32
+    {
+        Strings = SceneChunkId("STRS"),
+        Entities = SceneChunkId("ENTS"),
+        Script = SceneChunkId("SCRP"),
+        ScriptFields = SceneChunkId("SFLD"),
+        Reflected = SceneChunkId("RFLC"), // one per component type of AllComponents
+    };
+
+    // range of the string table
+    struct SceneString
+    {
+        u32 offset = 0;
+        u32 length = 0;
+    };
+
+    struct SceneBinaryHeader
+    {
+        u32 magic = IXSCENE_BINARY_MAGIC;
+        u32 version = IXSCENE_BINARY_VERSION;
+        u32 chunkCount = 0;
+        u32 entityCount = 0;
+        SceneString title;
+        u64 reserved = 0;
+    };
+
+    // component chunks hold count entity indices (padded to 8 bytes) followed by count records
+    struct SceneChunkHeader
+    {
+        u32 id = 0;
+        u32 count = 0;
+        u32 stride = 0;
+        u32 reserved = 0;
+        u64 size = 0; // payload bytes, without padding
+    };
+
+    struct SceneEntityRecord
+    {
+        u64 uuid = 0;
+        u64 parent = 0;
+        SceneString name;
+        u32 type = 0;
+        u32 reserved = 0;
+    };
+
+    // the class name is in the Script reflected block, this is the range of its field values
+    struct ScriptRecord
+    {
+        u32 firstField = 0; // into SceneDocument::scriptFields
+        u32 fieldCount = 0;
+    };
+
+    struct ScriptFieldRecord
+    {
+        SceneString name;
+        u32 type = 0; // ScriptFieldType
+        u32 reserved = 0;
+        u8 value[16] = {}; // same bytes as ScriptFieldInstance
+    };
+
+    // one packed value of a reflected record
+    struct SceneFieldRecord
+    {
+        SceneString name;
+        u32 type = 0; // ComponentFieldType
+        u32 offset = 0; // into the record
+    };
+
+    // a reflected chunk starts with this and the field table, then the entity indices and records
+    struct SceneReflectedHeader
+    {
+        SceneString component;
+        u32 fieldCount = 0;
+        u32 reserved = 0;
+    };
+
+    static_assert(sizeof(SceneBinaryHeader) == 32);
+    static_assert(sizeof(SceneChunkHeader) == 24);
+    static_assert(sizeof(SceneEntityRecord) == 32);
+    static_assert(sizeof(ScriptRecord) == 8);
+    static_assert(sizeof(ScriptFieldRecord) == 32);
+    static_assert(sizeof(SceneFieldRecord) == 16);
+    static_assert(sizeof(SceneReflectedHeader) == 16);
+
+    template<typename T>
+    struct SceneComponentBlock
+    {
+        std::vector<u32> entities; // increasing indices into SceneDocument::entities
+        std::vector<T> records;
+
+        T &Add(u32 entity)
+        {
+            entities.push_back(entity);
+            return records.emplace_back();
+        }
+
+        [[nodiscard]] size_t Size() const { return records.size(); }
+    };
+
+    // Components packed from the fields of their ComponentInfo.
+    // A record is a u32 mask of the fields present followed by the values. The field
+    // table travels with the block and fields are matched by name and type on load,
+    // so fields can be added or reordered without a new format version.
+    struct SceneReflectedBlock
+    {
+        SceneString component; // ComponentInfo<T>::name
+        std::vector<SceneFieldRecord> fields;
+        u32 stride = 0;
+
+        std::vector<u32> entities; // increasing indices into SceneDocument::entities
+        std::vector<u8> records;
+
+        u8 *Add(u32 entity)
+        {
+            entities.push_back(entity);
+            records.resize(records.size() + stride, 0);
+            return records.data() + records.size() - stride;
+        }
+
+        [[nodiscard]] const u8 *Record(size_t index) const { return records.data() + index * stride; }
+        [[nodiscard]] size_t Size() const { return entities.size(); }
+    };
+
+    // Plain data form of a scene, one array per component type. Both the YAML source
+    // and the binary .ixbscene go through it, the binary form is read without parsing
+    // and turned into a scene with one bulk insert per component storage.
+    class SceneDocument
+    {
+    public:
+        std::string title;
+        std::vector<SceneEntityRecord> entities;
+
+        std::vector<SceneReflectedBlock> reflected;
+        SceneComponentBlock<ScriptRecord> scripts;
+        std::vector<ScriptFieldRecord> scriptFields;
+
+        // equal strings share one range
+        SceneString AddString(std::string_view str);
+        [[nodiscard]] std::string_view GetString(SceneString str) const;
+        [[nodiscard]] size_t GetStringTableSize() const { return m_Strings.size(); }
+
+        // AudioSource handles, read ahead of the commit
+        [[nodiscard]] std::vector<u64> GetAudioHandles() const;
+
+        // entities in UUID order
+        static SceneDocument FromScene(Scene *scene);
+
+        // packs the entity after the ones the document already has, callers keep UUID order
+        void AppendEntity(Scene *scene, entt::entity handle);
+
+        // packs entity index again from the scene, in the records it already has. false when
+        // the entity has different components or script fields than when it was packed
+        bool RepackEntity(Scene *scene, u32 index, entt::entity handle);
+
+        Ref<Scene> CreateScene() const;
+
+        // creates entities [first, first + count) with their components, parents are linked
+        // separately once every entity exists, see SceneLoader for the time sliced use
+        void CommitEntities(Scene *scene, u32 first, u32 count) const;
+        void LinkParents(Scene *scene, u32 first, u32 count) const;
+
+        // false when the file node has no scene, yaml-cpp throws on malformed values
+        static bool FromYaml(const YAML::Node &sceneFileNode, SceneDocument &outDocument);
+        void AppendYamlEntity(const YAML::Node &entityNode);
+        void ToYaml(Serializer &sr) const;
+        void EntityToYaml(Serializer &sr, u32 index) const; // one element of the Entities sequence
+
+        bool WriteBinary(const std::filesystem::path &filepath) const;
+        static bool ReadBinary(const std::filesystem::path &filepath, SceneDocument &outDocument);
+        static bool ReadBinary(const u8 *data, u64 size, SceneDocument &outDocument);
+
+    private:
+        std::string m_Strings;
+        std::unordered_map<std::string, SceneString> m_StringLookup;
+    };
+}
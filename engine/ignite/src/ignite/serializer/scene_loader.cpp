@@ -0,0 +1,348 @@
+#include "scene_loader.hpp"
+#include "scene_document.hpp"
+#include "serializer.hpp"
+
+#include "ignite/scene/scene.hpp"
+#include "ignite/project/project.hpp"
+
+#include "ignite/core/logger.hpp"
+#include "ignite/core/time.hpp"
+#include "ignite/core/job_system.hpp"
+#include "ignite/core/profiler.hpp"
+#include "ignite/core/vfs/async_reader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <spanstream>
+
+namespace ignite {
+
+    struct SceneLoadState
+    {
+        std::mutex mutex;
+        std::deque<Scope<SceneDocument>> staged; // parsed, waiting for the main thread
+        std::string title;
+        bool parsed = false; // the parse job has published its last batch
+        bool failed = false;
+
+        // consumed batches are freed by a job, see ReleaseBatches
+        std::vector<Scope<SceneDocument>> retired;
+        bool closed = false; // the loader takes no more batches
+
+        std::atomic<bool> canceled = false;
+        std::atomic<u32> entityCount = 0;
+
+        JobCounter jobs; // the parse job and the release jobs, waited for by the loader
+    };
+
+    namespace
+    {
+        void Publish(SceneLoadState &state, Scope<SceneDocument> batch)
+        {
+            std::scoped_lock lock(state.mutex);
+            state.staged.push_back(std::move(batch));
+        }
+
+        // freeing the batches on the main thread right after the YAML document was torn down
+        // makes the allocator consolidate the whole document there, which stalls a frame for
+        // hundreds of milliseconds on large scenes
+        void ReleaseBatches(SceneLoadState &state)
+        {
+            // freed outside the lock when they go out of scope
+            std::vector<Scope<SceneDocument>> retired;
+            std::deque<Scope<SceneDocument>> staged;
+            {
+                std::scoped_lock lock(state.mutex);
+                retired.swap(state.retired);
+
+                // batches published after the loader was closed
+                if (state.closed)
+                    staged.swap(state.staged);
+            }
+        }
+
+        // job, only touches the shared state and stops at the next entity once canceled
+        void ParseScene(const Ref<SceneLoadState> &state, const std::filesystem::path &filepath, vfs::ReadFuture read)
+        {
+            Ref<vfs::IBlob> data = read.get();
+            bool failed = false;
+
+            if (vfs::IBlob::IsEmpty(data.get()))
+            {
+                LOG_ERROR("[Scene Loader] Failed to open {}", filepath.generic_string());
+                failed = true;
+            }
+            else if (filepath.extension() == IXSCENE_BINARY_EXTENSION)
+            {
+                // already in record form, handed over as a single batch
+                Scope<SceneDocument> document = CreateScope<SceneDocument>();
+                if (SceneDocument::ReadBinary(static_cast<const u8 *>(data->Data()), data->Size(), *document))
+                {
+                    {
+                        std::scoped_lock lock(state->mutex);
+                        state->title = document->title;
+                    }
+                    state->entityCount = static_cast<u32>(document->entities.size());
+                    Publish(*state, std::move(document));
+                }
+                else
+                {
+                    LOG_ERROR("[Scene Loader] Invalid binary scene {}", filepath.generic_string());
+                    failed = true;
+                }
+            }
+            else
+            {
+                // yaml-cpp has no incremental reader, the document is parsed in one go and
+                // the entities are converted and handed over batch by batch after that
+                try
+                {
+                    std::ispanstream stream(std::span(static_cast<const char *>(data->Data()), data->Size()));
+                    YAML::Node sceneFileNode = YAML::Load(stream);
+                    YAML::Node sceneNode = sceneFileNode["Scene"];
+                    if (!sceneNode)
+                    {
+                        LOG_ERROR("[Scene Loader] Invalid scene file {}", filepath.generic_string());
+                        failed = true;
+                    }
+                    else
+                    {
+                        const std::string title = sceneNode["Title"].as<std::string>();
+                        {
+                            std::scoped_lock lock(state->mutex);
+                            state->title = title;
+                        }
+
+                        YAML::Node entitiesNode = sceneNode["Entities"];
+                        state->entityCount = static_cast<u32>(entitiesNode.size());
+
+                        Scope<SceneDocument> batch;
+                        for (YAML::Node entityNode : entitiesNode)
+                        {
+                            if (state->canceled)
+                                break;
+
+                            if (!batch)
+                            {
+                                batch = CreateScope<SceneDocument>();
+                                batch->title = title;
+                            }
+
+                            batch->AppendYamlEntity(entityNode);
+                            if (batch->entities.size() == SCENE_LOADER_BATCH_SIZE)
+                                Publish(*state, std::move(batch));
+                        }
+
+                        if (batch && !state->canceled)
+                            Publish(*state, std::move(batch));
+                    }
+                }
+                catch (const YAML::Exception &e)
+                {
+                    LOG_ERROR("[Scene Loader] Failed to parse {}: {}", filepath.generic_string(), e.what());
+                    failed = true;
+                }
+            }
+
+            {
+                std::scoped_lock lock(state->mutex);
+                state->parsed = true;
+                state->failed = failed;
+            }
+
+            data.reset();
+            read = {};
+            ReleaseBatches(*state);
+        }
+
+        void StartRelease(const Ref<SceneLoadState> &state)
+        {
+            JobSystem::Run([state]() { ReleaseBatches(*state); }, &state->jobs);
+        }
+    }
+
+    SceneLoader::SceneLoader(const std::filesystem::path &filepath)
+        : m_Filepath(filepath), m_State(CreateRef<SceneLoadState>())
+    {
+        // a private copy instead of a mapping, a canceled parse job may still be running
+        // when the editor saves over the same file
+        vfs::ReadFuture read = vfs::AsyncReader::Submit(nullptr, { { m_Filepath, nullptr } }).front();
+        JobSystem::Run([state = m_State, filepath = m_Filepath, read = std::move(read)]() mutable { ParseScene(state, filepath, std::move(read)); }, &m_State->jobs);
+    }
+
+    SceneLoader::~SceneLoader()
+    {
+        // the parse job stops at the next entity
+        m_State->canceled = true;
+        if (m_Status == SceneLoadStatus::Loading)
+            Close();
+
+        JobSystem::Wait(m_State->jobs);
+    }
+
+    bool SceneLoader::Update(f64 budgetMs)
+    {
+        IGN_PROFILE_FUNCTION();
+
+        if (m_Status != SceneLoadStatus::Loading)
+            return true;
+
+        if (m_State->canceled)
+        {
+            Finish(SceneLoadStatus::Canceled);
+            return true;
+        }
+
+        Timer timer;
+        while (timer.ElapsedMillis() < budgetMs)
+        {
+            // take over what the parse job has staged so far
+            bool parsed, failed;
+            std::string title;
+            const size_t stagedBatch = m_Batches.size();
+            {
+                std::scoped_lock lock(m_State->mutex);
+                while (!m_State->staged.empty())
+                {
+                    m_Batches.push_back(std::move(m_State->staged.front()));
+                    m_State->staged.pop_front();
+                }
+                parsed = m_State->parsed;
+                failed = m_State->failed;
+                if (!m_Scene)
+                    title = m_State->title;
+            }
+
+            if (failed)
+            {
+                Finish(SceneLoadStatus::Failed);
+                return true;
+            }
+
+            for (size_t i = stagedBatch; i < m_Batches.size(); ++i)
+                PrefetchAssets(*m_Batches[i]);
+
+            if (m_CommitBatch < m_Batches.size())
+            {
+                if (!m_Scene)
+                    m_Scene = Scene::Create(m_Batches.front()->title);
+
+                const SceneDocument &batch = *m_Batches[m_CommitBatch];
+                const u32 count = std::min<u32>(SCENE_LOADER_COMMIT_STEP, static_cast<u32>(batch.entities.size()) - m_CommitCursor);
+                batch.CommitEntities(m_Scene.get(), m_CommitCursor, count);
+
+                m_CommitCursor += count;
+                m_CommittedCount += count;
+                if (m_CommitCursor >= batch.entities.size())
+                {
+                    ++m_CommitBatch;
+                    m_CommitCursor = 0;
+                }
+                continue;
+            }
+
+            if (!parsed)
+                break; // nothing staged yet, try again next frame
+
+            // every entity exists, parents may live in any batch
+            if (!m_Scene)
+                m_Scene = Scene::Create(title);
+
+            if (m_LinkBatch < m_Batches.size())
+            {
+                const SceneDocument &batch = *m_Batches[m_LinkBatch];
+                batch.LinkParents(m_Scene.get(), m_LinkCursor, SCENE_LOADER_COMMIT_STEP);
+
+                m_LinkCursor += SCENE_LOADER_COMMIT_STEP;
+                if (m_LinkCursor >= batch.entities.size())
+                {
+                    Retire(std::move(m_Batches[m_LinkBatch++]));
+                    m_LinkCursor = 0;
+                }
+                continue;
+            }
+
+            Finish(SceneLoadStatus::Ready);
+            return true;
+        }
+
+        return false;
+    }
+
+    void SceneLoader::Cancel()
+    {
+        m_State->canceled = true;
+    }
+
+    f32 SceneLoader::GetProgress() const
+    {
+        if (m_Status == SceneLoadStatus::Ready)
+            return 1.0f;
+
+        const u32 entityCount = m_State->entityCount;
+        if (entityCount == 0)
+            return 0.0f;
+
+        // linking is the last step and takes a fraction of the commit, leave room for it
+        return 0.95f * static_cast<f32>(m_CommittedCount) / static_cast<f32>(entityCount);
+    }
+
+    u32 SceneLoader::GetEntityCount() const
+    {
+        return m_State->entityCount;
+    }
+
+    void SceneLoader::PrefetchAssets(const SceneDocument &batch)
+    {
+        Project *project = Project::GetActive();
+        if (!project)
+            return;
+
+        const std::vector<u64> audioHandles = batch.GetAudioHandles();
+        if (audioHandles.empty())
+            return;
+
+        // read while the batches before this one are committed
+        std::vector<AssetHandle> handles;
+        handles.reserve(audioHandles.size());
+        for (u64 handle : audioHandles)
+            handles.push_back(AssetHandle(handle));
+
+        project->GetAssetManager().Prefetch(handles);
+    }
+
+    void SceneLoader::Finish(SceneLoadStatus status)
+    {
+        m_Status = status;
+        if (status != SceneLoadStatus::Ready)
+            m_Scene.reset();
+
+        Close();
+    }
+
+    void SceneLoader::Retire(Scope<SceneDocument> batch)
+    {
+        {
+            std::scoped_lock lock(m_State->mutex);
+            m_State->retired.push_back(std::move(batch));
+        }
+        StartRelease(m_State);
+    }
+
+    void SceneLoader::Close()
+    {
+        {
+            std::scoped_lock lock(m_State->mutex);
+            for (Scope<SceneDocument> &batch : m_Batches)
+            {
+                if (batch)
+                    m_State->retired.push_back(std::move(batch));
+            }
+            m_State->closed = true;
+        }
+        StartRelease(m_State);
+        m_Batches.clear();
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+
+#include <filesystem>
+#include <vector>
+
+namespace ignite {
+
+#define SCENE_LOADER_FRAME_BUDGET_MS 4.0
+#define SCENE_LOADER_BATCH_SIZE 512 // entities per staged document handed over by the parse job
+#define SCENE_LOADER_COMMIT_STEP 64 // entities per bulk insert, the budget is checked between steps
+
+    class Scene;
+    class SceneDocument;
+    struct SceneLoadState;
+
+    enum class SceneLoadStatus : u8
+    {
+        Loading, // parsing on a job or committing on the main thread
+        Ready,
+        Failed,
+        Canceled
+    };
+
+    // Opens a .ixscene or .ixbscene without stalling the frame. A job parses entities into
+    // staged SceneDocument batches while the main thread commits them to the registry in Update,
+    // a few bulk inserts per call, so a frame never spends more than the budget on the scene.
+    class SceneLoader
+    {
+    public:
+        explicit SceneLoader(const std::filesystem::path &filepath);
+        ~SceneLoader();
+
+        SceneLoader(const SceneLoader &) = delete;
+        SceneLoader &operator=(const SceneLoader &) = delete;
+
+        // main thread, once per frame. true when ready, failed or canceled
+        bool Update(f64 budgetMs = SCENE_LOADER_FRAME_BUDGET_MS);
+
+        // the parse job stops at the next entity and the partly built scene is dropped
+        void Cancel();
+
+        [[nodiscard]] SceneLoadStatus GetStatus() const { return m_Status; }
+        [[nodiscard]] bool IsDone() const { return m_Status != SceneLoadStatus::Loading; }
+
+        // committed entities over the entities in the file, zero until the file is parsed
+        [[nodiscard]] f32 GetProgress() const;
+        [[nodiscard]] u32 GetEntityCount() const;
+        [[nodiscard]] u32 GetCommittedCount() const { return m_CommittedCount; }
+
+        // null until ready
+        [[nodiscard]] Ref<Scene> GetScene() const { return m_Status == SceneLoadStatus::Ready ? m_Scene : nullptr; }
+        [[nodiscard]] const std::filesystem::path &GetFilepath() const { return m_Filepath; }
+
+    private:
+        // starts reading the assets a staged batch references
+        void PrefetchAssets(const SceneDocument &batch);
+        void Finish(SceneLoadStatus status);
+        void Retire(Scope<SceneDocument> batch);
+        void Close();
+
+        std::filesystem::path m_Filepath;
+        Ref<SceneLoadState> m_State; // shared with the parse and release jobs, waited for on destruction
+
+        SceneLoadStatus m_Status = SceneLoadStatus::Loading;
+        Ref<Scene> m_Scene;
+
+        // batches stay alive until their parents are linked, then are freed by a job
+        std::vector<Scope<SceneDocument>> m_Batches;
+        size_t m_CommitBatch = 0;
+        u32 m_CommitCursor = 0;
+        size_t m_LinkBatch = 0;
+        u32 m_LinkCursor = 0;
+        u32 m_CommittedCount = 0;
+    };
+}
@@ -0,0 +1,105 @@
+#include "scene_save_cache.hpp"
+
+#include "ignite/scripting/script_class.hpp"
+#include "ignite/scripting/script_engine.hpp"
+#include "ignite/scene/scene.hpp"
+#include "ignite/scene/entity.hpp"
+#include "ignite/scene/component.hpp"
+#include "ignite/scene/component_reflection.hpp"
+#include "ignite/core/hash.hpp"
+
+#include <algorithm>
+
+namespace ignite {
+
+    namespace
+    {
+        // raw storage of a ScriptFieldInstance
+        struct ScriptFieldValue
+        {
+            u8 bytes[16];
+        };
+
+        template<typename Storage>
+        u64 HashFieldValue(u64 hash, const Storage &value)
+        {
+            if constexpr (std::is_same_v<Storage, std::string>)
+                return HashString(value, hash);
+            else
+                return HashBytes(&value, sizeof(value), hash);
+        }
+
+        // the fields SerializeScriptFields writes, in the same order
+        u64 HashScriptFields(u64 hash, Entity entity, const Script &comp)
+        {
+            const Ref<ScriptClass> scriptClass = ScriptEngine::GetEntityClassesByName(comp.className);
+            if (!scriptClass)
+                return hash;
+
+            const auto &classFields = scriptClass->GetFields();
+            if (classFields.empty())
+                return hash;
+
+            ScriptFieldMap &fields = ScriptEngine::GetScriptFieldMap(entity);
+            for (const auto &[fieldName, field] : classFields)
+            {
+                auto it = fields.find(fieldName);
+                if (it == fields.end() || field.Type == ScriptFieldType::Invalid)
+                    continue;
+
+                const ScriptFieldValue value = it->second.GetValue<ScriptFieldValue>();
+                hash = HashString(fieldName, hash);
+                hash = HashCombine(hash, static_cast<u64>(field.Type));
+                hash = HashBytes(value.bytes, sizeof(value.bytes), hash);
+            }
+            return hash;
+        }
+    }
+
+    std::vector<SceneSaveEntity> GatherSaveEntities(Scene *scene)
+    {
+        std::vector<SceneSaveEntity> saveEntities;
+        saveEntities.reserve(scene->entities.size());
+        for (const auto &[uuid, handle] : scene->entities)
+            saveEntities.push_back({ uuid, handle });
+
+        std::sort(saveEntities.begin(), saveEntities.end(), [](const SceneSaveEntity &a, const SceneSaveEntity &b)
+        {
+            return static_cast<u64>(a.uuid) < static_cast<u64>(b.uuid);
+        });
+
+        entt::registry &registry = *scene->registry;
+        for (SceneSaveEntity &saveEntity : saveEntities)
+        {
+            const ID &idComp = registry.get<ID>(saveEntity.handle);
+
+            u64 hash = HashString(idComp.name);
+            hash = HashCombine(hash, static_cast<u64>(idComp.uuid));
+            hash = HashCombine(hash, static_cast<u64>(idComp.type));
+            hash = HashCombine(hash, static_cast<u64>(idComp.parent));
+
+            u32 bit = 0;
+            ForEachComponentType(AllComponents{}, [&]<typename T>()
+            {
+                const u32 index = bit++;
+                const T *comp = registry.try_get<T>(saveEntity.handle);
+                if (!comp)
+                    return;
+
+                saveEntity.components |= 1ull << index;
+                hash = HashCombine(hash, static_cast<u64>(T::StaticType()));
+                ForEachField<T>([&](const auto &field)
+                {
+                    hash = HashFieldValue(hash, ToFieldStorage(field.Get(*comp)));
+                });
+
+                if constexpr (std::is_same_v<T, Script>)
+                    hash = HashScriptFields(hash, Entity{ saveEntity.handle, scene }, *comp);
+            });
+
+            saveEntity.hash = hash;
+        }
+
+        return saveEntities;
+    }
+}
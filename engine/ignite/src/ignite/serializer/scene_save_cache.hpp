@@ -0,0 +1,77 @@
+#pragma once
+
+#include "scene_document.hpp"
+
+#include "ignite/core/types.hpp"
+#include "ignite/core/uuid.hpp"
+
+#include <entt/entt.hpp>
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ignite {
+
+#define SCENE_SAVE_STRING_GROWTH 2 // the binary document is packed again from scratch once renames doubled its string table
+
+    class Scene;
+
+    // one entity as it is about to be saved
+    struct SceneSaveEntity
+    {
+        UUID uuid;
+        entt::entity handle = entt::null;
+        u64 hash = 0; // ID, every saved component field and the script field values
+        u64 components = 0; // bit per AllComponents index
+    };
+
+    // every entity of the scene in UUID order, with the hash of what a save writes for it
+    std::vector<SceneSaveEntity> GatherSaveEntities(Scene *scene);
+
+    // What a save writes, detached from the scene so it can be written on a worker. The YAML
+    // blocks and the binary document are shared with the SceneSaveCache, which never changes
+    // them once captured: a later save replaces a block, or copies the document first.
+    struct SceneSaveSnapshot
+    {
+        std::filesystem::path filepath;
+        std::vector<std::filesystem::path> dependencies; // recorded in the dependency graph once written
+
+        std::string yamlHeader;
+        std::vector<Ref<const std::string>> yamlBlocks; // null for the entities of yamlDocument until written
+
+        // entities changed since the last save, packed on the main thread and emitted by WriteSnapshot
+        Scope<SceneDocument> yamlDocument;
+        std::vector<u32> yamlDocumentBlocks; // index into yamlBlocks of each entity
+        std::vector<u64> yamlDocumentHashes;
+
+        Ref<const SceneDocument> binaryDocument; // set for binary saves
+    };
+
+    // What the last save of a scene wrote, kept on the scene. A save hashes every entity and
+    // only emits the ones whose hash changed, so dirty tracking covers every way of editing
+    // a component. Nothing here depends on the file, saving to a new path reuses it as well.
+    class SceneSaveCache
+    {
+    public:
+        // an element of the Entities sequence, already at the indent of the file
+        struct YamlEntity
+        {
+            u64 hash = 0;
+            Ref<const std::string> text;
+        };
+
+        std::unordered_map<UUID, YamlEntity> yamlEntities;
+
+        // the document of the last binary save, entities repacked in place when only values changed
+        Ref<SceneDocument> binaryDocument;
+        std::vector<u64> binaryHashes;
+        std::vector<u64> binaryComponents;
+        size_t binaryStringTableSize = 0; // right after the last full pack
+        bool binaryValid = false;
+
+        // entities emitted or repacked by the last save
+        u32 lastEncodedCount = 0;
+    };
+}
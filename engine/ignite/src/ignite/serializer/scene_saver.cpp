@@ -0,0 +1,54 @@
+#include "scene_saver.hpp"
+#include "scene_save_cache.hpp"
+#include "serializer.hpp"
+
+#include "ignite/scene/scene.hpp"
+#include "ignite/core/profiler.hpp"
+
+namespace ignite {
+
+    SceneSaver::SceneSaver(const Ref<Scene> &scene, const std::filesystem::path &filepath)
+        : m_Scene(scene), m_Filepath(filepath)
+    {
+        SceneSerializer serializer(m_Scene);
+        m_Snapshot = serializer.CaptureSnapshot(m_Filepath);
+        m_CaptureMillis = m_Timer.ElapsedMillis();
+
+        // the snapshot shares nothing with the scene that the main thread still changes
+        JobSystem::Run([this]() { m_Succeeded = SceneSerializer::WriteSnapshot(*m_Snapshot); }, &m_Job);
+    }
+
+    SceneSaver::~SceneSaver()
+    {
+        JobSystem::Wait(m_Job);
+    }
+
+    bool SceneSaver::Update()
+    {
+        IGN_PROFILE_FUNCTION();
+
+        if (m_Status != SceneSaveStatus::Saving)
+            return true;
+
+        if (!m_Job.IsDone())
+            return false;
+
+        SceneSerializer::CacheEmittedBlocks(m_Scene.get(), *m_Snapshot);
+
+        if (m_Succeeded)
+        {
+            SceneSerializer::RecordDependencies(*m_Snapshot);
+            m_Status = SceneSaveStatus::Saved;
+        }
+        else
+        {
+            // WriteSnapshot logged why, the changes are still unsaved
+            m_Scene->SetDirtyFlag(true);
+            m_Status = SceneSaveStatus::Failed;
+        }
+
+        // the blocks and document go back to the cache alone, the next save changes them in place
+        m_Snapshot.reset();
+        return true;
+    }
+}
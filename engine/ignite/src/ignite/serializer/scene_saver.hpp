@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ignite/core/types.hpp"
+#include "ignite/core/time.hpp"
+#include "ignite/core/job_system.hpp"
+
+#include <filesystem>
+
+namespace ignite {
+
+#define SCENE_AUTOSAVE_INTERVAL 120.0f // seconds between autosaves of a dirty scene
+
+    class Scene;
+    struct SceneSaveSnapshot;
+
+    enum class SceneSaveStatus : u8
+    {
+        Saving, // the job is writing the snapshot
+        Saved,
+        Failed
+    };
+
+    // Saves a scene without stalling the frame. The constructor captures a snapshot on the main
+    // thread, which only packs the entities changed since the last save, and a job emits and
+    // writes it to a temporary file renamed over the scene. The scene can be edited, or closed, meanwhile.
+    class SceneSaver
+    {
+    public:
+        SceneSaver(const Ref<Scene> &scene, const std::filesystem::path &filepath);
+
+        // waits for the job, a save is never left halfway
+        ~SceneSaver();
+
+        SceneSaver(const SceneSaver &) = delete;
+        SceneSaver &operator=(const SceneSaver &) = delete;
+
+        // main thread, once per frame. true when saved or failed
+        bool Update();
+
+        [[nodiscard]] SceneSaveStatus GetStatus() const { return m_Status; }
+        [[nodiscard]] bool IsDone() const { return m_Status != SceneSaveStatus::Saving; }
+
+        [[nodiscard]] const std::filesystem::path &GetFilepath() const { return m_Filepath; }
+        [[nodiscard]] f32 GetCaptureMillis() const { return m_CaptureMillis; } // main thread part
+        [[nodiscard]] f32 GetElapsed() const { return m_Timer.Elapsed(); }
+
+    private:
+        Ref<Scene> m_Scene; // dirtied again when the write fails
+        std::filesystem::path m_Filepath;
+
+        Scope<SceneSaveSnapshot> m_Snapshot;
+        JobCounter m_Job;
+        bool m_Succeeded = false; // set by the job before m_Job is done
+
+        SceneSaveStatus m_Status = SceneSaveStatus::Saving;
+        Timer m_Timer;
+        f32 m_CaptureMillis = 0.0f;
+    };
+}
@@ -1,5 +1,7 @@
 #include "serializer.hpp"
-#include "serializer.hpp"
+#include "component_serializer.hpp"
+#include "scene_document.hpp"
+#include "scene_save_cache.hpp"
 
 #include "ignite/scripting/script_class.hpp"
 #include "ignite/scripting/script_engine.hpp"
@@ -8,15 +10,98 @@
 #include "ignite/scene/scene.hpp"
 #include "ignite/project/project.hpp"
 #include "ignite/core/logger.hpp"
+#include "ignite/core/vfs/mapped_file.hpp"
 
 #include "ignite/scene/entity.hpp"
 #include "ignite/scene/component.hpp"
 #include "ignite/scene/scene_manager.hpp"
+#include "ignite/core/profiler.hpp"
 
 #include <fstream>
+#include <spanstream>
 
 namespace ignite {
 
+    namespace
+    {
+        void DeserializeScriptFields(const YAML::Node &node, Entity entity, const Script &comp)
+        {
+            YAML::Node classFieldsNode = node["Fields"];
+            if (!classFieldsNode)
+                return;
+
+            Ref<ScriptClass> scriptClass = ScriptEngine::GetEntityClassesByName(comp.className);
+            if (!scriptClass)
+                return;
+
+            const auto &classFields = scriptClass->GetFields();
+            ScriptFieldMap &fieldMap = ScriptEngine::GetScriptFieldMap(entity);
+
+            for (YAML::Node fieldNode : classFieldsNode)
+            {
+                std::string fieldName = fieldNode["Name"].as<std::string>();
+                ScriptFieldType fieldType = Utils::ScriptFieldTypeFromString(fieldNode["Type"].as<std::string>());
+
+                ScriptFieldInstance &fieldInstance = fieldMap[fieldName];
+
+                if (!fieldMap.contains(fieldName))
+                    continue;
+
+                fieldInstance.Field = classFields.at(fieldName);
+
+                switch (fieldType)
+                {
+                case ScriptFieldType::Float: fieldInstance.SetValue(fieldNode["Value"].as<float>()); break;
+                case ScriptFieldType::Double: fieldInstance.SetValue(fieldNode["Value"].as<double>()); break;
+                case ScriptFieldType::Bool: fieldInstance.SetValue(fieldNode["Value"].as<bool>()); break;
+                case ScriptFieldType::Char: fieldInstance.SetValue(fieldNode["Value"].as<char>()); break;
+                case ScriptFieldType::Byte: fieldInstance.SetValue(fieldNode["Value"].as<int8_t>()); break;
+                case ScriptFieldType::Short: fieldInstance.SetValue(fieldNode["Value"].as<int16_t>()); break;
+                case ScriptFieldType::Long: fieldInstance.SetValue(fieldNode["Value"].as<int64_t>()); break;
+                case ScriptFieldType::UByte: fieldInstance.SetValue(fieldNode["Value"].as<uint8_t>()); break;
+                case ScriptFieldType::UShort: fieldInstance.SetValue(fieldNode["Value"].as<uint16_t>()); break;
+                case ScriptFieldType::UInt: fieldInstance.SetValue(fieldNode["Value"].as<uint32_t>()); break;
+                case ScriptFieldType::ULong: fieldInstance.SetValue(fieldNode["Value"].as<uint64_t>()); break;
+                case ScriptFieldType::Int: fieldInstance.SetValue(fieldNode["Value"].as<int>()); break;
+                case ScriptFieldType::Entity: fieldInstance.SetValue(fieldNode["Value"].as<uint64_t>()); break;
+                case ScriptFieldType::Vector2: fieldInstance.SetValue(fieldNode["Value"].as<glm::vec2>()); break;
+                case ScriptFieldType::Vector3: fieldInstance.SetValue(fieldNode["Value"].as<glm::vec3>()); break;
+                case ScriptFieldType::Vector4: fieldInstance.SetValue(fieldNode["Value"].as<glm::vec4>()); break;
+                }
+            }
+        }
+
+        // one element of the Entities sequence, emitted alone and indented the way
+        // the emitter indents it inside the whole file
+        std::string SerializeEntityBlock(const SceneDocument &document, u32 index)
+        {
+            Serializer sr;
+            sr.BeginSequence();
+            document.EntityToYaml(sr, index);
+            sr.EndSequence();
+
+            const std::string_view emitted = sr.GetString();
+
+            std::string block;
+            block.reserve(emitted.size() + emitted.size() / 8);
+
+            size_t lineStart = 0;
+            while (lineStart < emitted.size())
+            {
+                size_t lineEnd = emitted.find('\n', lineStart);
+                if (lineEnd == std::string_view::npos)
+                    lineEnd = emitted.size();
+
+                if (lineStart > 0)
+                    block += '\n';
+                block += "    ";
+                block += emitted.substr(lineStart, lineEnd - lineStart);
+                lineStart = lineEnd + 1;
+            }
+            return block;
+        }
+    }
+
     Serializer::Serializer(const std::filesystem::path &filepath)
         : m_Filepath(filepath)
     {
@@ -31,6 +116,8 @@ namespace ignite {
 
     void Serializer::Serialize(const std::filesystem::path &filepath)
     {
+        IGN_PROFILE_FUNCTION();
+
         m_Filepath = filepath;
 
         std::ofstream outFile(m_Filepath);
@@ -71,11 +158,15 @@ namespace ignite {
 
     YAML::Node Serializer::Deserialize(const std::filesystem::path &filepath)
     {
-        std::ifstream inFile(filepath);
-        std::stringstream buffer;
-        buffer << inFile.rdbuf();
-        inFile.close();
-        return YAML::Load(buffer.str());
+        IGN_PROFILE_FUNCTION();
+
+        // parse straight from the mapped file instead of copying it into a string first
+        Ref<vfs::MappedFile> mapped = vfs::MappedFile::Open(filepath);
+        if (!mapped)
+            return YAML::Node();
+
+        std::ispanstream stream(std::span<const char>(reinterpret_cast<const char *>(mapped->Data()), static_cast<size_t>(mapped->Size())));
+        return YAML::Load(stream);
     }
 
     SceneSerializer::SceneSerializer(const Ref<Scene> &scene)
@@ -85,224 +176,200 @@ namespace ignite {
 
     bool SceneSerializer::Serialize(const std::filesystem::path &filepath)
     {
+        IGN_PROFILE_FUNCTION();
+
         if (!m_Scene)
             return false;
 
-        Serializer sr(filepath);
+        return Write(CaptureSnapshot(filepath));
+    }
 
-        sr.BeginMap(); // START
+    bool SceneSerializer::SerializeBinary(const std::filesystem::path &filepath)
+    {
+        IGN_PROFILE_FUNCTION();
 
-        sr.BeginMap("Scene"); // scene file header
-        sr.AddKeyValue<std::string>("Version", ENGINE_VERSION);
-        sr.AddKeyValue<std::string>("Title", m_Scene->name);
-        sr.BeginSequence("Entities");
+        if (!m_Scene)
+            return false;
+
+        return Write(CaptureBinary(filepath));
+    }
 
-        // entities sequence
-        for (auto& e : m_Scene->entities | std::views::values)
+    Scope<SceneSaveSnapshot> SceneSerializer::CaptureSnapshot(const std::filesystem::path &filepath)
+    {
+        IGN_PROFILE_FUNCTION();
+
+        if (filepath.extension() == IXSCENE_BINARY_EXTENSION)
+            return CaptureBinary(filepath);
+
+        return CaptureYaml(filepath);
+    }
+
+    bool SceneSerializer::WriteSnapshot(SceneSaveSnapshot &snapshot)
+    {
+        IGN_PROFILE_FUNCTION();
+
+        // both formats are written uncompressed. the YAML file is the editable source, the binary
+        // file is mapped and read in place by ReadBinary. packed builds compress them with LZ4 in the .ixpak
+        if (snapshot.binaryDocument)
+            return snapshot.binaryDocument->WriteBinary(snapshot.filepath);
+
+        // the entities packed by the capture are emitted here, off the main thread
+        if (snapshot.yamlDocument)
         {
-            Entity entity = { e, m_Scene.get() };
-            const ID &idComp = entity.GetComponent<ID>();
+            for (u32 i = 0; i < static_cast<u32>(snapshot.yamlDocument->entities.size()); ++i)
+                snapshot.yamlBlocks[snapshot.yamlDocumentBlocks[i]] = CreateRef<const std::string>(SerializeEntityBlock(*snapshot.yamlDocument, i));
+        }
 
-            sr.BeginMap(); // START Entity
-            {
-                // ID Component
-                sr.AddKeyValue("ID", idComp.uuid);
-                sr.AddKeyValue("Name", idComp.name);
-                sr.AddKeyValue("Type", EntityTypeToString(idComp.type));
-                sr.AddKeyValue("Parent", idComp.parent);
-
-                // Transform Component
-                if (entity.HasComponent<Transform>())
-                {
-                    const Transform &comp = entity.GetComponent<Transform>();
-                    sr.BeginMap("Transform");
-                    {
-                        sr.AddKeyValue("WorldTranslation", comp.translation);
-                        sr.AddKeyValue("WorldRotation", comp.rotation);
-                        sr.AddKeyValue("WorldScale", comp.scale);
+        std::error_code ec;
+        if (snapshot.filepath.has_parent_path())
+            std::filesystem::create_directories(snapshot.filepath.parent_path(), ec);
 
-                        sr.AddKeyValue("LocalTranslation", comp.localTranslation);
-                        sr.AddKeyValue("LocalRotation", comp.localRotation);
-                        sr.AddKeyValue("LocalScale", comp.localScale);
+        // same as the binary file, written next to the scene and renamed over it
+        std::filesystem::path tempFilepath = snapshot.filepath;
+        tempFilepath += ".tmp";
 
-                        sr.AddKeyValue("Visible", comp.visible);
-                    }
-                    sr.EndMap();
-                }
+        {
+            std::ofstream outFile(tempFilepath, std::ios::trunc);
+            outFile << snapshot.yamlHeader;
+            for (const Ref<const std::string> &block : snapshot.yamlBlocks)
+                outFile << '\n' << *block;
 
-                // Camera
-                if (entity.HasComponent<Camera>())
-                {
-                    const Camera &comp = entity.GetComponent<Camera>();
-                    sr.BeginMap("Camera");
-                    {
-                        int projectionType = static_cast<int>(comp.projectionType);
-                        sr.AddKeyValue("ProjectionType", projectionType);
-                        sr.AddKeyValue("NearClip", comp.nearClip);
-                        sr.AddKeyValue("FarClip", comp.farClip);
-                        sr.AddKeyValue("Zoom", comp.zoom);
-                        sr.AddKeyValue("Fov", comp.fov);
-                        sr.AddKeyValue("Primary", comp.primary);
-                    }
-                    sr.EndMap();
-                }
+            if (!outFile.good())
+            {
+                LOG_ERROR("[Scene SR] Failed to write {}", snapshot.filepath.generic_string());
+                outFile.close();
+                std::filesystem::remove(tempFilepath, ec);
+                return false;
+            }
+        }
 
-                // Sprite component
-                if (entity.HasComponent<Sprite2D>())
-                {
-                    const Sprite2D &comp = entity.GetComponent<Sprite2D>();
-                    sr.BeginMap("Sprite2D");
-                    {
-                        sr.AddKeyValue("Color", comp.color);
-                        sr.AddKeyValue("TilingFactor", comp.tilingFactor);
-                    }
-                    sr.EndMap();
-                }
+        std::filesystem::rename(tempFilepath, snapshot.filepath, ec);
+        if (ec)
+        {
+            LOG_ERROR("[Scene SR] Failed to write {}: {}", snapshot.filepath.generic_string(), ec.message());
+            std::filesystem::remove(tempFilepath, ec);
+            return false;
+        }
 
-                // Rigidbody 2D
-                if (entity.HasComponent<Rigidbody2D>())
-                {
-                    const Rigidbody2D &comp = entity.GetComponent<Rigidbody2D>();
-                    sr.BeginMap("Rigidbody2D");
-                    {
-                        sr.AddKeyValue("Type", BodyTypeToString(comp.type));
-                        sr.AddKeyValue("LinearVelocity", comp.linearVelocity);
-                        sr.AddKeyValue("AngularVelocity", comp.angularVelocity);
-                        sr.AddKeyValue("GravityScale", comp.gravityScale);
-                        sr.AddKeyValue("LinearDamping", comp.linearDamping);
-                        sr.AddKeyValue("AngularDamping", comp.angularDamping);
-                        sr.AddKeyValue("FixedRotation", comp.fixedRotation);
-                        sr.AddKeyValue("IsAwake", comp.isAwake);
-                        sr.AddKeyValue("IsEnabled", comp.isEnabled);
-                        sr.AddKeyValue("IsEnableSleep", comp.isEnableSleep);
-                    }
-                    sr.EndMap();
-                }
+        return true;
+    }
 
-                // Box collider 2D
-                if (entity.HasComponent<BoxCollider2D>())
-                {
-                    const BoxCollider2D &comp = entity.GetComponent<BoxCollider2D>();
-                    sr.BeginMap("BoxCollider2D");
-                    {
-                        sr.AddKeyValue("Size", comp.size);
-                        sr.AddKeyValue("Offset", comp.offset);
-                        sr.AddKeyValue("Restitution", comp.restitution);
-                        sr.AddKeyValue("Friction", comp.friction);
-                        sr.AddKeyValue("Density", comp.density);
-                        sr.AddKeyValue("IsSensor", comp.isSensor);
-                    }
-                    sr.EndMap();
-                }
+    void SceneSerializer::CacheEmittedBlocks(Scene *scene, const SceneSaveSnapshot &snapshot)
+    {
+        if (!snapshot.yamlDocument || !scene->saveCache)
+            return;
 
-                // skinned mesh
-                if (entity.HasComponent<SkinnedMesh>())
-                {
-                    const SkinnedMesh &comp = entity.GetComponent<SkinnedMesh>();
-                    sr.BeginMap("SkinnedMesh");
-                    sr.AddKeyValue("Filepath", comp.filepath.generic_string());
-                    sr.EndMap();
-                }
+        // an entity edited again since the capture has another hash, its block is emitted by the next save
+        for (u32 i = 0; i < static_cast<u32>(snapshot.yamlDocument->entities.size()); ++i)
+        {
+            auto it = scene->saveCache->yamlEntities.find(UUID(snapshot.yamlDocument->entities[i].uuid));
+            if (it != scene->saveCache->yamlEntities.end() && !it->second.text && it->second.hash == snapshot.yamlDocumentHashes[i])
+                it->second.text = snapshot.yamlBlocks[snapshot.yamlDocumentBlocks[i]];
+        }
+    }
 
-                // Mesh Renderer
-                if (entity.HasComponent<MeshRenderer>())
-                {
-                    const MeshRenderer &comp = entity.GetComponent<MeshRenderer>();
-                    sr.BeginMap("MeshRenderer");
-                    {
-                        sr.AddKeyValue("Root", static_cast<uint64_t>(comp.root));
-                        sr.AddKeyValue("MeshIndex", comp.meshIndex);
-                    }
-                    sr.EndMap();
-                }
+    void SceneSerializer::RecordDependencies(const SceneSaveSnapshot &snapshot)
+    {
+        if (Project *project = Project::GetActive())
+            project->GetAssetManager().GetDependencyGraph().Record(project->GetAssetRelativeFilepath(snapshot.filepath), snapshot.dependencies);
+    }
 
-                // Audio Source
-                if (entity.HasComponent<AudioSource>())
-                {
-                    const AudioSource &comp = entity.GetComponent<AudioSource>();
-                    sr.BeginMap("AudioSource");
-                    {
-                        sr.AddKeyValue("Handle", static_cast<uint64_t>(comp.handle));
-                        sr.AddKeyValue("Volume", comp.volume);
-                        sr.AddKeyValue("Pitch", comp.pitch);
-                        sr.AddKeyValue("Pan", comp.pan);
-                        sr.AddKeyValue("PlayOnStart", comp.playOnStart);
-                    }
-                    sr.EndMap();
-                }
+    bool SceneSerializer::Write(const Scope<SceneSaveSnapshot> &snapshot)
+    {
+        IGN_PROFILE_FUNCTION();
 
-                // Script
-                if (entity.HasComponent<Script>())
-                {
-                    const Script &comp = entity.GetComponent<Script>();
-                    sr.BeginMap("Script");
-                    {
-                        sr.AddKeyValue("ClassName", comp.className);
+        const bool written = WriteSnapshot(*snapshot);
+        CacheEmittedBlocks(m_Scene.get(), *snapshot);
+        if (!written)
+        {
+            m_Scene->SetDirtyFlag(true);
+            return false;
+        }
 
-                        // Fields
-                        const Ref<ScriptClass> scriptClass = ScriptEngine::GetEntityClassesByName(comp.className);
+        RecordDependencies(*snapshot);
+        return true;
+    }
 
-                        if (scriptClass)
-                        {
-                            const auto &classFields = scriptClass->GetFields();
-
-                            if (!classFields.empty())
-                            {
-                                auto &fields = ScriptEngine::GetScriptFieldMap(entity);
-
-                                sr.BeginSequence("Fields");
-                                for (const auto &[fieldName, field] : classFields)
-                                {
-                                    if (fields.find(fieldName) == fields.end() || field.Type == ScriptFieldType::Invalid)
-                                    {
-                                        continue;
-                                    }
-
-                                    sr.BeginMap();
-                                    sr.AddKeyValue("Name", fieldName);
-                                    sr.AddKeyValue("Type", Utils::ScriptFieldTypeToString(field.Type));
-                                    
-                                    ScriptFieldInstance fieldInstance = fields.at(fieldName);
-                                    switch (field.Type)
-                                    {
-                                    case ScriptFieldType::Float: sr.AddKeyValue("Value", fieldInstance.GetValue<float>()); break;
-                                    case ScriptFieldType::Double: sr.AddKeyValue("Value", fieldInstance.GetValue<double>()); break;
-                                    case ScriptFieldType::Bool: sr.AddKeyValue("Value", fieldInstance.GetValue<bool>()); break;
-                                    case ScriptFieldType::Char: sr.AddKeyValue("Value", fieldInstance.GetValue<char>()); break;
-                                    case ScriptFieldType::Byte: sr.AddKeyValue("Value", fieldInstance.GetValue<int8_t>()); break;
-                                    case ScriptFieldType::Short: sr.AddKeyValue("Value", fieldInstance.GetValue<int16_t>()); break;
-                                    case ScriptFieldType::Long: sr.AddKeyValue("Value", fieldInstance.GetValue<int64_t>()); break;
-                                    case ScriptFieldType::UByte: sr.AddKeyValue("Value", fieldInstance.GetValue<uint8_t>()); break;
-                                    case ScriptFieldType::UShort: sr.AddKeyValue("Value", fieldInstance.GetValue<uint16_t>()); break;
-                                    case ScriptFieldType::UInt: sr.AddKeyValue("Value", fieldInstance.GetValue<uint32_t>()); break;
-                                    case ScriptFieldType::ULong: sr.AddKeyValue("Value", fieldInstance.GetValue<uint64_t>()); break;
-                                    case ScriptFieldType::Int: sr.AddKeyValue("Value", fieldInstance.GetValue<int>()); break;
-                                    case ScriptFieldType::Vector2: sr.AddKeyValue("Value", fieldInstance.GetValue<glm::vec2>()); break;
-                                    case ScriptFieldType::Vector3: sr.AddKeyValue("Value", fieldInstance.GetValue<glm::vec3>()); break;
-                                    case ScriptFieldType::Vector4: sr.AddKeyValue("Value", fieldInstance.GetValue<glm::vec4>()); break;
-                                    case ScriptFieldType::Entity: sr.AddKeyValue("Value", fieldInstance.GetValue<uint64_t>()); break;
-                                    }
-
-                                    sr.EndMap();
-                                }
-
-                                sr.EndSequence();
-                            }
-                        }
+    SceneSaveCache &SceneSerializer::GetSaveCache()
+    {
+        if (!m_Scene->saveCache)
+            m_Scene->saveCache = CreateScope<SceneSaveCache>();
+        return *m_Scene->saveCache;
+    }
 
-                    }
-                    sr.EndMap();
-                }
+    void SceneSerializer::GatherDependencies(const std::vector<SceneSaveEntity> &saveEntities, SceneSaveSnapshot &snapshot)
+    {
+        for (const SceneSaveEntity &saveEntity : saveEntities)
+        {
+            Entity entity = { saveEntity.handle, m_Scene.get() };
 
+            if (entity.HasComponent<SkinnedMesh>())
+            {
+                snapshot.dependencies.push_back(entity.GetComponent<SkinnedMesh>().filepath);
+            }
+
+            if (entity.HasComponent<AudioSource>())
+            {
+                const AudioSource &comp = entity.GetComponent<AudioSource>();
+                if (Project *project = Project::GetActive(); project && project->GetAssetManager().IsAssetHandleValid(comp.handle))
+                    snapshot.dependencies.push_back(project->GetAssetManager().GetFilepath(comp.handle));
             }
-            sr.EndMap(); // END Entity
         }
+    }
 
-        sr.EndSequence(); // Entities
-        sr.EndMap(); // scene
+    Scope<SceneSaveSnapshot> SceneSerializer::CaptureYaml(const std::filesystem::path &filepath)
+    {
+        SceneSaveCache &cache = GetSaveCache();
+        const std::vector<SceneSaveEntity> saveEntities = GatherSaveEntities(m_Scene.get());
+
+        Scope<SceneSaveSnapshot> snapshot = CreateScope<SceneSaveSnapshot>();
+        snapshot->filepath = filepath;
 
+        // scene file header, the entities follow as text blocks
+        Serializer sr;
+        sr.BeginMap(); // START
+        sr.BeginMap("Scene");
+        sr.AddKeyValue<std::string>("Version", ENGINE_VERSION);
+        sr.AddKeyValue<std::string>("Title", m_Scene->name);
+        sr.EndMap(); // scene
         sr.EndMap(); // END
 
+        snapshot->yamlHeader = sr.GetString();
+        snapshot->yamlHeader += saveEntities.empty() ? "\n  Entities: []" : "\n  Entities:";
+
+        // entities in UUID order, only the ones that changed since the last save are packed.
+        // packing copies plain values, the YAML text is emitted by WriteSnapshot on the worker
+        snapshot->yamlBlocks.reserve(saveEntities.size());
+
+        cache.lastEncodedCount = 0;
+        for (const SceneSaveEntity &saveEntity : saveEntities)
+        {
+            SceneSaveCache::YamlEntity &cached = cache.yamlEntities[saveEntity.uuid];
+            if (!cached.text || cached.hash != saveEntity.hash)
+            {
+                if (!snapshot->yamlDocument)
+                    snapshot->yamlDocument = CreateScope<SceneDocument>();
+
+                cached.hash = saveEntity.hash;
+                cached.text.reset(); // set by CacheEmittedBlocks once written
+                snapshot->yamlDocument->AppendEntity(m_Scene.get(), saveEntity.handle);
+                snapshot->yamlDocumentBlocks.push_back(static_cast<u32>(snapshot->yamlBlocks.size()));
+                snapshot->yamlDocumentHashes.push_back(saveEntity.hash);
+                ++cache.lastEncodedCount;
+            }
+
+            snapshot->yamlBlocks.push_back(cached.text);
+        }
+
+        // drop the blocks of destroyed entities
+        if (cache.yamlEntities.size() > saveEntities.size())
+        {
+            std::erase_if(cache.yamlEntities, [this](const auto &entry)
+            {
+                return !m_Scene->entities.contains(entry.first);
+            });
+        }
+
         // Example
 #if 0
         sr.BeginMap(); // START
@@ -350,19 +417,132 @@ namespace ignite {
         sr.EndMap(); // END
 
 #endif
-        sr.Serialize();
 
-        // Scene should be not dirty
+        GatherDependencies(saveEntities, *snapshot);
+
+        // the file will hold the scene as it is now, edits made while it is written dirty it again
         m_Scene->SetDirtyFlag(false);
 
-        return true;
+        return snapshot;
+    }
+
+    Scope<SceneSaveSnapshot> SceneSerializer::CaptureBinary(const std::filesystem::path &filepath)
+    {
+        SceneSaveCache &cache = GetSaveCache();
+        const std::vector<SceneSaveEntity> saveEntities = GatherSaveEntities(m_Scene.get());
+
+        // the records of the last save are reused while the same entities have the same
+        // components, only changed entities are packed again. FromScene uses the same UUID order
+        bool repack = cache.binaryValid
+            && cache.binaryDocument->entities.size() == saveEntities.size()
+            && cache.binaryDocument->GetStringTableSize() <= cache.binaryStringTableSize * SCENE_SAVE_STRING_GROWTH;
+
+        for (size_t i = 0; repack && i < saveEntities.size(); ++i)
+        {
+            repack = cache.binaryDocument->entities[i].uuid == static_cast<u64>(saveEntities[i].uuid)
+                && cache.binaryComponents[i] == saveEntities[i].components;
+        }
+
+        // a snapshot still being written keeps the document it was captured with
+        if (repack && cache.binaryDocument.use_count() > 1)
+            cache.binaryDocument = CreateRef<SceneDocument>(*cache.binaryDocument);
+
+        cache.lastEncodedCount = 0;
+        for (u32 i = 0; repack && i < saveEntities.size(); ++i)
+        {
+            if (cache.binaryHashes[i] == saveEntities[i].hash)
+                continue;
+
+            repack = cache.binaryDocument->RepackEntity(m_Scene.get(), i, saveEntities[i].handle);
+            ++cache.lastEncodedCount;
+        }
+
+        if (!repack)
+        {
+            cache.binaryDocument = CreateRef<SceneDocument>(SceneDocument::FromScene(m_Scene.get()));
+            cache.binaryStringTableSize = cache.binaryDocument->GetStringTableSize();
+            cache.lastEncodedCount = static_cast<u32>(saveEntities.size());
+        }
+
+        cache.binaryDocument->title = m_Scene->name;
+        cache.binaryValid = true;
+
+        cache.binaryHashes.resize(saveEntities.size());
+        cache.binaryComponents.resize(saveEntities.size());
+        for (size_t i = 0; i < saveEntities.size(); ++i)
+        {
+            cache.binaryHashes[i] = saveEntities[i].hash;
+            cache.binaryComponents[i] = saveEntities[i].components;
+        }
+
+        // still written whole to a temporary file and renamed, a crash never leaves half a scene
+        Scope<SceneSaveSnapshot> snapshot = CreateScope<SceneSaveSnapshot>();
+        snapshot->filepath = filepath;
+        snapshot->binaryDocument = cache.binaryDocument;
+        GatherDependencies(saveEntities, *snapshot);
+
+        m_Scene->SetDirtyFlag(false);
+
+        return snapshot;
     }
 
     Ref<Scene> SceneSerializer::Deserialize(const std::filesystem::path &filepath)
     {
         LOG_ASSERT(std::filesystem::exists(filepath), "[Scene SR] File does not exists!\n{}", filepath.generic_string());
 
-        YAML::Node sceneFileNode = Serializer::Deserialize(filepath);
+        if (filepath.extension() == IXSCENE_BINARY_EXTENSION)
+            return DeserializeBinary(filepath);
+
+        return Deserialize(Serializer::Deserialize(filepath));
+    }
+
+    Ref<Scene> SceneSerializer::DeserializeBinary(const std::filesystem::path &filepath)
+    {
+        IGN_PROFILE_FUNCTION();
+
+        SceneDocument document;
+        if (!SceneDocument::ReadBinary(filepath, document))
+            return nullptr;
+
+        return document.CreateScene();
+    }
+
+    bool SceneSerializer::ConvertToBinary(const std::filesystem::path &yamlFilepath, const std::filesystem::path &binaryFilepath)
+    {
+        SceneDocument document;
+        try
+        {
+            if (!SceneDocument::FromYaml(Serializer::Deserialize(yamlFilepath), document))
+            {
+                LOG_ERROR("[Scene SR] Invalid scene file {}", yamlFilepath.generic_string());
+                return false;
+            }
+        }
+        catch (const YAML::Exception &e)
+        {
+            LOG_ERROR("[Scene SR] Failed to parse {}: {}", yamlFilepath.generic_string(), e.what());
+            return false;
+        }
+
+        return document.WriteBinary(binaryFilepath);
+    }
+
+    bool SceneSerializer::ConvertToYaml(const std::filesystem::path &binaryFilepath, const std::filesystem::path &yamlFilepath)
+    {
+        SceneDocument document;
+        if (!SceneDocument::ReadBinary(binaryFilepath, document))
+            return false;
+
+        Serializer sr(yamlFilepath);
+        document.ToYaml(sr);
+        sr.Serialize();
+        return true;
+    }
+
+    Ref<Scene> SceneSerializer::Deserialize(const YAML::Node &sceneFileNode)
+    {
+        IGN_PROFILE_FUNCTION();
+
         YAML::Node sceneNode = sceneFileNode["Scene"];
 
         LOG_ASSERT(sceneNode, "[Scene SR] Invalid scene file");
@@ -382,127 +562,22 @@ namespace ignite {
             UUID parent = UUID(entityNode["Parent"].as<uint64_t>());
             desEntity.GetComponent<ID>().parent = parent;
 
-            // Transform component
-            if (YAML::Node node = entityNode["Transform"])
-            {
-                Transform &comp = desEntity.AddComponent<Transform>();
-                comp.translation = node["WorldTranslation"].as<glm::vec3>();
-                comp.rotation = node["WorldRotation"].as<glm::quat>();
-                comp.scale = node["WorldScale"].as<glm::vec3>();
-                comp.localTranslation = node["WorldTranslation"].as<glm::vec3>();
-                comp.localRotation = node["WorldRotation"].as<glm::quat>();
-                comp.localScale = node["WorldScale"].as<glm::vec3>();
-                comp.visible = node["Visible"].as<bool>();
-            }
-
-            // Camera component
-            if (YAML::Node node = entityNode["Camera"])
-            {
-                Camera &comp = desEntity.AddComponent<Camera>();
-                comp.projectionType = static_cast<ICamera::Type>(node["ProjectionType"].as<int>());
-                comp.nearClip = node["NearClip"].as<float>();
-                comp.farClip = node["FarClip"].as<float>();
-                comp.zoom = node["Zoom"].as<float>();
-                comp.fov = node["Fov"].as<float>();
-                comp.primary = node["Primary"].as<bool>();
-            }
-
-            // Sprite2D component
-            if (YAML::Node node = entityNode["Sprite2D"])
+            // components, read into their ComponentInfo fields
+            ForEachComponentType(AllComponents{}, [&]<typename T>()
             {
-                Sprite2D &comp = desEntity.AddComponent<Sprite2D>();
-                comp.color = node["Color"].as<glm::vec4>();
-                comp.tilingFactor = node["TilingFactor"].as<glm::vec2>();
-            }
-
-            // Rigidbody 2D
-            if (YAML::Node node = entityNode["Rigidbody2D"])
-            {
-                Rigidbody2D &comp = desEntity.AddComponent<Rigidbody2D>();
-                comp.type = BodyTypeFromString(node["Type"].as<std::string>());
-                comp.linearVelocity = node["LinearVelocity"].as<glm::vec2>();
-                comp.angularVelocity = node["AngularVelocity"].as<float>();
-                comp.gravityScale = node["GravityScale"].as<float>();
-                comp.linearDamping = node["LinearDamping"].as<float>();
-                comp.angularDamping = node["AngularDamping"].as<float>();
-                comp.fixedRotation = node["FixedRotation"].as<bool>();
-                comp.isAwake = node["IsAwake"].as<bool>();
-                comp.isEnabled = node["IsEnabled"].as<bool>();
-                comp.isEnableSleep = node["IsEnableSleep"].as<bool>();
-            }
-
-            // BoxCollider 2D
-            if (YAML::Node node = entityNode["BoxCollider2D"])
-            {
-                BoxCollider2D &comp = desEntity.AddComponent<BoxCollider2D>();
-                comp.size = node["Size"].as<glm::vec2>();
-                comp.offset = node["Offset"].as<glm::vec2>();
-                comp.restitution = node["Restitution"].as<float>();
-                comp.friction = node["Friction"].as<float>();
-                comp.density = node["Density"].as<float>();
-                comp.isSensor = node["IsSensor"].as<bool>();
-            }
-
-            // Audio Source
-            if (YAML::Node node = entityNode["AudioSource"])
-            {
-                AudioSource &comp = desEntity.AddComponent<AudioSource>();
-                comp.handle = AssetHandle(node["Handle"].as<uint64_t>());
-                comp.volume = node["Volume"].as<float>();
-                comp.pitch= node["Pitch"].as<float>();
-                comp.pan = node["Pan"].as<float>();
-                comp.playOnStart = node["PlayOnStart"].as<bool>();
-            }
-
-            // Script
-            if (YAML::Node node = entityNode["Script"])
-            {
-                Script &sc = desEntity.AddComponent<Script>();
-                sc.className = node["ClassName"].as<std::string>();
-
-                if (YAML::Node classFieldsNode = node["Fields"])
+                if constexpr ((ComponentInfo<T>::flags & ComponentFlags_SaveOnly) == 0)
                 {
-                    Ref<ScriptClass> scriptClass = ScriptEngine::GetEntityClassesByName(sc.className);
-                    if (scriptClass)
-                    {
-                        const auto &classFields = scriptClass->GetFields();
-                        ScriptFieldMap &fieldMap = ScriptEngine::GetScriptFieldMap(desEntity);
-
-                        for (YAML::Node fieldNode : classFieldsNode)
-                        {
-                            std::string fieldName = fieldNode["Name"].as<std::string>();
-                            ScriptFieldType fieldType = Utils::ScriptFieldTypeFromString(fieldNode["Type"].as<std::string>());
-
-                            ScriptFieldInstance &fieldInstance = fieldMap[fieldName];
-
-                            if (!fieldMap.contains(fieldName))
-                                continue;
-
-                            fieldInstance.Field = classFields.at(fieldName);
-
-                            switch (fieldType)
-                            {
-                            case ScriptFieldType::Float: fieldInstance.SetValue(fieldNode["Value"].as<float>()); break;
-                            case ScriptFieldType::Double: fieldInstance.SetValue(fieldNode["Value"].as<double>()); break;
-                            case ScriptFieldType::Bool: fieldInstance.SetValue(fieldNode["Value"].as<bool>()); break;
-                            case ScriptFieldType::Char: fieldInstance.SetValue(fieldNode["Value"].as<char>()); break;
-                            case ScriptFieldType::Byte: fieldInstance.SetValue(fieldNode["Value"].as<int8_t>()); break;
-                            case ScriptFieldType::Short: fieldInstance.SetValue(fieldNode["Value"].as<int16_t>()); break;
-                            case ScriptFieldType::Long: fieldInstance.SetValue(fieldNode["Value"].as<int64_t>()); break;
-                            case ScriptFieldType::UByte: fieldInstance.SetValue(fieldNode["Value"].as<uint8_t>()); break;
-                            case ScriptFieldType::UShort: fieldInstance.SetValue(fieldNode["Value"].as<uint16_t>()); break;
-                            case ScriptFieldType::UInt: fieldInstance.SetValue(fieldNode["Value"].as<uint32_t>()); break;
-                            case ScriptFieldType::ULong: fieldInstance.SetValue(fieldNode["Value"].as<uint64_t>()); break;
-                            case ScriptFieldType::Int: fieldInstance.SetValue(fieldNode["Value"].as<int>()); break;
-                            case ScriptFieldType::Entity: fieldInstance.SetValue(fieldNode["Value"].as<uint64_t>()); break;
-                            case ScriptFieldType::Vector2: fieldInstance.SetValue(fieldNode["Value"].as<glm::vec2>()); break;
-                            case ScriptFieldType::Vector3: fieldInstance.SetValue(fieldNode["Value"].as<glm::vec3>()); break;
-                            case ScriptFieldType::Vector4: fieldInstance.SetValue(fieldNode["Value"].as<glm::vec4>()); break;
-                            }
-                        }
-                    }
+                    YAML::Node node = entityNode[ComponentInfo<T>::name];
+                    if (!node)
+                        return;
+
+                    // CreateEntity already added the builtin components
+                    T &comp = desEntity.HasComponent<T>() ? desEntity.GetComponent<T>() : desEntity.AddComponent<T>();
+                    DeserializeComponentFields(node, comp);
+                    if constexpr (std::is_same_v<T, Script>)
+                        DeserializeScriptFields(node, desEntity, comp);
                 }
-            }
+            });
         }
         
         // attach each node to it's parent
@@ -567,8 +642,9 @@ namespace ignite {
             assetSr.BeginMap("AssetRegistry");
 
             assetSr.BeginSequence("Assets"); // Asset sequence
-            for (auto &[handle, metadata] : assetRegistry)
+            for (const AssetRegistry::Entry *entry : assetRegistry.GetSortedEntries())
             {
+                const auto &[handle, metadata] = *entry;
                 assetSr.BeginMap(); // Begin Metadata
 
                 assetSr.AddKeyValue("Handle", static_cast<uint64_t>(handle));
@@ -585,6 +661,10 @@ namespace ignite {
             assetSr.Serialize();
         }
 
+        AssetDependencyGraph &dependencyGraph = assetManager.GetDependencyGraph();
+        if (dependencyGraph.IsDirty())
+            dependencyGraph.Save(m_Project->GetCacheDirectory() / ASSET_DEPENDENCY_GRAPH_FILENAME);
+
         return true;
     }
 
@@ -9,6 +9,8 @@
 
 #include <glm/glm.hpp>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <filesystem>
 
@@ -266,10 +268,14 @@ namespace ignite {
 
     class Scene;
     class Project;
+    class SceneSaveCache;
+    struct SceneSaveEntity;
+    struct SceneSaveSnapshot;
 
     class Serializer
     {
     public:
+        Serializer() = default;
         explicit Serializer(const std::filesystem::path &filepath);
 
         void Serialize() const;
@@ -289,10 +295,20 @@ namespace ignite {
             m_Emitter << YAML::Key << keyName << YAML::Value << value;
         }
 
+        // sequence element
+        template<typename T>
+        void AddValue(T value)
+        {
+            m_Emitter << value;
+        }
+
         static YAML::Node Deserialize(const std::filesystem::path &filepath);
 
         const std::filesystem::path &GetFilepath() const { return m_Filepath; }
 
+        // what was emitted so far
+        std::string_view GetString() const { return { m_Emitter.c_str(), m_Emitter.size() }; }
+
     private:
         YAML::Emitter m_Emitter;
         std::filesystem::path m_Filepath;
@@ -303,11 +319,35 @@ namespace ignite {
     public:
         SceneSerializer(const Ref<Scene> &scene);
 
+        // the format follows the extension, IXSCENE_BINARY_EXTENSION is written as binary
         bool Serialize(const std::filesystem::path &filepath);
+        bool SerializeBinary(const std::filesystem::path &filepath);
+
+        // A save in two steps, see SceneSaver. The capture runs on the main thread and leaves
+        // the scene clean, the snapshot can then be written on any thread. The emitted YAML
+        // blocks are cached and the dependencies recorded on the main thread once it is written.
+        Scope<SceneSaveSnapshot> CaptureSnapshot(const std::filesystem::path &filepath);
+        static bool WriteSnapshot(SceneSaveSnapshot &snapshot);
+        static void CacheEmittedBlocks(Scene *scene, const SceneSaveSnapshot &snapshot);
+        static void RecordDependencies(const SceneSaveSnapshot &snapshot);
 
         static Ref<Scene> Deserialize(const std::filesystem::path &filepath);
+        static Ref<Scene> DeserializeBinary(const std::filesystem::path &filepath);
+
+        // builds the scene from an already parsed file, lets the parse run off the main thread
+        static Ref<Scene> Deserialize(const YAML::Node &sceneFileNode);
+
+        // YAML stays the source format, the binary file is built from it for fast loading
+        static bool ConvertToBinary(const std::filesystem::path &yamlFilepath, const std::filesystem::path &binaryFilepath);
+        static bool ConvertToYaml(const std::filesystem::path &binaryFilepath, const std::filesystem::path &yamlFilepath);
 
     private:
+        Scope<SceneSaveSnapshot> CaptureYaml(const std::filesystem::path &filepath);
+        Scope<SceneSaveSnapshot> CaptureBinary(const std::filesystem::path &filepath);
+        void GatherDependencies(const std::vector<SceneSaveEntity> &saveEntities, SceneSaveSnapshot &snapshot);
+        SceneSaveCache &GetSaveCache();
+        bool Write(const Scope<SceneSaveSnapshot> &snapshot);
+
         Ref<Scene> m_Scene;
     };
 
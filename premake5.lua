@@ -25,3 +25,8 @@ group "Engine"
     include "engine/ignite/ignite-engine.lua"
     include "scriptcore/ignite-script.lua"
 group ""
+
+group "Tools"
+    include "tools/packer/ignite-packer.lua"
+    include "tools/scene/ignite-scene.lua"
+group ""
@@ -22,12 +22,17 @@ struct Environment
 {
     float exposure;
     float gamma;
+    float specularMipCount;
+    float padding;
+    float4 irradianceSH[9];
 };
 
 struct Object
 {
     float4x4 transformMatrix;
     float4x4 normalMatrix;
+    uint entityID;
+    uint3 padding;
 };
 
 struct Material
@@ -61,7 +66,7 @@ Texture2D specularTex : register(t1);
 Texture2D emissiveTex : register(t2);
 Texture2D roughnessTex : register(t3);
 Texture2D normalTex : register(t4);
-Texture2D environTex : register(t5);
+TextureCube environTex : register(t5);
 SamplerState sampler0 : register(s0);
 
 float3 CalcDirLight(float3 ldirection, float3 lcolor, float3 normal, float3 viewDirection, float3 diffTexColor, float shadow)
@@ -115,8 +120,8 @@ PSOutput main(PSInput input)
     float3 specularColor = lerp(float3(0.04f, 0.04f, 0.04f), albedo, finalMetallic);
     
     float3 reflectDir = reflect(-viewDir, normal);
-    float mipLevel = filteredRoughness * 5.0f;
-    float3 reflectRadiance = SampleSphericalMap(environTex, sampler0, reflectDir);
+    float mipLevel = filteredRoughness * (env.specularMipCount - 1.0f);
+    float3 reflectRadiance = environTex.SampleLevel(sampler0, reflectDir, mipLevel).rgb;
     reflectRadiance = reflectRadiance / (reflectRadiance + 1.0f); // soft clamp (ACES-like)
 
     float reflectionStrength = lerp(0.001f, 1.0f, finalMetallic);
@@ -127,7 +132,7 @@ PSOutput main(PSInput input)
     float3 reflectedSpecular = GGXReflect(normal, viewDir, reflectDir, reflectRadiance, specularColor, material.roughness);
     reflectedSpecular *= reflectionStrength * dirLight.intensity * NdotR * F;
 
-    float3 ambient = dirLight.color.rgb * dirLight.ambientIntensity * diffuseColor;
+    float3 ambient = EvaluateIrradianceSH(env.irradianceSH, normal) * dirLight.ambientIntensity * diffuseColor;
     float3 irradiance = dirLight.color.rgb * dirLight.intensity;
     
     lighting = GGX(
@@ -13,6 +13,8 @@ struct Object
 {
     float4x4 transformMatrix;
     float4x4 normalMatrix;
+    uint entityID;
+    uint3 padding;
     float4x4 boneTransforms[MAX_BONES];
 };
 
@@ -28,7 +30,6 @@ struct VSInput
     float4 color        : COLOR;
     uint4 boneIDs       : BONEIDS;
     float4 weights      : WEIGHTS;
-    uint entityID       : ENTITYID;
 };
 
 struct PSInput
@@ -81,6 +82,6 @@ PSInput main(VSInput input)
     output.UV           = input.UV;
     output.tilingFactor = input.tilingFactor;
     output.color        = input.color;
-    output.entityID     = input.entityID;
+    output.entityID     = object.entityID;
     return output;
 }
\ No newline at end of file
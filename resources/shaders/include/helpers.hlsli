@@ -74,3 +74,18 @@ float3 SampleSphericalMap(Texture2D tex, SamplerState samp, float3 dir)
     uv.y = asin(clamp(dir.y, -1.0f, 1.0f)) / 3.14159265f + 0.5f;
     return tex.Sample(samp, uv).rgb;
 }
+
+// L2 spherical harmonics baked by the environment baker, returns diffuse radiance
+float3 EvaluateIrradianceSH(float4 sh[9], float3 n)
+{
+    float3 result = sh[0].rgb * 0.282095f;
+    result += sh[1].rgb * (0.488603f * n.y);
+    result += sh[2].rgb * (0.488603f * n.z);
+    result += sh[3].rgb * (0.488603f * n.x);
+    result += sh[4].rgb * (1.092548f * n.x * n.y);
+    result += sh[5].rgb * (1.092548f * n.y * n.z);
+    result += sh[6].rgb * (0.315392f * (3.0f * n.z * n.z - 1.0f));
+    result += sh[7].rgb * (1.092548f * n.x * n.z);
+    result += sh[8].rgb * (0.546274f * (n.x * n.x - n.y * n.y));
+    return max(result, float3(0.0f, 0.0f, 0.0f));
+}
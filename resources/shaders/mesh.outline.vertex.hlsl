@@ -13,6 +13,8 @@ struct Object
 {
     float4x4 transformMatrix;
     float4x4 normalMatrix;
+    uint entityID;
+    uint3 padding;
     float4x4 boneTransforms[MAX_BONES];
 };
 
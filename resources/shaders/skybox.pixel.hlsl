@@ -14,7 +14,7 @@ struct PSInput
     float3 UVW      : UVW;
 };
 
-Texture2D texture0 : register(t0);
+TextureCube texture0 : register(t0);
 SamplerState sampler0 : register(s0);
 
 struct PSOutput
@@ -27,7 +27,7 @@ PSOutput main(PSInput input)
 {
     PSOutput result;
     float3 dir = normalize(input.UVW);
-    float3 color = SampleSphericalMap(texture0, sampler0, dir);
+    float3 color = texture0.SampleLevel(sampler0, dir, 0.0f).rgb;
 
     result.color = float4(FilmicTonemap(color, env.exposure, env.gamma), 1.0f);
     result.entityID = uint4(-1, -1, -1, -1);
@@ -4,6 +4,95 @@ namespace Ignite
     public abstract class Component
     {
         public Entity Entity { get; internal set; }
+
+        // fields declared in the engine ComponentInfo, the name is the scene file key
+        protected bool GetBool(string field)
+        {
+            InternalCalls.Component_GetBool(Entity.ID, GetType(), field, out bool value);
+            return value;
+        }
+
+        protected void SetBool(string field, bool value)
+        {
+            InternalCalls.Component_SetBool(Entity.ID, GetType(), field, value);
+        }
+
+        protected int GetInt(string field)
+        {
+            InternalCalls.Component_GetInt(Entity.ID, GetType(), field, out int value);
+            return value;
+        }
+
+        protected void SetInt(string field, int value)
+        {
+            InternalCalls.Component_SetInt(Entity.ID, GetType(), field, value);
+        }
+
+        protected float GetFloat(string field)
+        {
+            InternalCalls.Component_GetFloat(Entity.ID, GetType(), field, out float value);
+            return value;
+        }
+
+        protected void SetFloat(string field, float value)
+        {
+            InternalCalls.Component_SetFloat(Entity.ID, GetType(), field, value);
+        }
+
+        protected Vector2 GetVector2(string field)
+        {
+            InternalCalls.Component_GetVector2(Entity.ID, GetType(), field, out Vector2 value);
+            return value;
+        }
+
+        protected void SetVector2(string field, Vector2 value)
+        {
+            InternalCalls.Component_SetVector2(Entity.ID, GetType(), field, value);
+        }
+
+        protected Vector3 GetVector3(string field)
+        {
+            InternalCalls.Component_GetVector3(Entity.ID, GetType(), field, out Vector3 value);
+            return value;
+        }
+
+        protected void SetVector3(string field, Vector3 value)
+        {
+            InternalCalls.Component_SetVector3(Entity.ID, GetType(), field, value);
+        }
+
+        protected Vector4 GetVector4(string field)
+        {
+            InternalCalls.Component_GetVector4(Entity.ID, GetType(), field, out Vector4 value);
+            return value;
+        }
+
+        protected void SetVector4(string field, Vector4 value)
+        {
+            InternalCalls.Component_SetVector4(Entity.ID, GetType(), field, value);
+        }
+
+        protected Quaternion GetQuaternion(string field)
+        {
+            InternalCalls.Component_GetQuaternion(Entity.ID, GetType(), field, out Quaternion value);
+            return value;
+        }
+
+        protected void SetQuaternion(string field, Quaternion value)
+        {
+            InternalCalls.Component_SetQuaternion(Entity.ID, GetType(), field, value);
+        }
+
+        protected ulong GetULong(string field)
+        {
+            InternalCalls.Component_GetULong(Entity.ID, GetType(), field, out ulong value);
+            return value;
+        }
+
+        protected void SetULong(string field, ulong value)
+        {
+            InternalCalls.Component_SetULong(Entity.ID, GetType(), field, value);
+        }
     }
 
     public class Transform : Component
@@ -102,4 +191,359 @@ namespace Ignite
             }
         }
     }
+
+    public class Camera : Component
+    {
+        public enum ProjectionType
+        {
+            Orthographic = 0,
+            Perspective
+        }
+
+        public ProjectionType Projection
+        {
+            get { return (ProjectionType)GetInt("ProjectionType"); }
+            set { SetInt("ProjectionType", (int)value); }
+        }
+
+        public float NearClip
+        {
+            get { return GetFloat("NearClip"); }
+            set { SetFloat("NearClip", value); }
+        }
+
+        public float FarClip
+        {
+            get { return GetFloat("FarClip"); }
+            set { SetFloat("FarClip", value); }
+        }
+
+        public float Zoom
+        {
+            get { return GetFloat("Zoom"); }
+            set { SetFloat("Zoom", value); }
+        }
+
+        public float Fov
+        {
+            get { return GetFloat("Fov"); }
+            set { SetFloat("Fov", value); }
+        }
+
+        public bool Primary
+        {
+            get { return GetBool("Primary"); }
+            set { SetBool("Primary", value); }
+        }
+    }
+
+    public class Sprite2D : Component
+    {
+        public Vector4 Color
+        {
+            get { return GetVector4("Color"); }
+            set { SetVector4("Color", value); }
+        }
+
+        public Vector2 TilingFactor
+        {
+            get { return GetVector2("TilingFactor"); }
+            set { SetVector2("TilingFactor", value); }
+        }
+    }
+
+    public class Rigidbody2D : Component
+    {
+        public enum BodyType
+        {
+            Static = 0,
+            Dynamic,
+            Kinematic
+        }
+
+        public BodyType Type
+        {
+            get { return (BodyType)GetInt("Type"); }
+            set { SetInt("Type", (int)value); }
+        }
+
+        public Vector2 LinearVelocity
+        {
+            get { return GetVector2("LinearVelocity"); }
+            set { SetVector2("LinearVelocity", value); }
+        }
+
+        public float AngularVelocity
+        {
+            get { return GetFloat("AngularVelocity"); }
+            set { SetFloat("AngularVelocity", value); }
+        }
+
+        public float GravityScale
+        {
+            get { return GetFloat("GravityScale"); }
+            set { SetFloat("GravityScale", value); }
+        }
+
+        public float LinearDamping
+        {
+            get { return GetFloat("LinearDamping"); }
+            set { SetFloat("LinearDamping", value); }
+        }
+
+        public float AngularDamping
+        {
+            get { return GetFloat("AngularDamping"); }
+            set { SetFloat("AngularDamping", value); }
+        }
+
+        public bool FixedRotation
+        {
+            get { return GetBool("FixedRotation"); }
+            set { SetBool("FixedRotation", value); }
+        }
+
+        public bool IsAwake
+        {
+            get { return GetBool("IsAwake"); }
+            set { SetBool("IsAwake", value); }
+        }
+
+        public bool IsEnabled
+        {
+            get { return GetBool("IsEnabled"); }
+            set { SetBool("IsEnabled", value); }
+        }
+
+        public bool IsEnableSleep
+        {
+            get { return GetBool("IsEnableSleep"); }
+            set { SetBool("IsEnableSleep", value); }
+        }
+    }
+
+    public class BoxCollider2D : Component
+    {
+        public Vector2 Size
+        {
+            get { return GetVector2("Size"); }
+            set { SetVector2("Size", value); }
+        }
+
+        public Vector2 Offset
+        {
+            get { return GetVector2("Offset"); }
+            set { SetVector2("Offset", value); }
+        }
+
+        public float Restitution
+        {
+            get { return GetFloat("Restitution"); }
+            set { SetFloat("Restitution", value); }
+        }
+
+        public float Friction
+        {
+            get { return GetFloat("Friction"); }
+            set { SetFloat("Friction", value); }
+        }
+
+        public float Density
+        {
+            get { return GetFloat("Density"); }
+            set { SetFloat("Density", value); }
+        }
+
+        public bool IsSensor
+        {
+            get { return GetBool("IsSensor"); }
+            set { SetBool("IsSensor", value); }
+        }
+    }
+
+    public class AudioSource : Component
+    {
+        public float Volume
+        {
+            get { return GetFloat("Volume"); }
+            set { SetFloat("Volume", value); }
+        }
+
+        public float Pitch
+        {
+            get { return GetFloat("Pitch"); }
+            set { SetFloat("Pitch", value); }
+        }
+
+        public float Pan
+        {
+            get { return GetFloat("Pan"); }
+            set { SetFloat("Pan", value); }
+        }
+
+        public bool PlayOnStart
+        {
+            get { return GetBool("PlayOnStart"); }
+            set { SetBool("PlayOnStart", value); }
+        }
+    }
+
+    public class Rigidbody : Component
+    {
+        public enum MotionQualityType
+        {
+            Discrete = 0,
+            LinearCast
+        }
+
+        public MotionQualityType MotionQuality
+        {
+            get { return (MotionQualityType)GetInt("MotionQuality"); }
+            set { SetInt("MotionQuality", (int)value); }
+        }
+
+        public bool UseGravity
+        {
+            get { return GetBool("UseGravity"); }
+            set { SetBool("UseGravity", value); }
+        }
+
+        public bool RotateX
+        {
+            get { return GetBool("RotateX"); }
+            set { SetBool("RotateX", value); }
+        }
+
+        public bool RotateY
+        {
+            get { return GetBool("RotateY"); }
+            set { SetBool("RotateY", value); }
+        }
+
+        public bool RotateZ
+        {
+            get { return GetBool("RotateZ"); }
+            set { SetBool("RotateZ", value); }
+        }
+
+        public bool MoveX
+        {
+            get { return GetBool("MoveX"); }
+            set { SetBool("MoveX", value); }
+        }
+
+        public bool MoveY
+        {
+            get { return GetBool("MoveY"); }
+            set { SetBool("MoveY", value); }
+        }
+
+        public bool MoveZ
+        {
+            get { return GetBool("MoveZ"); }
+            set { SetBool("MoveZ", value); }
+        }
+
+        public bool IsStatic
+        {
+            get { return GetBool("IsStatic"); }
+            set { SetBool("IsStatic", value); }
+        }
+
+        public float Mass
+        {
+            get { return GetFloat("Mass"); }
+            set { SetFloat("Mass", value); }
+        }
+
+        public bool AllowSleeping
+        {
+            get { return GetBool("AllowSleeping"); }
+            set { SetBool("AllowSleeping", value); }
+        }
+
+        public bool RetainAcceleration
+        {
+            get { return GetBool("RetainAcceleration"); }
+            set { SetBool("RetainAcceleration", value); }
+        }
+
+        public float GravityFactor
+        {
+            get { return GetFloat("GravityFactor"); }
+            set { SetFloat("GravityFactor", value); }
+        }
+
+        public Vector3 CenterMass
+        {
+            get { return GetVector3("CenterMass"); }
+            set { SetVector3("CenterMass", value); }
+        }
+    }
+
+    public class BoxCollider : Component
+    {
+        public Vector3 Scale
+        {
+            get { return GetVector3("Scale"); }
+            set { SetVector3("Scale", value); }
+        }
+
+        public float Friction
+        {
+            get { return GetFloat("Friction"); }
+            set { SetFloat("Friction", value); }
+        }
+
+        public float StaticFriction
+        {
+            get { return GetFloat("StaticFriction"); }
+            set { SetFloat("StaticFriction", value); }
+        }
+
+        public float Restitution
+        {
+            get { return GetFloat("Restitution"); }
+            set { SetFloat("Restitution", value); }
+        }
+
+        public float Density
+        {
+            get { return GetFloat("Density"); }
+            set { SetFloat("Density", value); }
+        }
+    }
+
+    public class SphereCollider : Component
+    {
+        public float Radius
+        {
+            get { return GetFloat("Radius"); }
+            set { SetFloat("Radius", value); }
+        }
+
+        public float Friction
+        {
+            get { return GetFloat("Friction"); }
+            set { SetFloat("Friction", value); }
+        }
+
+        public float StaticFriction
+        {
+            get { return GetFloat("StaticFriction"); }
+            set { SetFloat("StaticFriction", value); }
+        }
+
+        public float Restitution
+        {
+            get { return GetFloat("Restitution"); }
+            set { SetFloat("Restitution", value); }
+        }
+
+        public float Density
+        {
+            get { return GetFloat("Density"); }
+            set { SetFloat("Density", value); }
+        }
+    }
 }
@@ -54,5 +54,39 @@ namespace Ignite
         internal extern static void TransformComponent_GetScale(ulong entityID, out Vector3 result);
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         internal extern static void TransformComponent_SetScale(ulong entityID, Vector3 value);
+
+        // Reflected component fields, matched by name and type
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_GetBool(ulong entityID, Type componentType, string field, out bool result);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_SetBool(ulong entityID, Type componentType, string field, bool value);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_GetInt(ulong entityID, Type componentType, string field, out int result);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_SetInt(ulong entityID, Type componentType, string field, int value);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_GetFloat(ulong entityID, Type componentType, string field, out float result);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_SetFloat(ulong entityID, Type componentType, string field, float value);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_GetVector2(ulong entityID, Type componentType, string field, out Vector2 result);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_SetVector2(ulong entityID, Type componentType, string field, Vector2 value);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_GetVector3(ulong entityID, Type componentType, string field, out Vector3 result);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_SetVector3(ulong entityID, Type componentType, string field, Vector3 value);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_GetVector4(ulong entityID, Type componentType, string field, out Vector4 result);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_SetVector4(ulong entityID, Type componentType, string field, Vector4 value);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_GetQuaternion(ulong entityID, Type componentType, string field, out Quaternion result);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_SetQuaternion(ulong entityID, Type componentType, string field, Quaternion value);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_GetULong(ulong entityID, Type componentType, string field, out ulong result);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void Component_SetULong(ulong entityID, Type componentType, string field, ulong value);
     }
 }
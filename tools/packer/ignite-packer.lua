@@ -0,0 +1,66 @@
+project "IgnitePacker"
+kind "ConsoleApp"
+staticruntime "off"
+architecture "x64"
+language "c++"
+cppdialect "c++23"
+
+targetdir (OUTPUT_DIR)
+objdir (INTOUTPUT_DIR)
+
+files {
+    "src/**.cpp",
+    "src/**.hpp",
+}
+
+links {
+    "IgniteEngine"
+}
+
+includedirs {
+    "src",
+    "%{wks.location}/engine/ignite/src",
+    "%{IncludeDir.GLM}",
+    "%{IncludeDir.SPDLOG}",
+}
+
+filter "system:linux"
+defines {
+    "PLATFORM_LINUX",
+}
+
+filter "system:windows"
+buildoptions {
+    "/utf-8"
+}
+defines {
+    "PLATFORM_WINDOWS",
+    "NOMINMAX",
+    "_CRT_SECURE_NO_WARNINGS"
+}
+
+filter "configurations:Debug"
+    runtime "Debug"
+    optimize "off"
+    symbols "on"
+    defines {
+        "DEBUG",
+        "_DEBUG",
+    }
+
+filter "configurations:Release"
+    runtime "Release"
+    optimize "on"
+    symbols "off"
+    defines {
+        "NDEBUG"
+    }
+
+filter "configurations:Dist"
+    runtime "Release"
+    optimize "on"
+    symbols "off"
+    defines {
+        "NDEBUG",
+        "IGNITE_DIST"
+    }
@@ -0,0 +1,47 @@
+#include <ignite/core/logger.hpp>
+#include <ignite/core/vfs/pack_file_system.hpp>
+
+#include <cstring>
+
+using namespace ignite;
+
+// IgnitePacker <asset directory> <output.ixpak> [--store]
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::printf("usage: IgnitePacker <asset directory> <output.ixpak> [--store]\n");
+        std::printf("  --store  write files uncompressed, every file can be mapped without a copy\n");
+        return 1;
+    }
+
+    const std::filesystem::path assetDirectory = argv[1];
+    const std::filesystem::path outputFilepath = argv[2];
+
+    vfs::PackCompression compression = vfs::PackCompression::LZ4;
+    for (int i = 3; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--store") == 0)
+            compression = vfs::PackCompression::None;
+    }
+
+    Logger::Init();
+
+    int result = 0;
+    if (!std::filesystem::is_directory(assetDirectory))
+    {
+        LOG_ERROR("[Packer] {} is not a directory", assetDirectory.generic_string());
+        result = 1;
+    }
+    else
+    {
+        vfs::PackBuilder builder;
+        builder.AddDirectory(assetDirectory, compression);
+
+        if (!builder.Write(outputFilepath))
+            result = 1;
+    }
+
+    Logger::Shutdown();
+    return result;
+}
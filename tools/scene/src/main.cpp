@@ -0,0 +1,149 @@
+#include <ignite/core/logger.hpp>
+#include <ignite/core/time.hpp>
+#include <ignite/serializer/serializer.hpp>
+#include <ignite/serializer/scene_document.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+using namespace ignite;
+
+namespace
+{
+    struct BenchResult
+    {
+        f32 min = 0.0f;
+        f32 avg = 0.0f;
+    };
+
+    BenchResult Measure(int iterations, const std::function<bool()> &func)
+    {
+        BenchResult result;
+        result.min = std::numeric_limits<f32>::max();
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            Timer timer;
+            if (!func())
+                return {};
+
+            const f32 elapsed = timer.ElapsedMillis();
+            result.min = std::min(result.min, elapsed);
+            result.avg += elapsed / static_cast<f32>(iterations);
+        }
+
+        return result;
+    }
+
+    void PrintResult(const char *name, const BenchResult &yaml, const BenchResult &binary)
+    {
+        std::printf("  %-6s yaml %10.2f ms (min %10.2f)   binary %8.2f ms (min %8.2f)   x%.1f\n",
+            name, yaml.avg, yaml.min, binary.avg, binary.min, binary.avg > 0.0f ? yaml.avg / binary.avg : 0.0f);
+    }
+
+    // load and save of the same scene through both formats, entity creation is left out
+    // since it needs the runtime, the bulk insert only replaces the per entity AddComponent calls
+    int Bench(const std::filesystem::path &filepath, int iterations)
+    {
+        SceneDocument document;
+        try
+        {
+            if (!SceneDocument::FromYaml(Serializer::Deserialize(filepath), document))
+            {
+                LOG_ERROR("[Scene Tool] Invalid scene file {}", filepath.generic_string());
+                return 1;
+            }
+        }
+        catch (const YAML::Exception &e)
+        {
+            LOG_ERROR("[Scene Tool] Failed to parse {}: {}", filepath.generic_string(), e.what());
+            return 1;
+        }
+
+        const std::filesystem::path tempDirectory = std::filesystem::temp_directory_path();
+        const std::filesystem::path yamlFilepath = tempDirectory / "ignite-scene-bench.ixscene";
+        const std::filesystem::path binaryFilepath = tempDirectory / ("ignite-scene-bench" IXSCENE_BINARY_EXTENSION);
+
+        const BenchResult yamlSave = Measure(iterations, [&]()
+        {
+            Serializer sr(yamlFilepath);
+            document.ToYaml(sr);
+            sr.Serialize();
+            return true;
+        });
+
+        const BenchResult binarySave = Measure(iterations, [&]()
+        {
+            return document.WriteBinary(binaryFilepath);
+        });
+
+        const BenchResult yamlLoad = Measure(iterations, [&]()
+        {
+            SceneDocument loaded;
+            return SceneDocument::FromYaml(Serializer::Deserialize(yamlFilepath), loaded);
+        });
+
+        const BenchResult binaryLoad = Measure(iterations, [&]()
+        {
+            SceneDocument loaded;
+            return SceneDocument::ReadBinary(binaryFilepath, loaded);
+        });
+
+        std::error_code ec;
+        std::printf("%s: %zu entities, %d iterations\n", filepath.generic_string().c_str(), document.entities.size(), iterations);
+        std::printf("  size   yaml %10llu bytes        binary %8llu bytes\n",
+            static_cast<unsigned long long>(std::filesystem::file_size(yamlFilepath, ec)),
+            static_cast<unsigned long long>(std::filesystem::file_size(binaryFilepath, ec)));
+        PrintResult("load", yamlLoad, binaryLoad);
+        PrintResult("save", yamlSave, binarySave);
+
+        std::filesystem::remove(yamlFilepath, ec);
+        std::filesystem::remove(binaryFilepath, ec);
+        return 0;
+    }
+}
+
+// IgniteSceneTool convert <input> <output>
+// IgniteSceneTool bench <scene.ixscene> [iterations]
+int main(int argc, char **argv)
+{
+    if (argc < 3 || (std::strcmp(argv[1], "convert") == 0 && argc < 4))
+    {
+        std::printf("usage: IgniteSceneTool convert <input> <output>\n");
+        std::printf("       IgniteSceneTool bench <scene.ixscene> [iterations]\n");
+        std::printf("  convert  .ixscene (YAML) to %s (binary) or back, picked from the input extension\n", IXSCENE_BINARY_EXTENSION);
+        std::printf("  bench    time load and save of the scene as YAML and as binary\n");
+        return 1;
+    }
+
+    Logger::Init();
+
+    int result = 0;
+    if (std::strcmp(argv[1], "convert") == 0)
+    {
+        const std::filesystem::path inputFilepath = argv[2];
+        const std::filesystem::path outputFilepath = argv[3];
+
+        const bool converted = inputFilepath.extension() == IXSCENE_BINARY_EXTENSION
+            ? SceneSerializer::ConvertToYaml(inputFilepath, outputFilepath)
+            : SceneSerializer::ConvertToBinary(inputFilepath, outputFilepath);
+
+        result = converted ? 0 : 1;
+    }
+    else if (std::strcmp(argv[1], "bench") == 0)
+    {
+        const int iterations = argc > 3 ? std::max(1, std::atoi(argv[3])) : 5;
+        result = Bench(argv[2], iterations);
+    }
+    else
+    {
+        LOG_ERROR("[Scene Tool] Unknown command {}", argv[1]);
+        result = 1;
+    }
+
+    Logger::Shutdown();
+    return result;
+}